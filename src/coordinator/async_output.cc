@@ -0,0 +1,221 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! AsyncOutput: snapshot-based, background visualization and checkpoint writes.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: ATS developers
+*/
+
+#include "mpi.h"
+#include "hdf5.h"
+
+#include "errors.hh"
+#include "State.hh"
+
+#include "async_output.hh"
+
+namespace ATS {
+
+AsyncOutput::AsyncOutput(Teuchos::ParameterList& plist) :
+    in_flight_(0),
+    done_(false)
+{
+  nsnapshots_ = plist.get<int>("asynchronous output queue length", 2);
+  if (nsnapshots_ < 1) {
+    Errors::Message msg("Coordinator: \"asynchronous output queue length\" must be positive.");
+    Exceptions::amanzi_throw(msg);
+  }
+
+  int provided = MPI_THREAD_SINGLE;
+  MPI_Query_thread(&provided);
+  hbool_t hdf5_threadsafe = 0;
+  if (H5is_library_threadsafe(&hdf5_threadsafe) < 0) hdf5_threadsafe = 0;
+  threaded_ = provided == MPI_THREAD_MULTIPLE && hdf5_threadsafe;
+
+  if (threaded_) worker_ = std::thread(&AsyncOutput::Run_, this);
+}
+
+
+AsyncOutput::~AsyncOutput()
+{
+  if (threaded_) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      done_ = true;
+    }
+    cv_.notify_all();
+    worker_.join();
+  }
+
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  if (!finalized) {
+    for (auto& comm : comms_) MPI_Comm_free(&comm);
+  }
+}
+
+
+void
+AsyncOutput::Write(const Teuchos::RCP<Amanzi::State>& S,
+                   const std::vector<Writer>& writers)
+{
+  if (writers.empty()) return;
+
+  if (!threaded_) {
+    for (const auto& writer : writers) writer(S.ptr());
+    return;
+  }
+
+  // Snapshots are created at the first write, once the fields to be written
+  // are known, and before the writer thread has any job to read them.
+  if (snapshots_.empty()) {
+    for (int i=0; i!=nsnapshots_; ++i) {
+      snapshots_.push_back(CreateSnapshot_(*S));
+      free_.push_back(i);
+    }
+  }
+
+  // wait for a free snapshot -- this is the back-pressure
+  int slot;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]() { return !free_.empty() || error_; });
+    Rethrow_();
+    slot = free_.back();
+    free_.pop_back();
+  }
+
+  // only this thread touches a snapshot that is not queued
+  CopyToSnapshot_(*S, *snapshots_[slot]);
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    jobs_.push_back(Job{slot, writers});
+  }
+  cv_.notify_all();
+}
+
+
+void
+AsyncOutput::Flush()
+{
+  if (!threaded_) return;
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this]() { return (jobs_.empty() && in_flight_ == 0) || error_; });
+  Rethrow_();
+}
+
+
+Epetra_MpiComm*
+AsyncOutput::Duplicate(const Epetra_MpiComm& comm)
+{
+  MPI_Comm dup;
+  MPI_Comm_dup(comm.Comm(), &dup);
+  comms_.push_back(dup);
+  epetra_comms_.push_back(Teuchos::rcp(new Epetra_MpiComm(dup)));
+  return epetra_comms_.back().get();
+}
+
+
+void
+AsyncOutput::Run_()
+{
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this]() { return !jobs_.empty() || done_; });
+      if (jobs_.empty()) return;
+      job = jobs_.front();
+      jobs_.pop_front();
+      ++in_flight_;
+    }
+
+    std::exception_ptr error;
+    try {
+      for (const auto& writer : job.writers) writer(snapshots_[job.slot].ptr());
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      --in_flight_;
+      free_.push_back(job.slot);
+      if (error && !error_) error_ = error;
+    }
+    cv_.notify_all();
+  }
+}
+
+
+Teuchos::RCP<Amanzi::State>
+AsyncOutput::CreateSnapshot_(const Amanzi::State& S)
+{
+  Teuchos::ParameterList state_list;
+  Teuchos::RCP<Amanzi::State> snapshot = Teuchos::rcp(new Amanzi::State(state_list));
+  for (Amanzi::State::mesh_iterator mesh=S.mesh_begin(); mesh!=S.mesh_end(); ++mesh) {
+    snapshot->RegisterMesh(mesh->first, mesh->second.first, mesh->second.second);
+  }
+
+  for (Amanzi::State::field_iterator f=S.field_begin(); f!=S.field_end(); ++f) {
+    const Amanzi::Field& field = *f->second;
+    if (!field.io_vis() && !field.io_checkpoint()) continue;
+
+    if (field.type() == Amanzi::COMPOSITE_VECTOR_FIELD) {
+      snapshot->RequireField(f->first, field.owner())
+          ->Update(S.GetFieldData(f->first)->Map());
+    } else if (field.type() == Amanzi::CONSTANT_SCALAR) {
+      snapshot->RequireScalar(f->first, field.owner());
+    } else if (field.type() == Amanzi::CONSTANT_VECTOR) {
+      snapshot->RequireConstantVector(f->first, field.owner(),
+              S.GetConstantVectorData(f->first)->MyLength());
+    }
+  }
+  snapshot->Setup();
+
+  for (Amanzi::State::field_iterator f=snapshot->field_begin(); f!=snapshot->field_end(); ++f) {
+    Teuchos::RCP<const Amanzi::Field> field = S.GetField(f->first);
+    f->second->set_io_vis(field->io_vis());
+    f->second->set_io_checkpoint(field->io_checkpoint());
+    f->second->set_initialized();
+  }
+  return snapshot;
+}
+
+
+void
+AsyncOutput::CopyToSnapshot_(const Amanzi::State& S, Amanzi::State& snapshot)
+{
+  for (Amanzi::State::field_iterator f=snapshot.field_begin(); f!=snapshot.field_end(); ++f) {
+    const Amanzi::Key& key = f->first;
+    const Amanzi::Key& owner = f->second->owner();
+    if (f->second->type() == Amanzi::COMPOSITE_VECTOR_FIELD) {
+      *snapshot.GetFieldData(key, owner) = *S.GetFieldData(key);
+    } else if (f->second->type() == Amanzi::CONSTANT_SCALAR) {
+      *snapshot.GetScalarData(key, owner) = *S.GetScalarData(key);
+    } else if (f->second->type() == Amanzi::CONSTANT_VECTOR) {
+      *snapshot.GetConstantVectorData(key, owner) = *S.GetConstantVectorData(key);
+    }
+  }
+  snapshot.set_time(S.time());
+  snapshot.set_cycle(S.cycle());
+}
+
+
+// Errors on the writer thread are reported on the main thread at the next
+// Write() or Flush().  Called with the mutex held.
+void
+AsyncOutput::Rethrow_()
+{
+  if (error_) {
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+} // namespace ATS
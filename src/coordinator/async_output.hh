@@ -0,0 +1,119 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! AsyncOutput: snapshot-based, background visualization and checkpoint writes.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: ATS developers
+*/
+
+/*!
+
+Writing vis and checkpoint files sits on the critical path of the timestep
+loop.  In asynchronous mode, the Coordinator instead copies the fields that
+are written, those marked for vis or checkpointing, into one of a fixed
+number of staging snapshots and hands the snapshot to a background thread,
+which does the write while the next timestep proceeds.  When all snapshots
+are in flight, the next request blocks until one is free, which bounds the
+memory used.
+
+The writer thread issues collective MPI-IO calls concurrently with the
+solver, so asynchronous mode requires that MPI was initialized with
+``MPI_THREAD_MULTIPLE`` (which ats requests only when this option is on) and
+that HDF5 was built thread-safe.  Otherwise writes fall back to being done
+synchronously.  The writer thread only communicates on its own duplicates of
+the communicators, so that its collectives never interleave with the
+solver's.  Vis files are written in the background too, except those of
+deformable meshes, whose coordinates are read from the live mesh and so are
+written synchronously.
+
+In the `"cycle driver`" list:
+
+* `"asynchronous output`" ``[bool]`` **false** Write vis and checkpoints
+  from a background thread.
+
+* `"asynchronous output queue length`" ``[int]`` **2** Number of state
+  snapshots that may be waiting to be written.
+
+*/
+
+#ifndef ATS_ASYNC_OUTPUT_HH_
+#define ATS_ASYNC_OUTPUT_HH_
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_Ptr.hpp"
+#include "Teuchos_ParameterList.hpp"
+#include "Epetra_MpiComm.h"
+
+namespace Amanzi {
+class State;
+}
+
+namespace ATS {
+
+class AsyncOutput {
+
+ public:
+  typedef std::function<void(const Teuchos::Ptr<Amanzi::State>&)> Writer;
+
+  AsyncOutput(Teuchos::ParameterList& plist);
+  ~AsyncOutput();
+
+  // Snapshot the written fields of S and queue the writers on it.  Blocks
+  // while the queue is full.  The fields are those marked for I/O at the
+  // first call.
+  void Write(const Teuchos::RCP<Amanzi::State>& S,
+             const std::vector<Writer>& writers);
+
+  // Block until all queued writes are done.
+  void Flush();
+
+  // A duplicate of comm, owned by this, for writers to use on the thread.
+  Epetra_MpiComm* Duplicate(const Epetra_MpiComm& comm);
+
+  bool threaded() const { return threaded_; }
+
+ protected:
+  void Run_();
+  void Rethrow_();
+
+  // A state with the meshes of S and its fields marked for I/O, and a copy
+  // of their values, time, and cycle.
+  static Teuchos::RCP<Amanzi::State> CreateSnapshot_(const Amanzi::State& S);
+  static void CopyToSnapshot_(const Amanzi::State& S, Amanzi::State& snapshot);
+
+ protected:
+  struct Job {
+    int slot;
+    std::vector<Writer> writers;
+  };
+
+  bool threaded_;
+  int nsnapshots_;
+  std::vector<Teuchos::RCP<Amanzi::State> > snapshots_;
+  std::vector<int> free_;
+  std::deque<Job> jobs_;
+  int in_flight_;
+  bool done_;
+  std::exception_ptr error_;
+  std::vector<MPI_Comm> comms_;
+  std::vector<Teuchos::RCP<Epetra_MpiComm> > epetra_comms_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::thread worker_;
+};
+
+} // namespace ATS
+
+#endif
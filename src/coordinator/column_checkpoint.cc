@@ -0,0 +1,486 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! ColumnCheckpoint: single-file checkpointing for column-decomposed runs.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: ATS developers
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include "hdf5.h"
+
+#include "errors.hh"
+#include "Key.hh"
+#include "State.hh"
+
+#include "column_checkpoint.hh"
+
+namespace ATS {
+
+namespace {
+
+// A field component (or scalar, when comp is empty) contributing to a dataset.
+struct Source {
+  Amanzi::Key key;
+  Amanzi::Key owner;
+  std::string comp;
+};
+
+// A contiguous range of a Source, identified in the file by id.
+struct Piece {
+  int source;
+  long long id;
+  int start;
+  int length;
+};
+
+struct Dataset {
+  Dataset() : ndofs(-1) {}
+  int ndofs;
+  std::vector<Source> sources;
+  std::vector<Piece> pieces;
+};
+
+typedef std::map<std::string, Dataset> DatasetMap;
+
+
+// Domains created as subgrid members, e.g. "column_12" or
+// "surface_column_12", are split into the set name and the GID.
+bool
+splitSubgridDomain(const Amanzi::Key& domain, std::string& set, long long& gid)
+{
+  std::size_t pos = domain.find_last_of('_');
+  if (pos == std::string::npos || pos == 0 || pos+1 == domain.size()) return false;
+  for (std::size_t i=pos+1; i!=domain.size(); ++i) {
+    if (!std::isdigit(domain[i])) return false;
+  }
+  set = domain.substr(0,pos);
+  gid = std::stoll(domain.substr(pos+1));
+  return true;
+}
+
+
+// Sort the checkpointed fields of S into datasets.  Column fields are
+// aggregated over the domain set, one piece per column; fields on other
+// meshes get one piece per entity.  Global scalars are only written from
+// rank 0, but every rank reads them.
+void
+collectDatasets(const Amanzi::State& S, bool all_scalars, int rank,
+                DatasetMap& dsets)
+{
+  for (Amanzi::State::field_iterator f=S.field_begin(); f!=S.field_end(); ++f) {
+    if (!f->second->io_checkpoint()) continue;
+
+    const Amanzi::Key& key = f->first;
+    std::string set;
+    long long gid(0);
+    bool is_col = splitSubgridDomain(Amanzi::Keys::getDomain(key), set, gid);
+    std::string base = is_col ? Amanzi::Keys::getKey(set+"_*", Amanzi::Keys::getVarName(key)) : key;
+
+    if (f->second->type() == Amanzi::COMPOSITE_VECTOR_FIELD) {
+      Teuchos::RCP<const Amanzi::CompositeVector> cv = S.GetFieldData(key);
+      for (const auto& comp : *cv) {
+        const Epetra_MultiVector& vec = *cv->ViewComponent(comp, false);
+        Dataset& ds = dsets[base+"."+comp];
+        if (ds.ndofs >= 0 && ds.ndofs != vec.NumVectors()) {
+          Errors::Message msg;
+          msg << "ColumnCheckpoint: field \"" << key << "\" component \"" << comp
+              << "\" has a different number of dofs than other members of its domain set.";
+          Exceptions::amanzi_throw(msg);
+        }
+        ds.ndofs = vec.NumVectors();
+        int src = ds.sources.size();
+        ds.sources.push_back(Source{key, f->second->owner(), comp});
+
+        if (is_col) {
+          ds.pieces.push_back(Piece{src, gid, 0, vec.MyLength()});
+        } else {
+          const Epetra_BlockMap& map = vec.Map();
+          ds.pieces.reserve(ds.pieces.size() + vec.MyLength());
+          for (int i=0; i!=vec.MyLength(); ++i) {
+            ds.pieces.push_back(Piece{src, static_cast<long long>(map.GID(i)), i, 1});
+          }
+        }
+      }
+
+    } else if (f->second->type() == Amanzi::CONSTANT_SCALAR) {
+      if (!is_col && !all_scalars && rank != 0) continue;
+      Dataset& ds = dsets[base];
+      ds.ndofs = 1;
+      int src = ds.sources.size();
+      ds.sources.push_back(Source{key, f->second->owner(), ""});
+      ds.pieces.push_back(Piece{src, is_col ? gid : 0, 0, 1});
+    }
+  }
+}
+
+
+// Datasets must be created and opened collectively, but not every rank owns
+// a piece of every dataset.  Form the union of names over all ranks.
+std::map<std::string,int>
+globalDatasets(const DatasetMap& dsets, MPI_Comm comm)
+{
+  std::stringstream local;
+  for (const auto& ds : dsets) local << ds.first << "\n" << ds.second.ndofs << "\n";
+  std::string local_str = local.str();
+
+  int size;
+  MPI_Comm_size(comm, &size);
+  int local_len = local_str.size();
+  std::vector<int> lens(size), displs(size, 0);
+  MPI_Allgather(&local_len, 1, MPI_INT, &lens[0], 1, MPI_INT, comm);
+  for (int p=1; p!=size; ++p) displs[p] = displs[p-1] + lens[p-1];
+
+  std::vector<char> all(displs[size-1] + lens[size-1] + 1, '\0');
+  MPI_Allgatherv(const_cast<char*>(local_str.data()), local_len, MPI_CHAR,
+                 &all[0], &lens[0], &displs[0], MPI_CHAR, comm);
+
+  std::map<std::string,int> names;
+  std::stringstream all_ss(std::string(all.begin(), all.end()-1));
+  std::string name, ndofs;
+  while (std::getline(all_ss, name) && std::getline(all_ss, ndofs)) {
+    names[name] = std::stoi(ndofs);
+  }
+  return names;
+}
+
+
+void
+checkH5(herr_t ierr, const std::string& what, const std::string& filename)
+{
+  if (ierr < 0) {
+    Errors::Message msg;
+    msg << "ColumnCheckpoint: HDF5 error in " << what << " on file \"" << filename << "\".";
+    Exceptions::amanzi_throw(msg);
+  }
+}
+
+
+// Collectively create a dataset and write this rank's hyperslab of it.
+void
+writeDataset(hid_t file, hid_t dxpl, const std::string& name, hid_t type, int ndims,
+             const hsize_t* dims, const hsize_t* start, const hsize_t* count,
+             const void* data, const std::string& filename)
+{
+  hid_t fspace = H5Screate_simple(ndims, dims, NULL);
+  hid_t mspace = H5Screate_simple(ndims, count, NULL);
+  hid_t dset = H5Dcreate2(file, name.c_str(), type, fspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  checkH5(dset, "creating dataset "+name, filename);
+
+  if (count[0] > 0) {
+    H5Sselect_hyperslab(fspace, H5S_SELECT_SET, start, NULL, count, NULL);
+  } else {
+    H5Sselect_none(fspace);
+    H5Sselect_none(mspace);
+  }
+  checkH5(H5Dwrite(dset, type, mspace, fspace, dxpl, data), "writing dataset "+name, filename);
+
+  H5Dclose(dset);
+  H5Sclose(mspace);
+  H5Sclose(fspace);
+}
+
+
+template<typename T>
+void
+writeAttribute(hid_t file, const std::string& name, hid_t type, T value,
+               const std::string& filename)
+{
+  hid_t space = H5Screate(H5S_SCALAR);
+  hid_t attr = H5Acreate2(file, name.c_str(), type, space, H5P_DEFAULT, H5P_DEFAULT);
+  checkH5(attr, "creating attribute "+name, filename);
+  checkH5(H5Awrite(attr, type, &value), "writing attribute "+name, filename);
+  H5Aclose(attr);
+  H5Sclose(space);
+}
+
+
+template<typename T>
+T
+readAttribute(hid_t file, const std::string& name, hid_t type, const std::string& filename)
+{
+  T value;
+  hid_t attr = H5Aopen(file, name.c_str(), H5P_DEFAULT);
+  checkH5(attr, "opening attribute "+name, filename);
+  checkH5(H5Aread(attr, type, &value), "reading attribute "+name, filename);
+  H5Aclose(attr);
+  return value;
+}
+
+
+hid_t
+openFile(MPI_Comm comm, const std::string& filename, bool create)
+{
+  hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+  H5Pset_fapl_mpio(fapl, comm, MPI_INFO_NULL);
+  hid_t file = create ?
+      H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fapl) :
+      H5Fopen(filename.c_str(), H5F_ACC_RDONLY, fapl);
+  H5Pclose(fapl);
+  checkH5(file, create ? "creating file" : "opening file", filename);
+  return file;
+}
+
+} // namespace
+
+
+ColumnCheckpoint::ColumnCheckpoint(Teuchos::ParameterList& plist, Epetra_MpiComm* comm) :
+    Amanzi::IOEvent(plist),
+    comm_(comm)
+{
+  filebasename_ = plist.get<std::string>("file name base", "checkpoint");
+  filenamedigits_ = plist.get<int>("file name digits", 5);
+}
+
+
+std::string
+ColumnCheckpoint::Filename_(int cycle) const
+{
+  std::stringstream oss;
+  oss << filebasename_ << std::setfill('0') << std::setw(filenamedigits_) << cycle << ".h5";
+  return oss.str();
+}
+
+
+void
+ColumnCheckpoint::Write(const Amanzi::State& S, double dt)
+{
+  MPI_Comm comm = comm_->Comm();
+  int rank = comm_->MyPID();
+
+  DatasetMap dsets;
+  collectDatasets(S, false, rank, dsets);
+  std::map<std::string,int> names = globalDatasets(dsets, comm);
+
+  std::string filename = Filename_(S.cycle());
+  hid_t file = openFile(comm, filename, true);
+  writeAttribute(file, "time", H5T_NATIVE_DOUBLE, S.time(), filename);
+  writeAttribute(file, "dt", H5T_NATIVE_DOUBLE, dt, filename);
+  writeAttribute(file, "cycle", H5T_NATIVE_INT, S.cycle(), filename);
+
+  hid_t dxpl = H5Pcreate(H5P_DATASET_XFER);
+  H5Pset_dxpl_mpio(dxpl, H5FD_MPIO_COLLECTIVE);
+
+  Dataset empty;
+  for (const auto& name : names) {
+    auto ds_it = dsets.find(name.first);
+    const Dataset& ds = ds_it == dsets.end() ? empty : ds_it->second;
+
+    // offsets of this rank's rows and entries
+    long long local[2] = { static_cast<long long>(ds.pieces.size()), 0 };
+    for (const auto& p : ds.pieces) local[1] += p.length;
+    long long offset[2] = { 0, 0 };
+    long long total[2] = { 0, 0 };
+    MPI_Exscan(local, offset, 2, MPI_LONG_LONG, MPI_SUM, comm);
+    if (rank == 0) offset[0] = offset[1] = 0;
+    MPI_Allreduce(local, total, 2, MPI_LONG_LONG, MPI_SUM, comm);
+
+    // the column index table: (id, offset, length)
+    std::vector<long long> index(3*ds.pieces.size() + 1);
+    long long entry = offset[1];
+    for (int i=0; i!=ds.pieces.size(); ++i) {
+      index[3*i] = ds.pieces[i].id;
+      index[3*i+1] = entry;
+      index[3*i+2] = ds.pieces[i].length;
+      entry += ds.pieces[i].length;
+    }
+    hsize_t idims[2] = { static_cast<hsize_t>(total[0]), 3 };
+    hsize_t istart[2] = { static_cast<hsize_t>(offset[0]), 0 };
+    hsize_t icount[2] = { static_cast<hsize_t>(local[0]), 3 };
+    writeDataset(file, dxpl, name.first+".index", H5T_NATIVE_LLONG, 2,
+                 idims, istart, icount, &index[0], filename);
+
+    // resolve the vectors once, not per piece
+    std::vector<const Epetra_MultiVector*> vecs(ds.sources.size(), NULL);
+    std::vector<double> scalars(ds.sources.size(), 0.);
+    for (int s=0; s!=ds.sources.size(); ++s) {
+      if (ds.sources[s].comp.empty()) {
+        scalars[s] = *S.GetScalarData(ds.sources[s].key);
+      } else {
+        vecs[s] = S.GetFieldData(ds.sources[s].key)->ViewComponent(ds.sources[s].comp, false).get();
+      }
+    }
+
+    // one dataset per dof
+    std::vector<double> buf(local[1] + 1);
+    hsize_t dims[1] = { static_cast<hsize_t>(total[1]) };
+    hsize_t start[1] = { static_cast<hsize_t>(offset[1]) };
+    hsize_t count[1] = { static_cast<hsize_t>(local[1]) };
+    for (int dof=0; dof!=name.second; ++dof) {
+      int lcv = 0;
+      for (const auto& p : ds.pieces) {
+        if (vecs[p.source]) {
+          const double* vals = (*vecs[p.source])[dof] + p.start;
+          std::copy(vals, vals + p.length, &buf[lcv]);
+        } else {
+          buf[lcv] = scalars[p.source];
+        }
+        lcv += p.length;
+      }
+
+      std::stringstream dname;
+      dname << name.first << "." << dof;
+      writeDataset(file, dxpl, dname.str(), H5T_NATIVE_DOUBLE, 1,
+                   dims, start, count, &buf[0], filename);
+    }
+  }
+
+  H5Pclose(dxpl);
+  H5Fclose(file);
+}
+
+
+double
+ColumnCheckpoint::ReadInitialTime(const std::string& filename) const
+{
+  hid_t file = openFile(comm_->Comm(), filename, false);
+  double time = readAttribute<double>(file, "time", H5T_NATIVE_DOUBLE, filename);
+  H5Fclose(file);
+  return time;
+}
+
+
+void
+ColumnCheckpoint::Read(Amanzi::State& S, const std::string& filename) const
+{
+  MPI_Comm comm = comm_->Comm();
+  int rank = comm_->MyPID();
+
+  DatasetMap dsets;
+  collectDatasets(S, true, rank, dsets);
+  std::map<std::string,int> names = globalDatasets(dsets, comm);
+
+  hid_t file = openFile(comm, filename, false);
+  S.set_time(readAttribute<double>(file, "time", H5T_NATIVE_DOUBLE, filename));
+  S.set_cycle(readAttribute<int>(file, "cycle", H5T_NATIVE_INT, filename));
+
+  hid_t dxpl = H5Pcreate(H5P_DATASET_XFER);
+  H5Pset_dxpl_mpio(dxpl, H5FD_MPIO_COLLECTIVE);
+
+  Dataset empty;
+  for (const auto& name : names) {
+    auto ds_it = dsets.find(name.first);
+    const Dataset& ds = ds_it == dsets.end() ? empty : ds_it->second;
+
+    // read the full index table on every rank
+    hid_t didx = H5Dopen2(file, (name.first+".index").c_str(), H5P_DEFAULT);
+    checkH5(didx, "opening dataset "+name.first+".index", filename);
+    hid_t ispace = H5Dget_space(didx);
+    hsize_t idims[2];
+    H5Sget_simple_extent_dims(ispace, idims, NULL);
+    std::vector<long long> index(3*idims[0] + 1);
+    checkH5(H5Dread(didx, H5T_NATIVE_LLONG, ispace, ispace, dxpl, &index[0]),
+            "reading dataset "+name.first+".index", filename);
+    H5Sclose(ispace);
+    H5Dclose(didx);
+
+    // locate each local piece in the file
+    std::unordered_map<long long, int> needed;
+    for (int i=0; i!=ds.pieces.size(); ++i) needed[ds.pieces[i].id] = i;
+    std::vector<long long> file_offset(ds.pieces.size(), -1);
+    for (hsize_t r=0; r!=idims[0]; ++r) {
+      auto n = needed.find(index[3*r]);
+      if (n == needed.end()) continue;
+      if (index[3*r+2] != ds.pieces[n->second].length) {
+        Errors::Message msg;
+        msg << "ColumnCheckpoint: entry " << index[3*r] << " of \"" << name.first
+            << "\" in \"" << filename << "\" has a different size than the current mesh.";
+        Exceptions::amanzi_throw(msg);
+      }
+      file_offset[n->second] = index[3*r+1];
+    }
+    for (int i=0; i!=ds.pieces.size(); ++i) {
+      if (file_offset[i] < 0) {
+        Errors::Message msg;
+        msg << "ColumnCheckpoint: entry " << ds.pieces[i].id << " of \"" << name.first
+            << "\" not found in \"" << filename << "\".";
+        Exceptions::amanzi_throw(msg);
+      }
+    }
+
+    // HDF5 reads a selection in file order, so visit pieces in that order and
+    // merge adjacent ranges into as few hyperslabs as possible.
+    std::vector<int> order(ds.pieces.size());
+    for (int i=0; i!=order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(),
+              [&file_offset](int a, int b) { return file_offset[a] < file_offset[b]; });
+    std::vector<std::pair<hsize_t,hsize_t> > ranges;
+    hsize_t nlocal = 0;
+    for (int i : order) {
+      hsize_t off = file_offset[i];
+      hsize_t len = ds.pieces[i].length;
+      if (!ranges.empty() && ranges.back().first + ranges.back().second == off) {
+        ranges.back().second += len;
+      } else {
+        ranges.push_back(std::make_pair(off, len));
+      }
+      nlocal += len;
+    }
+
+    std::vector<Epetra_MultiVector*> vecs(ds.sources.size(), NULL);
+    for (int s=0; s!=ds.sources.size(); ++s) {
+      if (!ds.sources[s].comp.empty()) {
+        vecs[s] = S.GetFieldData(ds.sources[s].key, ds.sources[s].owner)
+            ->ViewComponent(ds.sources[s].comp, false).get();
+      }
+    }
+
+    std::vector<double> buf(nlocal + 1);
+    hsize_t mcount[1] = { nlocal };
+    for (int dof=0; dof!=name.second; ++dof) {
+      std::stringstream dname;
+      dname << name.first << "." << dof;
+      hid_t dset = H5Dopen2(file, dname.str().c_str(), H5P_DEFAULT);
+      checkH5(dset, "opening dataset "+dname.str(), filename);
+      hid_t fspace = H5Dget_space(dset);
+      hid_t mspace = H5Screate_simple(1, mcount, NULL);
+      if (ranges.empty()) {
+        H5Sselect_none(fspace);
+        H5Sselect_none(mspace);
+      } else {
+        for (int r=0; r!=ranges.size(); ++r) {
+          hsize_t start[1] = { ranges[r].first };
+          hsize_t count[1] = { ranges[r].second };
+          H5Sselect_hyperslab(fspace, r == 0 ? H5S_SELECT_SET : H5S_SELECT_OR,
+                              start, NULL, count, NULL);
+        }
+      }
+      checkH5(H5Dread(dset, H5T_NATIVE_DOUBLE, mspace, fspace, dxpl, &buf[0]),
+              "reading dataset "+dname.str(), filename);
+      H5Sclose(mspace);
+      H5Sclose(fspace);
+      H5Dclose(dset);
+
+      int lcv = 0;
+      for (int i : order) {
+        const Piece& p = ds.pieces[i];
+        if (vecs[p.source]) {
+          std::copy(&buf[lcv], &buf[lcv] + p.length, (*vecs[p.source])[dof] + p.start);
+        } else {
+          *S.GetScalarData(ds.sources[p.source].key, ds.sources[p.source].owner) = buf[lcv];
+        }
+        lcv += p.length;
+      }
+    }
+
+    for (const auto& s : ds.sources) {
+      if (!s.comp.empty()) S.GetFieldData(s.key, s.owner)->ScatterMasterToGhosted(s.comp);
+      S.GetField(s.key, s.owner)->set_initialized();
+    }
+  }
+
+  H5Pclose(dxpl);
+  H5Fclose(file);
+}
+
+} // namespace ATS
@@ -0,0 +1,82 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! ColumnCheckpoint: single-file checkpointing for column-decomposed runs.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: ATS developers
+*/
+
+/*!
+
+When the mesh is split into columns (a `"column`" sublist in `"mesh`"), each
+column lives on its own serial mesh.  By default each rank then writes its own
+checkpoint file, which at scale means thousands of small files per dump.  The
+aggregated column checkpoint instead writes all fields, from all columns on all
+ranks, into one collective HDF5 file.
+
+Each field component is stored as one contiguous dataset per dof, named
+`"DOMAIN_SET-VARNAME.COMPONENT.DOF`" (e.g. `"column_*-temperature.cell.0`"),
+alongside an index table `"DOMAIN_SET-VARNAME.COMPONENT.index`" whose rows are
+(column GID, offset, length).  Fields on non-column meshes are indexed by
+entity GID.  Because restart looks up blocks by GID rather than by rank,
+a checkpoint may be read back on any number of ranks.
+
+This is enabled in the `"checkpoints`" list:
+
+* `"aggregate column files`" ``[bool]`` **false** Write one file per
+  checkpoint instead of one file per rank.
+
+Restart from such a file through the `"restart from checkpoint columns`"
+sublist of the `"cycle driver`":
+
+* `"aggregated checkpoint file`" ``[string]`` Path to the aggregated file.
+
+*/
+
+#ifndef ATS_COLUMN_CHECKPOINT_HH_
+#define ATS_COLUMN_CHECKPOINT_HH_
+
+#include <string>
+
+#include "Teuchos_ParameterList.hpp"
+#include "Epetra_MpiComm.h"
+
+#include "IOEvent.hh"
+
+namespace Amanzi {
+class State;
+}
+
+namespace ATS {
+
+class ColumnCheckpoint : public Amanzi::IOEvent {
+
+ public:
+  ColumnCheckpoint(Teuchos::ParameterList& plist, Epetra_MpiComm* comm);
+
+  // write all checkpointed fields of S into a single file
+  void Write(const Amanzi::State& S, double dt);
+
+  // read all checkpointed fields of S from a single file
+  void Read(Amanzi::State& S, const std::string& filename) const;
+
+  // read only the time, for setting up restart
+  double ReadInitialTime(const std::string& filename) const;
+
+  void set_filebasename(const std::string& base) { filebasename_ = base; }
+
+ protected:
+  std::string Filename_(int cycle) const;
+
+ protected:
+  std::string filebasename_;
+  int filenamedigits_;
+  Epetra_MpiComm* comm_;
+};
+
+} // namespace ATS
+
+#endif
@@ -30,20 +30,59 @@ including Vis and restart/checkpoint dumps.  It contains one and only one PK
 #include "TreeVector.hh"
 #include "PK_Factory.hh"
 //#include "pk_factory_ats.hh"
+#include "pk_bdf_default.hh"
+#include "weak_mpc.hh"
 
+#include "deform_helpers.hh"
+
+#include "async_output.hh"
+#include "column_checkpoint.hh"
+#include "evaluator_profiler.hh"
+#include "single_precision_vis.hh"
 #include "coordinator.hh"
 
 #define DEBUG_MODE 1
 
 namespace ATS {
 
+namespace {
+
+// Create the files of vis.  The HDF5 writer keeps the communicator its mesh
+// has when the files are created, so to write through comm, if given, the
+// mesh is lent comm for the duration.
+void
+createVisFiles(Amanzi::Visualization& vis,
+               const Teuchos::RCP<const Amanzi::AmanziMesh::Mesh>& mesh,
+               const Epetra_MpiComm* comm)
+{
+  if (comm == NULL) {
+    vis.CreateFiles();
+    return;
+  }
+
+  Teuchos::RCP<Amanzi::AmanziMesh::Mesh> mesh_nc =
+      Teuchos::rcp_const_cast<Amanzi::AmanziMesh::Mesh>(mesh);
+  const Epetra_MpiComm* mesh_comm = mesh->get_comm();
+  mesh_nc->set_comm(comm);
+  try {
+    vis.CreateFiles();
+  } catch (...) {
+    mesh_nc->set_comm(mesh_comm);
+    throw;
+  }
+  mesh_nc->set_comm(mesh_comm);
+}
+
+} // namespace
+
 Coordinator::Coordinator(Teuchos::ParameterList& parameter_list,
                          Teuchos::RCP<Amanzi::State>& S,
                          Epetra_MpiComm* comm ) :
     parameter_list_(Teuchos::rcp(new Teuchos::ParameterList(parameter_list))),
     S_(S),
     comm_(comm),
-    restart_(false) {
+    restart_(false),
+    restart_aggregated_(false) {
 
   // create and start the global timer
   timer_ = Teuchos::rcp(new Teuchos::Time("wallclock_monitor",true));
@@ -78,22 +117,39 @@ void Coordinator::coordinator_init() {
   int rank = comm_->MyPID();
   int size = comm_->NumProc();
   std::stringstream check;
-  
-  if(parameter_list_->sublist("mesh").isSublist("column"))  
+
+  // column runs write one checkpoint per rank unless aggregated into a
+  // single file
+  bool columns = parameter_list_->sublist("mesh").isSublist("column");
+  bool aggregate = parameter_list_->isSublist("checkpoint") &&
+      parameter_list_->sublist("checkpoint").get<bool>("aggregate column files", false);
+
+  if(columns && !aggregate)
     check << "checkpoint " << rank;
   else
     check << "checkpoint";
   
   // create the checkpointing
 
-  Teuchos::ParameterList& chkp_plist = parameter_list_->sublist(check.str());
-  if (parameter_list_->sublist("mesh").isSublist("column") && size >1){
+  checkpoint_list_ = Teuchos::sublist(parameter_list_, check.str());
+  Teuchos::ParameterList& chkp_plist = *checkpoint_list_;
+  if (columns && aggregate) {
+    // the Checkpoint still controls when dumps happen, but writes go through
+    // the aggregated file
+    checkpoint_comm_ = comm_;
+    column_checkpoint_ = Teuchos::rcp(new ColumnCheckpoint(chkp_plist, comm_));
+    checkpoint_ = Teuchos::rcp(new Amanzi::Checkpoint(chkp_plist, comm_));
+  }
+  else if (columns && size >1){
     MPI_Comm mpi_comm_self(MPI_COMM_SELF);
     Epetra_MpiComm *comm_self = new Epetra_MpiComm(mpi_comm_self);
+    checkpoint_comm_ = comm_self;
     checkpoint_ = Teuchos::rcp(new Amanzi::Checkpoint(chkp_plist, comm_self));
   }
-  else
+  else {
+    checkpoint_comm_ = comm_;
     checkpoint_ = Teuchos::rcp(new Amanzi::Checkpoint(chkp_plist, comm_));
+  }
   
 
   // create the observations
@@ -135,6 +191,17 @@ void Coordinator::setup() {
   S_->RequireScalar("dt", "coordinator");
 
   pk_->Setup(S_.ptr());  
+
+  // The time integrator's checkpointed history takes the structure of the
+  // solution, which is known only now.  Under a weak MPC, each sub-PK has its
+  // own time integrator.
+  Teuchos::RCP<Amanzi::PK_BDF_Default> pk_bdf =
+      Teuchos::rcp_dynamic_cast<Amanzi::PK_BDF_Default>(pk_);
+  if (pk_bdf != Teuchos::null) pk_bdf->SetupIntegratorHistory(S_.ptr());
+  Teuchos::RCP<Amanzi::WeakMPC> pk_weak =
+      Teuchos::rcp_dynamic_cast<Amanzi::WeakMPC>(pk_);
+  if (pk_weak != Teuchos::null) pk_weak->SetupIntegratorHistory(S_.ptr());
+
   S_->Setup();
 }
 
@@ -147,16 +214,27 @@ void Coordinator::initialize() {
   // Note that if this is so, we can probably ignore some of the above
   // initialize() calls and the commit_state() call, but I'm afraid to try
   // that and break all the PKs.
-  // Currently not a true restart -- for a true restart this should also get:
-  // -- timestep size dt
-  // -- BDF history to allow projection to continue correctly.
+  // This is a true restart only if the top-level PK checkpoints its time
+  // integrator history, in which case the timestep size and the time
+  // derivative of the solution are read here with the rest of State, and
+  // restored to the time integrator in pk_->Initialize().
 
   int size = comm_->NumProc();
 
 
-  //---
+  // the reader of aggregated column checkpoints, only when restarting from one
+  Teuchos::RCP<ColumnCheckpoint> column_reader;
+  if (restart_ && restart_aggregated_) {
+    Teuchos::ParameterList reader_plist;
+    column_reader = Teuchos::rcp(new ColumnCheckpoint(reader_plist, comm_));
+  }
+
   if (restart_) {
-    if (parameter_list_->sublist("mesh").isSublist("column") && size >1){
+    if (restart_aggregated_) {
+      t0_ = column_reader->ReadInitialTime(restart_filename_);
+      S_->set_time(t0_);
+    }
+    else if (parameter_list_->sublist("mesh").isSublist("column") && size >1){
       MPI_Comm mpi_comm_self(MPI_COMM_SELF);
       Epetra_MpiComm *comm_self = new Epetra_MpiComm(mpi_comm_self);
       t0_ = Amanzi::ReadCheckpointInitialTime(comm_self, restart_filename_);
@@ -170,7 +248,12 @@ void Coordinator::initialize() {
 
   // Restart from checkpoint, part 2.
   if (restart_) {
-    if (parameter_list_->sublist("mesh").isSublist("column") && size >1){
+    if (restart_aggregated_) {
+      column_reader->Read(*S_, restart_filename_);
+      t0_ = S_->time();
+      cycle0_ = S_->cycle();
+    }
+    else if (parameter_list_->sublist("mesh").isSublist("column") && size >1){
       MPI_Comm mpi_comm_self(MPI_COMM_SELF);
       Epetra_MpiComm *comm_self = new Epetra_MpiComm(mpi_comm_self);
       ReadCheckpoint(comm_self, S_.ptr(), restart_filename_);
@@ -227,6 +310,26 @@ void Coordinator::initialize() {
   // commit the initial conditions.
   pk_->CommitStep(0., 0., S_);
 
+  // writing vis and checkpoints in the background, set up before the vis
+  // files are created so that they get communicators of their own
+  bool threaded_output = false;
+  if (coordinator_list_->get<bool>("asynchronous output", false)) {
+    output_ = Teuchos::rcp(new AsyncOutput(*coordinator_list_));
+    threaded_output = output_->threaded();
+    if (threaded_output) {
+      Epetra_MpiComm* chkp_comm = output_->Duplicate(*checkpoint_comm_);
+      checkpoint_ = Teuchos::rcp(new Amanzi::Checkpoint(*checkpoint_list_, chkp_comm));
+      if (column_checkpoint_ != Teuchos::null)
+        column_checkpoint_ = Teuchos::rcp(new ColumnCheckpoint(*checkpoint_list_, chkp_comm));
+
+    } else if (vo_->os_OK(Teuchos::VERB_LOW)) {
+      Teuchos::OSTab tab = vo_->getOSTab();
+      *vo_->os() << "WARNING: asynchronous output requested, but MPI does not provide "
+                 << "MPI_THREAD_MULTIPLE or HDF5 is not thread-safe.  Writing output "
+                 << "synchronously." << std::endl;
+    }
+  }
+
   // visualization
   auto vis_list = Teuchos::sublist(parameter_list_,"visualization");
   for (auto& entry : *vis_list) {
@@ -234,19 +337,30 @@ void Coordinator::initialize() {
 
     if (S_->HasMesh(domain_name)) {
       // visualize standard domain
-      auto mesh_p = S_->GetMesh(domain_name);
+      std::string mesh_name = domain_name;
       if (vis_list->get<bool>("visualize on 3D mesh", false) && S_->HasMesh(domain_name+"_3d"))
-        mesh_p = S_->GetMesh(domain_name+"_3d");
+        mesh_name = domain_name+"_3d";
+      auto mesh_p = S_->GetMesh(mesh_name);
       
       auto sublist_p = Teuchos::sublist(vis_list, domain_name);
 
-      // vis successful timesteps
+      // vis successful timesteps, from the output thread unless the mesh
+      // moves
+      bool async = threaded_output && !S_->IsDeformableMesh(mesh_name);
       auto vis = Teuchos::rcp(new Amanzi::Visualization(*sublist_p));
       vis->set_name(domain_name);
       vis->set_mesh(mesh_p);
-      vis->CreateFiles();
+      createVisFiles(*vis, mesh_p, async ? output_->Duplicate(*mesh_p->get_comm()) : NULL);
     
       visualization_.push_back(vis);
+      visualization_async_.push_back(async);
+
+      // diagnostics written in single precision instead
+      if (sublist_p->isParameter("single precision fields")) {
+        single_visualization_.push_back(Teuchos::rcp(
+            new SinglePrecisionVis(*sublist_p, domain_name, S_.ptr(),
+                                   threaded_output ? output_->Duplicate(*comm_) : comm_)));
+      }
 
     } else if (boost::ends_with(domain_name, "_*")) {
       // visualize domain set
@@ -255,12 +369,16 @@ void Coordinator::initialize() {
         if (boost::starts_with(m->first, domain_set_name)) {
           // visualize each subdomain
           Teuchos::ParameterList sublist = vis_list->sublist(domain_name);
-          sublist.set<std::string>("file name base", std::string("visdump_")+m->first);
+          sublist.set<std::string>("file name base",
+                  sublist.get<std::string>("file name base", "visdump")+"_"+m->first);
+          bool async = threaded_output && !S_->IsDeformableMesh(m->first);
           auto vis = Teuchos::rcp(new Amanzi::Visualization(sublist));
           vis->set_name(m->first);
           vis->set_mesh(m->second.first);    
-          vis->CreateFiles();
+          createVisFiles(*vis, m->second.first,
+                         async ? output_->Duplicate(*m->second.first->get_comm()) : NULL);
           visualization_.push_back(vis);
+          visualization_async_.push_back(async);
         }
       }
 
@@ -279,6 +397,7 @@ void Coordinator::initialize() {
        vis!=visualization_.end(); ++vis) {
     (*vis)->RegisterWithTimeStepManager(tsm_.ptr());
   }
+  for (auto& vis : single_visualization_) vis->RegisterWithTimeStepManager(tsm_.ptr());
 
   // -- register checkpoint times
   checkpoint_->RegisterWithTimeStepManager(tsm_.ptr());
@@ -306,16 +425,27 @@ void Coordinator::initialize() {
   // set the states in the PKs
   //Teuchos::RCP<const State> cS = S_; // ensure PKs get const reference state
   pk_->set_states(S_, S_inter_, S_next_); // note this does not allow subcycling
+
+  // instrument the evaluators of all states, now that all exist
+  if (coordinator_list_->get<bool>("profile evaluators", false)) {
+    profiler_ = Teuchos::rcp(new EvaluatorProfiler(*coordinator_list_));
+    profiler_->Install(S_.ptr());
+    profiler_->Install(S_inter_.ptr());
+    profiler_->Install(S_next_.ptr());
+  }
 }
 
 void Coordinator::finalize() {
+  // Any pending output must land before the final checkpoint.
+  if (output_ != Teuchos::null) output_->Flush();
+
   // Force checkpoint at the end of simulation.
   // Only do if the checkpoint was not already written, or we would be writing
   // the same file twice.
   // This really should be removed, but for now is left to help stupid developers.
   if (!checkpoint_->DumpRequested(S_next_->cycle(), S_next_->time())) {
     pk_->CalculateDiagnostics(S_next_);
-    WriteCheckpoint(checkpoint_.ptr(), S_next_.ptr(), 0.0);
+    write_checkpoint(S_next_.ptr(), 0.0);
   }
 
   // flush observations to make sure they are saved
@@ -455,9 +585,15 @@ void Coordinator::read_parameter_list() {
   if (coordinator_list_->isSublist("restart from checkpoint columns")){
     restart_ = true;
     Teuchos::ParameterList list = coordinator_list_->sublist("restart from checkpoint columns");
-    std::stringstream name;
-    name << list.get<std::string>("checkpoint file") << "checkpoint_" << rank << "_" << list.get<std::string>("cycles") << ".h5";
-    restart_filename_  = name.str();
+    if (list.isParameter("aggregated checkpoint file")) {
+      // a single file, readable on any number of ranks
+      restart_aggregated_ = true;
+      restart_filename_ = list.get<std::string>("aggregated checkpoint file");
+    } else {
+      std::stringstream name;
+      name << list.get<std::string>("checkpoint file") << "checkpoint_" << rank << "_" << list.get<std::string>("cycles") << ".h5";
+      restart_filename_  = name.str();
+    }
   }
 }
 
@@ -525,67 +661,32 @@ bool Coordinator::advance(double t_old, double t_new) {
     // The timestep sizes have been updated, so copy back old soln and try again.
     *S_next_ = *S_;
 
-    // check whether meshes are deformable, and if so, recover the old coordinates
+    // check whether meshes are deformable, and if so, recover the old
+    // coordinates.  Only nodes that actually moved are restored.  Note the
+    // Mesh caches its geometry privately, so the volumes, areas and normals
+    // of the affected cells are recomputed rather than restored.
     for (Amanzi::State::mesh_iterator mesh=S_->mesh_begin();
          mesh!=S_->mesh_end(); ++mesh) {
-      bool surf = boost::starts_with(mesh->first, "surface_");
-
       if (S_->IsDeformableMesh(mesh->first)){
+        std::string node_key;
         if (mesh->first.find("column") != std::string::npos) {
-        // collect the old coordinates
-          
-          std::string node_key = mesh->first+std::string("-vertex_coordinate");
-          
-          Teuchos::RCP<const Amanzi::CompositeVector> vc_vec = S_->GetFieldData(node_key);
-          vc_vec->ScatterMasterToGhosted();
-          const Epetra_MultiVector& vc = *vc_vec->ViewComponent("node", true);
-          std::vector<int> node_ids(vc.MyLength());
-          Amanzi::AmanziGeometry::Point_List old_positions(vc.MyLength());
-          for (int n=0;n!=vc.MyLength();++n) {
-            node_ids[n] = n;
-            if (mesh->second.first->space_dimension() == 2) {
-              old_positions[n] = Amanzi::AmanziGeometry::Point(vc[0][n], vc[1][n]);
-            } else {
-              old_positions[n] = Amanzi::AmanziGeometry::Point(vc[0][n], vc[1][n], vc[2][n]);
-            }
-          }
-          
-          // undeform the mesh
-          Amanzi::AmanziGeometry::Point_List final_positions;
-          mesh->second.first->deform(node_ids, old_positions, false, &final_positions);
-        }
-        
-        else if (!parameter_list_->sublist("mesh").isSublist("column")) {
-          // collect the old coordinates
-          
-          std::string node_key;
+          node_key = mesh->first+std::string("-vertex_coordinate");
+        } else if (!parameter_list_->sublist("mesh").isSublist("column")) {
           if (mesh->first != "domain")
             node_key= mesh->first+std::string("-vertex_coordinate");
           else
             node_key = std::string("vertex_coordinate");
-
-          Teuchos::RCP<const Amanzi::CompositeVector> vc_vec = S_->GetFieldData(node_key);
-          vc_vec->ScatterMasterToGhosted();
-          const Epetra_MultiVector& vc = *vc_vec->ViewComponent("node", true);
-          std::vector<int> node_ids(vc.MyLength());
-          Amanzi::AmanziGeometry::Point_List old_positions(vc.MyLength());
-          for (int n=0;n!=vc.MyLength();++n) {
-            node_ids[n] = n;
-            if (mesh->second.first->space_dimension() == 2) {
-              old_positions[n] = Amanzi::AmanziGeometry::Point(vc[0][n], vc[1][n]);
-            } else {
-              old_positions[n] = Amanzi::AmanziGeometry::Point(vc[0][n], vc[1][n], vc[2][n]);
-            }
-          }
-          
-          // undeform the mesh
-          Amanzi::AmanziGeometry::Point_List final_positions;
-          mesh->second.first->deform(node_ids, old_positions, false, &final_positions);
+        } else {
+          continue;
         }
-        
-      }
-      
 
+        Teuchos::RCP<const Amanzi::CompositeVector> vc_vec = S_->GetFieldData(node_key);
+        vc_vec->ScatterMasterToGhosted();
+        const Epetra_MultiVector& vc = *vc_vec->ViewComponent("node", true);
+
+        // undeform the mesh
+        Amanzi::Deform::RestoreNodeCoordinates(*mesh->second.first, vc);
+      }
     }
   }
   return fail;
@@ -607,17 +708,53 @@ void Coordinator::visualize(bool force) {
     pk_->CalculateDiagnostics(S_next_);
   }
 
-  for (std::vector<Teuchos::RCP<Amanzi::Visualization> >::iterator vis=visualization_.begin();
-       vis!=visualization_.end(); ++vis) {
-    if (force || (*vis)->DumpRequested(S_next_->cycle(), S_next_->time())) {
-      WriteVis((*vis).ptr(), S_next_.ptr());
+  // Vis of meshes that do not move, and single precision vis, are written
+  // from the snapshot by the output thread, on communicators of their own.
+  std::vector<AsyncOutput::Writer> writers;
+  for (int i=0; i!=visualization_.size(); ++i) {
+    Teuchos::RCP<Amanzi::Visualization> vis = visualization_[i];
+    if (force || vis->DumpRequested(S_next_->cycle(), S_next_->time())) {
+      if (visualization_async_[i]) {
+        writers.push_back([vis](const Teuchos::Ptr<Amanzi::State>& S) {
+            WriteVis(vis.ptr(), S); });
+      } else {
+        WriteVis(vis.ptr(), S_next_.ptr());
+      }
+    }
+  }
+
+  for (auto& vis : single_visualization_) {
+    if (force || vis->DumpRequested(S_next_->cycle(), S_next_->time())) {
+      if (output_ != Teuchos::null) {
+        Teuchos::RCP<SinglePrecisionVis> vis_p = vis;
+        writers.push_back([vis_p](const Teuchos::Ptr<Amanzi::State>& S) {
+            vis_p->Write(*S); });
+      } else {
+        vis->Write(*S_next_);
+      }
     }
   }
+  if (output_ != Teuchos::null) output_->Write(S_next_, writers);
 }
 
 void Coordinator::checkpoint(double dt, bool force) {
   if (force || checkpoint_->DumpRequested(S_next_->cycle(), S_next_->time())) {
-    WriteCheckpoint(checkpoint_.ptr(), S_next_.ptr(), dt);
+    if (output_ != Teuchos::null) {
+      std::vector<AsyncOutput::Writer> writers;
+      writers.push_back([this,dt](const Teuchos::Ptr<Amanzi::State>& S) {
+          write_checkpoint(S, dt); });
+      output_->Write(S_next_, writers);
+    } else {
+      write_checkpoint(S_next_.ptr(), dt);
+    }
+  }
+}
+
+void Coordinator::write_checkpoint(const Teuchos::Ptr<Amanzi::State>& S, double dt) {
+  if (column_checkpoint_ != Teuchos::null) {
+    column_checkpoint_->Write(*S, dt);
+  } else {
+    WriteCheckpoint(checkpoint_.ptr(), S, dt);
   }
 }
 
@@ -639,7 +776,8 @@ void Coordinator::cycle_driver() {
 
   //  exit(0);
 
-  // get the intial timestep -- note, this would have to be fixed for a true restart
+  // get the intial timestep -- on restart, this is the checkpointed one if the
+  // time integrator history was checkpointed
   double dt = get_dt(false);
 
   // visualization at IC
@@ -696,12 +834,18 @@ void Coordinator::cycle_driver() {
     // flush observations to make sure they are saved
     observations_->Flush();
 
+    // pending output must land before the checkpoints, which are written
+    // from this thread
+    if (output_ != Teuchos::null) output_->Flush();
+
     // catch errors to dump two checkpoints -- one as a "last good" checkpoint
     // and one as a "debugging data" checkpoint.
     checkpoint_->set_filebasename("last_good_checkpoint");
-    WriteCheckpoint(checkpoint_.ptr(), S_.ptr(), dt);
+    if (column_checkpoint_ != Teuchos::null) column_checkpoint_->set_filebasename("last_good_checkpoint");
+    write_checkpoint(S_.ptr(), dt);
     checkpoint_->set_filebasename("error_checkpoint");
-    WriteCheckpoint(checkpoint_.ptr(), S_next_.ptr(), dt);
+    if (column_checkpoint_ != Teuchos::null) column_checkpoint_->set_filebasename("error_checkpoint");
+    write_checkpoint(S_next_.ptr(), dt);
     throw e;
   }
 #endif
@@ -712,6 +856,7 @@ void Coordinator::cycle_driver() {
   S_->WriteStatistics(vo_);  
   report_memory();
   Teuchos::TimeMonitor::summarize(*vo_->os());
+  if (profiler_ != Teuchos::null) profiler_->Write(*vo_->os(), *comm_);
 
   finalize();
 
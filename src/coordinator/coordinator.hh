@@ -25,9 +25,20 @@ the simulation, including starting and ending times and restart options.
 * `"end cycle`" ``[int]`` If provided, specifies the end of the simulation in timestep cycles.
 
 * `"restart from checkpoint file`" ``[string]`` If provided, specifies a path to the checkpoint file to continue a stopped simulation.
+  Only State is restored, unless the top-level PK's time integrator sets
+  `"checkpoint integrator history`" (see PKBDFBase_), in which case the
+  timestep size and predictor continue as in the uninterrupted run.
 
 * `"wallclock duration [hrs]`" ``[double]`` After this time, the simulation will checkpoint and end.  Not required.
 
+* `"asynchronous output`" ``[bool]`` **false** If true, checkpoint and vis
+  files are written from a snapshot of the state by a background thread.
+  See AsyncOutput_.
+
+* `"profile evaluators`" ``[bool]`` **false** If true, record call counts and
+  timings of each evaluator, written at the end of the run.  See
+  EvaluatorProfiler_.
+
 * `"required times`" ``[time-control-spec]``
 
   A TimeControl_ spec that sets a collection of times/cycles at which the simulation is guaranteed to hit exactly.  This is useful for situations such as where data is provided at a regular interval, and interpolation error related to that data is to be minimized.
@@ -79,6 +90,11 @@ class UnstructuredObservations;
 
 namespace ATS {
 
+class ColumnCheckpoint;
+class AsyncOutput;
+class EvaluatorProfiler;
+class SinglePrecisionVis;
+
 class Coordinator {
 
 public:
@@ -104,6 +120,7 @@ public:
 private:
   void coordinator_init();
   void read_parameter_list();
+  void write_checkpoint(const Teuchos::Ptr<Amanzi::State>& S, double dt);
 
   // PK container and factory
   Teuchos::RCP<Amanzi::PK> pk_;
@@ -134,9 +151,17 @@ private:
 
   // vis and checkpointing
   std::vector<Teuchos::RCP<Amanzi::Visualization> > visualization_;
+  std::vector<bool> visualization_async_;
   std::vector<Teuchos::RCP<Amanzi::Visualization> > failed_visualization_;
+  std::vector<Teuchos::RCP<SinglePrecisionVis> > single_visualization_;
   Teuchos::RCP<Amanzi::Checkpoint> checkpoint_;
+  Teuchos::RCP<ColumnCheckpoint> column_checkpoint_;
+  Teuchos::RCP<Teuchos::ParameterList> checkpoint_list_;
+  Epetra_MpiComm* checkpoint_comm_;
+  Teuchos::RCP<AsyncOutput> output_;
+  Teuchos::RCP<EvaluatorProfiler> profiler_;
   bool restart_;
+  bool restart_aggregated_;
   std::string restart_filename_;
 
   // observations
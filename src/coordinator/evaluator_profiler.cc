@@ -0,0 +1,405 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! EvaluatorProfiler: per-evaluator call counts and timings of the dependency graph.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: ATS developers
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+#include "errors.hh"
+#include "State.hh"
+
+#include "evaluator_profiler.hh"
+
+namespace ATS {
+
+namespace {
+
+// FNV-1a over the bytes of the data.
+std::uint64_t
+hashBytes(std::uint64_t h, const void* data, std::size_t n)
+{
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  for (std::size_t i=0; i!=n; ++i) {
+    h ^= p[i];
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+// The sorted union over ranks of a set of strings, which may not contain
+// null characters.
+std::vector<std::string>
+allGatherStrings(const std::set<std::string>& local, const Epetra_MpiComm& comm)
+{
+  std::string packed;
+  for (const auto& str : local) packed += str + '\0';
+  int len = packed.size();
+
+  int nranks = comm.NumProc();
+  std::vector<int> lens(nranks), offsets(nranks+1, 0);
+  MPI_Allgather(&len, 1, MPI_INT, &lens[0], 1, MPI_INT, comm.Comm());
+  for (int r=0; r!=nranks; ++r) offsets[r+1] = offsets[r] + lens[r];
+
+  std::vector<char> all(std::max(offsets[nranks], 1));
+  MPI_Allgatherv(const_cast<char*>(packed.data()), len, MPI_CHAR,
+                 &all[0], &lens[0], &offsets[0], MPI_CHAR, comm.Comm());
+
+  std::set<std::string> merged;
+  for (int i=0; i<offsets[nranks]; i += std::strlen(&all[i]) + 1) {
+    merged.insert(std::string(&all[i]));
+  }
+  return std::vector<std::string>(merged.begin(), merged.end());
+}
+
+Teuchos::ParameterList
+shimList(const Amanzi::Key& key)
+{
+  Teuchos::ParameterList plist(key);
+  plist.set("evaluator name", key);
+  return plist;
+}
+
+} // namespace
+
+
+EvaluatorProfiler::EvaluatorProfiler(Teuchos::ParameterList& plist) :
+    overhead_(0.)
+{
+  detect_redundant_ = plist.get<bool>("profile evaluators detect redundant", false);
+  graph_filename_ = plist.get<std::string>("profile evaluators graph filename",
+          "evaluator_profile.dot");
+}
+
+
+void
+EvaluatorProfiler::Install(const Teuchos::Ptr<Amanzi::State>& S)
+{
+  // One evaluator may provide several keys.  Each gets one shim, under all
+  // of its keys, and one entry.
+  std::map<Amanzi::FieldEvaluator*, Teuchos::RCP<Amanzi::FieldEvaluator> > evals;
+  std::map<Amanzi::FieldEvaluator*, std::vector<Amanzi::Key> > keys;
+  for (Amanzi::State::evaluator_iterator fe=S->field_evaluator_begin();
+       fe!=S->field_evaluator_end(); ++fe) {
+    if (fe->second == Teuchos::null) continue;
+    if (Teuchos::rcp_dynamic_cast<ProfiledFieldEvaluator>(fe->second) != Teuchos::null ||
+        Teuchos::rcp_dynamic_cast<ProfiledPrimaryVariableFieldEvaluator>(fe->second) != Teuchos::null)
+      continue;
+    evals[fe->second.get()] = fe->second;
+    keys[fe->second.get()].push_back(fe->first);
+  }
+
+  for (auto& ev : evals) {
+    std::vector<Amanzi::Key>& ev_keys = keys[ev.first];
+    std::sort(ev_keys.begin(), ev_keys.end());
+
+    std::string name = ev_keys[0];
+    for (std::size_t i=1; i!=ev_keys.size(); ++i) name += "," + ev_keys[i];
+    Entry& e = entries_[name];
+    e.name = name;
+    e.keys = ev_keys;
+
+    Teuchos::ParameterList plist = shimList(ev_keys[0]);
+    Teuchos::RCP<Amanzi::FieldEvaluator> shim;
+    Teuchos::RCP<Amanzi::PrimaryVariableFieldEvaluator> pv =
+        Teuchos::rcp_dynamic_cast<Amanzi::PrimaryVariableFieldEvaluator>(ev.second);
+    if (pv != Teuchos::null) {
+      shim = Teuchos::rcp(new ProfiledPrimaryVariableFieldEvaluator(plist, pv, e, *this));
+    } else {
+      shim = Teuchos::rcp(new ProfiledFieldEvaluator(plist, ev.second, e, *this));
+    }
+    for (const auto& key : ev_keys) S->SetFieldEvaluator(key, shim);
+  }
+}
+
+
+void
+EvaluatorProfiler::Updated_(Entry& e, const Teuchos::Ptr<Amanzi::State>& S)
+{
+  std::uint64_t sum = Checksum_(e, *S);
+  auto last = e.input_checksum.find(S.get());
+  if (last != e.input_checksum.end()) {
+    if (last->second == sum) e.redundant++;
+    last->second = sum;
+  } else {
+    e.input_checksum[S.get()] = sum;
+  }
+}
+
+
+std::uint64_t
+EvaluatorProfiler::Checksum_(const Entry& e, const Amanzi::State& S) const
+{
+  std::uint64_t h = 14695981039346656037ull;
+  for (const Entry* dep : e.dependencies) {
+    for (const auto& key : dep->keys) {
+      if (!S.HasField(key)) continue;
+      Teuchos::RCP<const Amanzi::Field> field = S.GetField(key);
+      if (field->type() == Amanzi::COMPOSITE_VECTOR_FIELD) {
+        Teuchos::RCP<const Amanzi::CompositeVector> cv = S.GetFieldData(key);
+        for (const auto& comp : *cv) {
+          const Epetra_MultiVector& vec = *cv->ViewComponent(comp, false);
+          for (int j=0; j!=vec.NumVectors(); ++j) {
+            h = hashBytes(h, vec[j], vec.MyLength() * sizeof(double));
+          }
+        }
+      } else if (field->type() == Amanzi::CONSTANT_SCALAR) {
+        h = hashBytes(h, S.GetScalarData(key).get(), sizeof(double));
+      }
+    }
+  }
+  return h;
+}
+
+
+void
+EvaluatorProfiler::Write(std::ostream& os, const Epetra_MpiComm& comm) const
+{
+  // Ranks need not have the same evaluators (e.g. one state per column), so
+  // reduce over the union of their names, and of their dependency edges.
+  std::set<std::string> local_names, local_edges;
+  for (const auto& en : entries_) {
+    local_names.insert(en.first);
+    for (const Entry* dep : en.second.dependencies) {
+      local_edges.insert(en.first + '\n' + dep->name);
+    }
+  }
+  std::vector<std::string> names = allGatherStrings(local_names, comm);
+  std::vector<std::string> edges = allGatherStrings(local_edges, comm);
+  int n = names.size();
+  if (n == 0) return;
+
+  // Missing entries are zero for the maximum, and do not count for the
+  // minimum.
+  const int nfields = 7;
+  const double missing = std::numeric_limits<double>::max();
+  std::vector<double> local_max(nfields*n, 0.), local_min(nfields*n, missing);
+  std::vector<double> global_max(nfields*n), global_min(nfields*n);
+  for (int i=0; i!=n; ++i) {
+    auto en = entries_.find(names[i]);
+    if (en == entries_.end()) continue;
+    const Entry& e = en->second;
+    double* v = &local_max[nfields*i];
+    v[0] = e.calls;
+    v[1] = e.updates;
+    v[2] = e.redundant;
+    v[3] = e.deriv_calls;
+    v[4] = e.deriv_updates;
+    v[5] = e.inclusive;
+    v[6] = e.exclusive;
+    std::copy(v, v+nfields, &local_min[nfields*i]);
+  }
+  comm.MaxAll(&local_max[0], &global_max[0], nfields*n);
+  comm.MinAll(&local_min[0], &global_min[0], nfields*n);
+
+  std::vector<int> order(n);
+  for (int i=0; i!=n; ++i) order[i] = i;
+  std::sort(order.begin(), order.end(), [&](int a, int b) {
+      return global_max[nfields*a+6] > global_max[nfields*b+6]; });
+
+  double total = 0.;
+  for (int i=0; i!=n; ++i) total += global_max[nfields*i+6];
+
+  if (comm.MyPID() != 0) return;
+
+  os << std::endl << "Evaluator profile, sorted by exclusive time (updates are inferred"
+     << " from the changes reported)" << std::endl;
+  os << std::setw(40) << std::left << "evaluator" << std::right
+     << std::setw(10) << "calls" << std::setw(10) << "updates" << std::setw(10) << "redundant"
+     << std::setw(10) << "d calls" << std::setw(10) << "d updates"
+     << std::setw(14) << "incl [s]" << std::setw(14) << "excl [s]" << std::setw(8) << "%"
+     << std::endl;
+  for (int i : order) {
+    const double* vmax = &global_max[nfields*i];
+    const double* vmin = &global_min[nfields*i];
+    os << std::setw(40) << std::left << names[i] << std::right
+       << std::setw(10) << (long long) vmax[0]
+       << std::setw(10) << (long long) vmax[1]
+       << std::setw(10) << (long long) vmin[2]
+       << std::setw(10) << (long long) vmax[3]
+       << std::setw(10) << (long long) vmax[4]
+       << std::setw(14) << std::setprecision(6) << vmax[5]
+       << std::setw(14) << std::setprecision(6) << vmax[6]
+       << std::setw(8) << std::setprecision(3) << (total > 0. ? 100. * vmax[6] / total : 0.)
+       << std::endl;
+  }
+
+  // the graph, shaded by exclusive time
+  std::ofstream dot(graph_filename_.c_str());
+  if (!dot.good()) {
+    Errors::Message msg;
+    msg << "EvaluatorProfiler: cannot open \"" << graph_filename_ << "\" for writing.";
+    Exceptions::amanzi_throw(msg);
+  }
+  dot << "digraph evaluators {" << std::endl
+      << "  node [shape=box, style=filled];" << std::endl;
+  double max_excl = global_max[nfields*order[0]+6];
+  for (int i=0; i!=n; ++i) {
+    const double* vmax = &global_max[nfields*i];
+    double shade = max_excl > 0. ? vmax[6] / max_excl : 0.;
+    dot << "  \"" << names[i] << "\" [label=\"" << names[i]
+        << "\\nupdates: " << (long long) vmax[1]
+        << " (" << (long long) global_min[nfields*i+2] << " redundant)"
+        << "\\nd updates: " << (long long) vmax[4]
+        << "\\nexcl: " << std::setprecision(4) << vmax[6] << " s"
+        << "\\nincl: " << std::setprecision(4) << vmax[5] << " s"
+        << "\", fillcolor=\"0.0 " << std::setprecision(3) << shade << " 1.0\"];" << std::endl;
+  }
+  for (const auto& edge : edges) {
+    std::size_t sep = edge.find('\n');
+    dot << "  \"" << edge.substr(0, sep) << "\" -> \"" << edge.substr(sep+1) << "\";" << std::endl;
+  }
+  dot << "}" << std::endl;
+}
+
+
+// -----------------------------------------------------------------------------
+// ProfiledFieldEvaluator
+// -----------------------------------------------------------------------------
+ProfiledFieldEvaluator::ProfiledFieldEvaluator(Teuchos::ParameterList& plist,
+        const Teuchos::RCP<Amanzi::FieldEvaluator>& inner,
+        EvaluatorProfiler::Entry& entry,
+        EvaluatorProfiler& profiler) :
+    Amanzi::FieldEvaluator(plist),
+    inner_(inner),
+    entry_(&entry),
+    profiler_(&profiler) {}
+
+ProfiledFieldEvaluator::ProfiledFieldEvaluator(const ProfiledFieldEvaluator& other) :
+    Amanzi::FieldEvaluator(other),
+    inner_(other.inner_->Clone()),
+    entry_(other.entry_),
+    profiler_(other.profiler_) {}
+
+Teuchos::RCP<Amanzi::FieldEvaluator>
+ProfiledFieldEvaluator::Clone() const {
+  return Teuchos::rcp(new ProfiledFieldEvaluator(*this));
+}
+
+void
+ProfiledFieldEvaluator::operator=(const Amanzi::FieldEvaluator& other) {
+  const ProfiledFieldEvaluator* other_p = dynamic_cast<const ProfiledFieldEvaluator*>(&other);
+  if (other_p) *inner_ = *other_p->inner_;
+  else *inner_ = other;
+}
+
+bool
+ProfiledFieldEvaluator::HasFieldChanged(const Teuchos::Ptr<Amanzi::State>& S,
+        Amanzi::Key request) {
+  return profiler_->Profile(*entry_, S, request, false,
+          [&]() { return inner_->HasFieldChanged(S, request); });
+}
+
+bool
+ProfiledFieldEvaluator::HasFieldDerivativeChanged(const Teuchos::Ptr<Amanzi::State>& S,
+        Amanzi::Key request, Amanzi::Key wrt_key) {
+  return profiler_->Profile(*entry_, S, request+"|"+wrt_key, true,
+          [&]() { return inner_->HasFieldDerivativeChanged(S, request, wrt_key); });
+}
+
+bool
+ProfiledFieldEvaluator::IsDependency(const Teuchos::Ptr<Amanzi::State>& S,
+        Amanzi::Key key) const {
+  return inner_->IsDependency(S, key);
+}
+
+bool
+ProfiledFieldEvaluator::ProvidesKey(Amanzi::Key key) const {
+  return inner_->ProvidesKey(key);
+}
+
+void
+ProfiledFieldEvaluator::EnsureCompatibility(const Teuchos::Ptr<Amanzi::State>& S) {
+  inner_->EnsureCompatibility(S);
+}
+
+std::string
+ProfiledFieldEvaluator::WriteToString() const {
+  return inner_->WriteToString();
+}
+
+
+// -----------------------------------------------------------------------------
+// ProfiledPrimaryVariableFieldEvaluator
+// -----------------------------------------------------------------------------
+ProfiledPrimaryVariableFieldEvaluator::ProfiledPrimaryVariableFieldEvaluator(
+        Teuchos::ParameterList& plist,
+        const Teuchos::RCP<Amanzi::PrimaryVariableFieldEvaluator>& inner,
+        EvaluatorProfiler::Entry& entry,
+        EvaluatorProfiler& profiler) :
+    Amanzi::PrimaryVariableFieldEvaluator(plist),
+    inner_(inner),
+    entry_(&entry),
+    profiler_(&profiler) {}
+
+ProfiledPrimaryVariableFieldEvaluator::ProfiledPrimaryVariableFieldEvaluator(
+        const ProfiledPrimaryVariableFieldEvaluator& other) :
+    Amanzi::PrimaryVariableFieldEvaluator(other),
+    inner_(Teuchos::rcp_dynamic_cast<Amanzi::PrimaryVariableFieldEvaluator>(
+        other.inner_->Clone(), true)),
+    entry_(other.entry_),
+    profiler_(other.profiler_) {}
+
+Teuchos::RCP<Amanzi::FieldEvaluator>
+ProfiledPrimaryVariableFieldEvaluator::Clone() const {
+  return Teuchos::rcp(new ProfiledPrimaryVariableFieldEvaluator(*this));
+}
+
+void
+ProfiledPrimaryVariableFieldEvaluator::operator=(const Amanzi::FieldEvaluator& other) {
+  const ProfiledPrimaryVariableFieldEvaluator* other_p =
+      dynamic_cast<const ProfiledPrimaryVariableFieldEvaluator*>(&other);
+  if (other_p) *inner_ = static_cast<const Amanzi::FieldEvaluator&>(*other_p->inner_);
+  else *inner_ = other;
+}
+
+bool
+ProfiledPrimaryVariableFieldEvaluator::HasFieldChanged(const Teuchos::Ptr<Amanzi::State>& S,
+        Amanzi::Key request) {
+  return profiler_->Profile(*entry_, S, request, false,
+          [&]() { return inner_->HasFieldChanged(S, request); });
+}
+
+bool
+ProfiledPrimaryVariableFieldEvaluator::HasFieldDerivativeChanged(
+        const Teuchos::Ptr<Amanzi::State>& S, Amanzi::Key request, Amanzi::Key wrt_key) {
+  return profiler_->Profile(*entry_, S, request+"|"+wrt_key, true,
+          [&]() { return inner_->HasFieldDerivativeChanged(S, request, wrt_key); });
+}
+
+bool
+ProfiledPrimaryVariableFieldEvaluator::IsDependency(const Teuchos::Ptr<Amanzi::State>& S,
+        Amanzi::Key key) const {
+  return inner_->IsDependency(S, key);
+}
+
+bool
+ProfiledPrimaryVariableFieldEvaluator::ProvidesKey(Amanzi::Key key) const {
+  return inner_->ProvidesKey(key);
+}
+
+void
+ProfiledPrimaryVariableFieldEvaluator::EnsureCompatibility(const Teuchos::Ptr<Amanzi::State>& S) {
+  inner_->EnsureCompatibility(S);
+}
+
+void
+ProfiledPrimaryVariableFieldEvaluator::SetFieldAsChanged(const Teuchos::Ptr<Amanzi::State>& S) {
+  inner_->SetFieldAsChanged(S);
+}
+
+std::string
+ProfiledPrimaryVariableFieldEvaluator::WriteToString() const {
+  return inner_->WriteToString();
+}
+
+} // namespace ATS
@@ -0,0 +1,278 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! EvaluatorProfiler: per-evaluator call counts and timings of the dependency graph.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: ATS developers
+*/
+
+/*!
+
+The evaluators recurse through the dependency graph on every request for a
+field, so the time spent in any one of them is hidden inside the PK timers.
+When profiling is on, the Coordinator wraps every evaluator of its states in
+a thin shim that records, for each evaluator:
+
+* the number of requests (calls to ``HasFieldChanged()`` and
+  ``HasFieldDerivativeChanged()``),
+* the number of inferred updates of the field and of its derivatives,
+* the number of inferred updates for which none of its dependencies changed
+  since the last one in the same state (redundant updates), if requested,
+* the inclusive time, including its dependencies, and the exclusive time,
+  its own work only.
+
+The shims sit outside the evaluators, so updates are not counted where they
+happen but inferred from the answers: an update is counted when the evaluator
+reports a change and one of its dependencies reported a change during the
+same request.  The dependencies are likewise those actually requested at run
+time.  For evaluators with no dependencies (primary and independent
+variables), an update is counted when a requester that has already seen the
+field is told it changed.  An evaluator that recomputes without reporting a
+change, or reports a change it did not recompute, is miscounted.
+
+At the end of the run the table, sorted by exclusive time, is written to the
+Coordinator's output, and the dependency graph, annotated with the counts and
+times, is written in graphviz format.  Ranks need not have the same
+evaluators; the table and graph cover the union of them.  Counts and times
+are the maximum over the ranks that have the evaluator, and redundant updates
+the minimum.
+
+When profiling is off nothing is wrapped, and the cost is zero.
+
+In the `"cycle driver`" list:
+
+* `"profile evaluators`" ``[bool]`` **false** Record evaluator counts and
+  timings.
+
+* `"profile evaluators graph filename`" ``[string]``
+  **evaluator_profile.dot** The annotated dependency graph.
+
+* `"profile evaluators detect redundant`" ``[bool]`` **false** Checksum the
+  dependencies at each update to count redundant updates.  This is
+  expensive, a pass over all of the data of the dependencies per update, and
+  is meant to be turned on only to look for redundant work.  Its cost is not
+  included in the times, but is in the run time.
+
+*/
+
+#ifndef ATS_EVALUATOR_PROFILER_HH_
+#define ATS_EVALUATOR_PROFILER_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_Ptr.hpp"
+#include "Teuchos_ParameterList.hpp"
+#include "Epetra_MpiComm.h"
+
+#include "Key.hh"
+#include "FieldEvaluator.hh"
+#include "primary_variable_field_evaluator.hh"
+
+namespace Amanzi {
+class State;
+}
+
+namespace ATS {
+
+class EvaluatorProfiler {
+
+ public:
+  // Counts and times of one evaluator, which may provide several keys.
+  struct Entry {
+    Entry() :
+        calls(0), updates(0), redundant(0),
+        deriv_calls(0), deriv_updates(0),
+        inclusive(0.), exclusive(0.) {}
+
+    std::string name;
+    std::vector<Amanzi::Key> keys;
+
+    // updates are inferred from the answers of the evaluator and its
+    // dependencies, not counted in the update itself
+    long long calls, updates, redundant;
+    long long deriv_calls, deriv_updates;
+    double inclusive, exclusive;
+
+    // dependencies observed at run time
+    std::set<Entry*> dependencies;
+
+    // requesters told of the current value (or derivative), per state
+    std::map<const Amanzi::State*, std::set<std::string> > served;
+    std::map<const Amanzi::State*, std::set<std::string> > deriv_served;
+
+    // checksum of the dependencies at the last update, per state
+    std::map<const Amanzi::State*, std::uint64_t> input_checksum;
+  };
+
+ public:
+  EvaluatorProfiler(Teuchos::ParameterList& plist);
+
+  // Wrap each evaluator of S.  Evaluators already wrapped are left alone, so
+  // this may be called again after evaluators are added.
+  void Install(const Teuchos::Ptr<Amanzi::State>& S);
+
+  // Write the sorted table to os and, on rank 0, the graph to file.
+  void Write(std::ostream& os, const Epetra_MpiComm& comm) const;
+
+  // Time a call to an evaluator, inner(), on behalf of request.
+  template<class Inner>
+  bool Profile(Entry& e, const Teuchos::Ptr<Amanzi::State>& S,
+               const std::string& request, bool derivative, Inner inner);
+
+ protected:
+  struct Frame {
+    Entry* entry;
+    double child_time;
+    double overhead_start;
+    bool child_changed;
+  };
+
+  typedef std::chrono::steady_clock Clock;
+
+  static double Seconds_(const Clock::time_point& t0, const Clock::time_point& t1) {
+    return std::chrono::duration<double>(t1 - t0).count();
+  }
+
+  void Updated_(Entry& e, const Teuchos::Ptr<Amanzi::State>& S);
+  std::uint64_t Checksum_(const Entry& e, const Amanzi::State& S) const;
+
+ protected:
+  std::map<std::string, Entry> entries_;
+  std::vector<Frame> stack_;
+  double overhead_;
+
+  bool detect_redundant_;
+  std::string graph_filename_;
+};
+
+
+// Shim around a secondary or independent variable evaluator.
+class ProfiledFieldEvaluator : public Amanzi::FieldEvaluator {
+
+ public:
+  ProfiledFieldEvaluator(Teuchos::ParameterList& plist,
+                         const Teuchos::RCP<Amanzi::FieldEvaluator>& inner,
+                         EvaluatorProfiler::Entry& entry,
+                         EvaluatorProfiler& profiler);
+  ProfiledFieldEvaluator(const ProfiledFieldEvaluator& other);
+
+  virtual Teuchos::RCP<Amanzi::FieldEvaluator> Clone() const;
+  virtual void operator=(const Amanzi::FieldEvaluator& other);
+
+  virtual bool HasFieldChanged(const Teuchos::Ptr<Amanzi::State>& S, Amanzi::Key request);
+  virtual bool HasFieldDerivativeChanged(const Teuchos::Ptr<Amanzi::State>& S,
+          Amanzi::Key request, Amanzi::Key wrt_key);
+  virtual bool IsDependency(const Teuchos::Ptr<Amanzi::State>& S, Amanzi::Key key) const;
+  virtual bool ProvidesKey(Amanzi::Key key) const;
+  virtual void EnsureCompatibility(const Teuchos::Ptr<Amanzi::State>& S);
+  virtual std::string WriteToString() const;
+
+  Teuchos::RCP<Amanzi::FieldEvaluator> inner() const { return inner_; }
+
+ protected:
+  Teuchos::RCP<Amanzi::FieldEvaluator> inner_;
+  EvaluatorProfiler::Entry* entry_;
+  EvaluatorProfiler* profiler_;
+};
+
+
+// Shim around a primary variable evaluator.  PKs cast the evaluators of their
+// primary variables to mark them as changed, so this must remain one.
+class ProfiledPrimaryVariableFieldEvaluator : public Amanzi::PrimaryVariableFieldEvaluator {
+
+ public:
+  ProfiledPrimaryVariableFieldEvaluator(Teuchos::ParameterList& plist,
+          const Teuchos::RCP<Amanzi::PrimaryVariableFieldEvaluator>& inner,
+          EvaluatorProfiler::Entry& entry,
+          EvaluatorProfiler& profiler);
+  ProfiledPrimaryVariableFieldEvaluator(const ProfiledPrimaryVariableFieldEvaluator& other);
+
+  virtual Teuchos::RCP<Amanzi::FieldEvaluator> Clone() const;
+  virtual void operator=(const Amanzi::FieldEvaluator& other);
+
+  virtual bool HasFieldChanged(const Teuchos::Ptr<Amanzi::State>& S, Amanzi::Key request);
+  virtual bool HasFieldDerivativeChanged(const Teuchos::Ptr<Amanzi::State>& S,
+          Amanzi::Key request, Amanzi::Key wrt_key);
+  virtual bool IsDependency(const Teuchos::Ptr<Amanzi::State>& S, Amanzi::Key key) const;
+  virtual bool ProvidesKey(Amanzi::Key key) const;
+  virtual void EnsureCompatibility(const Teuchos::Ptr<Amanzi::State>& S);
+  virtual void SetFieldAsChanged(const Teuchos::Ptr<Amanzi::State>& S);
+  virtual std::string WriteToString() const;
+
+  Teuchos::RCP<Amanzi::PrimaryVariableFieldEvaluator> inner() const { return inner_; }
+
+ protected:
+  Teuchos::RCP<Amanzi::PrimaryVariableFieldEvaluator> inner_;
+  EvaluatorProfiler::Entry* entry_;
+  EvaluatorProfiler* profiler_;
+};
+
+
+template<class Inner>
+bool
+EvaluatorProfiler::Profile(Entry& e, const Teuchos::Ptr<Amanzi::State>& S,
+                           const std::string& request, bool derivative, Inner inner)
+{
+  if (!stack_.empty()) stack_.back().entry->dependencies.insert(&e);
+  stack_.push_back(Frame{&e, 0., overhead_, false});
+
+  Clock::time_point t0 = Clock::now();
+  bool changed;
+  try {
+    changed = inner();
+  } catch (...) {
+    // failed updates are not counted, but must not unbalance the stack
+    stack_.pop_back();
+    throw;
+  }
+  Clock::time_point t1 = Clock::now();
+
+  Frame frame = stack_.back();
+  stack_.pop_back();
+  double elapsed = Seconds_(t0, t1) - (overhead_ - frame.overhead_start);
+  e.inclusive += elapsed;
+  e.exclusive += elapsed - frame.child_time;
+  if (!stack_.empty()) {
+    stack_.back().child_time += elapsed;
+    stack_.back().child_changed |= changed;
+  }
+
+  // Infer an update: a change is new if a dependency changed, or if a
+  // requester that was already told of the current value is told again.
+  std::set<std::string>& served = derivative ?
+      e.deriv_served[S.get()] : e.served[S.get()];
+  if (changed) {
+    if (frame.child_changed || served.count(request)) {
+      served.clear();
+      if (derivative) {
+        e.deriv_updates++;
+      } else {
+        e.updates++;
+        if (detect_redundant_ && !e.dependencies.empty()) {
+          Clock::time_point c0 = Clock::now();
+          Updated_(e, S);
+          overhead_ += Seconds_(c0, Clock::now());
+        }
+      }
+    }
+    served.insert(request);
+  }
+
+  if (derivative) e.deriv_calls++;
+  else e.calls++;
+  return changed;
+}
+
+} // namespace ATS
+
+#endif
@@ -0,0 +1,202 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! SinglePrecisionVis: single precision visualization of diagnostic fields.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: ATS developers
+*/
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include "hdf5.h"
+
+#include "errors.hh"
+#include "State.hh"
+#include "FieldEvaluator.hh"
+#include "primary_variable_field_evaluator.hh"
+
+#include "single_precision_vis.hh"
+
+namespace ATS {
+
+namespace {
+
+void
+checkH5(herr_t ierr, const std::string& what, const std::string& filename)
+{
+  if (ierr < 0) {
+    Errors::Message msg;
+    msg << "SinglePrecisionVis: HDF5 error in " << what << " on file \"" << filename << "\".";
+    Exceptions::amanzi_throw(msg);
+  }
+}
+
+template<typename T>
+void
+writeAttribute(hid_t file, const std::string& name, hid_t type, T value,
+               const std::string& filename)
+{
+  hid_t space = H5Screate(H5S_SCALAR);
+  hid_t attr = H5Acreate2(file, name.c_str(), type, space, H5P_DEFAULT, H5P_DEFAULT);
+  checkH5(attr, "creating attribute "+name, filename);
+  checkH5(H5Awrite(attr, type, &value), "writing attribute "+name, filename);
+  H5Aclose(attr);
+  H5Sclose(space);
+}
+
+} // namespace
+
+
+SinglePrecisionVis::SinglePrecisionVis(Teuchos::ParameterList& plist,
+        const Amanzi::Key& domain, const Teuchos::Ptr<Amanzi::State>& S,
+        Epetra_MpiComm* comm) :
+    Amanzi::IOEvent(plist),
+    comm_(comm)
+{
+  filebasename_ = plist.get<std::string>("single precision file name base",
+          plist.get<std::string>("file name base", "visdump")+"_single");
+  filenamedigits_ = plist.get<int>("file name digits", 5);
+  bits_ = plist.get<int>("single precision mantissa bits", 23);
+  if (bits_ < 1 || bits_ > 23) {
+    Errors::Message msg("SinglePrecisionVis: \"single precision mantissa bits\" must be in [1,23].");
+    Exceptions::amanzi_throw(msg);
+  }
+
+  Teuchos::Array<std::string> names =
+      plist.get<Teuchos::Array<std::string> >("single precision fields");
+  for (const auto& name : names) {
+    Amanzi::Key key = Amanzi::Keys::getKey(domain, name);
+
+    // Only a diagnostic may be reduced: a secondary variable, owned by its
+    // own evaluator, which is not an input to any other field.
+    std::string reason;
+    if (!S->HasField(key)) {
+      reason = "it does not exist";
+    } else if (S->GetField(key)->type() != Amanzi::COMPOSITE_VECTOR_FIELD) {
+      reason = "it is not a field on the mesh";
+    } else if (!S->HasFieldEvaluator(key) || S->GetField(key)->owner() != key) {
+      reason = "it is owned by \"" + S->GetField(key)->owner() + "\", not by its evaluator";
+    } else if (Teuchos::rcp_dynamic_cast<Amanzi::PrimaryVariableFieldEvaluator>(
+                   S->GetFieldEvaluator(key)) != Teuchos::null) {
+      reason = "it is a primary variable";
+    } else {
+      for (Amanzi::State::evaluator_iterator fe=S->field_evaluator_begin();
+           fe!=S->field_evaluator_end(); ++fe) {
+        if (fe->second != Teuchos::null && fe->first != key &&
+            fe->second->IsDependency(S, key)) {
+          reason = "\"" + fe->first + "\" depends on it";
+          break;
+        }
+      }
+    }
+
+    if (!reason.empty()) {
+      Errors::Message msg;
+      msg << "SinglePrecisionVis: cannot write \"" << key
+          << "\" in single precision, as " << reason << ".";
+      Exceptions::amanzi_throw(msg);
+    }
+
+    S->GetField(key, key)->set_io_vis(false);
+    keys_.push_back(key);
+  }
+}
+
+
+float
+SinglePrecisionVis::Round(double value, int bits)
+{
+  float f = static_cast<float>(value);
+  if (bits >= 23 || !std::isfinite(f)) return f;
+
+  std::uint32_t u;
+  std::memcpy(&u, &f, sizeof(float));
+  int drop = 23 - bits;
+  u += std::uint32_t(1) << (drop-1);
+  u &= ~((std::uint32_t(1) << drop) - 1);
+  std::memcpy(&f, &u, sizeof(float));
+  return f;
+}
+
+
+std::string
+SinglePrecisionVis::Filename_(int cycle) const
+{
+  std::stringstream oss;
+  oss << filebasename_ << "_" << std::setfill('0') << std::setw(filenamedigits_) << cycle << ".h5";
+  return oss.str();
+}
+
+
+void
+SinglePrecisionVis::Write(const Amanzi::State& S)
+{
+  MPI_Comm comm = comm_->Comm();
+  int rank = comm_->MyPID();
+  std::string filename = Filename_(S.cycle());
+
+  hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+  H5Pset_fapl_mpio(fapl, comm, MPI_INFO_NULL);
+  hid_t file = H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+  H5Pclose(fapl);
+  checkH5(file, "creating file", filename);
+
+  writeAttribute(file, "time", H5T_NATIVE_DOUBLE, S.time(), filename);
+  writeAttribute(file, "cycle", H5T_NATIVE_INT, S.cycle(), filename);
+  writeAttribute(file, "mantissa bits", H5T_NATIVE_INT, bits_, filename);
+
+  hid_t dxpl = H5Pcreate(H5P_DATASET_XFER);
+  H5Pset_dxpl_mpio(dxpl, H5FD_MPIO_COLLECTIVE);
+
+  for (const auto& key : keys_) {
+    Teuchos::RCP<const Amanzi::CompositeVector> cv = S.GetFieldData(key);
+    for (const auto& comp : *cv) {
+      const Epetra_MultiVector& vec = *cv->ViewComponent(comp, false);
+      long long local = vec.MyLength();
+      long long offset = 0, total = 0;
+      MPI_Exscan(&local, &offset, 1, MPI_LONG_LONG, MPI_SUM, comm);
+      if (rank == 0) offset = 0;
+      MPI_Allreduce(&local, &total, 1, MPI_LONG_LONG, MPI_SUM, comm);
+
+      hsize_t dims[1] = { static_cast<hsize_t>(total) };
+      hsize_t start[1] = { static_cast<hsize_t>(offset) };
+      hsize_t count[1] = { static_cast<hsize_t>(local) };
+      buf_.resize(local + 1);
+
+      for (int dof=0; dof!=vec.NumVectors(); ++dof) {
+        for (int i=0; i!=local; ++i) buf_[i] = Round(vec[dof][i], bits_);
+
+        std::stringstream dname;
+        dname << key << "." << comp << "." << dof;
+        hid_t fspace = H5Screate_simple(1, dims, NULL);
+        hid_t mspace = H5Screate_simple(1, count, NULL);
+        hid_t dset = H5Dcreate2(file, dname.str().c_str(), H5T_NATIVE_FLOAT, fspace,
+                                H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        checkH5(dset, "creating dataset "+dname.str(), filename);
+        if (local > 0) {
+          H5Sselect_hyperslab(fspace, H5S_SELECT_SET, start, NULL, count, NULL);
+        } else {
+          H5Sselect_none(fspace);
+          H5Sselect_none(mspace);
+        }
+        checkH5(H5Dwrite(dset, H5T_NATIVE_FLOAT, mspace, fspace, dxpl, &buf_[0]),
+                "writing dataset "+dname.str(), filename);
+        H5Dclose(dset);
+        H5Sclose(mspace);
+        H5Sclose(fspace);
+      }
+    }
+  }
+
+  H5Pclose(dxpl);
+  H5Fclose(file);
+}
+
+} // namespace ATS
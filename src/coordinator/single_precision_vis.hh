@@ -0,0 +1,97 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! SinglePrecisionVis: single precision visualization of diagnostic fields.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: ATS developers
+*/
+
+/*!
+
+Diagnostic fields, which are calculated only for visualization and never
+enter a residual (velocities, component energies and water contents, surface
+balance terms), are typically a large share of every vis dump, and rarely
+need more than single precision.  Such fields may be listed in a
+visualization domain's list, and are then removed from the (double precision)
+vis files and instead written, on the same schedule, to a file of their own in
+single precision.
+
+Only fields that are safe to reduce may be listed: each must be calculated by
+its own secondary variable evaluator, and no other evaluator may depend on it.
+Primary variables, fields owned by a PK (e.g. fluxes, which are used by other
+PKs), and fields that are inputs to other fields are refused.
+
+Each dump is one HDF5 file, `"FILE_NAME_BASE_CYCLE.h5`", with one dataset
+`"KEY.COMPONENT.DOF`" per dof of each component, in the same order as the
+double precision vis files (owned entities, by rank).
+
+In a `"visualization`" domain list:
+
+* `"single precision fields`" ``[Array(string)]`` Names of the diagnostic
+  variables on this domain to write in single precision.
+
+* `"single precision file name base`" ``[string]`` **FILE_NAME_BASE_single**
+  Where FILE_NAME_BASE is the `"file name base`" of the vis list.
+
+* `"single precision mantissa bits`" ``[int]`` **23** Keep only this many of
+  the 23 mantissa bits, rounding to nearest.  Fewer bits quantize the values
+  (e.g. 10 bits is a relative precision of 1e-3), so that the files compress
+  much better, e.g. with ``h5repack -f GZIP=4``.
+
+*/
+
+#ifndef ATS_SINGLE_PRECISION_VIS_HH_
+#define ATS_SINGLE_PRECISION_VIS_HH_
+
+#include <string>
+#include <vector>
+
+#include "Teuchos_ParameterList.hpp"
+#include "Teuchos_Ptr.hpp"
+#include "Epetra_MpiComm.h"
+
+#include "Key.hh"
+#include "IOEvent.hh"
+
+namespace Amanzi {
+class State;
+}
+
+namespace ATS {
+
+class SinglePrecisionVis : public Amanzi::IOEvent {
+
+ public:
+  // Checks the fields, and removes them from the double precision vis of S.
+  SinglePrecisionVis(Teuchos::ParameterList& plist, const Amanzi::Key& domain,
+                     const Teuchos::Ptr<Amanzi::State>& S, Epetra_MpiComm* comm);
+
+  void Write(const Amanzi::State& S);
+
+  const std::vector<Amanzi::Key>& fields() const { return keys_; }
+
+  const Epetra_MpiComm& comm() const { return *comm_; }
+  void set_comm(Epetra_MpiComm* comm) { comm_ = comm; }
+
+  // Round to single precision, keeping only the leading bits of the mantissa.
+  static float Round(double value, int bits);
+
+ protected:
+  std::string Filename_(int cycle) const;
+
+ protected:
+  std::vector<Amanzi::Key> keys_;
+  std::string filebasename_;
+  int filenamedigits_;
+  int bits_;
+  Epetra_MpiComm* comm_;
+
+  std::vector<float> buf_;
+};
+
+} // namespace ATS
+
+#endif
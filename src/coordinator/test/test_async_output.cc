@@ -0,0 +1,176 @@
+/*
+  Testing of asynchronous output.
+*/
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "UnitTest++.h"
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+#include "Epetra_MpiComm.h"
+
+#include "errors.hh"
+#include "MeshFactory.hh"
+#include "State.hh"
+
+#include "async_output.hh"
+
+using namespace Amanzi;
+
+struct async_state {
+  Epetra_MpiComm* comm;
+  Teuchos::RCP<State> S;
+
+  async_state() {
+    comm = new Epetra_MpiComm(MPI_COMM_WORLD);
+
+    Teuchos::ParameterList region_list;
+    Teuchos::RCP<AmanziGeometry::GeometricModel> gm =
+        Teuchos::rcp(new AmanziGeometry::GeometricModel(3, region_list, comm));
+    AmanziMesh::MeshFactory meshfactory(comm);
+    AmanziMesh::FrameworkPreference pref;
+    pref.push_back(AmanziMesh::MSTK);
+    meshfactory.preference(pref);
+    Teuchos::RCP<AmanziMesh::Mesh> mesh = meshfactory(0.,0.,0., 1.,1.,1., 4,4,4, gm);
+
+    Teuchos::ParameterList state_list;
+    S = Teuchos::rcp(new State(state_list));
+    S->RegisterDomainMesh(mesh);
+    S->RequireField("temperature", "energy")->SetMesh(mesh)->SetGhosted()
+        ->AddComponent("cell", AmanziMesh::CELL, 1);
+    S->RequireField("scratch", "energy")->SetMesh(mesh)->SetGhosted()
+        ->AddComponent("cell", AmanziMesh::CELL, 1);
+    S->Setup();
+    S->GetFieldData("temperature", "energy")->PutScalar(0.);
+    S->GetField("temperature", "energy")->set_initialized();
+    S->GetFieldData("scratch", "energy")->PutScalar(0.);
+    S->GetField("scratch", "energy")->set_initialized();
+    S->GetField("scratch", "energy")->set_io_vis(false);
+    S->GetField("scratch", "energy")->set_io_checkpoint(false);
+    S->Initialize();
+  }
+
+  ~async_state() { delete comm; }
+
+  // Writes the cell values and their global sum, computed on comm.
+  static void Write(const State& S, const std::string& filename,
+                    const Epetra_MpiComm& comm) {
+    const Epetra_MultiVector& temp =
+        *S.GetFieldData("temperature")->ViewComponent("cell", false);
+    double sum = 0., local_sum = 0.;
+    for (int c=0; c!=temp.MyLength(); ++c) local_sum += temp[0][c];
+    comm.SumAll(&local_sum, &sum, 1);
+
+    std::ofstream out(filename.c_str(), std::ios::app);
+    out << std::setprecision(17) << "cycle " << S.cycle() << " sum " << sum << std::endl;
+    for (int c=0; c!=temp.MyLength(); ++c) out << temp[0][c] << std::endl;
+  }
+
+  // Writes ncycles dumps, changing the state right after each is requested.
+  void Run(const Teuchos::RCP<AsyncOutput>& output, const std::string& filename,
+           int ncycles) {
+    std::remove(filename.c_str());
+    Epetra_MpiComm* write_comm = output != Teuchos::null ? output->Duplicate(*comm) : comm;
+
+    Epetra_MultiVector& temp =
+        *S->GetFieldData("temperature", "energy")->ViewComponent("cell", false);
+    for (int cycle=0; cycle!=ncycles; ++cycle) {
+      for (int c=0; c!=temp.MyLength(); ++c)
+        temp[0][c] = 273.15 + cycle + 0.001 * comm->MyPID() + 1.e-6 * c;
+
+      if (output != Teuchos::null) {
+        std::vector<AsyncOutput::Writer> writers;
+        writers.push_back([filename,write_comm](const Teuchos::Ptr<State>& S_snap) {
+            Write(*S_snap, filename, *write_comm); });
+        output->Write(S, writers);
+      } else {
+        Write(*S, filename, *write_comm);
+      }
+
+      // the snapshot, not this, must be written
+      temp.PutScalar(-1.);
+      S->advance_cycle();
+    }
+    if (output != Teuchos::null) output->Flush();
+  }
+};
+
+
+std::string
+readFile(const std::string& filename)
+{
+  std::ifstream in(filename.c_str());
+  std::stringstream contents;
+  contents << in.rdbuf();
+  return contents.str();
+}
+
+
+TEST_FIXTURE(async_state, ASYNC_OUTPUT_MATCHES_SYNC) {
+  int ncycles = 6;
+  std::stringstream sync_name, async_name;
+  sync_name << "async_output_test_sync_" << comm->MyPID() << ".txt";
+  async_name << "async_output_test_async_" << comm->MyPID() << ".txt";
+
+  Run(Teuchos::null, sync_name.str(), ncycles);
+
+  // a short queue, so that the back-pressure is exercised
+  S->set_cycle(0);
+  Teuchos::ParameterList plist;
+  plist.set<int>("asynchronous output queue length", 1);
+  Teuchos::RCP<AsyncOutput> output = Teuchos::rcp(new AsyncOutput(plist));
+  if (comm->MyPID() == 0 && !output->threaded()) {
+    std::cout << "AsyncOutput: no MPI_THREAD_MULTIPLE or thread-safe HDF5, "
+              << "testing the synchronous fallback" << std::endl;
+  }
+  Run(output, async_name.str(), ncycles);
+  output = Teuchos::null;
+
+  std::string sync_out = readFile(sync_name.str());
+  CHECK(!sync_out.empty());
+  CHECK(sync_out == readFile(async_name.str()));
+}
+
+
+TEST_FIXTURE(async_state, ASYNC_OUTPUT_RETHROWS) {
+  Teuchos::ParameterList plist;
+  Teuchos::RCP<AsyncOutput> output = Teuchos::rcp(new AsyncOutput(plist));
+
+  std::vector<AsyncOutput::Writer> writers;
+  writers.push_back([](const Teuchos::Ptr<State>&) {
+      Errors::Message msg("failed write");
+      Exceptions::amanzi_throw(msg); });
+
+  bool thrown = false;
+  try {
+    output->Write(S, writers);
+    output->Flush();
+  } catch (const Errors::Message&) {
+    thrown = true;
+  }
+  CHECK(thrown);
+}
+
+
+TEST_FIXTURE(async_state, ASYNC_OUTPUT_SNAPSHOTS_ONLY_WRITTEN_FIELDS) {
+  Teuchos::ParameterList plist;
+  Teuchos::RCP<AsyncOutput> output = Teuchos::rcp(new AsyncOutput(plist));
+
+  bool has_temperature = false;
+  bool has_scratch = true;
+  std::vector<AsyncOutput::Writer> writers;
+  writers.push_back([&](const Teuchos::Ptr<State>& S_snap) {
+      has_temperature = S_snap->HasField("temperature");
+      has_scratch = S_snap->HasField("scratch"); });
+  output->Write(S, writers);
+  output->Flush();
+
+  CHECK(has_temperature);
+  if (output->threaded()) CHECK(!has_scratch);
+}
@@ -0,0 +1,180 @@
+/*
+  Testing of aggregated column checkpoints, written on N ranks and read back
+  on M.
+*/
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "UnitTest++.h"
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+#include "Epetra_MpiComm.h"
+
+#include "errors.hh"
+#include "Key.hh"
+#include "MeshFactory.hh"
+#include "State.hh"
+
+#include "column_checkpoint.hh"
+
+using namespace Amanzi;
+
+namespace {
+
+const int ncols = 6;
+const int ncells = 4;
+
+std::string
+columnDomain(int gid)
+{
+  std::stringstream domain;
+  domain << "column_" << gid;
+  return domain.str();
+}
+
+double
+columnValue(int gid, int c)
+{
+  return 100. * gid + c + 0.5;
+}
+
+// A state with one serial column mesh per listed column GID, a temperature
+// field and a scalar on each, and a global scalar.
+Teuchos::RCP<State>
+columnState(const std::vector<int>& gids)
+{
+  Epetra_MpiComm* comm_self = new Epetra_MpiComm(MPI_COMM_SELF);
+  Teuchos::ParameterList region_list;
+  Teuchos::RCP<AmanziGeometry::GeometricModel> gm =
+      Teuchos::rcp(new AmanziGeometry::GeometricModel(3, region_list, comm_self));
+  AmanziMesh::MeshFactory meshfactory(comm_self);
+  AmanziMesh::FrameworkPreference pref;
+  pref.push_back(AmanziMesh::MSTK);
+  meshfactory.preference(pref);
+
+  Teuchos::ParameterList state_list;
+  Teuchos::RCP<State> S = Teuchos::rcp(new State(state_list));
+  for (int gid : gids) {
+    Teuchos::RCP<AmanziMesh::Mesh> mesh =
+        meshfactory(0.,0.,0., 1.,1.,1., 1,1,ncells, gm);
+    std::string domain = columnDomain(gid);
+    S->RegisterMesh(domain, mesh);
+    S->RequireField(Keys::getKey(domain, "temperature"), "test")->SetMesh(mesh)
+        ->SetGhosted()->AddComponent("cell", AmanziMesh::CELL, 1);
+    S->RequireScalar(Keys::getKey(domain, "snow_depth"), "test");
+  }
+  S->RequireScalar("atmospheric_pressure", "test");
+  S->Setup();
+
+  for (int gid : gids) {
+    std::string domain = columnDomain(gid);
+    S->GetFieldData(Keys::getKey(domain, "temperature"), "test")->PutScalar(-1.);
+    S->GetField(Keys::getKey(domain, "temperature"), "test")->set_initialized();
+    *S->GetScalarData(Keys::getKey(domain, "snow_depth"), "test") = -1.;
+    S->GetField(Keys::getKey(domain, "snow_depth"), "test")->set_initialized();
+  }
+  *S->GetScalarData("atmospheric_pressure", "test") = -1.;
+  S->GetField("atmospheric_pressure", "test")->set_initialized();
+  S->Initialize();
+  return S;
+}
+
+} // namespace
+
+
+// Write on all ranks, each owning every size-th column, then read on about
+// half of them, each owning a different, reversed set of columns.
+TEST(COLUMN_CHECKPOINT_WRITE_N_READ_M) {
+  Epetra_MpiComm comm(MPI_COMM_WORLD);
+  int rank = comm.MyPID();
+  int size = comm.NumProc();
+
+  // write on N = size ranks
+  std::vector<int> write_gids;
+  for (int gid=0; gid!=ncols; ++gid) {
+    if (gid % size == rank) write_gids.push_back(gid);
+  }
+  Teuchos::RCP<State> S_write = columnState(write_gids);
+  S_write->set_time(86400.);
+  S_write->set_cycle(7);
+  for (int gid : write_gids) {
+    std::string domain = columnDomain(gid);
+    Epetra_MultiVector& temp = *S_write->GetFieldData(Keys::getKey(domain, "temperature"), "test")
+        ->ViewComponent("cell", false);
+    for (int c=0; c!=ncells; ++c) temp[0][c] = columnValue(gid, c);
+    *S_write->GetScalarData(Keys::getKey(domain, "snow_depth"), "test") = 0.01 * gid;
+  }
+  *S_write->GetScalarData("atmospheric_pressure", "test") = 101325.;
+
+  Teuchos::ParameterList write_plist;
+  write_plist.set<std::string>("file name base", "column_checkpoint_test_");
+  ATS::ColumnCheckpoint writer(write_plist, &comm);
+  writer.Write(*S_write, 3600.);
+  std::string filename = "column_checkpoint_test_00007.h5";
+
+  // read on M = (N+1)/2 ranks
+  int nread = (size + 1) / 2;
+  MPI_Comm read_mpi_comm;
+  MPI_Comm_split(MPI_COMM_WORLD, rank < nread ? 0 : MPI_UNDEFINED, rank, &read_mpi_comm);
+  if (read_mpi_comm != MPI_COMM_NULL) {
+    Epetra_MpiComm read_comm(read_mpi_comm);
+    std::vector<int> read_gids;
+    for (int gid=0; gid!=ncols; ++gid) {
+      if ((ncols - 1 - gid) % nread == read_comm.MyPID()) read_gids.push_back(gid);
+    }
+    Teuchos::RCP<State> S_read = columnState(read_gids);
+
+    Teuchos::ParameterList read_plist;
+    ATS::ColumnCheckpoint reader(read_plist, &read_comm);
+    CHECK_CLOSE(86400., reader.ReadInitialTime(filename), 1.e-10);
+    reader.Read(*S_read, filename);
+
+    CHECK_CLOSE(86400., S_read->time(), 1.e-10);
+    CHECK_EQUAL(7, S_read->cycle());
+    CHECK_CLOSE(101325., *S_read->GetScalarData("atmospheric_pressure"), 1.e-10);
+    for (int gid : read_gids) {
+      std::string domain = columnDomain(gid);
+      const Epetra_MultiVector& temp = *S_read->GetFieldData(Keys::getKey(domain, "temperature"))
+          ->ViewComponent("cell", false);
+      CHECK_EQUAL(ncells, temp.MyLength());
+      for (int c=0; c!=ncells; ++c) CHECK_CLOSE(columnValue(gid, c), temp[0][c], 1.e-10);
+      CHECK_CLOSE(0.01 * gid, *S_read->GetScalarData(Keys::getKey(domain, "snow_depth")), 1.e-10);
+    }
+    MPI_Comm_free(&read_mpi_comm);
+  }
+
+  comm.Barrier();
+  if (rank == 0) std::remove(filename.c_str());
+}
+
+
+// A column that is not in the file is an error, not silently left alone.
+TEST(COLUMN_CHECKPOINT_MISSING_COLUMN) {
+  Epetra_MpiComm comm(MPI_COMM_WORLD);
+  int rank = comm.MyPID();
+
+  std::vector<int> write_gids;
+  if (rank == 0) write_gids.push_back(0);
+  Teuchos::RCP<State> S_write = columnState(write_gids);
+  S_write->set_cycle(1);
+
+  Teuchos::ParameterList write_plist;
+  write_plist.set<std::string>("file name base", "column_checkpoint_missing_");
+  ATS::ColumnCheckpoint writer(write_plist, &comm);
+  writer.Write(*S_write, 1.);
+  std::string filename = "column_checkpoint_missing_00001.h5";
+
+  // every rank asks for a column that was never written
+  std::vector<int> read_gids(1, ncols + rank);
+  Teuchos::RCP<State> S_read = columnState(read_gids);
+  Teuchos::ParameterList read_plist;
+  ATS::ColumnCheckpoint reader(read_plist, &comm);
+  CHECK_THROW(reader.Read(*S_read, filename), Errors::Message);
+
+  comm.Barrier();
+  if (rank == 0) std::remove(filename.c_str());
+}
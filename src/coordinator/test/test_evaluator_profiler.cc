@@ -0,0 +1,180 @@
+/*
+  Testing of the evaluator profiler: counts on a two-evaluator graph, and the
+  table written when ranks have different evaluators.
+*/
+
+#include <sstream>
+#include <string>
+
+#include "UnitTest++.h"
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+#include "Epetra_MpiComm.h"
+
+#include "MeshFactory.hh"
+#include "State.hh"
+#include "primary_variable_field_evaluator.hh"
+#include "secondary_variable_field_evaluator.hh"
+
+#include "evaluator_profiler.hh"
+
+using namespace Amanzi;
+
+namespace {
+
+// b = 2 a
+class DoubleEvaluator : public SecondaryVariableFieldEvaluator {
+ public:
+  explicit
+  DoubleEvaluator(Teuchos::ParameterList& plist) :
+      SecondaryVariableFieldEvaluator(plist) {
+    dependencies_.insert("a");
+  }
+  DoubleEvaluator(const DoubleEvaluator& other) :
+      SecondaryVariableFieldEvaluator(other) {}
+
+  virtual Teuchos::RCP<FieldEvaluator> Clone() const {
+    return Teuchos::rcp(new DoubleEvaluator(*this));
+  }
+
+  virtual void EvaluateField_(const Teuchos::Ptr<State>& S,
+          const Teuchos::Ptr<CompositeVector>& result) {
+    result->Update(2., *S->GetFieldData("a"), 0.);
+  }
+  virtual void EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
+          Key wrt_key, const Teuchos::Ptr<CompositeVector>& result) {
+    result->PutScalar(2.);
+  }
+};
+
+Teuchos::ParameterList
+evaluatorList(const std::string& key)
+{
+  Teuchos::ParameterList plist(key);
+  plist.set("evaluator name", key);
+  return plist;
+}
+
+// A state on one local cell with a primary variable "a", b = 2 a, and
+// primary variables of the given extra keys.
+Teuchos::RCP<State>
+twoEvaluatorState(const std::vector<std::string>& extra)
+{
+  Epetra_MpiComm* comm_self = new Epetra_MpiComm(MPI_COMM_SELF);
+  Teuchos::ParameterList region_list;
+  Teuchos::RCP<AmanziGeometry::GeometricModel> gm =
+      Teuchos::rcp(new AmanziGeometry::GeometricModel(3, region_list, comm_self));
+  AmanziMesh::MeshFactory meshfactory(comm_self);
+  AmanziMesh::FrameworkPreference pref;
+  pref.push_back(AmanziMesh::MSTK);
+  meshfactory.preference(pref);
+  Teuchos::RCP<AmanziMesh::Mesh> mesh = meshfactory(0.,0.,0., 1.,1.,1., 1,1,1, gm);
+
+  Teuchos::ParameterList state_list;
+  Teuchos::RCP<State> S = Teuchos::rcp(new State(state_list));
+  S->RegisterDomainMesh(mesh);
+
+  std::vector<std::string> primaries(extra);
+  primaries.push_back("a");
+  for (const auto& key : primaries) {
+    S->RequireField(key, "test")->SetMesh(mesh)->SetGhosted()
+        ->AddComponent("cell", AmanziMesh::CELL, 1);
+    Teuchos::ParameterList plist = evaluatorList(key);
+    S->SetFieldEvaluator(key, Teuchos::rcp(new PrimaryVariableFieldEvaluator(plist)));
+  }
+  S->RequireField("b", "b")->SetMesh(mesh)->SetGhosted()
+      ->AddComponent("cell", AmanziMesh::CELL, 1);
+  Teuchos::ParameterList b_list = evaluatorList("b");
+  S->SetFieldEvaluator("b", Teuchos::rcp(new DoubleEvaluator(b_list)));
+  S->Setup();
+
+  for (const auto& key : primaries) {
+    S->GetFieldData(key, "test")->PutScalar(1.);
+    S->GetField(key, "test")->set_initialized();
+  }
+  S->GetField("b", "b")->set_initialized();
+  return S;
+}
+
+// The calls and updates of an evaluator in the written table, -1 if absent.
+void
+tableCounts(const std::string& table, const std::string& name,
+            long long& calls, long long& updates)
+{
+  calls = -1;
+  updates = -1;
+  std::stringstream lines(table);
+  std::string line;
+  while (std::getline(lines, line)) {
+    std::stringstream tokens(line);
+    std::string first;
+    tokens >> first;
+    if (first == name) tokens >> calls >> updates;
+  }
+}
+
+} // namespace
+
+
+TEST(EVALUATOR_PROFILER_TWO_EVALUATORS) {
+  Epetra_MpiComm comm(MPI_COMM_WORLD);
+  Teuchos::RCP<State> S = twoEvaluatorState(std::vector<std::string>());
+
+  Teuchos::ParameterList plist;
+  plist.set<std::string>("profile evaluators graph filename", "evaluator_profile_test.dot");
+  ATS::EvaluatorProfiler profiler(plist);
+  profiler.Install(S.ptr());
+
+  // first request: b computes from a, whose first answer to b is not an update
+  CHECK(S->GetFieldEvaluator("b")->HasFieldChanged(S.ptr(), "test"));
+  // nothing changed
+  CHECK(!S->GetFieldEvaluator("b")->HasFieldChanged(S.ptr(), "test"));
+  // a changes, and b recomputes
+  Teuchos::RCP<PrimaryVariableFieldEvaluator> a_eval =
+      Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>(S->GetFieldEvaluator("a"));
+  CHECK(a_eval != Teuchos::null);
+  a_eval->SetFieldAsChanged(S.ptr());
+  CHECK(S->GetFieldEvaluator("b")->HasFieldChanged(S.ptr(), "test"));
+  CHECK_CLOSE(2., (*S->GetFieldData("b")->ViewComponent("cell",false))[0][0], 1.e-12);
+
+  std::stringstream table;
+  profiler.Write(table, comm);
+  if (comm.MyPID() == 0) {
+    long long calls, updates;
+    tableCounts(table.str(), "a", calls, updates);
+    CHECK_EQUAL(3, calls);
+    CHECK_EQUAL(1, updates);
+    tableCounts(table.str(), "b", calls, updates);
+    CHECK_EQUAL(3, calls);
+    CHECK_EQUAL(2, updates);
+  }
+}
+
+
+// Ranks with different evaluators, as with one state per column: the table
+// covers all of them, and no rank waits on the others.
+TEST(EVALUATOR_PROFILER_DIFFERENT_EVALUATORS_PER_RANK) {
+  Epetra_MpiComm comm(MPI_COMM_WORLD);
+  std::vector<std::string> extra;
+  if (comm.MyPID() == comm.NumProc() - 1) extra.push_back("c");
+  Teuchos::RCP<State> S = twoEvaluatorState(extra);
+
+  Teuchos::ParameterList plist;
+  plist.set<std::string>("profile evaluators graph filename", "evaluator_profile_test.dot");
+  ATS::EvaluatorProfiler profiler(plist);
+  profiler.Install(S.ptr());
+
+  CHECK(S->GetFieldEvaluator("b")->HasFieldChanged(S.ptr(), "test"));
+  if (!extra.empty()) S->GetFieldEvaluator("c")->HasFieldChanged(S.ptr(), "test");
+
+  std::stringstream table;
+  profiler.Write(table, comm);
+  if (comm.MyPID() == 0) {
+    long long calls, updates;
+    tableCounts(table.str(), "b", calls, updates);
+    CHECK_EQUAL(1, calls);
+    tableCounts(table.str(), "c", calls, updates);
+    CHECK_EQUAL(1, calls);
+  }
+}
@@ -0,0 +1,61 @@
+/*
+  Testing of the rounding of single precision visualization.
+*/
+
+#include <cmath>
+#include <limits>
+
+#include "UnitTest++.h"
+
+#include "single_precision_vis.hh"
+
+using ATS::SinglePrecisionVis;
+
+// Rounding to 10 bits is to the nearest multiple of 2^-10 in [1,2), with
+// ties away from zero.
+TEST(SINGLE_PRECISION_VIS_ROUND_HALFWAY) {
+  double ulp = std::ldexp(1., -10);
+  double half = std::ldexp(1., -11);
+  double eps = std::ldexp(1., -20);
+
+  CHECK_EQUAL(1.f, SinglePrecisionVis::Round(1. + half - eps, 10));
+  CHECK_EQUAL(static_cast<float>(1. + ulp), SinglePrecisionVis::Round(1. + half, 10));
+  CHECK_EQUAL(static_cast<float>(1. + ulp), SinglePrecisionVis::Round(1. + half + eps, 10));
+  CHECK_EQUAL(static_cast<float>(1. + ulp), SinglePrecisionVis::Round(1. + ulp + half - eps, 10));
+  CHECK_EQUAL(static_cast<float>(1. + 2*ulp), SinglePrecisionVis::Round(1. + ulp + half, 10));
+
+  // the same magnitudes when negative
+  CHECK_EQUAL(-1.f, SinglePrecisionVis::Round(-(1. + half - eps), 10));
+  CHECK_EQUAL(static_cast<float>(-(1. + ulp)), SinglePrecisionVis::Round(-(1. + half), 10));
+}
+
+// Rounding up a mantissa of all ones carries into the exponent.
+TEST(SINGLE_PRECISION_VIS_ROUND_CARRY) {
+  CHECK_EQUAL(2.f, SinglePrecisionVis::Round(2. - std::ldexp(1., -23), 10));
+  CHECK_EQUAL(2.f, SinglePrecisionVis::Round(2. - std::ldexp(1., -12), 10));
+  CHECK_EQUAL(-4.f, SinglePrecisionVis::Round(-(4. - std::ldexp(1., -13)), 10));
+
+  // and past the largest float, to infinity
+  float max = std::numeric_limits<float>::max();
+  CHECK_EQUAL(std::numeric_limits<float>::infinity(), SinglePrecisionVis::Round(max, 10));
+}
+
+// All 23 bits is the plain conversion to float.
+TEST(SINGLE_PRECISION_VIS_ROUND_ALL_BITS) {
+  double one_ulp = 1. + std::ldexp(1., -23);
+  CHECK_EQUAL(static_cast<float>(one_ulp), SinglePrecisionVis::Round(one_ulp, 23));
+  CHECK(SinglePrecisionVis::Round(one_ulp, 23) > 1.f);
+  CHECK_EQUAL(static_cast<float>(1./3.), SinglePrecisionVis::Round(1./3., 23));
+  CHECK_EQUAL(static_cast<float>(-1.e-30), SinglePrecisionVis::Round(-1.e-30, 23));
+}
+
+// Infinities and NaN pass through, as do doubles too large for a float.
+TEST(SINGLE_PRECISION_VIS_ROUND_NONFINITE) {
+  float inf = std::numeric_limits<float>::infinity();
+  double dinf = std::numeric_limits<double>::infinity();
+  CHECK_EQUAL(inf, SinglePrecisionVis::Round(dinf, 10));
+  CHECK_EQUAL(-inf, SinglePrecisionVis::Round(-dinf, 10));
+  CHECK_EQUAL(inf, SinglePrecisionVis::Round(1.e300, 10));
+  CHECK(std::isnan(SinglePrecisionVis::Round(std::numeric_limits<double>::quiet_NaN(), 10)));
+  CHECK(std::isnan(SinglePrecisionVis::Round(std::numeric_limits<double>::quiet_NaN(), 23)));
+}
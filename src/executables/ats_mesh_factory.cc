@@ -67,6 +67,7 @@ createMesh(Teuchos::ParameterList& mesh_plist,
       Errors::Message msg("\"read mesh file\" parameter \"format\" missing.");
       Exceptions::amanzi_throw(msg);
     }
+    bool column_partition = setPartitioner(mesh_plist, factory);
     auto mesh = factory.create(file, gm);
 
     if (mesh_plist.isParameter("build columns from set")) {
@@ -77,6 +78,7 @@ createMesh(Teuchos::ParameterList& mesh_plist,
     bool deformable = mesh_plist.get<bool>("deformable mesh",false);
 
     checkVerifyMesh(mesh_plist, mesh);
+    if (column_partition) checkColumnPartition(mesh_plist, mesh);
     S.RegisterMesh(Amanzi::Keys::cleanPListName(mesh_plist.name()), mesh, deformable);
     
   } else if (mesh_type == "generate mesh") {
@@ -87,10 +89,12 @@ createMesh(Teuchos::ParameterList& mesh_plist,
     prefs.push_back(Amanzi::AmanziMesh::MSTK);
 
     // generated mesh
+    bool column_partition = setPartitioner(mesh_plist, factory);
     auto mesh = factory.create(mesh_plist.sublist("generate mesh parameters"), gm);
     bool deformable = mesh_plist.get<bool>("deformable mesh",false);
 
     checkVerifyMesh(mesh_plist, mesh);
+    if (column_partition) checkColumnPartition(mesh_plist, mesh);
     S.RegisterMesh(Amanzi::Keys::cleanPListName(mesh_plist.name()), mesh, deformable);
 
   } else if (mesh_type == "logical mesh") {
@@ -281,6 +285,74 @@ bool checkVerifyMesh(Teuchos::ParameterList& mesh_plist,
 }
 
 
+bool
+setPartitioner(Teuchos::ParameterList& mesh_plist,
+               Amanzi::AmanziMesh::MeshFactory& factory)
+{
+  if (!mesh_plist.isParameter("partitioner")) return false;
+
+  auto partitioner = mesh_plist.get<std::string>("partitioner");
+  if (partitioner == "metis") {
+    factory.set_partitioner(Amanzi::AmanziMesh::METIS);
+  } else if (partitioner == "zoltan_graph") {
+    factory.set_partitioner(Amanzi::AmanziMesh::ZOLTAN_GRAPH);
+  } else if (partitioner == "zoltan_rcb" || partitioner == "columns") {
+    // MSTK partitions with RCB on the cell centroids projected onto the x-y
+    // plane ("map view"), so every cell of a column lands on the same rank.
+    factory.set_partitioner(Amanzi::AmanziMesh::ZOLTAN_RCB);
+  } else {
+    Errors::Message msg;
+    msg << "ATS Mesh Factory: unknown \"partitioner\" parameter \"" << partitioner
+        << "\" in mesh \"" << Amanzi::Keys::cleanPListName(mesh_plist.name())
+        << "\": valid partitioners are \"metis\", \"zoltan_graph\", \"zoltan_rcb\", and \"columns\".";
+    Exceptions::amanzi_throw(msg);
+  }
+  return partitioner == "columns";
+}
+
+
+void
+checkColumnPartition(Teuchos::ParameterList& mesh_plist,
+                     Teuchos::RCP<Amanzi::AmanziMesh::Mesh> mesh)
+{
+  ASSERT(!mesh.is_null());
+  if (!mesh_plist.isParameter("build columns from set")) mesh->build_columns();
+
+  // An owned column is split if any of its cells is a ghost.  This happens
+  // for pre-partitioned (.par) files, or meshes that are not extruded.
+  int ncells_owned = mesh->num_entities(Amanzi::AmanziMesh::CELL, Amanzi::AmanziMesh::OWNED);
+  int ncols = mesh->num_columns(false);
+  int nsplit = 0;
+  for (int col=0; col!=ncols; ++col) {
+    for (auto c : mesh->cells_of_column(col)) {
+      if (c >= ncells_owned) {
+        nsplit++;
+        break;
+      }
+    }
+  }
+
+  int nfaces_ghost = mesh->num_entities(Amanzi::AmanziMesh::FACE, Amanzi::AmanziMesh::USED)
+      - mesh->num_entities(Amanzi::AmanziMesh::FACE, Amanzi::AmanziMesh::OWNED);
+
+  int local[3] = { ncols, nsplit, nfaces_ghost };
+  int global[3] = { 0, 0, 0 };
+  mesh->get_comm()->SumAll(local, global, 3);
+  if (mesh->get_comm()->MyPID() == 0)
+    std::cout << "Column partition of mesh \"" << Amanzi::Keys::cleanPListName(mesh_plist.name())
+              << "\": " << global[0] << " columns, " << global[1] << " split across ranks, "
+              << global[2] << " ghost faces" << std::endl;
+
+  if (global[1] > 0) {
+    Errors::Message msg;
+    msg << "ATS Mesh Factory: \"partitioner\" \"columns\" requested for mesh \""
+        << Amanzi::Keys::cleanPListName(mesh_plist.name()) << "\", but " << global[1]
+        << " columns are split across ranks.";
+    Exceptions::amanzi_throw(msg);
+  }
+}
+
+
 void
 createMeshes(Teuchos::ParameterList& global_list,
              const Teuchos::RCP<Epetra_MpiComm>& comm,
@@ -311,6 +383,18 @@ createMeshes(Teuchos::ParameterList& global_list,
     }
   }
 
+  expandMeshLists(global_list, comm, S);
+
+  Teuchos::TimeMonitor::summarize();
+  Teuchos::TimeMonitor::zeroOutTimers();
+}
+
+
+void
+expandMeshLists(Teuchos::ParameterList& global_list,
+                const Teuchos::RCP<Epetra_MpiComm>& comm,
+                Amanzi::State& S)
+{
   // FIXME --etc
   // this should be dealt with somewhere else, and more generally
   // generalize vis for columns
@@ -344,12 +428,16 @@ createMeshes(Teuchos::ParameterList& global_list,
     global_list.remove("visualization surface cells");
   }
 
-  int rank;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  int rank = comm->MyPID();
 
   //generalize checkpoint files for columns
   if(global_list.isSublist("checkpoints") && global_list.sublist("mesh").isSublist("column")){
   Teuchos::ParameterList& checkpoint_plist = global_list.sublist("checkpoints");
+  if (checkpoint_plist.get<bool>("aggregate column files", false)) {
+    // all columns go into a single file, see ColumnCheckpoint
+    global_list.set("checkpoint", checkpoint_plist);
+    global_list.remove("checkpoints");
+  } else {
     std::stringstream name_check;
     name_check << rank;
     if (global_list.isSublist("checkpoints"))
@@ -358,13 +446,8 @@ createMeshes(Teuchos::ParameterList& global_list,
       checkpoint_plist.set("file name base", "checkpoint");
     global_list.set("checkpoint " +name_check.str(), checkpoint_plist);
     global_list.remove("checkpoints");
-        
   }
-  
-  
-  Teuchos::TimeMonitor::summarize();
-  Teuchos::TimeMonitor::zeroOutTimers();
-  
-
+  }
 }
+
 } // namespace ATS
@@ -33,6 +33,16 @@ through providing a "verify mesh" option.
 
 * `"verify mesh`" ``[bool]`` **false** Perform a mesh audit.
 * `"deformable mesh`" ``[bool]`` **false** Will this mesh be deformed?
+* `"partitioner`" ``[string]`` Partitioner used to distribute a read or
+  generated mesh in parallel, one of `"metis`", `"zoltan_graph`",
+  `"zoltan_rcb`", or `"columns`".  The default is that of the mesh framework.
+  `"zoltan_rcb`" partitions the surface (map view) projection of the mesh,
+  and so never splits a column of an extruded mesh across ranks.
+  `"columns`" is this partitioner, followed by a check that every column is
+  owned by a single rank (using `"build columns from set`" if provided) and a
+  report of the number of ghost faces.  Use this for meshes with a surface
+  mesh, column or subgrid meshes, or column-based PKs, so that the surface
+  and subsurface partitions agree and vertical adjacency is rank-local.
 
 All mesh specs take a general form:
 
@@ -240,6 +250,7 @@ Example:
 #define ATS_MESH_FACTORY_HH_
 
 #include "Teuchos_ParameterList.hpp"
+#include "MeshFactory.hh"
 #include "State.hh"
 
 
@@ -249,6 +260,14 @@ bool
 checkVerifyMesh(Teuchos::ParameterList& mesh_plist,
                 Teuchos::RCP<Amanzi::AmanziMesh::Mesh> mesh);
 
+bool
+setPartitioner(Teuchos::ParameterList& mesh_plist,
+               Amanzi::AmanziMesh::MeshFactory& factory);
+
+void
+checkColumnPartition(Teuchos::ParameterList& mesh_plist,
+                     Teuchos::RCP<Amanzi::AmanziMesh::Mesh> mesh);
+
 void
 createMesh(Teuchos::ParameterList& plist,
            const Teuchos::RCP<Epetra_MpiComm>& comm,
@@ -262,6 +281,13 @@ createMeshes(Teuchos::ParameterList& plist,
              const Teuchos::RCP<Amanzi::AmanziGeometry::GeometricModel>& gm,
              Amanzi::State& s);
 
+// Expand the vis and checkpoint lists that depend upon the meshes in s, which
+// createMeshes() does after creating them.  Needed when s is given meshes
+// created for another State.
+void
+expandMeshLists(Teuchos::ParameterList& plist,
+                const Teuchos::RCP<Epetra_MpiComm>& comm,
+                Amanzi::State& s);
 
 } // namespace ATS
 
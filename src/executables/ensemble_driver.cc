@@ -0,0 +1,195 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! EnsembleDriver: many parameter sets of one input deck in a single process.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: ATS developers
+*/
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "boost/algorithm/string/predicate.hpp"
+
+#include "Epetra_MpiComm.h"
+#include "Teuchos_ParameterList.hpp"
+
+#include "errors.hh"
+#include "exceptions.hh"
+
+#include "GeometricModel.hh"
+#include "State.hh"
+#include "coordinator.hh"
+
+#include "ats_mesh_factory.hh"
+#include "ensemble_driver.hh"
+
+namespace ATS {
+
+Teuchos::ParameterList
+ensembleMemberList(const Teuchos::ParameterList& plist,
+                   const std::string& member_name)
+{
+  const Teuchos::ParameterList& members = plist.sublist("ensemble").sublist("members");
+  if (!members.isSublist(member_name)) {
+    Errors::Message msg;
+    msg << "Ensemble: no member \"" << member_name << "\".";
+    Exceptions::amanzi_throw(msg);
+  }
+
+  Teuchos::ParameterList member_plist(plist);
+  member_plist.remove("ensemble");
+
+  const Teuchos::ParameterList& member = members.sublist(member_name);
+  if (member.isSublist("parameters")) {
+    member_plist.setParameters(member.sublist("parameters"));
+  }
+  return member_plist;
+}
+
+
+void
+prefixOutputFilenames(Teuchos::ParameterList& plist,
+                      const std::string& prefix)
+{
+  // the Coordinator always writes a final checkpoint, even without a list
+  bool checkpoint = false;
+  for (auto& entry : plist) {
+    if (boost::starts_with(entry.first, "checkpoint")) checkpoint = true;
+  }
+  if (!checkpoint) plist.sublist("checkpoint");
+
+  for (auto& entry : plist) {
+    const std::string& name = entry.first;
+    if (!plist.isSublist(name)) continue;
+    Teuchos::ParameterList& sublist = plist.sublist(name);
+
+    if (name == "visualization") {
+      // one list per domain, or per domain set, which the Coordinator
+      // suffixes with the name of each subdomain
+      for (auto& domain : sublist) {
+        if (!sublist.isSublist(domain.first)) continue;
+        Teuchos::ParameterList& vis_list = sublist.sublist(domain.first);
+        std::string base;
+        if (boost::ends_with(domain.first, "_*")) {
+          base = "visdump";
+        } else if (domain.first == "domain") {
+          base = "visdump_data";
+        } else {
+          base = "visdump_" + domain.first + "_data";
+        }
+        vis_list.set("file name base", prefix + vis_list.get<std::string>("file name base", base));
+      }
+
+    } else if (boost::starts_with(name, "visualization ")) {
+      std::string base = "visdump_" + name.substr(std::string("visualization ").size()) + "_data";
+      sublist.set("file name base", prefix + sublist.get<std::string>("file name base", base));
+
+    } else if (boost::starts_with(name, "checkpoint")) {
+      sublist.set("file name base", prefix + sublist.get<std::string>("file name base", "checkpoint"));
+
+    } else if (name == "observations") {
+      for (auto& obs : sublist) {
+        if (!sublist.isSublist(obs.first)) continue;
+        Teuchos::ParameterList& obs_list = sublist.sublist(obs.first);
+        if (obs_list.isParameter("observation output filename")) {
+          obs_list.set("observation output filename",
+                       prefix + obs_list.get<std::string>("observation output filename"));
+        }
+      }
+    }
+  }
+}
+
+
+int
+runEnsemble(const MPI_Comm& mpi_comm, Teuchos::ParameterList& plist)
+{
+  Teuchos::ParameterList& ensemble_list = plist.sublist("ensemble");
+
+  // split the ranks into groups, one member at a time per group
+  int rank, size;
+  MPI_Comm_rank(mpi_comm, &rank);
+  MPI_Comm_size(mpi_comm, &size);
+  int ranks_per_member = ensemble_list.get<int>("ranks per member", 1);
+  if (ranks_per_member < 1 || size % ranks_per_member != 0) {
+    Errors::Message msg;
+    msg << "Ensemble: \"ranks per member\" (" << ranks_per_member
+        << ") must divide the number of ranks (" << size << ").";
+    Exceptions::amanzi_throw(msg);
+  }
+  int ngroups = size / ranks_per_member;
+  int group = rank / ranks_per_member;
+
+  std::vector<std::string> members;
+  Teuchos::ParameterList& members_list = ensemble_list.sublist("members");
+  for (auto& entry : members_list) {
+    if (members_list.isSublist(entry.first)) members.push_back(entry.first);
+  }
+  if (members.size() == 0) {
+    Errors::Message msg("Ensemble: \"members\" list is empty.");
+    Exceptions::amanzi_throw(msg);
+  }
+
+  MPI_Comm group_comm;
+  MPI_Comm_split(mpi_comm, group, rank, &group_comm);
+
+  {
+    Teuchos::RCP<Epetra_MpiComm> comm = Teuchos::rcp(new Epetra_MpiComm(group_comm));
+
+    // Meshes of the last member, reused by the next one if it has the same
+    // regions and meshes and none are deformed.
+    Teuchos::RCP<Amanzi::AmanziGeometry::GeometricModel> gm;
+    Teuchos::ParameterList regions_list, meshes_list;
+    std::vector<std::tuple<Amanzi::Key, Teuchos::RCP<Amanzi::AmanziMesh::Mesh>, bool> > meshes;
+    bool shareable = false;
+
+    int nmembers = members.size();
+    for (int m=group; m<nmembers; m+=ngroups) {
+      Teuchos::ParameterList member_plist = ensembleMemberList(plist, members[m]);
+      std::string prefix = members_list.sublist(members[m]).get<std::string>("output prefix",
+              members[m] + "_");
+
+      Teuchos::ParameterList state_plist = member_plist.sublist("state");
+      Teuchos::RCP<Amanzi::State> S = Teuchos::rcp(new Amanzi::State(state_plist));
+
+      if (shareable &&
+          member_plist.sublist("regions") == regions_list &&
+          member_plist.sublist("mesh") == meshes_list) {
+        for (const auto& mesh : meshes) {
+          S->RegisterMesh(std::get<0>(mesh), std::get<1>(mesh), std::get<2>(mesh));
+        }
+        expandMeshLists(member_plist, comm, *S);
+
+      } else {
+        regions_list = member_plist.sublist("regions");
+        meshes_list = member_plist.sublist("mesh");
+        Teuchos::ParameterList reg_params(regions_list);
+        gm = Teuchos::rcp(new Amanzi::AmanziGeometry::GeometricModel(3, reg_params, comm.get()));
+        createMeshes(member_plist, comm, gm, *S);
+
+        meshes.clear();
+        shareable = true;
+        for (Amanzi::State::mesh_iterator mesh=S->mesh_begin(); mesh!=S->mesh_end(); ++mesh) {
+          bool deformable = S->IsDeformableMesh(mesh->first);
+          meshes.push_back(std::make_tuple(mesh->first, mesh->second.first, deformable));
+          shareable &= !deformable;
+        }
+      }
+
+      prefixOutputFilenames(member_plist, prefix);
+
+      Coordinator coordinator(member_plist, S, comm.get());
+      coordinator.cycle_driver();
+    }
+  }
+
+  MPI_Comm_free(&group_comm);
+  return 0;
+}
+
+} // namespace ATS
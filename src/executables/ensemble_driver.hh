@@ -0,0 +1,108 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! EnsembleDriver: many parameter sets of one input deck in a single process.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: ATS developers
+*/
+
+/*!
+
+Uncertainty quantification and calibration run the same input deck many
+times, differing only in a few parameters.  Rather than launching a job per
+member, an `"ensemble`" list in the input file runs all members from one
+process.
+
+MPI_COMM_WORLD is split into groups of `"ranks per member`" ranks, and the
+members are dealt round-robin to the groups.  Each group runs its members one
+after another.  The regions and meshes are created once per group and shared
+by all of its members, unless a mesh is deformable, in which case each member
+gets its own.  Each member otherwise gets its own State, PKs, evaluators,
+timestep control and output.
+
+A member's input is the input deck, less the `"ensemble`" list, with the
+member's `"parameters`" merged over it: parameters in the member list replace
+those of the same name in the deck, recursively through sublists, and new ones
+are added.  Output file names (visualization, checkpoint and observation
+files) are prefixed with the member's `"output prefix`".
+
+* `"ensemble`" ``[list]``
+
+  * `"ranks per member`" ``[int]`` **1** Number of MPI ranks that run each
+    member.  Must divide the number of ranks.
+
+  * `"members`" ``[list]`` One sublist per member.
+
+    * `"MEMBER_NAME`" ``[list]``
+
+      * `"output prefix`" ``[string]`` **MEMBER_NAME_** Prefix of all output
+        file names of the member.
+
+      * `"parameters`" ``[list]`` Input deck entries that differ from the
+        deck.
+
+Example:
+
+.. code-block:: xml
+
+  <ParameterList name="ensemble">
+    <Parameter name="ranks per member" type="int" value="1"/>
+    <ParameterList name="members">
+      <ParameterList name="k_low">
+        <ParameterList name="parameters">
+          <ParameterList name="state">
+            <ParameterList name="field evaluators">
+              <ParameterList name="permeability">
+                <ParameterList name="function">
+                  <ParameterList name="domain">
+                    <ParameterList name="function">
+                      <ParameterList name="function-constant">
+                        <Parameter name="value" type="double" value="1.e-13"/>
+                      </ParameterList>
+                    </ParameterList>
+                  </ParameterList>
+                </ParameterList>
+              </ParameterList>
+            </ParameterList>
+          </ParameterList>
+        </ParameterList>
+      </ParameterList>
+      <ParameterList name="k_high">
+        ...
+      </ParameterList>
+    </ParameterList>
+  </ParameterList>
+
+*/
+
+#ifndef ATS_ENSEMBLE_DRIVER_HH_
+#define ATS_ENSEMBLE_DRIVER_HH_
+
+#include "mpi.h"
+
+#include "Teuchos_ParameterList.hpp"
+
+namespace ATS {
+
+// The input deck of a member: plist, less the ensemble list, with the
+// member's parameters merged over it.
+Teuchos::ParameterList
+ensembleMemberList(const Teuchos::ParameterList& plist,
+                   const std::string& member_name);
+
+// Prefix the vis, checkpoint and observation file names of plist.  Must
+// follow expandMeshLists(), which names the per-column files.
+void
+prefixOutputFilenames(Teuchos::ParameterList& plist,
+                      const std::string& prefix);
+
+// Run all members of plist's ensemble.
+int
+runEnsemble(const MPI_Comm& mpi_comm, Teuchos::ParameterList& plist);
+
+} // namespace ATS
+
+#endif
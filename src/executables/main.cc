@@ -1,4 +1,5 @@
 #include <iostream>
+#include <mpi.h>
 
 #include <Epetra_Comm.h>
 #include <Epetra_MpiComm.h>
@@ -70,6 +71,29 @@
 
 Teuchos::EVerbosityLevel Amanzi::VerbosityLevel::level_ = Teuchos::VERB_MEDIUM;
 
+
+// Does the input file ask for asynchronous output?  This is read before MPI
+// is initialized, and so must not use it.  Errors in the file are left to be
+// reported when it is read for the run.
+bool asyncOutputRequested(int argc, char *argv[])
+{
+  std::string xmlInFileName = "options.xml";
+  const std::string option = "--xml_file=";
+  for (int i=1; i<argc; ++i) {
+    std::string arg(argv[i]);
+    if (arg.compare(0, option.size(), option) == 0) xmlInFileName = arg.substr(option.size());
+  }
+
+  try {
+    Teuchos::RCP<Teuchos::ParameterList> plist =
+        Teuchos::getParametersFromXmlFile(xmlInFileName);
+    return plist->isSublist("cycle driver") &&
+        plist->sublist("cycle driver").get<bool>("asynchronous output", false);
+  } catch (...) {
+    return false;
+  }
+}
+
 int main(int argc, char *argv[])
 {
 
@@ -78,6 +102,13 @@ int main(int argc, char *argv[])
   feraiseexcept(FE_DIVBYZERO | FE_INVALID | FE_OVERFLOW);
 #endif
 
+  // asynchronous output writes from a second thread, so ask for full thread
+  // support only if it is on; the session finds MPI already initialized and
+  // finalizes it
+  int mpi_thread_required = asyncOutputRequested(argc, argv) ?
+      MPI_THREAD_MULTIPLE : MPI_THREAD_SINGLE;
+  int mpi_thread_provided;
+  MPI_Init_thread(&argc, &argv, mpi_thread_required, &mpi_thread_provided);
   Teuchos::GlobalMPISession mpiSession(&argc,&argv,0);
 
   Teuchos::CommandLineProcessor CLP;
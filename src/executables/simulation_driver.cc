@@ -27,6 +27,7 @@ Author: Ethan Coon (ecoon@lanl.gov)
 #include "exceptions.hh"
 
 #include "ats_mesh_factory.hh"
+#include "ensemble_driver.hh"
 #include "simulation_driver.hh"
 
 
@@ -55,6 +56,11 @@ int SimulationDriver::Run(
       std::endl;
   }
 
+  // many members of one deck, see EnsembleDriver
+  if (plist.isSublist("ensemble")) {
+    return ATS::runEnsemble(mpi_comm, plist);
+  }
+
   // create the geometric model and regions
   Teuchos::ParameterList reg_params = plist.sublist("regions");
   Teuchos::RCP<Amanzi::AmanziGeometry::GeometricModel> gm =
@@ -0,0 +1,15 @@
+#include <UnitTest++.h>
+#include <TestReporterStdout.h>
+#include <mpi.h>
+#include "Teuchos_GlobalMPISession.hpp"
+
+#include "VerboseObject_objs.hh"
+
+int main(int argc, char *argv[])
+{
+  // as in ats, so that asynchronous output may use a thread
+  int provided;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+  Teuchos::GlobalMPISession mpiSession(&argc,&argv,0);
+  return UnitTest::RunAllTests ();
+}
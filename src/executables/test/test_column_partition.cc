@@ -0,0 +1,61 @@
+/*
+  Testing of the "columns" partitioner: no column of a generated, extruded
+  mesh is split across ranks.
+*/
+
+#include <string>
+
+#include "UnitTest++.h"
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+#include "Teuchos_Array.hpp"
+#include "Epetra_MpiComm.h"
+
+#include "GeometricModel.hh"
+#include "State.hh"
+
+#include "ats_mesh_factory.hh"
+
+using namespace Amanzi;
+
+TEST(COLUMN_PARTITION_NO_SPLIT_COLUMNS) {
+  Teuchos::RCP<Epetra_MpiComm> comm = Teuchos::rcp(new Epetra_MpiComm(MPI_COMM_WORLD));
+  Teuchos::ParameterList region_list;
+  Teuchos::RCP<AmanziGeometry::GeometricModel> gm =
+      Teuchos::rcp(new AmanziGeometry::GeometricModel(3, region_list, comm.get()));
+
+  // 4x4 columns of 3 cells
+  Teuchos::ParameterList mesh_list("domain");
+  mesh_list.set<std::string>("mesh type", "generate mesh");
+  mesh_list.set<std::string>("partitioner", "columns");
+  Teuchos::ParameterList& gen_list = mesh_list.sublist("generate mesh parameters");
+  gen_list.set("number of cells", Teuchos::Array<int>(Teuchos::tuple(4, 4, 3)));
+  gen_list.set("domain low coordinate", Teuchos::Array<double>(Teuchos::tuple(0., 0., 0.)));
+  gen_list.set("domain high coordinate", Teuchos::Array<double>(Teuchos::tuple(1., 1., 1.)));
+
+  Teuchos::ParameterList state_list;
+  State S(state_list);
+  ATS::createMesh(mesh_list, comm, gm, S);
+  Teuchos::RCP<const AmanziMesh::Mesh> mesh = S.GetMesh("domain");
+
+  // every owned column, and so every column, has only owned cells
+  int ncells_owned = mesh->num_entities(AmanziMesh::CELL, AmanziMesh::OWNED);
+  int ncols = mesh->num_columns(false);
+  int nsplit = 0;
+  for (int col=0; col!=ncols; ++col) {
+    for (auto c : mesh->cells_of_column(col)) {
+      if (c >= ncells_owned) {
+        nsplit++;
+        break;
+      }
+    }
+  }
+
+  int local[2] = { ncols, nsplit };
+  int global[2] = { 0, 0 };
+  comm->SumAll(local, global, 2);
+  CHECK_EQUAL(16, global[0]);
+  CHECK_EQUAL(0, global[1]);
+  CHECK_EQUAL(3 * ncols, ncells_owned);
+}
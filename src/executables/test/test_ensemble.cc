@@ -0,0 +1,148 @@
+/*
+  Testing of ensembles: each member of an ensemble must give the same results
+  as its input deck run alone.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+
+#include "UnitTest++.h"
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+#include "Teuchos_XMLParameterListHelpers.hpp"
+#include "Epetra_MpiComm.h"
+
+#include "GeometricModel.hh"
+#include "State.hh"
+#include "coordinator.hh"
+
+#include "ats_mesh_factory.hh"
+#include "ensemble_driver.hh"
+
+#include "state_evaluators_registration.hh"
+#include "constitutive_relations_eos_registration.hh"
+#include "constitutive_relations_generic_evaluators_registration.hh"
+#include "flow_relations_registration.hh"
+#include "flow_richards_registration.hh"
+
+using namespace Amanzi;
+
+namespace {
+
+// The numbers in an observation file, in order.  Headers are skipped.
+std::vector<double>
+observedValues(const std::string& filename)
+{
+  std::vector<double> values;
+  std::ifstream file(filename.c_str());
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::stringstream tokens(line);
+    std::string token;
+    while (tokens >> token) {
+      char* end;
+      double value = std::strtod(token.c_str(), &end);
+      if (end != token.c_str() && *end == '\0') values.push_back(value);
+    }
+  }
+  return values;
+}
+
+// Is there a file in the working directory starting with this prefix?
+bool
+hasFileWithPrefix(const std::string& prefix)
+{
+  bool found = false;
+  DIR* dir = opendir(".");
+  if (dir == NULL) return false;
+  for (struct dirent* entry = readdir(dir); entry != NULL; entry = readdir(dir)) {
+    if (std::string(entry->d_name).compare(0, prefix.size(), prefix) == 0) found = true;
+  }
+  closedir(dir);
+  return found;
+}
+
+// Run one member's deck alone, as the ats executable does.
+void
+runAlone(Teuchos::ParameterList& plist, const std::string& prefix)
+{
+  Teuchos::RCP<Epetra_MpiComm> comm = Teuchos::rcp(new Epetra_MpiComm(MPI_COMM_WORLD));
+  Teuchos::ParameterList reg_params = plist.sublist("regions");
+  Teuchos::RCP<AmanziGeometry::GeometricModel> gm =
+      Teuchos::rcp(new AmanziGeometry::GeometricModel(3, reg_params, comm.get()));
+  Teuchos::ParameterList state_plist = plist.sublist("state");
+  Teuchos::RCP<State> S = Teuchos::rcp(new State(state_plist));
+  ATS::createMeshes(plist, comm, gm, *S);
+  ATS::prefixOutputFilenames(plist, prefix);
+
+  ATS::Coordinator coordinator(plist, S, comm.get());
+  coordinator.cycle_driver();
+}
+
+} // namespace
+
+
+// Infiltration into a column, for two permeabilities.  Both members share
+// one mesh in the ensemble, and each must match the same deck run alone.
+TEST(ENSEMBLE_MEMBERS_MATCH_SEPARATE_RUNS) {
+  Epetra_MpiComm comm(MPI_COMM_WORLD);
+  Teuchos::RCP<Teuchos::ParameterList> plist =
+      Teuchos::getParametersFromXmlFile("test/ensemble_column.xml");
+
+  std::vector<std::string> members;
+  members.push_back("k_low");
+  members.push_back("k_high");
+
+  Teuchos::ParameterList ensemble_plist(*plist);
+  CHECK_EQUAL(0, ATS::runEnsemble(MPI_COMM_WORLD, ensemble_plist));
+
+  for (const auto& member : members) {
+    Teuchos::ParameterList member_plist = ATS::ensembleMemberList(*plist, member);
+    CHECK(!member_plist.isSublist("ensemble"));
+    runAlone(member_plist, "alone_" + member + "_");
+  }
+  comm.Barrier();
+
+  if (comm.MyPID() == 0) {
+    std::vector<std::string> observations;
+    observations.push_back("water_content.dat");
+    observations.push_back("pressure.dat");
+
+    for (const auto& obs : observations) {
+      for (const auto& member : members) {
+        std::vector<double> together = observedValues(member + "_" + obs);
+        std::vector<double> alone = observedValues("alone_" + member + "_" + obs);
+        CHECK(together.size() > 0);
+        CHECK_EQUAL(alone.size(), together.size());
+        if (alone.size() != together.size()) continue;
+        for (int i=0; i!=alone.size(); ++i) {
+          CHECK_CLOSE(alone[i], together[i], 1.e-10 * std::abs(alone[i]));
+        }
+      }
+
+      // the members differ, or the comparison above proves nothing
+      std::vector<double> low = observedValues(members[0] + "_" + obs);
+      std::vector<double> high = observedValues(members[1] + "_" + obs);
+      CHECK_EQUAL(low.size(), high.size());
+      double diff = 0.;
+      for (int i=0; i<low.size() && i<high.size(); ++i) {
+        if (low[i] != 0.) diff = std::max(diff, std::abs(low[i] - high[i]) / std::abs(low[i]));
+      }
+      CHECK(diff > 1.e-6);
+    }
+
+    // without a checkpoint list, the final checkpoints are still prefixed
+    for (const auto& member : members) {
+      CHECK(hasFileWithPrefix(member + "_checkpoint"));
+    }
+  }
+}
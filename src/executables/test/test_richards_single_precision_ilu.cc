@@ -0,0 +1,142 @@
+/*
+  Testing of the "single precision ilu" preconditioner: Richards infiltration
+  into a column must take the same steps to the same solution as with a
+  double precision preconditioner.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+
+#include "UnitTest++.h"
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+#include "Teuchos_XMLParameterListHelpers.hpp"
+#include "Epetra_MpiComm.h"
+
+#include "GeometricModel.hh"
+#include "State.hh"
+#include "coordinator.hh"
+
+#include "ats_mesh_factory.hh"
+#include "ensemble_driver.hh"
+
+#include "state_evaluators_registration.hh"
+#include "constitutive_relations_eos_registration.hh"
+#include "constitutive_relations_generic_evaluators_registration.hh"
+#include "flow_relations_registration.hh"
+#include "flow_richards_registration.hh"
+
+using namespace Amanzi;
+
+namespace {
+
+// The numbers in an observation file, in order.  Headers are skipped.
+std::vector<double>
+observedValues(const std::string& filename)
+{
+  std::vector<double> values;
+  std::ifstream file(filename.c_str());
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::stringstream tokens(line);
+    std::string token;
+    while (tokens >> token) {
+      char* end;
+      double value = std::strtod(token.c_str(), &end);
+      if (end != token.c_str() && *end == '\0') values.push_back(value);
+    }
+  }
+  return values;
+}
+
+// The largest cycle of the checkpoints written with this prefix, which is the
+// number of steps taken.
+int
+lastCheckpointCycle(const std::string& prefix)
+{
+  int cycle = -1;
+  DIR* dir = opendir(".");
+  if (dir == NULL) return cycle;
+  for (struct dirent* entry = readdir(dir); entry != NULL; entry = readdir(dir)) {
+    std::string name(entry->d_name);
+    if (name.compare(0, prefix.size(), prefix) == 0) {
+      cycle = std::max(cycle, std::atoi(name.substr(prefix.size()).c_str()));
+    }
+  }
+  closedir(dir);
+  return cycle;
+}
+
+// Run the column with this preconditioner list, inside GMRES.
+void
+runColumn(Teuchos::ParameterList plist, const Teuchos::ParameterList& pc_list,
+          const std::string& prefix)
+{
+  Teuchos::ParameterList& flow_list = plist.sublist("PKs").sublist("flow");
+  flow_list.remove("preconditioner");
+  flow_list.set("preconditioner", pc_list);
+  Teuchos::ParameterList& ls_list = flow_list.sublist("linear solver");
+  ls_list.set<std::string>("iterative method", "gmres");
+  ls_list.sublist("gmres parameters").set<double>("error tolerance", 1.e-12);
+  ls_list.sublist("gmres parameters").set<int>("maximum number of iterations", 200);
+
+  Teuchos::RCP<Epetra_MpiComm> comm = Teuchos::rcp(new Epetra_MpiComm(MPI_COMM_WORLD));
+  Teuchos::ParameterList reg_params = plist.sublist("regions");
+  Teuchos::RCP<AmanziGeometry::GeometricModel> gm =
+      Teuchos::rcp(new AmanziGeometry::GeometricModel(3, reg_params, comm.get()));
+  Teuchos::ParameterList state_plist = plist.sublist("state");
+  Teuchos::RCP<State> S = Teuchos::rcp(new State(state_plist));
+  ATS::createMeshes(plist, comm, gm, *S);
+  ATS::prefixOutputFilenames(plist, prefix);
+
+  ATS::Coordinator coordinator(plist, S, comm.get());
+  coordinator.cycle_driver();
+}
+
+} // namespace
+
+
+TEST(RICHARDS_SINGLE_PRECISION_ILU_CONVERGENCE_UNCHANGED) {
+  Epetra_MpiComm comm(MPI_COMM_WORLD);
+  Teuchos::RCP<Teuchos::ParameterList> plist =
+      Teuchos::getParametersFromXmlFile("test/ensemble_column.xml");
+  Teuchos::ParameterList column = ATS::ensembleMemberList(*plist, "k_low");
+
+  Teuchos::ParameterList double_pc =
+      column.sublist("PKs").sublist("flow").sublist("preconditioner");
+  runColumn(column, double_pc, "double_pc_");
+
+  Teuchos::ParameterList single_pc;
+  single_pc.set<std::string>("preconditioner type", "single precision ilu");
+  runColumn(column, single_pc, "single_pc_");
+  comm.Barrier();
+
+  if (comm.MyPID() == 0) {
+    // the same number of steps, so the nonlinear solves converged alike
+    int ncycles = lastCheckpointCycle("double_pc_checkpoint");
+    CHECK(ncycles > 0);
+    CHECK_EQUAL(ncycles, lastCheckpointCycle("single_pc_checkpoint"));
+
+    std::vector<std::string> observations;
+    observations.push_back("water_content.dat");
+    observations.push_back("pressure.dat");
+    for (const auto& obs : observations) {
+      std::vector<double> dbl = observedValues("double_pc_" + obs);
+      std::vector<double> sgl = observedValues("single_pc_" + obs);
+      CHECK(dbl.size() > 0);
+      CHECK_EQUAL(dbl.size(), sgl.size());
+      for (int i=0; i<dbl.size() && i<sgl.size(); ++i) {
+        CHECK_CLOSE(dbl[i], sgl[i], 1.e-8 * std::abs(dbl[i]));
+      }
+    }
+  }
+}
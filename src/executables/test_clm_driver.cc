@@ -1,3 +1,4 @@
+#include <cmath>
 #include <iostream>
 
 #include <Epetra_Comm.h>
@@ -5,42 +6,112 @@
 #include "Epetra_SerialComm.h"
 
 #include "ats_clm_driver.hh"
+#include <ats.h>
+
+// Checks a condition, counting failures.
+#define CLM_CHECK(cond, what) \
+  if (!(cond)) { std::cerr << "test_clm_driver FAILED: " << what << std::endl; ++nfail; }
 
 int main(int argc, char *argv[])
 {
   Teuchos::GlobalMPISession mpiSession(&argc,&argv,0);
   MPI_Comm mpi_comm(MPI_COMM_WORLD);
+  int nfail = 0;
 
-  Amanzi::ATSCLMDriver driver;
   int col_types = 0;
   int num_cols = 25;
   int num_types = 1;
   int num_rows = 15;
 
-  driver.Initialize(mpi_comm, &col_types, num_cols, num_types);
-
-  double T[num_rows * num_cols];
-  double sl[num_rows * num_cols];
-  double si[num_rows * num_cols];
-  double e_flux[num_cols];
-  double w_flux[num_cols];
-  double zero = 0.;
-
-  for (int i=0; i!=num_cols; ++i) {
-    e_flux[i] = 0;
-    w_flux[i] = 0;
-    for (int j=0; j!=num_rows; ++j) {
-      int index = j + i*num_rows;
-      T[index] = zero;
-      sl[index] = zero;
-      si[index] = zero;
+  // Copy interface, driving the class directly.
+  {
+    Amanzi::ATSCLMDriver driver;
+    driver.Initialize(mpi_comm, &col_types, num_cols, num_types);
+
+    double T[num_rows * num_cols];
+    double sl[num_rows * num_cols];
+    double si[num_rows * num_cols];
+    double e_flux[num_cols];
+    double w_flux[num_cols];
+    double zero = 0.;
+
+    for (int i=0; i!=num_cols; ++i) {
+      e_flux[i] = 0;
+      w_flux[i] = 0;
+      for (int j=0; j!=num_rows; ++j) {
+        int index = j + i*num_rows;
+        T[index] = zero;
+        sl[index] = zero;
+        si[index] = zero;
+      }
     }
+
+    driver.SetInitCLMData(&T[0], &sl[0], &si[0]);
+    driver.SetCLMData(&e_flux[0], &w_flux[0]);
+    driver.Advance(1.);
+    driver.Finalize();
   }
 
-  driver.SetInitCLMData(&T[0], &sl[0], &si[0]);
-  driver.SetCLMData(&e_flux[0], &w_flux[0]);
-  driver.Advance(1.);
-  driver.Finalize();
-}
+  // Zero-copy interface, through the C entry points.
+  {
+    int32_t ierr = ats_init(mpi_comm, &col_types, num_cols, num_types);
+    CLM_CHECK(ierr == ATS_SUCCESS, "ats_init returned " << ierr);
+
+    double* field[5];
+    int32_t length[5];
+    const int32_t fields[5] = { ATS_FIELD_TEMPERATURE, ATS_FIELD_SATURATION_LIQUID,
+                                ATS_FIELD_SATURATION_ICE, ATS_FIELD_SURFACE_ENERGY_SOURCE,
+                                ATS_FIELD_SURFACE_MASS_SOURCE };
+    for (int f=0; f!=5; ++f) {
+      ierr = ats_get_field_view(fields[f], &field[f], &length[f]);
+      CLM_CHECK(ierr == ATS_SUCCESS, "ats_get_field_view(" << fields[f] << ") returned " << ierr);
+      CLM_CHECK(field[f] != NULL, "ats_get_field_view(" << fields[f] << ") gave no buffer");
+      int expected = f < 3 ? num_rows * num_cols : num_cols;
+      CLM_CHECK(length[f] == expected, "field " << fields[f] << " has length "
+                << length[f] << ", expected " << expected);
+    }
+
+    double* bad_data = NULL;
+    int32_t bad_length = -1;
+    ierr = ats_get_field_view(5, &bad_data, &bad_length);
+    CLM_CHECK(ierr == ATS_FIELD_ERROR, "invalid field returned " << ierr);
+    CLM_CHECK(bad_data == NULL && bad_length == 0, "invalid field gave a buffer");
+
+    // initial temperatures; saturations are written by ATS
+    for (int i=0; i!=length[ATS_FIELD_TEMPERATURE]; ++i)
+      field[ATS_FIELD_TEMPERATURE][i] = 273.65;
+    ierr = ats_exchange(ATS_EXCHANGE_INIT);
+    CLM_CHECK(ierr == ATS_SUCCESS, "ats_exchange(INIT) returned " << ierr);
 
+    for (int i=0; i!=num_cols; ++i) {
+      field[ATS_FIELD_SURFACE_ENERGY_SOURCE][i] = 0.;
+      field[ATS_FIELD_SURFACE_MASS_SOURCE][i] = 0.;
+    }
+    ierr = ats_exchange(ATS_EXCHANGE_IN);
+    CLM_CHECK(ierr == ATS_SUCCESS, "ats_exchange(IN) returned " << ierr);
+
+    ierr = ats_advance(1., 0);
+    CLM_CHECK(ierr == ATS_SUCCESS, "ats_advance returned " << ierr);
+
+    ierr = ats_exchange(ATS_EXCHANGE_OUT);
+    CLM_CHECK(ierr == ATS_SUCCESS, "ats_exchange(OUT) returned " << ierr);
+    for (int f=0; f!=3; ++f) {
+      for (int i=0; i!=length[f]; ++i) {
+        CLM_CHECK(std::isfinite(field[f][i]), "field " << fields[f] << " entry "
+                  << i << " is " << field[f][i] << " after exchange out");
+      }
+    }
+    // no flux is put in over a single step, so the temperature stays close
+    for (int i=0; i!=length[ATS_FIELD_TEMPERATURE]; ++i) {
+      CLM_CHECK(std::abs(field[ATS_FIELD_TEMPERATURE][i] - 273.65) < 1.,
+                "temperature entry " << i << " is " << field[ATS_FIELD_TEMPERATURE][i]);
+    }
 
+    ierr = ats_exchange(3);
+    CLM_CHECK(ierr == ATS_FIELD_ERROR, "invalid exchange direction returned " << ierr);
+
+    ats_finalize();
+  }
+
+  return nfail > 0 ? 1 : 0;
+}
@@ -20,6 +20,24 @@ AdvectionDonorUpwind::AdvectionDonorUpwind(Teuchos::ParameterList& advect_plist,
 
   upwind_cell_ = Teuchos::rcp(new Epetra_IntVector(mesh_->face_map(true)));
   downwind_cell_ = Teuchos::rcp(new Epetra_IntVector(mesh_->face_map(true)));
+
+  // cache the face-to-cell topology, so that the upwind cells can be found
+  // without querying the mesh every time the flux changes
+  unsigned int nfaces_ghosted = upwind_cell_->MyLength();
+  face_cells_.assign(2 * nfaces_ghosted, -1);
+  face_dirs_.assign(2 * nfaces_ghosted, 0);
+
+  AmanziMesh::Entity_ID_List faces;
+  std::vector<int> fdirs;
+  unsigned int ncells_used = mesh_->num_entities(AmanziMesh::CELL, AmanziMesh::USED);
+  for (unsigned int c=0; c!=ncells_used; ++c) {
+    mesh_->cell_get_faces_and_dirs(c, &faces, &fdirs);
+    for (unsigned int i=0; i!=faces.size(); ++i) {
+      int k = face_cells_[2*faces[i]] < 0 ? 2*faces[i] : 2*faces[i] + 1;
+      face_cells_[k] = c;
+      face_dirs_[k] = fdirs[i];
+    }
+  }
 };
 
 
@@ -30,6 +48,9 @@ void AdvectionDonorUpwind::set_flux(const Teuchos::RCP<const CompositeVector>& f
 };
 
 
+// All dofs are processed one at a time over contiguous arrays, and the cell
+// update gathers from the faces of each cell, so that no two iterations
+// write the same entry.
 void AdvectionDonorUpwind::Apply(const Teuchos::RCP<Functions::BoundaryFunction>& bc_flux,
                                  bool include_bc_fluxes) {
 
@@ -41,15 +62,16 @@ void AdvectionDonorUpwind::Apply(const Teuchos::RCP<Functions::BoundaryFunction>
 
     flux_->ScatterMasterToGhosted("face");
     const Epetra_MultiVector& flux = *flux_->ViewComponent("face",true);
-
-    unsigned int nfaces_ghosted = field_f.MyLength();
-    for (unsigned int f=0; f!=nfaces_ghosted; ++f) {  // loop over master and slave faces
-      int c1 = (*upwind_cell_)[f];
-      if (c1 >=0) {
-        double u = std::abs(flux[0][f]);
-        for (unsigned int i=0; i!=num_dofs_; ++i) {
-          field_f[i][f] = u * field_c[i][c1];
-        }
+    const double* flux_f = flux[0];
+
+    const int* faces = upwind_faces_.data();
+    const int* cells = upwind_face_cells_.data();
+    unsigned int nfaces = upwind_faces_.size();
+    for (unsigned int i=0; i!=num_dofs_; ++i) {
+      const double* field_ci = field_c[i];
+      double* field_fi = field_f[i];
+      for (unsigned int k=0; k!=nfaces; ++k) {
+        field_fi[faces[k]] = std::abs(flux_f[faces[k]]) * field_ci[cells[k]];
       }
     }
   }
@@ -57,27 +79,23 @@ void AdvectionDonorUpwind::Apply(const Teuchos::RCP<Functions::BoundaryFunction>
   // Part 2: put fluxes in cell
   {
     Epetra_MultiVector& field_c = *field_->ViewComponent("cell", false);
-    field_c.PutScalar(0.);
     unsigned int ncells_owned = field_c.MyLength();
 
     // no scatter required
     const Epetra_MultiVector& field_f = *field_->ViewComponent("face", true);
 
-    unsigned int nfaces_ghosted = field_f.MyLength();
-    for (unsigned int f=0; f!=nfaces_ghosted; ++f) {  // loop over master and slave faces
-      int c1 = (*upwind_cell_)[f];
-      int c2 = (*downwind_cell_)[f];
-
-      if (c1 >= 0 && c1 < ncells_owned) {
-        for (int i=0; i!=num_dofs_; ++i) {
-          field_c[i][c1] -= field_f[i][f];
-        }
-      }
-
-      if (c2 >=0 && c2 < ncells_owned) {
-        for (int i=0; i!=num_dofs_; ++i) {
-          field_c[i][c2] += field_f[i][f];
+    const int* offsets = cell_face_offsets_.data();
+    const int* faces = cell_faces_.data();
+    const double* signs = cell_face_signs_.data();
+    for (unsigned int i=0; i!=num_dofs_; ++i) {
+      const double* field_fi = field_f[i];
+      double* field_ci = field_c[i];
+      for (unsigned int c=0; c!=ncells_owned; ++c) {
+        double sum = 0.;
+        for (int k=offsets[c]; k!=offsets[c+1]; ++k) {
+          sum += signs[k] * field_fi[faces[k]];
         }
+        field_ci[c] = sum;
       }
     }
   }
@@ -89,25 +107,54 @@ void AdvectionDonorUpwind::IdentifyUpwindCells_() {
   upwind_cell_->PutValue(-1);
   downwind_cell_->PutValue(-1);
 
-  AmanziMesh::Entity_ID_List faces;
-  std::vector<int> fdirs;
-
   flux_->ScatterMasterToGhosted("face");
   const Epetra_MultiVector& flux_f = *flux_->ViewComponent("face",true);
 
-  unsigned int ncells_used = mesh_->num_entities(AmanziMesh::CELL, AmanziMesh::USED);
-  for (unsigned int c=0; c!=ncells_used; ++c) {
-    mesh_->cell_get_faces_and_dirs(c, &faces, &fdirs);
-
-    for (unsigned int i=0; i!=faces.size(); ++i) {
-      AmanziMesh::Entity_ID f = faces[i];
-      if (flux_f[0][f] * fdirs[i] >= 0) {
+  unsigned int nfaces_ghosted = upwind_cell_->MyLength();
+  for (unsigned int f=0; f!=nfaces_ghosted; ++f) {
+    for (unsigned int k=2*f; k!=2*f+2; ++k) {
+      int c = face_cells_[k];
+      if (c < 0) continue;
+      if (flux_f[0][f] * face_dirs_[k] >= 0) {
         (*upwind_cell_)[f] = c;
       } else {
         (*downwind_cell_)[f] = c;
       }
     }
   }
+
+  // split out the faces with an upwind cell, and the owned cells' faces
+  int ncells_owned = mesh_->num_entities(AmanziMesh::CELL, AmanziMesh::OWNED);
+  upwind_faces_.clear();
+  upwind_face_cells_.clear();
+  cell_face_offsets_.assign(ncells_owned + 1, 0);
+  for (unsigned int f=0; f!=nfaces_ghosted; ++f) {
+    int c1 = (*upwind_cell_)[f];
+    int c2 = (*downwind_cell_)[f];
+    if (c1 >= 0) {
+      upwind_faces_.push_back(f);
+      upwind_face_cells_.push_back(c1);
+    }
+    if (c1 >= 0 && c1 < ncells_owned) cell_face_offsets_[c1+1]++;
+    if (c2 >= 0 && c2 < ncells_owned) cell_face_offsets_[c2+1]++;
+  }
+  for (int c=0; c!=ncells_owned; ++c) cell_face_offsets_[c+1] += cell_face_offsets_[c];
+
+  cell_faces_.resize(cell_face_offsets_[ncells_owned]);
+  cell_face_signs_.resize(cell_face_offsets_[ncells_owned]);
+  std::vector<int> next(cell_face_offsets_.begin(), cell_face_offsets_.end() - 1);
+  for (unsigned int f=0; f!=nfaces_ghosted; ++f) {
+    int c1 = (*upwind_cell_)[f];
+    int c2 = (*downwind_cell_)[f];
+    if (c1 >= 0 && c1 < ncells_owned) {
+      cell_faces_[next[c1]] = f;
+      cell_face_signs_[next[c1]++] = -1.;
+    }
+    if (c2 >= 0 && c2 < ncells_owned) {
+      cell_faces_[next[c2]] = f;
+      cell_face_signs_[next[c2]++] = 1.;
+    }
+  }
 };
 
 } // namespace Operators
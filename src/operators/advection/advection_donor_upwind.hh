@@ -11,6 +11,8 @@
 #ifndef OPERATOR_ADVECTION_ADVECTION_DONOR_UPWIND_HH_
 #define OPERATOR_ADVECTION_ADVECTION_DONOR_UPWIND_HH_
 
+#include <vector>
+
 #include "Teuchos_RCP.hpp"
 #include "Teuchos_ParameterList.hpp"
 #include "Epetra_IntVector.h"
@@ -39,6 +41,21 @@ private:
 
   Teuchos::RCP<Epetra_IntVector> upwind_cell_;
   Teuchos::RCP<Epetra_IntVector> downwind_cell_;
+
+  // face-to-cell topology, two entries per used face, ordered by cell.
+  // Missing cells of boundary faces are -1.
+  std::vector<int> face_cells_;
+  std::vector<int> face_dirs_;
+
+  // faces with an upwind cell, and that cell
+  std::vector<int> upwind_faces_;
+  std::vector<int> upwind_face_cells_;
+
+  // for each owned cell, the faces it exchanges with and the sign of the
+  // exchange, in CSR format and in face order
+  std::vector<int> cell_face_offsets_;
+  std::vector<int> cell_faces_;
+  std::vector<double> cell_face_signs_;
 };
 
 } // namespace Operators
@@ -0,0 +1,360 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+/* -------------------------------------------------------------------------
+   ATS
+
+   License: see $ATS_DIR/COPYRIGHT
+
+   Microbenchmark of the operator kernels: diffusion assembly, apply,
+   preconditioner setup and solve, upwinding of face coefficients, and donor
+   upwind advection, on a mesh generated in-process.
+
+   Usage:  operator_benchmark [key=value ...]
+
+     mesh=structured|columnar|perturbed|<file.exo>   (structured)
+     nx=, ny=, nz=          cells in each direction      (32, 32, 32)
+     dofs=                  advected dofs per cell       (10)
+     nrep=                  calls timed per kernel       (10)
+     discretization=        diffusion discretization     (mfd: optimized for sparsity)
+     preconditioner=        preconditioner type          (boomer amg)
+     format=csv|json        output format                (csv)
+
+   "columnar" is nx x ny columns of nz cells that are 100 times wider than
+   they are tall, as in typical subsurface runs.  "perturbed" is the
+   structured mesh with randomly displaced interior nodes, so that cells are
+   not orthogonal.  Any other value is read as an Exodus II file.
+
+   One record is written per kernel with the time per call (the maximum over
+   ranks), the number of cells processed per second, and for the kernels that
+   stream through a known amount of memory, an estimate of the bandwidth.
+   ------------------------------------------------------------------------- */
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "mpi.h"
+#include "Epetra_MpiComm.h"
+#include "Epetra_CrsMatrix.h"
+#include "Teuchos_ParameterList.hpp"
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_Array.hpp"
+
+#include "GeometricModel.hh"
+#include "MeshFactory.hh"
+#include "Mesh.hh"
+#include "CompositeVector.hh"
+#include "CompositeVectorSpace.hh"
+#include "OperatorDefs.hh"
+#include "OperatorDiffusionFactory.hh"
+#include "OperatorDiffusion.hh"
+#include "Operator.hh"
+#include "LinearOperatorFactory.hh"
+
+#include "advection_donor_upwind.hh"
+#include "upwind_total_flux.hh"
+#include "upwind_arithmetic_mean.hh"
+
+using namespace Amanzi;
+
+
+struct BenchmarkResult {
+  std::string kernel;
+  double seconds;   // per call
+  double entities;  // cells (or faces) processed per call
+  double bytes;     // bytes streamed per call, or 0 if not estimated
+};
+
+
+class Benchmark {
+ public:
+  Benchmark(const Epetra_MpiComm& comm, const std::map<std::string, std::string>& args) :
+      comm_(comm), args_(args) {}
+
+  std::string get(const std::string& key, const std::string& dflt) const {
+    std::map<std::string, std::string>::const_iterator it = args_.find(key);
+    return it == args_.end() ? dflt : it->second;
+  }
+  int get(const std::string& key, int dflt) const {
+    std::map<std::string, std::string>::const_iterator it = args_.find(key);
+    return it == args_.end() ? dflt : std::atoi(it->second.c_str());
+  }
+
+  // Time nrep calls of f, after one untimed call, returning the maximum
+  // over ranks of the time per call.
+  template<typename F>
+  double Time(F f, int nrep) {
+    f();
+    comm_.Barrier();
+    double start = MPI_Wtime();
+    for (int r=0; r!=nrep; ++r) f();
+    double elapsed = (MPI_Wtime() - start) / nrep;
+    double elapsed_max;
+    comm_.MaxAll(&elapsed, &elapsed_max, 1);
+    return elapsed_max;
+  }
+
+  void Record(const std::string& kernel, double seconds, double entities, double bytes=0.) {
+    double entities_global;
+    comm_.SumAll(&entities, &entities_global, 1);
+    double bytes_global;
+    comm_.SumAll(&bytes, &bytes_global, 1);
+    BenchmarkResult result = { kernel, seconds, entities_global, bytes_global };
+    results_.push_back(result);
+  }
+
+  void Write(const std::string& mesh_name, int ncells, int dofs, int nrep) const {
+    if (comm_.MyPID() != 0) return;
+
+    std::string format = get("format", std::string("csv"));
+    if (format == "json") std::printf("[\n");
+    else std::printf("kernel,mesh,ncells,dofs,nranks,nrep,seconds_per_call,entities_per_second,GB_per_second\n");
+
+    for (unsigned int i=0; i!=results_.size(); ++i) {
+      const BenchmarkResult& r = results_[i];
+      double rate = r.entities / r.seconds;
+      double bandwidth = r.bytes / r.seconds / 1.e9;
+      if (format == "json") {
+        std::printf("  {\"kernel\": \"%s\", \"mesh\": \"%s\", \"ncells\": %d, \"dofs\": %d, "
+                    "\"nranks\": %d, \"nrep\": %d, \"seconds_per_call\": %g, "
+                    "\"entities_per_second\": %g, \"GB_per_second\": %g}%s\n",
+                    r.kernel.c_str(), mesh_name.c_str(), ncells, dofs, comm_.NumProc(), nrep,
+                    r.seconds, rate, bandwidth, i+1 == results_.size() ? "" : ",");
+      } else {
+        std::printf("%s,%s,%d,%d,%d,%d,%g,%g,%g\n",
+                    r.kernel.c_str(), mesh_name.c_str(), ncells, dofs, comm_.NumProc(), nrep,
+                    r.seconds, rate, bandwidth);
+      }
+    }
+    if (format == "json") std::printf("]\n");
+  }
+
+ private:
+  const Epetra_MpiComm& comm_;
+  std::map<std::string, std::string> args_;
+  std::vector<BenchmarkResult> results_;
+};
+
+
+// deterministic pseudo-random number in [-0.5, 0.5) from an id, so that
+// every rank displaces a shared node the same way
+double Jitter(int gid, int dim) {
+  unsigned int h = 2654435761u * (unsigned int) (3*gid + dim + 1);
+  h ^= h >> 16;
+  h *= 2246822519u;
+  h ^= h >> 13;
+  return (h % 100000) / 100000. - 0.5;
+}
+
+
+Teuchos::RCP<AmanziMesh::Mesh>
+CreateMesh(const Epetra_MpiComm& comm,
+           const Teuchos::RCP<AmanziGeometry::GeometricModel>& gm,
+           const std::string& type, int nx, int ny, int nz) {
+  AmanziMesh::MeshFactory factory(&comm);
+  AmanziMesh::FrameworkPreference prefs(factory.preference());
+  prefs.clear();
+  prefs.push_back(AmanziMesh::MSTK);
+  factory.preference(prefs);
+
+  if (type != "structured" && type != "columnar" && type != "perturbed") {
+    return factory.create(type, gm);
+  }
+
+  Teuchos::Array<double> low(3, 0.), high(3, 1.);
+  if (type == "columnar") {
+    high[0] = 100. * nx;
+    high[1] = 100. * ny;
+    high[2] = 1. * nz;
+  }
+  Teuchos::Array<int> ncells(3);
+  ncells[0] = nx; ncells[1] = ny; ncells[2] = nz;
+
+  Teuchos::ParameterList gen_plist;
+  gen_plist.set("number of cells", ncells);
+  gen_plist.set("domain low coordinate", low);
+  gen_plist.set("domain high coordinate", high);
+  Teuchos::RCP<AmanziMesh::Mesh> mesh = factory.create(gen_plist, gm);
+
+  if (type == "perturbed") {
+    double h[3] = { 1./nx, 1./ny, 1./nz };
+    const Epetra_Map& node_map = mesh->node_map(true);
+    AmanziMesh::Entity_ID_List node_ids;
+    AmanziGeometry::Point_List new_positions;
+    int nnodes = mesh->num_entities(AmanziMesh::NODE, AmanziMesh::USED);
+    for (int n=0; n!=nnodes; ++n) {
+      AmanziGeometry::Point x(3);
+      mesh->node_get_coordinates(n, &x);
+      bool interior = true;
+      for (int d=0; d!=3; ++d) interior &= x[d] > 0.5*h[d] && x[d] < 1. - 0.5*h[d];
+      if (!interior) continue;
+
+      for (int d=0; d!=3; ++d) x[d] += 0.4 * h[d] * Jitter(node_map.GID(n), d);
+      node_ids.push_back(n);
+      new_positions.push_back(x);
+    }
+    AmanziGeometry::Point_List final_positions;
+    mesh->deform(node_ids, new_positions, false, &final_positions);
+  }
+  return mesh;
+}
+
+
+int main(int argc, char* argv[]) {
+  MPI_Init(&argc, &argv);
+  {
+    Epetra_MpiComm comm(MPI_COMM_WORLD);
+
+    std::map<std::string, std::string> args;
+    for (int i=1; i<argc; ++i) {
+      std::string arg(argv[i]);
+      std::size_t eq = arg.find('=');
+      if (eq == std::string::npos) {
+        if (comm.MyPID() == 0) std::fprintf(stderr, "operator_benchmark: expected key=value, got \"%s\"\n", argv[i]);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+      }
+      args[arg.substr(0, eq)] = arg.substr(eq+1);
+    }
+    Benchmark bench(comm, args);
+
+    std::string mesh_type = bench.get("mesh", std::string("structured"));
+    int nx = bench.get("nx", 32);
+    int ny = bench.get("ny", 32);
+    int nz = bench.get("nz", 32);
+    int dofs = bench.get("dofs", 10);
+    int nrep = bench.get("nrep", 10);
+
+    Teuchos::ParameterList regions;
+    Teuchos::RCP<AmanziGeometry::GeometricModel> gm =
+        Teuchos::rcp(new AmanziGeometry::GeometricModel(3, regions, &comm));
+    Teuchos::RCP<AmanziMesh::Mesh> mesh = CreateMesh(comm, gm, mesh_type, nx, ny, nz);
+
+    int ncells = mesh->num_entities(AmanziMesh::CELL, AmanziMesh::OWNED);
+    int nfaces = mesh->num_entities(AmanziMesh::FACE, AmanziMesh::OWNED);
+    int nfaces_used = mesh->num_entities(AmanziMesh::FACE, AmanziMesh::USED);
+    int ncells_global;
+    comm.SumAll(&ncells, &ncells_global, 1);
+
+    // a uniform velocity field, as face fluxes
+    CompositeVectorSpace face_space;
+    face_space.SetMesh(mesh)->SetGhosted()->SetComponent("face", AmanziMesh::FACE, 1);
+    Teuchos::RCP<CompositeVector> flux = Teuchos::rcp(new CompositeVector(face_space));
+    {
+      Epetra_MultiVector& flux_f = *flux->ViewComponent("face", false);
+      AmanziGeometry::Point velocity(3);
+      velocity[0] = 1.; velocity[1] = 0.5; velocity[2] = -0.25;
+      for (int f=0; f!=nfaces; ++f) flux_f[0][f] = mesh->face_normal(f) * velocity;
+    }
+
+    // == diffusion ==
+    {
+      std::vector<int> bc_markers(nfaces_used, Operators::OPERATOR_BC_NONE);
+      std::vector<double> bc_values(nfaces_used, 0.);
+      std::vector<double> bc_mixed;
+      AmanziMesh::Entity_ID_List cells;
+      for (int f=0; f!=nfaces_used; ++f) {
+        mesh->face_get_cells(f, AmanziMesh::USED, &cells);
+        if (cells.size() == 1) bc_markers[f] = Operators::OPERATOR_BC_DIRICHLET;
+      }
+      Teuchos::RCP<Operators::BCs> bc = Teuchos::rcp(new Operators::BCs(
+          Operators::OPERATOR_BC_TYPE_FACE, bc_markers, bc_values, bc_mixed));
+
+      Teuchos::ParameterList diff_plist;
+      diff_plist.set("discretization primary",
+                     bench.get("discretization", std::string("mfd: optimized for sparsity")));
+      Operators::OperatorDiffusionFactory opfactory;
+      Teuchos::RCP<Operators::OperatorDiffusion> diff = opfactory.Create(diff_plist, mesh, bc);
+      diff->SetTensorCoefficient(Teuchos::null);
+      Teuchos::RCP<Operators::Operator> op = diff->global_operator();
+
+      double t = bench.Time([&]() {
+          op->Init();
+          diff->UpdateMatrices(Teuchos::null, Teuchos::null);
+          diff->ApplyBCs(true, true);
+        }, nrep);
+      bench.Record("diffusion_local_matrices", t, ncells);
+
+      op->SymbolicAssembleMatrix();
+      t = bench.Time([&]() { op->AssembleMatrix(); }, nrep);
+      bench.Record("diffusion_assemble", t, ncells);
+
+      Teuchos::ParameterList pc_plist;
+      pc_plist.set("preconditioner type", bench.get("preconditioner", std::string("boomer amg")));
+      t = bench.Time([&]() { op->InitPreconditioner(pc_plist); }, 1);
+      bench.Record("preconditioner_setup", t, ncells);
+
+      CompositeVector x(op->DomainMap()), b(op->RangeMap());
+      x.PutScalar(1.);
+      t = bench.Time([&]() { op->Apply(x, b); }, nrep);
+      bench.Record("diffusion_apply", t, ncells);
+
+      // the assembled matrix: values, column indices, and the two vectors
+      Teuchos::RCP<Epetra_CrsMatrix> A = op->A();
+      Epetra_Vector xa(A->DomainMap()), ba(A->RangeMap());
+      xa.PutScalar(1.);
+      t = bench.Time([&]() { A->Multiply(false, xa, ba); }, nrep);
+      bench.Record("assembled_spmv", t, A->NumMyRows(),
+                   12. * A->NumMyNonzeros() + 16. * A->NumMyRows());
+
+      t = bench.Time([&]() { op->ApplyInverse(b, x); }, nrep);
+      bench.Record("preconditioner_apply", t, ncells);
+
+      Teuchos::ParameterList solver_plist;
+      solver_plist.sublist("benchmark solver").set("iterative method", "pcg");
+      Teuchos::ParameterList& pcg_plist =
+          solver_plist.sublist("benchmark solver").sublist("pcg parameters");
+      pcg_plist.set("error tolerance", 1.e-8);
+      pcg_plist.set("maximum number of iterations", 1000);
+      AmanziSolvers::LinearOperatorFactory<Operators::Operator, CompositeVector, CompositeVectorSpace> sfactory;
+      Teuchos::RCP<AmanziSolvers::LinearOperator<Operators::Operator, CompositeVector, CompositeVectorSpace> >
+          solver = sfactory.Create("benchmark solver", solver_plist, op);
+
+      b.PutScalar(1.);
+      t = bench.Time([&]() { x.PutScalar(0.); solver->ApplyInverse(b, x); }, 1);
+      bench.Record("solve_pcg_" + std::to_string(solver->num_itrs()) + "_itrs", t, ncells);
+    }
+
+    // == upwinding of face coefficients ==
+    {
+      CompositeVectorSpace cell_space;
+      cell_space.SetMesh(mesh)->SetGhosted()->SetComponent("cell", AmanziMesh::CELL, 1);
+      CompositeVector cell_coef(cell_space);
+      cell_coef.PutScalar(2.);
+      CompositeVector face_coef(face_space);
+
+      Operators::UpwindTotalFlux total_flux("benchmark", "cell_coef", "face_coef", "flux", 1.e-8);
+      double t = bench.Time([&]() {
+          total_flux.CalculateCoefficientsOnFaces(cell_coef, *flux, Teuchos::ptr(&face_coef), Teuchos::null);
+        }, nrep);
+      bench.Record("upwind_total_flux", t, nfaces, 8. * 3 * nfaces);
+
+      Operators::UpwindArithmeticMean arithmetic_mean("benchmark", "cell_coef", "face_coef");
+      t = bench.Time([&]() {
+          arithmetic_mean.CalculateCoefficientsOnFaces(cell_coef, Teuchos::ptr(&face_coef));
+        }, nrep);
+      bench.Record("upwind_arithmetic_mean", t, nfaces, 8. * 3 * nfaces);
+    }
+
+    // == donor upwind advection ==
+    {
+      Teuchos::ParameterList advect_plist;
+      Operators::AdvectionDonorUpwind advection(advect_plist, mesh);
+      advection.set_num_dofs(dofs);
+
+      double t = bench.Time([&]() { advection.set_flux(flux); }, nrep);
+      bench.Record("advection_set_flux", t, nfaces);
+
+      advection.field()->PutScalar(1.);
+      t = bench.Time([&]() { advection.Apply(Teuchos::null); }, nrep);
+      // per dof: read a cell value and write a face value per face, then
+      // read two face values and write a cell value per cell
+      bench.Record("advection_apply", t, ncells,
+                   8. * dofs * (2. * nfaces + 3. * ncells));
+    }
+
+    bench.Write(mesh_type, ncells_global, dofs, nrep);
+  }
+  MPI_Finalize();
+  return 0;
+}
@@ -5,6 +5,8 @@
   Deformation optimization matrix
 */
 
+#include <algorithm>
+
 #include "EpetraExt_MatrixMatrix.h"
 #include "EpetraExt_RowMatrixOut.h"
 
@@ -29,12 +31,19 @@ MatrixVolumetricDeformation::MatrixVolumetricDeformation(
 };
 
 
+// The pre-assembled structure depends only on the mesh and is shared.
 MatrixVolumetricDeformation::MatrixVolumetricDeformation(
           const MatrixVolumetricDeformation& other) :
+    range_(other.range_),
+    domain_(other.domain_),
+    mesh_(other.mesh_),
     plist_(other.plist_),
-    mesh_(other.mesh_) {
+    operatorPre_(other.operatorPre_),
+    dVdz_(other.dVdz_),
+    max_nnode_neighbors_(other.max_nnode_neighbors_),
+    node_neighbor_offsets_(other.node_neighbor_offsets_),
+    node_neighbors_(other.node_neighbors_) {
   InitializeFromOptions_();
-  PreAssemble_();
 };
 
 
@@ -196,24 +205,28 @@ void MatrixVolumetricDeformation::PreAssemble_() {
 
   // == Form the normal equations, dVdz^T * dVdz ==
 
-  // calculate nnz
-  int *nnz_op = new int[nnodes];
+  // calculate nnz: the nodes sharing a cell with each node
+  std::vector<int> nnz_op(nnodes);
   max_nnode_neighbors_ = 0;
+  std::vector<int> cell_neighbors;
   for (unsigned int no=0; no!=nnodes; ++no) {
     AmanziMesh::Entity_ID_List cells;
     mesh_->node_get_cells(no, AmanziMesh::USED,&cells);
-    // THIS IS VERY SPECIFIC TO GEOMETRY!
-#if MESH_TYPE
-    int nnode_neighbors = (cells.size()/2 + 1) * 3;
-#else
-    int nnode_neighbors = 9*3;
-#endif
+    cell_neighbors.clear();
+    for (AmanziMesh::Entity_ID_List::const_iterator c=cells.begin();
+         c!=cells.end(); ++c) {
+      AmanziMesh::Entity_ID_List cell_nodes;
+      mesh_->cell_get_nodes(*c, &cell_nodes);
+      cell_neighbors.insert(cell_neighbors.end(), cell_nodes.begin(), cell_nodes.end());
+    }
+    std::sort(cell_neighbors.begin(), cell_neighbors.end());
+    int nnode_neighbors = std::unique(cell_neighbors.begin(), cell_neighbors.end())
+        - cell_neighbors.begin();
     max_nnode_neighbors_ = std::max(nnode_neighbors, max_nnode_neighbors_);
     nnz_op[no] = nnode_neighbors;
   }
 
-  operatorPre_ = Teuchos::rcp(new Epetra_CrsMatrix(Copy,node_map,nnz_op));
-  delete[] nnz_op;
+  operatorPre_ = Teuchos::rcp(new Epetra_CrsMatrix(Copy,node_map,nnz_op.data()));
 
   // form explicitly dVdz^T * dVdz
   EpetraExt::MatrixMatrix::Multiply(*dVdz_,true, *dVdz_,false, *operatorPre_);
@@ -232,38 +245,47 @@ void MatrixVolumetricDeformation::PreAssemble_() {
   //  EpetraExt::RowMatrixToMatlabFile("op_diag.txt", *operatorPre_);
 
   // -- Add in a diffusive term
-  int *node_indices = new int[max_nnode_neighbors_];
-  double *node_values = new double[max_nnode_neighbors_];
-
+  // determine the node neighbors, once, as contiguous adjacency arrays
+  node_neighbor_offsets_.assign(nnodes+1, 0);
+  node_neighbors_.clear();
   for (int n=0; n!=nnodes; ++n) {
-    // determine the set of node neighbors
-    std::set<int> neighbors;
     AmanziMesh::Entity_ID_List faces;
     mesh_->node_get_faces(n, AmanziMesh::USED, &faces);
     for (AmanziMesh::Entity_ID_List::const_iterator f=faces.begin();
          f!=faces.end(); ++f) {
       AmanziMesh::Entity_ID_List neighbor_nodes;
       mesh_->face_get_nodes(*f, &neighbor_nodes);
-      neighbors.insert(neighbor_nodes.begin(), neighbor_nodes.end());
+      node_neighbors_.insert(node_neighbors_.end(),
+                             neighbor_nodes.begin(), neighbor_nodes.end());
     }
 
-    // remove my node
-    neighbors.erase(n);
+    // sort, unique, and remove my node
+    std::vector<int>::iterator begin = node_neighbors_.begin() + node_neighbor_offsets_[n];
+    std::sort(begin, node_neighbors_.end());
+    std::vector<int>::iterator end = std::unique(begin, node_neighbors_.end());
+    end = std::remove(begin, end, n);
+    node_neighbors_.erase(end, node_neighbors_.end());
+    node_neighbor_offsets_[n+1] = node_neighbors_.size();
+  }
 
+  std::vector<int> node_indices(max_nnode_neighbors_);
+  std::vector<double> node_values(max_nnode_neighbors_);
+  for (int n=0; n!=nnodes; ++n) {
     // apply the stencil
-    int nneighbors = neighbors.size() + 1;
+    int nneighbors = node_neighbor_offsets_[n+1] - node_neighbor_offsets_[n] + 1;
+    ASSERT(nneighbors <= max_nnode_neighbors_);
     AmanziGeometry::Point center(3);
     mesh_->node_get_coordinates(n,&center);
     node_indices[0] = node_map.GID(n);
     node_values[0] = 0.;
 
     int lcv = 1;
-    for (std::set<int>::const_iterator hn=neighbors.begin();
-         hn!=neighbors.end(); ++hn) {
-      node_indices[lcv] = node_map_wghost.GID(*hn);
+    for (int k=node_neighbor_offsets_[n]; k!=node_neighbor_offsets_[n+1]; ++k) {
+      int hn = node_neighbors_[k];
+      node_indices[lcv] = node_map_wghost.GID(hn);
 
       AmanziGeometry::Point coord(3);
-      mesh_->node_get_coordinates(*hn,&coord);
+      mesh_->node_get_coordinates(hn,&coord);
       double smoothing = smoothing_ / AmanziGeometry::norm(center - coord);
       node_values[0] += smoothing;
       node_values[lcv] = - smoothing;
@@ -272,108 +294,62 @@ void MatrixVolumetricDeformation::PreAssemble_() {
 
     // add into the row
     ierr = operatorPre_->SumIntoGlobalValues(node_map.GID(n), nneighbors,
-            node_values, node_indices);
+            node_values.data(), node_indices.data());
     ASSERT(!ierr);
   }
 
   ierr = operatorPre_->FillComplete();  ASSERT(!ierr);
-
-  // clean up
-  delete[] node_indices;
-  delete[] node_values;
-
 }
 
 
+// The structure of operator_ is that of operatorPre_, fixed at
+// construction, so only values are written here.
 void MatrixVolumetricDeformation::Assemble(
     const Teuchos::Ptr<const AmanziMesh::Entity_ID_List>& fixed_nodes) {
 
   int ierr = 0;
-
-  // HARD CODED CRUFT!
-#if MESH_TYPE
-  int nnz = 6;
-  int indices[6];
-  double values[6];
-#else
-  int nnz = 8;
-  int indices[8];
-  double values[8];
-#endif
-
-  double eps = 1.e-4;
-  int *node_indices = new int[max_nnode_neighbors_];
-  double *node_values = new double[max_nnode_neighbors_];
-
-  // Domain and Range: matrix inverse solves the problem, given dV, what is
-  // dnode_z that results in that dV.  Therefore, A * dnode_z = dV
   const Epetra_Map& node_map = mesh_->node_map(false);
-  const Epetra_Map& node_map_wghost = mesh_->node_map(true);
   unsigned int nnodes = mesh_->num_entities(AmanziMesh::NODE, AmanziMesh::OWNED);
 
   // reset to non-fixed operator.
   if (operator_ == Teuchos::null) {
     operator_ = Teuchos::rcp(new Epetra_CrsMatrix(*operatorPre_));
   } else {
-    *operator_ = *operatorPre_;
+    for (unsigned int n=0; n!=nnodes; ++n) {
+      int nentries, nentries_pre;
+      double *values, *values_pre;
+      int *indices, *indices_pre;
+      ierr = operator_->ExtractMyRowView(n, nentries, values, indices); ASSERT(!ierr);
+      ierr = operatorPre_->ExtractMyRowView(n, nentries_pre, values_pre, indices_pre); ASSERT(!ierr);
+      ASSERT(nentries == nentries_pre);
+      std::copy(values_pre, values_pre + nentries, values);
+    }
   }
 
-  Epetra_Vector diag(node_map);
-  ierr = operatorPre_->ExtractDiagonalCopy(diag);  ASSERT(!ierr);
-  double min(0.);
-  diag.MinValue(&min);
-  std::cout << "MIN VAL OP_PRE = " << min << std::endl;
-  std::cout << "SIZE nnodes = " << nnodes << std::endl;
-  std::cout << "SIZE map = " << node_map.NumMyElements() << std::endl;
-  std::cout << "SIZE op pre Row = " << operatorPre_->RowMap().NumMyElements() << std::endl;
-  std::cout << "SIZE op pre Domain = " << operatorPre_->DomainMap().NumMyElements() << std::endl;
-  std::cout << "SIZE op pre Range = " << operatorPre_->RangeMap().NumMyElements() << std::endl;
-  std::cout << "SIZE op Row = " << operator_->RowMap().NumMyElements() << std::endl;
-  std::cout << "SIZE op Domain = " << operator_->DomainMap().NumMyElements() << std::endl;
-  std::cout << "SIZE op Range = " << operator_->RangeMap().NumMyElements() << std::endl;
-
-  ierr = operator_->ExtractDiagonalCopy(diag);  ASSERT(!ierr);
-  diag.MinValue(&min);
-  std::cout << "MIN VAL OP (PRE) = " << min << std::endl;
-
   // -- Fix the bottom nodes, they may not move
   for (AmanziMesh::Entity_ID_List::const_iterator n=fixed_nodes->begin();
        n!=fixed_nodes->end(); ++n) {
 
-    // extract the row
     if (*n < nnodes) {
-      int n_gid = node_map.GID(*n);
-      int nneighbors;
-      ierr = operator_->ExtractGlobalRowCopy(n_gid, max_nnode_neighbors_,
-              nneighbors, node_values, node_indices); ASSERT(!ierr);
+      int n_col = operator_->ColMap().LID(node_map.GID(*n));
+      int nentries;
+      double *values;
+      int *indices;
+      ierr = operator_->ExtractMyRowView(*n, nentries, values, indices); ASSERT(!ierr);
 
       // zero the row, 1 on diagonal
-      for (int i=0; i!=nneighbors; ++i)
-        node_values[i] = node_indices[i] == n_gid ? 1. : 0.;
-
-      double rowsum = 0.;
-      for (int i=0; i!=nneighbors; ++i) rowsum += node_indices[i];
-      ASSERT(rowsum > 0.);
-
-      // replace the row
-      ierr = operator_->ReplaceGlobalValues(n_gid, nneighbors,
-              node_values, node_indices); ASSERT(!ierr);
+      bool found_diagonal = false;
+      for (int i=0; i!=nentries; ++i) {
+        values[i] = indices[i] == n_col ? 1. : 0.;
+        found_diagonal |= indices[i] == n_col;
+      }
+      ASSERT(found_diagonal);
     }
   }
 
-  ierr = operator_->FillComplete();  ASSERT(!ierr);
-
-  ierr = operator_->ExtractDiagonalCopy(diag);  ASSERT(!ierr);
-  diag.MinValue(&min);
-  std::cout << "MIN VAL OP (POST) = " << min << std::endl;
-
   // dump Operator intermediate step
   //  EpetraExt::RowMatrixToMatlabFile("op.txt", *operator_);
 
-  // clean up
-  delete[] node_indices;
-  delete[] node_values;
-
   // Set the operator in the precon
   prec_->Destroy();
   prec_->Update(operator_);
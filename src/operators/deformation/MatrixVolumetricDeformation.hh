@@ -8,6 +8,7 @@
 #ifndef OPERATORS_MATRIX_VOLUMETRIC_DEFORMATION_HH_
 #define OPERATORS_MATRIX_VOLUMETRIC_DEFORMATION_HH_
 
+#include <vector>
 
 #include "Epetra_Map.h"
 #include "Epetra_Operator.h"
@@ -81,6 +82,10 @@ class MatrixVolumetricDeformation : public CompositeMatrix {
   Teuchos::RCP<Epetra_CrsMatrix> dVdz_;
   int max_nnode_neighbors_;
 
+  // node-to-node neighbors through faces, for owned nodes, in CSR format
+  std::vector<int> node_neighbor_offsets_;
+  std::vector<int> node_neighbors_;
+
   // parameters to control optimization
   double diagonal_shift_;
   double smoothing_;
@@ -0,0 +1,140 @@
+/*
+  License: BSD
+  Authors: ATS developers
+
+  ILU(0) preconditioner stored and applied in single precision.
+*/
+
+#include <algorithm>
+#include <utility>
+
+#include "dbc.hh"
+#include "errors.hh"
+
+#include "SinglePrecisionILU.hh"
+
+namespace Amanzi {
+namespace Operators {
+
+/* ******************************************************************
+ * Sparsity pattern of the local block.
+ ****************************************************************** */
+void SinglePrecisionILU::Symbolic_(const Epetra_CrsMatrix& A) {
+  const Epetra_Map& row_map = A.RowMap();
+  const Epetra_Map& col_map = A.ColMap();
+  nrows_ = A.NumMyRows();
+  nnz_A_ = A.NumMyNonzeros();
+
+  row_ptr_.assign(nrows_+1, 0);
+  diag_.assign(nrows_, -1);
+  cols_.clear();
+  src_.clear();
+  cols_.reserve(nnz_A_);
+  src_.reserve(nnz_A_);
+
+  std::vector<std::pair<int,int> > row(A.MaxNumEntries());
+  for (int i=0; i!=nrows_; ++i) {
+    int nentries;
+    double* vals;
+    int* inds;
+    A.ExtractMyRowView(i, nentries, vals, inds);
+
+    int n = 0;
+    for (int j=0; j!=nentries; ++j) {
+      int lrow = row_map.LID(col_map.GID(inds[j]));
+      if (lrow >= 0) row[n++] = std::make_pair(lrow, j);
+    }
+    std::sort(row.begin(), row.begin()+n);
+
+    for (int j=0; j!=n; ++j) {
+      if (row[j].first == i) diag_[i] = cols_.size();
+      cols_.push_back(row[j].first);
+      src_.push_back(row[j].second);
+    }
+    row_ptr_[i+1] = cols_.size();
+
+    if (diag_[i] < 0) {
+      Errors::Message msg("SinglePrecisionILU: matrix has no diagonal entry in a row.");
+      Exceptions::amanzi_throw(msg);
+    }
+  }
+  vals_.resize(cols_.size());
+  work_.resize(nrows_);
+}
+
+
+/* ******************************************************************
+ * Numeric ILU(0) factorization, in place, in single precision.
+ ****************************************************************** */
+void SinglePrecisionILU::Update(const Epetra_CrsMatrix& A) {
+  if (A.NumMyRows() != nrows_ || A.NumMyNonzeros() != nnz_A_) Symbolic_(A);
+
+  // round the local block
+  for (int i=0; i!=nrows_; ++i) {
+    int nentries;
+    double* vals;
+    int* inds;
+    A.ExtractMyRowView(i, nentries, vals, inds);
+    for (int k=row_ptr_[i]; k!=row_ptr_[i+1]; ++k) vals_[k] = (float) vals[src_[k]];
+  }
+
+  // IKJ elimination restricted to the pattern
+  for (int i=0; i!=nrows_; ++i) {
+    int end = row_ptr_[i+1];
+    for (int k=row_ptr_[i]; k!=diag_[i]; ++k) {
+      int c = cols_[k];
+      float l = vals_[k] / vals_[diag_[c]];
+      vals_[k] = l;
+
+      // row i -= l * (upper part of row c), where the patterns overlap
+      int p = k+1;
+      for (int q=diag_[c]+1; q!=row_ptr_[c+1]; ++q) {
+        while (p != end && cols_[p] < cols_[q]) ++p;
+        if (p == end) break;
+        if (cols_[p] == cols_[q]) vals_[p] -= l * vals_[q];
+      }
+    }
+
+    if (vals_[diag_[i]] == 0.f) {
+      Errors::Message msg("SinglePrecisionILU: zero pivot.");
+      Exceptions::amanzi_throw(msg);
+    }
+  }
+}
+
+
+/* ******************************************************************
+ * x = inv(U) inv(L) b
+ ****************************************************************** */
+int SinglePrecisionILU::ApplyInverse(const Epetra_MultiVector& b,
+        Epetra_MultiVector& x) const {
+  ASSERT(b.MyLength() == nrows_);
+  ASSERT(x.MyLength() == nrows_);
+  ASSERT(b.NumVectors() == x.NumVectors());
+  if (nrows_ == 0) return 0;
+
+  float* w = &work_[0];
+  for (int v=0; v!=b.NumVectors(); ++v) {
+    for (int i=0; i!=nrows_; ++i) w[i] = (float) b[v][i];
+
+    // forward, unit lower
+    for (int i=0; i!=nrows_; ++i) {
+      float s = w[i];
+      for (int k=row_ptr_[i]; k!=diag_[i]; ++k) s -= vals_[k] * w[cols_[k]];
+      w[i] = s;
+    }
+
+    // backward, upper
+    for (int i=nrows_-1; i>=0; --i) {
+      float s = w[i];
+      for (int k=diag_[i]+1; k!=row_ptr_[i+1]; ++k) s -= vals_[k] * w[cols_[k]];
+      w[i] = s / vals_[diag_[i]];
+    }
+
+    for (int i=0; i!=nrows_; ++i) x[v][i] = w[i];
+  }
+  return 0;
+}
+
+}  // namespace Operators
+}  // namespace Amanzi
@@ -0,0 +1,69 @@
+/*
+  License: BSD
+  Authors: ATS developers
+
+  ILU(0) preconditioner stored and applied in single precision.
+
+  A preconditioner is only an approximate inverse inside the outer Krylov
+  iteration, which works with the double precision operator, so its factors
+  need not be double.  Storing them as float halves the bytes
+  streamed by each application, which bounds its cost.
+
+  The factorization is of the processor-local block of the matrix (block
+  Jacobi across processors, as in the non-overlapping block ILU), with the
+  sparsity pattern of that block.  The pattern is computed once and reused
+  until the number of local nonzeros of the matrix changes.
+*/
+
+#ifndef OPERATORS_SINGLE_PRECISION_ILU_HH_
+#define OPERATORS_SINGLE_PRECISION_ILU_HH_
+
+#include <vector>
+
+#include "Epetra_CrsMatrix.h"
+#include "Epetra_MultiVector.h"
+
+namespace Amanzi {
+namespace Operators {
+
+class SinglePrecisionILU {
+ public:
+  SinglePrecisionILU() : nrows_(0), nnz_A_(-1) {}
+
+  // Factor the local block of A, rounded to single precision.
+  void Update(const Epetra_CrsMatrix& A);
+
+  // x = inv(LU) b.  The vectors are double, and are rounded to single
+  // precision for the triangular solves.  Returns 0 on success.
+  int ApplyInverse(const Epetra_MultiVector& b, Epetra_MultiVector& x) const;
+
+  // bytes of the stored factors
+  std::size_t bytes() const {
+    return vals_.size() * sizeof(float) + cols_.size() * sizeof(int)
+        + (row_ptr_.size() + diag_.size()) * sizeof(int);
+  }
+
+ protected:
+  void Symbolic_(const Epetra_CrsMatrix& A);
+
+ protected:
+  int nrows_;
+  int nnz_A_;
+
+  // CSR of the local block, columns sorted within a row, the position of
+  // each row's diagonal, and the position of each entry in A's row
+  std::vector<int> row_ptr_;
+  std::vector<int> cols_;
+  std::vector<int> diag_;
+  std::vector<int> src_;
+
+  // L (unit diagonal, not stored) and U, in place
+  std::vector<float> vals_;
+
+  mutable std::vector<float> work_;
+};
+
+}  // namespace Operators
+}  // namespace Amanzi
+
+#endif
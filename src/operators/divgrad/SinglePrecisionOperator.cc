@@ -0,0 +1,40 @@
+/*
+  License: BSD
+  Authors: ATS developers
+
+  An Operator whose inverse is approximated by SinglePrecisionILU.
+*/
+
+#include "errors.hh"
+
+#include "SinglePrecisionOperator.hh"
+
+namespace Amanzi {
+namespace Operators {
+
+/* ******************************************************************
+ * Refactor from the assembled matrix, which must be cell-centered.
+ ****************************************************************** */
+void SinglePrecisionOperator::Update() {
+  const Epetra_CrsMatrix& A = *op_->A();
+  const CompositeVectorSpace& space = op_->DomainMap();
+  if (space.size() != 1 || !space.HasComponent("cell") ||
+      A.NumMyRows() != space.Mesh()->num_entities(AmanziMesh::CELL, AmanziMesh::OWNED)) {
+    Errors::Message msg("SinglePrecisionOperator: \"single precision ilu\" is only supported for cell-centered discretizations.");
+    Exceptions::amanzi_throw(msg);
+  }
+  ilu_.Update(A);
+}
+
+
+/* ******************************************************************
+ * Y = inv(LU) X, on the cells.
+ ****************************************************************** */
+int SinglePrecisionOperator::ApplyInverse(const CompositeVector& X,
+        CompositeVector& Y) const {
+  return ilu_.ApplyInverse(*X.ViewComponent("cell",false),
+                           *Y.ViewComponent("cell",false));
+}
+
+}  // namespace Operators
+}  // namespace Amanzi
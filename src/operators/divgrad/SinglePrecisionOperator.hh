@@ -0,0 +1,55 @@
+/*
+  License: BSD
+  Authors: ATS developers
+
+  An Operator whose inverse is approximated by SinglePrecisionILU.
+
+  This is the matrix type handed to AmanziSolvers::LinearOperatorFactory for
+  the "single precision ilu" preconditioner: Apply() is the double precision
+  Operator, so the Krylov iteration converges to the same tolerance, while
+  ApplyInverse() is the float ILU(0) of its assembled matrix.
+
+  The assembled matrix must have one row per owned cell, in order, so only
+  cell-centered discretizations are supported.
+*/
+
+#ifndef OPERATORS_SINGLE_PRECISION_OPERATOR_HH_
+#define OPERATORS_SINGLE_PRECISION_OPERATOR_HH_
+
+#include "Teuchos_RCP.hpp"
+
+#include "CompositeVector.hh"
+#include "CompositeVectorSpace.hh"
+#include "Operator.hh"
+
+#include "SinglePrecisionILU.hh"
+
+namespace Amanzi {
+namespace Operators {
+
+class SinglePrecisionOperator {
+ public:
+  explicit SinglePrecisionOperator(const Teuchos::RCP<Operator>& op) : op_(op) {}
+
+  // Refactor from the operator's assembled matrix.
+  void Update();
+
+  int Apply(const CompositeVector& X, CompositeVector& Y) const {
+    return op_->Apply(X, Y);
+  }
+  int ApplyInverse(const CompositeVector& X, CompositeVector& Y) const;
+
+  const CompositeVectorSpace& DomainMap() const { return op_->DomainMap(); }
+  const CompositeVectorSpace& RangeMap() const { return op_->RangeMap(); }
+
+  const SinglePrecisionILU& ilu() const { return ilu_; }
+
+ protected:
+  Teuchos::RCP<Operator> op_;
+  SinglePrecisionILU ilu_;
+};
+
+}  // namespace Operators
+}  // namespace Amanzi
+
+#endif
@@ -0,0 +1,142 @@
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "UnitTest++.h"
+
+#include "Teuchos_RCP.hpp"
+#include "Epetra_MpiComm.h"
+#include "Epetra_Map.h"
+#include "Epetra_CrsMatrix.h"
+#include "Epetra_Vector.h"
+
+#include "SinglePrecisionILU.hh"
+
+using namespace Amanzi;
+
+// 5-point Laplacian on an nx x ny grid, with a contrast of kappa between the
+// x and y conductances, and eliminated Dirichlet rows on the left edge.
+Teuchos::RCP<Epetra_CrsMatrix> laplacian(const Epetra_Map& map, int nx, int ny,
+        double kappa) {
+  Teuchos::RCP<Epetra_CrsMatrix> A = Teuchos::rcp(new Epetra_CrsMatrix(Copy, map, 5));
+  for (int lid=0; lid!=map.NumMyElements(); ++lid) {
+    int gid = map.GID(lid);
+    int i = gid % nx;
+    int j = gid / nx;
+
+    std::vector<int> inds;
+    std::vector<double> vals;
+    if (i == 0) {
+      inds.push_back(gid); vals.push_back(1.);
+    } else {
+      double diag = 1.;
+      if (i > 1) { inds.push_back(gid-1); vals.push_back(-1.); }
+      if (i < nx-1) { inds.push_back(gid+1); vals.push_back(-1.); diag += 1.; }
+      if (j > 0) { inds.push_back(gid-nx); vals.push_back(-kappa); diag += kappa; }
+      if (j < ny-1) { inds.push_back(gid+nx); vals.push_back(-kappa); diag += kappa; }
+      inds.push_back(gid); vals.push_back(diag);
+    }
+    A->InsertGlobalValues(gid, inds.size(), &vals[0], &inds[0]);
+  }
+  A->FillComplete();
+  return A;
+}
+
+
+// Preconditioned CG in double precision.  Returns the number of iterations
+// to reduce the residual by tol, or -1.
+int pcg(const Epetra_CrsMatrix& A, const Operators::SinglePrecisionILU& pc,
+        const Epetra_Vector& b, Epetra_Vector& x, double tol, int max_its) {
+  Epetra_Vector r(b), z(b), p(b), Ap(b);
+  A.Multiply(false, x, Ap);
+  r.Update(-1., Ap, 1.);
+
+  double rnorm0;
+  b.Norm2(&rnorm0);
+  pc.ApplyInverse(r, z);
+  p = z;
+  double rz;
+  r.Dot(z, &rz);
+
+  for (int k=0; k!=max_its; ++k) {
+    A.Multiply(false, p, Ap);
+    double pAp;
+    p.Dot(Ap, &pAp);
+    double alpha = rz / pAp;
+    x.Update(alpha, p, 1.);
+    r.Update(-alpha, Ap, 1.);
+
+    double rnorm;
+    r.Norm2(&rnorm);
+    if (rnorm <= tol * rnorm0) return k+1;
+
+    pc.ApplyInverse(r, z);
+    double rz_new;
+    r.Dot(z, &rz_new);
+    p.Update(1., z, rz_new / rz);
+    rz = rz_new;
+  }
+  return -1;
+}
+
+
+TEST(SINGLE_PRECISION_ILU_TRIDIAGONAL) {
+  // ILU(0) of a tridiagonal matrix is its LU, so on one process the
+  // preconditioner is a direct solve, exact to single precision.
+  Epetra_MpiComm comm(MPI_COMM_WORLD);
+  if (comm.NumProc() > 1) return;
+
+  int n = 50;
+  Epetra_Map map(n, 0, comm);
+  Teuchos::RCP<Epetra_CrsMatrix> A = laplacian(map, n, 1, 0.);
+
+  Operators::SinglePrecisionILU pc;
+  pc.Update(*A);
+  CHECK(pc.bytes() < A->NumMyNonzeros() * (sizeof(double) + sizeof(int)));
+
+  Epetra_Vector x(map), b(map), y(map);
+  for (int i=0; i!=n; ++i) x[i] = std::sin(0.1*i);
+  A->Multiply(false, x, b);
+  pc.ApplyInverse(b, y);
+
+  y.Update(-1., x, 1.);
+  double err, xnorm;
+  y.NormInf(&err);
+  x.NormInf(&xnorm);
+  CHECK(err < 1.e-4 * xnorm);
+}
+
+
+TEST(SINGLE_PRECISION_ILU_OUTER_DOUBLE) {
+  // The outer double precision iteration converges well below single
+  // precision, and the float factors are still an effective preconditioner.
+  Epetra_MpiComm comm(MPI_COMM_WORLD);
+  int n = 40;
+  Epetra_Map map(n*n, 0, comm);
+  Teuchos::RCP<Epetra_CrsMatrix> A = laplacian(map, n, n, 100.);
+
+  Operators::SinglePrecisionILU pc;
+  pc.Update(*A);
+
+  Epetra_Vector x_true(map), b(map), x(map);
+  x_true.Random();
+  A->Multiply(false, x_true, b);
+
+  x.PutScalar(0.);
+  int its = pcg(*A, pc, b, x, 1.e-12, 500);
+  if (comm.MyPID() == 0) std::cout << "PCG with single precision ILU: " << its << " iterations" << std::endl;
+  CHECK(its > 0);
+
+  x.Update(-1., x_true, 1.);
+  double err, xnorm;
+  x.Norm2(&err);
+  x_true.Norm2(&xnorm);
+  CHECK(err < 1.e-8 * xnorm);
+
+  // refactoring with the same pattern gives the same preconditioner
+  A->Scale(2.);
+  pc.Update(*A);
+  x.PutScalar(0.);
+  int its2 = pcg(*A, pc, b, x, 1.e-12, 500);
+  CHECK_EQUAL(its, its2);
+}
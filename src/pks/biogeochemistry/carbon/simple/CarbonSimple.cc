@@ -9,6 +9,7 @@ Author: Ethan Coon
 Process kernel for energy equation for Richard's flow.
 ------------------------------------------------------------------------- */
 
+#include "PoolTurnoverExponential.hh"
 #include "CarbonSimple.hh"
 
 namespace Amanzi {
@@ -25,6 +26,7 @@ CarbonSimple::CarbonSimple(Teuchos::ParameterList& pk_tree,
     is_diffusion_(false),
     is_source_(false),
     is_decomp_(false),
+    is_exponential_(false),
     npools_(-1)
 {}
 
@@ -70,10 +72,75 @@ CarbonSimple::Setup(const Teuchos::Ptr<State>& S) {
   if (is_decomp_) {
     decomp_key_ = plist_->get<std::string>("decomposition rate", "carbon_decomposition_rate");
 
-    S->RequireField(div_diff_flux_key_)->SetMesh(mesh_)
+    S->RequireField(decomp_key_)->SetMesh(mesh_)
         ->AddComponent("cell", AmanziMesh::CELL, npools_);
-    S->RequireFieldEvaluator(div_diff_flux_key_);
+    S->RequireFieldEvaluator(decomp_key_);
+  }
+
+  // exact integration of turnover, which replaces decomposition
+  is_exponential_ = plist_->isSublist("exponential turnover");
+  if (is_exponential_) {
+    Teuchos::ParameterList& exp_list = plist_->sublist("exponential turnover");
+    decay_key_ = exp_list.get<std::string>("pool decay rate key", "soil_carbon_decay_rate");
+    S->RequireField(decay_key_)->SetMesh(mesh_)
+        ->AddComponent("cell", AmanziMesh::CELL, npools_);
+    S->RequireFieldEvaluator(decay_key_);
+
+    turnover_ = Teuchos::rcp(new PoolTurnoverExponential(exp_list.sublist("models"), npools_));
+  }
+}
+
+
+// Initialize owned (dependent) variables.
+void
+CarbonSimple::Initialize(const Teuchos::Ptr<State>& S) {
+  PK_Physical_Explicit_Default::Initialize(S);
+
+  if (is_exponential_) {
+    turnover_->Initialize(mesh_);
+    solution_split_ = Teuchos::rcp(new TreeVector(*solution_));
+  }
+}
+
+
+// Advance from state S0 to state S1 at time S0.time + dt.
+bool
+CarbonSimple::AdvanceStep(double t_old, double t_new, bool reinit) {
+  if (!is_exponential_)
+    return PK_Physical_Explicit_Default::AdvanceStep(t_old, t_new, reinit);
+
+  double dt = t_new - t_old;
+  Teuchos::OSTab out = vo_->getOSTab();
+  if (vo_->os_OK(Teuchos::VERB_HIGH))
+    *vo_->os() << "----------------------------------------------------------------" << std::endl
+               << "Advancing: t0 = " << S_inter_->time()
+               << " t1 = " << S_next_->time() << " h = " << dt << std::endl
+               << "----------------------------------------------------------------" << std::endl;
+
+  State_to_Solution(S_inter_, *solution_old_);
+  State_to_Solution(S_next_, *solution_);
+
+  // rates at the start of the step
+  S_inter_->GetFieldEvaluator(decay_key_)->HasFieldChanged(S_inter_.ptr(), name_);
+  const Epetra_MultiVector& k = *S_inter_->GetFieldData(decay_key_)
+      ->ViewComponent("cell",false);
+
+  // half a step of turnover
+  *solution_split_ = *solution_old_;
+  turnover_->Apply(0.5*dt, k, *solution_split_->Data()->ViewComponent("cell",false));
+
+  // a step of cryoturbation and sources
+  if (is_diffusion_ || is_source_) {
+    time_stepper_->TimeStep(t_old, dt, *solution_split_, *solution_);
+  } else {
+    *solution_ = *solution_split_;
   }
+
+  // half a step of turnover
+  turnover_->Apply(0.5*dt, k, *solution_->Data()->ViewComponent("cell",false));
+
+  ChangedSolution();
+  return false;
 }
 
 
@@ -156,7 +223,8 @@ CarbonSimple::AddSources_(const Teuchos::Ptr<State>& S,
 void
 CarbonSimple::AddDecomposition_(const Teuchos::Ptr<State>& S,
         const Teuchos::Ptr<CompositeVector>& g) {
-  if (is_decomp_) {
+  // with exponential turnover, decomposition is integrated separately
+  if (is_decomp_ && !is_exponential_) {
     S->GetFieldEvaluator(decomp_key_)->HasFieldChanged(S, name_);
     Teuchos::RCP<const CompositeVector> src = S->GetFieldData(decomp_key_);
     g->Update(1., *src, 1.);
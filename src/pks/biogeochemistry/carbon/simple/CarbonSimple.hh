@@ -19,6 +19,22 @@ Process kernel for energy equation for Richard's flow.
 namespace Amanzi {
 namespace BGC {
 
+class PoolTurnoverExponential;
+
+//
+// With an "exponential turnover" sublist, the linear turnover and transfer
+// between pools is integrated exactly by PoolTurnoverExponential, and only
+// cryoturbation and sources are left to the explicit integrator, by Strang
+// splitting: half a step of turnover, a step of the rest, half a step of
+// turnover.  The decomposition term is then not part of Functional().  The
+// list includes:
+//
+// * "pool decay rate key" [string] "soil_carbon_decay_rate", the first order
+//   turnover rate of each pool, held fixed over a step.
+// * "models" [list] one sublist per region, each with a "region" and the
+//   Century model's "percent sand".
+//
+
 class CarbonSimple : public PK_Physical_Explicit_Default {
 
  public:
@@ -34,8 +50,7 @@ class CarbonSimple : public PK_Physical_Explicit_Default {
   virtual void Setup(const Teuchos::Ptr<State>& S);
 
   // -- Initialize owned (dependent) variables.
-  // default ok?
-  // virtual void initialize(const Teuchos::Ptr<State>& S);
+  virtual void Initialize(const Teuchos::Ptr<State>& S);
 
   // -- Commit any secondary (dependent) variables.
   virtual void CommitStep(double t_old, double t_new, const Teuchos::RCP<State>& S) {};
@@ -49,6 +64,9 @@ class CarbonSimple : public PK_Physical_Explicit_Default {
 
   virtual std::string name(){return "carbon simple";};
 
+  // -- Advance from state S0 to state S1 at time S0.time + dt.
+  virtual bool AdvanceStep(double t_old, double t_new, bool reinit);
+
  protected:
 
   virtual void ApplyDiffusion_(const Teuchos::Ptr<State>& S,
@@ -73,6 +91,11 @@ class CarbonSimple : public PK_Physical_Explicit_Default {
   bool is_decomp_;
   Key decomp_key_;
 
+  bool is_exponential_;
+  Key decay_key_;
+  Teuchos::RCP<PoolTurnoverExponential> turnover_;
+  Teuchos::RCP<TreeVector> solution_split_;
+
  private:
   // factory registration
   static RegisteredPKFactory<CarbonSimple> reg_;
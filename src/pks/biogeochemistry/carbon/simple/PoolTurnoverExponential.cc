@@ -0,0 +1,231 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/* -------------------------------------------------------------------------
+ATS
+
+License: see $ATS_DIR/COPYRIGHT
+Author: ATS developers
+
+Exact integration of first order turnover and transfer between carbon pools.
+------------------------------------------------------------------------- */
+
+#include <algorithm>
+#include <cmath>
+
+#include "dbc.hh"
+#include "errors.hh"
+
+#include "century_model.hh"
+#include "PoolTurnoverExponential.hh"
+
+namespace Amanzi {
+namespace BGC {
+
+namespace {
+
+// C = A B, all n x n row-major.
+void
+multiply(int n, const double* A, const double* B, double* C) {
+  for (int i=0; i!=n; ++i) {
+    for (int j=0; j!=n; ++j) C[i*n+j] = 0.;
+    for (int l=0; l!=n; ++l) {
+      double a = A[i*n+l];
+      for (int j=0; j!=n; ++j) C[i*n+j] += a * B[l*n+j];
+    }
+  }
+}
+
+// Solve D X = N in place of N, destroying D.  Gaussian elimination with
+// partial pivoting.
+void
+solve(int n, double* D, double* N) {
+  for (int k=0; k!=n; ++k) {
+    int piv = k;
+    for (int i=k+1; i!=n; ++i)
+      if (std::abs(D[i*n+k]) > std::abs(D[piv*n+k])) piv = i;
+    if (piv != k) {
+      for (int j=0; j!=n; ++j) {
+        std::swap(D[k*n+j], D[piv*n+j]);
+        std::swap(N[k*n+j], N[piv*n+j]);
+      }
+    }
+    for (int i=k+1; i!=n; ++i) {
+      double f = D[i*n+k] / D[k*n+k];
+      if (f == 0.) continue;
+      for (int j=k; j!=n; ++j) D[i*n+j] -= f * D[k*n+j];
+      for (int j=0; j!=n; ++j) N[i*n+j] -= f * N[k*n+j];
+    }
+  }
+  for (int k=n-1; k>=0; --k) {
+    for (int j=0; j!=n; ++j) {
+      double s = N[k*n+j];
+      for (int l=k+1; l!=n; ++l) s -= D[k*n+l] * N[l*n+j];
+      N[k*n+j] = s / D[k*n+k];
+    }
+  }
+}
+
+} // namespace
+
+
+void
+turnoverOperator(const Epetra_SerialDenseVector& resp_frac,
+                 const Epetra_SerialDenseMatrix& transfer_frac,
+                 const double* k, double* A) {
+  // Tij[p][n] is the fraction of the turnover of p transferred to n
+  const Epetra_SerialDenseMatrix& Tij = transfer_frac;
+  int npools = resp_frac.Length();
+  for (int n=0; n!=npools; ++n) {
+    for (int p=0; p!=npools; ++p) {
+      A[n*npools+p] = k[p] * Tij[p][n] * (1 - resp_frac[p]);
+    }
+    A[n*npools+n] -= k[n];
+  }
+}
+
+
+void
+matrixExponential(int n, const double* A, double* E, double* work) {
+  const int nn = n*n;
+  double* X = work;
+  double* Xk = work + nn;
+  double* tmp = work + 2*nn;
+  double* N = work + 3*nn;
+  double* D = work + 4*nn;
+
+  // scale so that |A|_inf / 2^s <= 1/2
+  double norm = 0.;
+  for (int i=0; i!=n; ++i) {
+    double row = 0.;
+    for (int j=0; j!=n; ++j) row += std::abs(A[i*n+j]);
+    norm = std::max(norm, row);
+  }
+  int s = norm > 0.5 ? (int) std::ceil(std::log2(norm / 0.5)) : 0;
+  double scale = std::ldexp(1., -s);
+  for (int i=0; i!=nn; ++i) X[i] = A[i] * scale;
+
+  // N = sum c_j X^j, D = sum (-1)^j c_j X^j
+  const int q = 6;
+  double c = 1.;
+  for (int i=0; i!=nn; ++i) {
+    N[i] = D[i] = 0.;
+    Xk[i] = 0.;
+  }
+  for (int i=0; i!=n; ++i) N[i*n+i] = D[i*n+i] = Xk[i*n+i] = 1.;
+  for (int j=1; j<=q; ++j) {
+    c *= (double) (q - j + 1) / (j * (2*q - j + 1));
+    multiply(n, Xk, X, tmp);
+    std::copy(tmp, tmp+nn, Xk);
+    double sign = (j % 2) ? -1. : 1.;
+    for (int i=0; i!=nn; ++i) {
+      N[i] += c * Xk[i];
+      D[i] += sign * c * Xk[i];
+    }
+  }
+  solve(n, D, N);
+
+  // square s times
+  for (int l=0; l!=s; ++l) {
+    multiply(n, N, N, tmp);
+    std::copy(tmp, tmp+nn, N);
+  }
+  std::copy(N, N+nn, E);
+}
+
+
+PoolTurnoverExponential::PoolTurnoverExponential(Teuchos::ParameterList& plist,
+        int npools) :
+    npools_(npools),
+    dt_(-1.) {
+  std::vector<std::string> regions;
+  for (Teuchos::ParameterList::ConstIterator lcv=plist.begin();
+       lcv!=plist.end(); ++lcv) {
+    std::string name = lcv->first;
+    if (!plist.isSublist(name)) continue;
+    Teuchos::ParameterList& model_list = plist.sublist(name);
+    regions.push_back(model_list.get<std::string>("region"));
+
+    // currently only handles century!
+    if (model_list.get<std::string>("model type", "century") != "century") {
+      Errors::Message msg;
+      msg << "PoolTurnoverExponential: model \"" << name << "\" is of unknown type \""
+          << model_list.get<std::string>("model type") << "\", only \"century\" is supported.";
+      Exceptions::amanzi_throw(msg);
+    }
+    if (npools_ != 7) {
+      Errors::Message msg("PoolTurnoverExponential: the century model requires 7 carbon pools.");
+      Exceptions::amanzi_throw(msg);
+    }
+
+    resp_frac_.push_back(Epetra_SerialDenseVector());
+    transfer_frac_.push_back(Epetra_SerialDenseMatrix());
+    BGCRelations::centuryPools(model_list.get<double>("percent sand"),
+            resp_frac_.back(), transfer_frac_.back());
+  }
+  if (regions.size() == 0) {
+    Errors::Message msg("PoolTurnoverExponential: no models are given.");
+    Exceptions::amanzi_throw(msg);
+  }
+
+  part_ = Teuchos::rcp(new Functions::MeshPartition(AmanziMesh::CELL, regions));
+  A_.resize(npools_*npools_);
+  work_.resize(5*npools_*npools_);
+}
+
+
+void
+PoolTurnoverExponential::Initialize(const Teuchos::RCP<const AmanziMesh::Mesh>& mesh) {
+  part_->Initialize(mesh, -1);
+  part_->Verify();
+
+  int ncells = mesh->num_entities(AmanziMesh::CELL, AmanziMesh::OWNED);
+  expA_.assign(ncells*npools_*npools_, 0.);
+  k_.assign(ncells*npools_, -1.);
+  dt_ = -1.;
+}
+
+
+void
+PoolTurnoverExponential::Apply(double dt, const Epetra_MultiVector& k,
+        Epetra_MultiVector& C) {
+  ASSERT(k.NumVectors() == npools_);
+  ASSERT(C.NumVectors() == npools_);
+  const int np = npools_;
+  const int nn = np*np;
+  const int ncells = C.MyLength();
+  ASSERT(ncells*nn == expA_.size());
+
+  bool new_dt = dt != dt_;
+  dt_ = dt;
+
+  std::vector<double> Cc(np);
+  for (int c=0; c!=ncells; ++c) {
+    double* E = &expA_[c*nn];
+
+    // recompute the propagator only if the rates of this cell changed
+    double* k_c = &k_[c*np];
+    bool changed = new_dt;
+    for (int p=0; p!=np; ++p) {
+      if (k[p][c] != k_c[p]) {
+        k_c[p] = k[p][c];
+        changed = true;
+      }
+    }
+    if (changed) {
+      int i = (*part_)[c];
+      turnoverOperator(resp_frac_[i], transfer_frac_[i], k_c, &A_[0]);
+      for (int j=0; j!=nn; ++j) A_[j] *= dt;
+      matrixExponential(np, &A_[0], E, &work_[0]);
+    }
+
+    for (int p=0; p!=np; ++p) Cc[p] = C[p][c];
+    for (int n=0; n!=np; ++n) {
+      double Cn = 0.;
+      for (int p=0; p!=np; ++p) Cn += E[n*np+p] * Cc[p];
+      C[n][c] = Cn;
+    }
+  }
+}
+
+} // namespace BGC
+} // namespace Amanzi
@@ -0,0 +1,85 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/* -------------------------------------------------------------------------
+ATS
+
+License: see $ATS_DIR/COPYRIGHT
+Author: ATS developers
+
+Exact integration of first order turnover and transfer between carbon pools.
+
+Turnover of pool p at rate k_p C_p sends a fraction T_pn (1-r_p) of it to
+pool n and respires the rest (Koven et al 13, eqn 1).  Over a step in which
+the rates are frozen, this is the linear system dC/dt = A C, with
+
+  A_np = k_p (T_pn (1-r_p) - delta_np),
+
+solved exactly by C(t+dt) = exp(A dt) C(t).  The fast pools make A stiff, so
+an explicit method is limited to dt ~ 1/max(k), where the exponential is
+limited only by how fast k changes.
+
+The exponential of the small, dense A of each cell is computed by scaling and
+squaring of a Pade approximant, and kept until the cell's rates or the step
+size change.
+------------------------------------------------------------------------- */
+
+#ifndef PKS_CARBON_POOL_TURNOVER_EXPONENTIAL_HH_
+#define PKS_CARBON_POOL_TURNOVER_EXPONENTIAL_HH_
+
+#include <vector>
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+#include "Epetra_MultiVector.h"
+#include "Epetra_SerialDenseVector.h"
+#include "Epetra_SerialDenseMatrix.h"
+
+#include "Mesh.hh"
+#include "MeshPartition.hh"
+
+namespace Amanzi {
+namespace BGC {
+
+// The turnover operator A (row-major, npools x npools) of a cell with decay
+// rates k.
+void
+turnoverOperator(const Epetra_SerialDenseVector& resp_frac,
+                 const Epetra_SerialDenseMatrix& transfer_frac,
+                 const double* k, double* A);
+
+// E = exp(A) for the n x n row-major A, by scaling and squaring of the (6,6)
+// Pade approximant.  work must hold at least 5*n*n doubles.
+void
+matrixExponential(int n, const double* A, double* E, double* work);
+
+
+class PoolTurnoverExponential {
+
+ public:
+  // plist holds one sublist per region, each with a "region" and the
+  // Century model's "percent sand".
+  PoolTurnoverExponential(Teuchos::ParameterList& plist, int npools);
+
+  void Initialize(const Teuchos::RCP<const AmanziMesh::Mesh>& mesh);
+
+  // C <- exp(A(k) dt) C in each cell.
+  void Apply(double dt, const Epetra_MultiVector& k, Epetra_MultiVector& C);
+
+ protected:
+  int npools_;
+  Teuchos::RCP<Functions::MeshPartition> part_;
+  std::vector<Epetra_SerialDenseVector> resp_frac_;
+  std::vector<Epetra_SerialDenseMatrix> transfer_frac_;
+
+  // exp(A dt) of each cell, and the rates and dt it was computed with
+  std::vector<double> expA_;
+  std::vector<double> k_;
+  double dt_;
+
+  std::vector<double> A_, work_;
+};
+
+} // namespace BGC
+} // namespace Amanzi
+
+#endif
@@ -0,0 +1,63 @@
+#include <cmath>
+#include <vector>
+#include "UnitTest++.h"
+
+#include "Epetra_SerialDenseVector.h"
+#include "Epetra_SerialDenseMatrix.h"
+
+#include "century_model.hh"
+#include "PoolTurnoverExponential.hh"
+
+TEST(century_turnover_exponential) {
+  using namespace Amanzi::BGC;
+
+  Epetra_SerialDenseVector resp_frac;
+  Epetra_SerialDenseMatrix transfer_frac;
+  BGCRelations::centuryPools(50., resp_frac, transfer_frac);
+
+  // rates spanning four orders of magnitude, [1/yr]
+  const int n = 7;
+  double k[n] = { 14.8, 3.9, 18.5, 4.9, 7.3, 0.2, 0.0045 };
+  std::vector<double> A(n*n), E(n*n), work(5*n*n);
+  turnoverOperator(resp_frac, transfer_frac, k, &A[0]);
+  matrixExponential(n, &A[0], &E[0], &work[0]);
+
+  double C0[n] = { 1., 2., 3., 4., 5., 6., 7. };
+  double Cexp[n];
+  for (int i=0; i!=n; ++i) {
+    Cexp[i] = 0.;
+    for (int j=0; j!=n; ++j) Cexp[i] += E[i*n+j] * C0[j];
+  }
+
+  // reference: RK4 over a year at a step well inside the stability limit
+  double C[n], k1[n], k2[n], k3[n], k4[n], tmp[n];
+  for (int i=0; i!=n; ++i) C[i] = C0[i];
+  auto rhs = [&](const double* x, double* y) {
+    for (int i=0; i!=n; ++i) {
+      y[i] = 0.;
+      for (int j=0; j!=n; ++j) y[i] += A[i*n+j] * x[j];
+    }
+  };
+  const int nsteps = 10000;
+  double h = 1. / nsteps;
+  for (int s=0; s!=nsteps; ++s) {
+    rhs(C, k1);
+    for (int i=0; i!=n; ++i) tmp[i] = C[i] + 0.5*h*k1[i];
+    rhs(tmp, k2);
+    for (int i=0; i!=n; ++i) tmp[i] = C[i] + 0.5*h*k2[i];
+    rhs(tmp, k3);
+    for (int i=0; i!=n; ++i) tmp[i] = C[i] + h*k3[i];
+    rhs(tmp, k4);
+    for (int i=0; i!=n; ++i) C[i] += h/6. * (k1[i] + 2*k2[i] + 2*k3[i] + k4[i]);
+  }
+
+  for (int i=0; i!=n; ++i) {
+    CHECK_CLOSE(C[i], Cexp[i], 1.e-10 * std::abs(C[i]) + 1.e-14);
+    CHECK(Cexp[i] >= 0.);
+  }
+
+  // carbon is only lost, to respiration
+  double total0 = 0., total = 0.;
+  for (int i=0; i!=n; ++i) { total0 += C0[i]; total += Cexp[i]; }
+  CHECK(total < total0);
+}
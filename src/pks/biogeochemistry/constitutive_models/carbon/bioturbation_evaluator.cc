@@ -6,8 +6,6 @@
   Authors: Ethan Coon (ecoon@lanl.gov)
 */
 
-#include "Epetra_SerialDenseVector.h"
-
 #include "bioturbation_evaluator.hh"
 
 namespace Amanzi {
@@ -15,7 +13,8 @@ namespace BGC {
 namespace BGCRelations {
 
 BioturbationEvaluator::BioturbationEvaluator(Teuchos::ParameterList& plist) :
-    SecondaryVariableFieldEvaluator(plist) {
+    SecondaryVariableFieldEvaluator(plist),
+    col_mesh_(NULL) {
 
   carbon_key_ = plist_.get<std::string>("SOM key", "soil_organic_matter");
   dependencies_.insert(carbon_key_);
@@ -26,13 +25,16 @@ BioturbationEvaluator::BioturbationEvaluator(Teuchos::ParameterList& plist) :
     my_key_ = plist_.get<std::string>("divergence of bioturbation fluxes",
             "div_bioturbation");
   }
+  domain_ = Keys::getDomain(carbon_key_);
 }
 
 
 BioturbationEvaluator::BioturbationEvaluator(const BioturbationEvaluator& other) :
     SecondaryVariableFieldEvaluator(other),
     carbon_key_(other.carbon_key_),
-    diffusivity_key_(other.diffusivity_key_) {}
+    diffusivity_key_(other.diffusivity_key_),
+    domain_(other.domain_),
+    col_mesh_(NULL) {}
 
 Teuchos::RCP<FieldEvaluator>
 BioturbationEvaluator::Clone() const {
@@ -40,60 +42,90 @@ BioturbationEvaluator::Clone() const {
 }
 
 
+void
+BioturbationEvaluator::UpdateColumnGeometry_(const AmanziMesh::Mesh& mesh) {
+  int ncolumns = mesh.num_columns();
+  if (col_mesh_ != &mesh) {
+    col_offsets_.resize(ncolumns+1);
+    col_offsets_[0] = 0;
+    col_cells_.clear();
+    for (int i=0; i!=ncolumns; ++i) {
+      const AmanziMesh::Entity_ID_List& col = mesh.cells_of_column(i);
+      col_cells_.insert(col_cells_.end(), col.begin(), col.end());
+      col_offsets_[i+1] = col_cells_.size();
+    }
+    inv_dz_face_.resize(col_cells_.size());
+    inv_dz_cell_.resize(col_cells_.size());
+    col_mesh_ = &mesh;
+  }
+
+  // geometry, which changes if the mesh deforms
+  for (int i=0; i!=ncolumns; ++i) {
+    int begin = col_offsets_[i];
+    int end = col_offsets_[i+1];
+
+    double z = mesh.cell_centroid(col_cells_[begin])[2];
+    double z_up = z;
+    for (int j=begin; j!=end; ++j) {
+      double z_dn = j+1 != end ? mesh.cell_centroid(col_cells_[j+1])[2] : z;
+      inv_dz_face_[j] = j+1 != end ? 1. / (z - z_dn) : 0.;
+
+      // centroid to centroid, half of each at the interior
+      double dz = (j == begin || j+1 == end) ? (z_up - z_dn) : (z_up - z_dn) / 2.;
+      inv_dz_cell_[j] = dz > 0. ? 1. / dz : 0.;
+
+      z_up = z;
+      z = z_dn;
+    }
+  }
+}
+
+
 // Required methods from SecondaryVariableFieldEvaluator
 void BioturbationEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
         const Teuchos::Ptr<CompositeVector>& result) {
 
   Teuchos::RCP<const CompositeVector> carbon_cv = S->GetFieldData(carbon_key_);
   const AmanziMesh::Mesh& mesh = *carbon_cv->Mesh();
-  
+  if (col_mesh_ != &mesh || S->IsDeformableMesh(domain_)) {
+    UpdateColumnGeometry_(mesh);
+  }
+
   const Epetra_MultiVector& carbon = *carbon_cv->ViewComponent("cell",false);
   const Epetra_MultiVector& diff = *S->GetFieldData(diffusivity_key_)
       ->ViewComponent("cell",false);
   Epetra_MultiVector& res_c = *result->ViewComponent("cell",false);
 
-  // iterate over columns of the mesh
-  int ncolumns = mesh.num_columns();
-  for (int i=0; i<ncolumns; ++i) {
-    // grab the column
-    const AmanziMesh::Entity_ID_List& col = mesh.cells_of_column(i);
-
-    Epetra_SerialDenseVector dC_up(carbon.NumVectors());
-    Epetra_SerialDenseVector dC_dn(carbon.NumVectors());
-
-    // loop over column, getting cell index ci and cell c
-    int ci=0;
-    for (AmanziMesh::Entity_ID_List::const_iterator c=col.begin(); c!=col.end(); ++c, ++ci) {
-      double my_z = mesh.cell_centroid(*c)[2];
-      double dz_up = 0.;
-      double dz_dn = 0.;
-      
-      if (ci != 0) {
-        double my_z = mesh.cell_centroid(*c)[2];
-        int c_up = col[ci-1];
-        dz_up = mesh.cell_centroid(c_up)[2] - my_z;
-
-        for (int p=0; p!=carbon.NumVectors(); ++p) {
-          dC_up[p] = (diff[p][*c]+diff[p][c_up]) / 2. * (carbon[p][*c] - carbon[p][c_up]) / dz_up;
-        }
-      }
-
-      if (ci != col.size()-1) {
-        int c_dn = col[ci+1];
-        dz_dn = mesh.cell_centroid(c_dn)[2] - my_z;
+  double** carbon_v; carbon.ExtractView(&carbon_v);
+  double** diff_v; diff.ExtractView(&diff_v);
+  double** res_v; res_c.ExtractView(&res_v);
+  const int npools = carbon.NumVectors();
+  const int ncolumns = col_offsets_.size() - 1;
 
-        for (int p=0; p!=carbon.NumVectors(); ++p) {
-          dC_dn[p] = (diff[p][*c]+diff[p][c_dn]) / 2. * (carbon[p][c_dn] - carbon[p][*c]) / dz_up;
-        }
-      }
-
-      double dz = dz_dn == 0. ? dz_up :
-          dz_up == 0. ? dz_dn : (dz_up + dz_dn) / 2.;
-      for (int p=0; p!=carbon.NumVectors(); ++p) {
-        res_c[p][*c] = (dC_dn[p] - dC_up[p]) / dz;
+  // Iterate over columns of the mesh.  The flux through the bottom of a
+  // cell, positive downward, is carried to the next cell as the flux
+  // through its top.
+  for (int i=0; i<ncolumns; ++i) {
+    const int begin = col_offsets_[i];
+    const int end = col_offsets_[i+1];
+    const AmanziMesh::Entity_ID* col = &col_cells_[0];
+    const double* inv_dz_face = &inv_dz_face_[0];
+    const double* inv_dz_cell = &inv_dz_cell_[0];
+
+    for (int p=0; p!=npools; ++p) {
+      const double* C = carbon_v[p];
+      const double* D = diff_v[p];
+      double* res = res_v[p];
+
+      double flux_up = 0.;
+      for (int j=begin; j!=end; ++j) {
+        int c = col[j];
+        int c_dn = j+1 != end ? col[j+1] : c;
+        double flux_dn = (D[c] + D[c_dn]) / 2. * (C[c] - C[c_dn]) * inv_dz_face[j];
+        res[c] = (flux_up - flux_dn) * inv_dz_cell[j];
+        flux_up = flux_dn;
       }
     }
-    
   }
 }
 
@@ -3,12 +3,21 @@
 /*
   Evaluates bioturbation of carbon -- simple diffusion model.
 
+  Diffusion is vertical only, within each column of the mesh.  The column
+  structure and the centroid spacings are cached, and refreshed only if the
+  mesh changes or deforms, so that evaluation does no allocation and no mesh
+  queries.  Columns write only their own cells, and may be evaluated
+  independently.
+
   Authors: Ethan Coon (ecoon@lanl.gov)
 */
 
 #ifndef AMANZI_BGCRELATIONS_BIOTURBATION_HH_
 #define AMANZI_BGCRELATIONS_BIOTURBATION_HH_
 
+#include <vector>
+
+#include "Mesh.hh"
 #include "factory.hh"
 #include "secondary_variable_field_evaluator.hh"
 
@@ -29,14 +38,29 @@ class BioturbationEvaluator : public SecondaryVariableFieldEvaluator {
   virtual void EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
           Key wrt_key, const Teuchos::Ptr<CompositeVector>& result);
 
+protected:
+  // Cache the columns of mesh, flattened, and the inverse distances used in
+  // the fluxes.
+  void UpdateColumnGeometry_(const AmanziMesh::Mesh& mesh);
+
 protected:
   Key carbon_key_;
   Key diffusivity_key_;
+  Key domain_;
 
- private:
-  static Utils::RegisteredFactory<FieldEvaluator,BioturbationEvaluator> fac_;
+  // cells of column i are col_cells_[col_offsets_[i]:col_offsets_[i+1]],
+  // top to bottom
+  const AmanziMesh::Mesh* col_mesh_;
+  std::vector<int> col_offsets_;
+  std::vector<AmanziMesh::Entity_ID> col_cells_;
 
+  // 1 / (z_c - z_dn) below each cell of a column, 0 below the bottom one,
+  // and 1 / dz of each cell, by position in col_cells_
+  std::vector<double> inv_dz_face_;
+  std::vector<double> inv_dz_cell_;
 
+ private:
+  static Utils::RegisteredFactory<FieldEvaluator,BioturbationEvaluator> fac_;
 
 };
 
@@ -0,0 +1,51 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/*
+  Pool structure of the 7-pool Century soil carbon model.
+
+  Authors: ATS developers
+*/
+
+#include "Epetra_SerialDenseVector.h"
+#include "Epetra_SerialDenseMatrix.h"
+
+#include "century_model.hh"
+
+namespace Amanzi {
+namespace BGC {
+namespace BGCRelations {
+
+void
+centuryPools(double percent_sand,
+             Epetra_SerialDenseVector& resp_frac,
+             Epetra_SerialDenseMatrix& transfer_frac) {
+  double tt = 0.85 - 0.68 * 0.01 * (100 - percent_sand);
+
+  // initialize the respiration fraction
+  resp_frac.Size(7);
+  resp_frac[0] = 0.0;
+  resp_frac[1] = 0.55;
+  resp_frac[2] = 0.5;
+  resp_frac[3] = 0.5;
+  resp_frac[4] = tt;
+  resp_frac[5] = 0.55;
+  resp_frac[6] = 0.55;
+
+  // initialize conversion factors
+  Epetra_SerialDenseMatrix& Tij = transfer_frac;
+  Tij.Shape(7,7);
+  Tij[0][2] = 0.76;
+  Tij[0][3] = 0.24;
+  Tij[1][4] = 1.0;
+  Tij[2][4] = 1.0;
+  Tij[3][5] = 1.0;
+  Tij[4][5] = 1.0 - 0.004 / (1.0 - tt);
+  Tij[4][6] = 1.0 - Tij[4][5];
+  Tij[5][4] = 0.93;
+  Tij[5][6] = 0.07;
+  Tij[6][4] = 1.0;
+}
+
+} //namespace
+} //namespace
+} //namespace
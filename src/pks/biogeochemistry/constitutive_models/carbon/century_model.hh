@@ -0,0 +1,31 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/*
+  Pool structure of the 7-pool Century soil carbon model.
+
+  Authors: ATS developers
+*/
+
+#ifndef AMANZI_BGCRELATIONS_CENTURY_MODEL_HH_
+#define AMANZI_BGCRELATIONS_CENTURY_MODEL_HH_
+
+class Epetra_SerialDenseVector;
+class Epetra_SerialDenseMatrix;
+
+namespace Amanzi {
+namespace BGC {
+namespace BGCRelations {
+
+// Respiration fraction r_p of each pool and fraction T[p][n] of the turnover
+// of pool p transferred to pool n, given the sand content of the soil, in
+// percent.  Both are sized by this call.
+void
+centuryPools(double percent_sand,
+             Epetra_SerialDenseVector& resp_frac,
+             Epetra_SerialDenseMatrix& transfer_frac);
+
+} // namespace
+} // namespace
+} // namespace
+
+#endif
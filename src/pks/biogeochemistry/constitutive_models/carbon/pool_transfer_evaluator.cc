@@ -10,6 +10,7 @@
 #include "Epetra_SerialDenseVector.h"
 #include "Epetra_SerialDenseMatrix.h"
 
+#include "century_model.hh"
 #include "pool_transfer_evaluator.hh"
 
 namespace Amanzi {
@@ -118,31 +119,10 @@ PoolTransferEvaluator::InitModel_(const Teuchos::Ptr<State>& S, int npools) {
  
 void
 PoolTransferEvaluator::InitCenturyModel_(double percent_sand) {
-  double tt = 0.85 - 0.68 * 0.01 * (100 - percent_sand);
-
-  Epetra_SerialDenseVector RespF(7);
-  // initialize the respiration fraction
-  RespF[0] = 0.0;
-  RespF[1] = 0.55;
-  RespF[2] = 0.5;
-  RespF[3] = 0.5;
-  RespF[4] = tt;
-  RespF[5] = 0.55;
-  RespF[6] = 0.55;
+  Epetra_SerialDenseVector RespF;
+  Epetra_SerialDenseMatrix Tij;
+  centuryPools(percent_sand, RespF, Tij);
   resp_frac_.push_back(RespF);
-  
-  Epetra_SerialDenseMatrix Tij(7,7);
-  // initialize conversion factors
-  Tij[0][2] = 0.76;
-  Tij[0][3] = 0.24;
-  Tij[1][4] = 1.0;
-  Tij[2][4] = 1.0;
-  Tij[3][5] = 1.0;
-  Tij[4][5] = 1.0 - 0.004 / (1.0 - tt);
-  Tij[4][6] = 1.0 - Tij[4][5];
-  Tij[5][4] = 0.93;
-  Tij[5][6] = 0.07;
-  Tij[6][4] = 1.0;
   transfer_frac_.push_back(Tij);
 }
 
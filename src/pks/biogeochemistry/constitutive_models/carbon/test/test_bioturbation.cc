@@ -0,0 +1,149 @@
+#include <cmath>
+#include <string>
+#include <vector>
+#include "UnitTest++.h"
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+#include "Epetra_MpiComm.h"
+
+#include "MeshFactory.hh"
+#include "State.hh"
+#include "primary_variable_field_evaluator.hh"
+
+#include "bioturbation_evaluator.hh"
+
+namespace {
+
+using namespace Amanzi;
+
+const int npools = 2;
+const int ncells = 5;
+
+// One column of ncells cells, 0.2 thick, and the bioturbation of npools
+// pools in it.
+struct ColumnFixture {
+  ColumnFixture() : comm(MPI_COMM_SELF) {
+    Teuchos::ParameterList region_list;
+    Teuchos::RCP<AmanziGeometry::GeometricModel> gm =
+        Teuchos::rcp(new AmanziGeometry::GeometricModel(3, region_list, &comm));
+    AmanziMesh::MeshFactory meshfactory(&comm);
+    AmanziMesh::FrameworkPreference pref;
+    pref.push_back(AmanziMesh::MSTK);
+    meshfactory.preference(pref);
+    mesh = meshfactory(0.,0.,0., 1.,1.,1., 1,1,ncells, gm);
+    mesh->build_columns();
+
+    Teuchos::ParameterList state_list;
+    S = Teuchos::rcp(new State(state_list));
+    S->RegisterDomainMesh(mesh);
+
+    std::vector<std::string> primaries;
+    primaries.push_back("soil_organic_matter");
+    primaries.push_back("cryoturbation_diffusivity");
+    for (const auto& key : primaries) {
+      S->RequireField(key, "test")->SetMesh(mesh)->SetGhosted()
+          ->AddComponent("cell", AmanziMesh::CELL, npools);
+      Teuchos::ParameterList plist(key);
+      plist.set("evaluator name", key);
+      S->SetFieldEvaluator(key, Teuchos::rcp(new PrimaryVariableFieldEvaluator(plist)));
+    }
+
+    S->RequireField("div_bioturbation", "div_bioturbation")->SetMesh(mesh)->SetGhosted()
+        ->AddComponent("cell", AmanziMesh::CELL, npools);
+    Teuchos::ParameterList bio_list("div_bioturbation");
+    bio_list.set("evaluator name", "div_bioturbation");
+    S->SetFieldEvaluator("div_bioturbation",
+                         Teuchos::rcp(new BGC::BGCRelations::BioturbationEvaluator(bio_list)));
+    S->Setup();
+  }
+
+  // The divergence of the fluxes, top to bottom, of carbon[p][i] with
+  // diffusivity diff[p][i], in cell i from the top.
+  std::vector<std::vector<double> >
+  Evaluate(double (*carbon)(int p, int i), double (*diff)(int p, int i)) {
+    const AmanziMesh::Entity_ID_List& col = mesh->cells_of_column(0);
+    Epetra_MultiVector& C = *S->GetFieldData("soil_organic_matter", "test")
+        ->ViewComponent("cell",false);
+    Epetra_MultiVector& D = *S->GetFieldData("cryoturbation_diffusivity", "test")
+        ->ViewComponent("cell",false);
+    for (int p=0; p!=npools; ++p) {
+      for (int i=0; i!=ncells; ++i) {
+        C[p][col[i]] = carbon(p, i);
+        D[p][col[i]] = diff(p, i);
+      }
+    }
+    S->GetField("soil_organic_matter", "test")->set_initialized();
+    S->GetField("cryoturbation_diffusivity", "test")->set_initialized();
+    S->GetField("div_bioturbation", "div_bioturbation")->set_initialized();
+    Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>(
+        S->GetFieldEvaluator("soil_organic_matter"))->SetFieldAsChanged(S.ptr());
+
+    S->GetFieldEvaluator("div_bioturbation")->HasFieldChanged(S.ptr(), "test");
+    const Epetra_MultiVector& res = *S->GetFieldData("div_bioturbation")
+        ->ViewComponent("cell",false);
+    std::vector<std::vector<double> > div(npools, std::vector<double>(ncells));
+    for (int p=0; p!=npools; ++p) {
+      for (int i=0; i!=ncells; ++i) div[p][i] = res[p][col[i]];
+    }
+    return div;
+  }
+
+  Epetra_MpiComm comm;
+  Teuchos::RCP<AmanziMesh::Mesh> mesh;
+  Teuchos::RCP<State> S;
+};
+
+double uniformCarbon(int p, int i) { return 3. + p; }
+double peakedCarbon(int p, int i) { return i == 1 ? 10. + p : 1. + 0.5*i; }
+double linearCarbon(int p, int i) { return 1. + (p+1) * i; }
+double variableDiffusivity(int p, int i) { return 1.e-3 * (1 + i + p); }
+double constantDiffusivity(int p, int i) { return 1.e-3; }
+
+} // namespace
+
+
+// A uniform profile has no fluxes.
+TEST_FIXTURE(ColumnFixture, BIOTURBATION_UNIFORM) {
+  std::vector<std::vector<double> > div = Evaluate(uniformCarbon, variableDiffusivity);
+  for (int p=0; p!=npools; ++p) {
+    for (int i=0; i!=ncells; ++i) CHECK_CLOSE(0., div[p][i], 1.e-14);
+  }
+}
+
+
+// No carbon leaves the column: the divergence sums to zero over its cells,
+// which are all the same thickness.  It is not zero everywhere, and carbon
+// moves away from the peak.
+TEST_FIXTURE(ColumnFixture, BIOTURBATION_CONSERVED) {
+  std::vector<std::vector<double> > div = Evaluate(peakedCarbon, variableDiffusivity);
+  for (int p=0; p!=npools; ++p) {
+    double total = 0.;
+    double scale = 0.;
+    for (int i=0; i!=ncells; ++i) {
+      total += div[p][i];
+      scale += std::abs(div[p][i]);
+    }
+    CHECK(scale > 0.);
+    CHECK_CLOSE(0., total, 1.e-12 * scale);
+    CHECK(div[p][1] < 0.);
+    CHECK(div[p][0] > 0.);
+    CHECK(div[p][2] > 0.);
+  }
+}
+
+
+// A linear profile with constant diffusivity has a constant flux, so only the
+// end cells, which have no flux through the top or bottom of the column,
+// change.  Carbon increases with depth, so it moves up: D (dC/dz) / dz into
+// the top cell, and out of the bottom one.
+TEST_FIXTURE(ColumnFixture, BIOTURBATION_LINEAR) {
+  std::vector<std::vector<double> > div = Evaluate(linearCarbon, constantDiffusivity);
+  double dz = 1. / ncells;
+  for (int p=0; p!=npools; ++p) {
+    double flux = 1.e-3 * (p+1) / dz;
+    CHECK_CLOSE(flux / dz, div[p][0], 1.e-10);
+    for (int i=1; i!=ncells-1; ++i) CHECK_CLOSE(0., div[p][i], 1.e-10);
+    CHECK_CLOSE(-flux / dz, div[p][ncells-1], 1.e-10);
+  }
+}
@@ -0,0 +1,78 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+/* -------------------------------------------------------------------------
+   ATS
+
+   License: see $ATS_DIR/COPYRIGHT
+   Author: ATS developers
+
+   Helpers for deforming only the part of a mesh that actually moves.
+   ------------------------------------------------------------------------- */
+
+#include "deform_helpers.hh"
+
+namespace Amanzi {
+namespace Deform {
+
+int
+RestoreNodeCoordinates(AmanziMesh::Mesh& mesh,
+                       const Epetra_MultiVector& coords)
+{
+  int dim = mesh.space_dimension();
+  AmanziMesh::Entity_ID_List node_ids;
+  AmanziGeometry::Point_List old_positions;
+
+  AmanziGeometry::Point current(dim);
+  for (int n=0; n!=coords.MyLength(); ++n) {
+    mesh.node_get_coordinates(n, &current);
+
+    bool dirty = false;
+    for (int s=0; s!=dim; ++s) dirty |= current[s] != coords[s][n];
+
+    if (dirty) {
+      AmanziGeometry::Point old(dim);
+      for (int s=0; s!=dim; ++s) old[s] = coords[s][n];
+      node_ids.push_back(n);
+      old_positions.push_back(old);
+    }
+  }
+
+  // the snapshot was a valid mesh, so no need to check validity
+  if (node_ids.size() > 0) {
+    AmanziGeometry::Point_List final_positions;
+    mesh.deform(node_ids, old_positions, false, &final_positions);
+  }
+  return node_ids.size();
+}
+
+
+int
+DisplaceNodesVertically(AmanziMesh::Mesh& mesh,
+                        const Epetra_MultiVector& dz,
+                        bool keep_valid,
+                        std::vector<bool>* moved)
+{
+  int z_index = mesh.space_dimension() - 1;
+  if (moved) moved->assign(dz.MyLength(), false);
+
+  AmanziMesh::Entity_ID_List node_ids;
+  AmanziGeometry::Point_List new_positions;
+  for (int n=0; n!=dz.MyLength(); ++n) {
+    if (dz[0][n] != 0.) {
+      AmanziGeometry::Point coords;
+      mesh.node_get_coordinates(n, &coords);
+      coords[z_index] -= dz[0][n];
+      node_ids.push_back(n);
+      new_positions.push_back(coords);
+      if (moved) (*moved)[n] = true;
+    }
+  }
+
+  if (node_ids.size() > 0) {
+    AmanziGeometry::Point_List final_positions;
+    mesh.deform(node_ids, new_positions, keep_valid, &final_positions);
+  }
+  return node_ids.size();
+}
+
+} // namespace
+} // namespace
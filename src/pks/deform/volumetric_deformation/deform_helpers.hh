@@ -0,0 +1,49 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+/* -------------------------------------------------------------------------
+   ATS
+
+   License: see $ATS_DIR/COPYRIGHT
+   Author: ATS developers
+
+   Helpers for deforming only the part of a mesh that actually moves.
+
+   Mesh::deform() validates every node it is handed, and revalidating the
+   geometry of a node's neighborhood is the dominant cost.  Subsidence
+   typically moves a few columns, and only vertically, so these helpers pass
+   only the dirty nodes to deform().
+   ------------------------------------------------------------------------- */
+
+#ifndef PKS_DEFORM_HELPERS_HH_
+#define PKS_DEFORM_HELPERS_HH_
+
+#include <vector>
+
+#include "Epetra_MultiVector.h"
+#include "Mesh.hh"
+
+namespace Amanzi {
+namespace Deform {
+
+// Move the mesh back to saved node coordinates.  coords is a (ghosted)
+// "node" component with one vector per space dimension.  Only nodes whose
+// position differs from the saved one are moved, so the Mesh recomputes the
+// geometry of their neighborhood only.  Returns the number of nodes moved on
+// this process.
+int
+RestoreNodeCoordinates(AmanziMesh::Mesh& mesh,
+                       const Epetra_MultiVector& coords);
+
+// Column-wise vertical displacement: node n is shifted down by dz[0][n].
+// Nodes with zero displacement are not touched.  If provided, moved is
+// resized to the number of nodes and flags the nodes that moved.  Returns
+// the number of nodes moved on this process.
+int
+DisplaceNodesVertically(AmanziMesh::Mesh& mesh,
+                        const Epetra_MultiVector& dz,
+                        bool keep_valid,
+                        std::vector<bool>* moved=NULL);
+
+} // namespace
+} // namespace
+
+#endif
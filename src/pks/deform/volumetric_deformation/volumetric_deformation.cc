@@ -22,6 +22,7 @@
 #include "LinearOperatorFactory.hh"
 #include "CompositeVectorFunctionFactory.hh"
 
+#include "deform_helpers.hh"
 #include "volumetric_deformation.hh"
 
 #define DEBUG 0
@@ -456,6 +457,11 @@ bool VolumetricDeformation::AdvanceStep(double t_old, double t_new, bool reinit)
   }
 
 
+  // nodes moved this step, if known; used to update only the affected part
+  // of the surface meshes
+  std::vector<bool> moved_nodes;
+  bool moved_known = false;
+
   // only deform if needed
   double dcell_vol_norm(0.);
   dcell_vol_vec->Norm2(&dcell_vol_norm);
@@ -464,6 +470,27 @@ bool VolumetricDeformation::AdvanceStep(double t_old, double t_new, bool reinit)
   
     // Deform the subsurface mesh
     switch (strategy_) {
+    case (DEFORM_STRATEGY_GLOBAL_OPTIMIZATION) : {
+      // the normal equations of dVdz * dz = dV, with the bottom fixed; the
+      // operator's structure is fixed, so only its values are reassembled
+      def_matrix_->Assemble(fixed_node_list.ptr());
+
+      Teuchos::RCP<CompositeVector> nodal_dz_vec =
+          S_next_->GetFieldData(Keys::getKey(domain_,"nodal_dz"), name_);
+      CompositeVector rhs(*nodal_dz_vec);
+      def_matrix_->ApplyRHS(*dcell_vol_vec, rhs.ptr(), fixed_node_list.ptr());
+      operator_->ApplyInverse(rhs, *nodal_dz_vec);
+
+      // dz is upward, and the nodes are displaced downward
+      nodal_dz_vec->Scale(-1.);
+      nodal_dz_vec->ScatterMasterToGhosted("node");
+      DisplaceNodesVertically(*mesh_nc_, *nodal_dz_vec->ViewComponent("node",true),
+                              true, &moved_nodes);
+      moved_known = true;
+
+      solution_evaluator_->SetFieldAsChanged(S_next_.ptr());
+      break;
+    }
     case (DEFORM_STRATEGY_MSTK) : {
       // collect needed data, ghosted
       // -- cell vol
@@ -609,25 +636,16 @@ bool VolumetricDeformation::AdvanceStep(double t_old, double t_new, bool reinit)
 	}
       }
 
-      // deform the mesh
-      Entity_ID_List node_ids(nodal_dz.MyLength());
-      AmanziGeometry::Point_List new_positions(nodal_dz.MyLength());
+      // deform the mesh -- displacement is purely vertical, so only the
+      // nodes of columns that subside are moved
       for (int n=0; n!=nodal_dz.MyLength(); ++n) {
-	node_ids[n] = n;
-	mesh_->node_get_coordinates(n, &new_positions[n]);
 	ASSERT(nodal_dz[0][n] >= 0.);
-	new_positions[n][2] -= nodal_dz[0][n];
-      }
-      AmanziGeometry::Point_List final_positions;
-
-      for (auto&& p : new_positions) {
-	ASSERT(AmanziGeometry::norm(p) >= 0.);
       }
 
+#if DEBUG
       Teuchos::RCP<const CompositeVector> cv_vec_new = S_next_->GetFieldData(Keys::getKey(domain_,"cell_volume"));
       const Epetra_MultiVector& cv_new = *cv_vec_new->ViewComponent("cell",false);
-      
-#if DEBUG
+
       // DEBUG CRUFT BEGIN
       for (int c=0; c!=cv.MyLength(); ++c) {
         // min vol is rock vol + ice + a bit
@@ -638,8 +656,9 @@ bool VolumetricDeformation::AdvanceStep(double t_old, double t_new, bool reinit)
       }
       // DEBUG CRUFT END
 #endif
-      
-      mesh_nc_->deform(node_ids, new_positions, true, &final_positions);
+
+      DisplaceNodesVertically(*mesh_nc_, nodal_dz, true, &moved_nodes);
+      moved_known = true;
 
       // INSERT EXTRA CODE TO UNDEFORM THE MESH FOR MIN_VOLS!
 
@@ -647,10 +666,6 @@ bool VolumetricDeformation::AdvanceStep(double t_old, double t_new, bool reinit)
       
 #if DEBUG
       // DEBUG CRUFT BEGIN
-      for (auto&& p : final_positions) {
-	ASSERT(AmanziGeometry::norm(p) >= 0.);
-      }
-
       bool changed = S_next_->GetFieldEvaluator(Keys::getKey(domain_,"cell_volume")) -> HasFieldChanged(S_next_.ptr(), name_);
 
       for (int c=0; c!=cv.MyLength(); ++c) {
@@ -692,6 +707,8 @@ bool VolumetricDeformation::AdvanceStep(double t_old, double t_new, bool reinit)
       // get the coords of the node
       AmanziMesh::Entity_ID pnode =
           surf_mesh_->entity_get_parent(AmanziMesh::NODE, i);
+      if (moved_known && !moved_nodes[pnode]) continue;
+
       int dim = mesh_->space_dimension();
       AmanziGeometry::Point coord_domain(dim);
       mesh_->node_get_coordinates(pnode, &coord_domain);
@@ -705,9 +722,13 @@ bool VolumetricDeformation::AdvanceStep(double t_old, double t_new, bool reinit)
       surface_nodeids.push_back(i);
       surface_newpos.push_back(coord_surface);
     }
-    AmanziGeometry::Point_List surface_finpos;
-    surf_mesh_nc_->deform(surface_nodeids, surface_newpos, false, &surface_finpos);
-    surf3d_mesh_nc_->deform(surface3d_nodeids, surface3d_newpos, false, &surface_finpos);
+    if (surface_nodeids.size() > 0) {
+      AmanziGeometry::Point_List surface_finpos;
+      // the flattened surface mesh does not see vertical displacement
+      if (!moved_known)
+        surf_mesh_nc_->deform(surface_nodeids, surface_newpos, false, &surface_finpos);
+      surf3d_mesh_nc_->deform(surface3d_nodeids, surface3d_newpos, false, &surface_finpos);
+    }
   }
 
   {  // update vertex coordinates in state (for checkpointing and error recovery)
@@ -10,6 +10,15 @@ Base energy PK.
 
 This provides the base of an advection-diffusion equation for energy.
 
+With "matrix-free residual" true, the residual's diffusion and advection
+terms are computed together in one sweep over faces, directly from the face
+transmissibilities, rather than by assembling and applying the forward
+diffusion and advection operators.  The assembled operators are then used only
+in the preconditioner.  This requires a cell-centered discretization, face
+conductivities, implicit advection, and a mesh that does not deform.  Only
+two-point finite volume fluxes are computed this way; with other cell-centered
+discretizations, e.g. nonlinear finite volumes, the option is ignored.
+
 ------------------------------------------------------------------------- */
 
 #ifndef PKS_ENERGY_BASE_HH_
@@ -25,6 +34,7 @@ This provides the base of an advection-diffusion equation for energy.
 //#include "PK_PhysicalBDF_ATS.hh"
 #include "pk_physical_bdf_default.hh"
 #include "upwinding.hh"
+#include "fused_residual.hh"
 
 namespace Amanzi {
 
@@ -123,6 +133,11 @@ public:
   virtual void ApplyDiffusion_(const Teuchos::Ptr<State>& S,
           const Teuchos::Ptr<CompositeVector>& f);
 
+  // -- diffusion and advection in one sweep over faces, matrix-free
+  virtual void AddDiffusionAdvectionFused_(const Teuchos::Ptr<State>& S,
+          const Teuchos::Ptr<CompositeVector>& f);
+  void InitializeFusedResidual_(const Teuchos::Ptr<State>& S);
+
  protected:
   int niter_;
 
@@ -160,6 +175,11 @@ public:
   bool precon_used_;
   bool flux_exists_;
   bool jacobian_;
+  bool fused_residual_;
+
+  // owned faces and their transmissibilities, for the matrix-free residual
+  FusedFaces fused_faces_;
+  Teuchos::RCP<CompositeVector> fused_res_;
   
   double T_limit_;
   
@@ -101,6 +101,53 @@ void EnergyBase::ApplyDiffusion_(const Teuchos::Ptr<State>& S,
 };
 
 
+// -------------------------------------------------------------
+// Transmissibilities and orientation of the owned faces, for the
+// matrix-free residual.
+// -------------------------------------------------------------
+void EnergyBase::InitializeFusedResidual_(const Teuchos::Ptr<State>& S) {
+  InitializeFusedFaces(*mesh_, *matrix_diff_, *S->GetFieldData(uw_conductivity_key_),
+                       fused_faces_);
+  fused_res_ = Teuchos::rcp(new CompositeVector(*S->GetFieldData(key_)));
+}
+
+
+// -------------------------------------------------------------
+// Diffusion and advection, div (q h - K grad T), in one sweep over faces.
+//
+// Each owned face computes its conductive and advective fluxes, along its
+// normal, and adds them to its two cells.  Contributions to ghost cells are
+// sent to their owners afterward, so the only communication is one ghost
+// update each of temperature and enthalpy, and one gather of the residual.
+// -------------------------------------------------------------
+void EnergyBase::AddDiffusionAdvectionFused_(const Teuchos::Ptr<State>& S,
+        const Teuchos::Ptr<CompositeVector>& g) {
+  // update the thermal conductivity and enthalpy
+  UpdateConductivityData_(S);
+  S->GetFieldEvaluator(enthalpy_key_)->HasFieldChanged(S, name_);
+  ApplyDirichletBCsToEnthalpy_(S);
+
+  Teuchos::RCP<const CompositeVector> temp = S->GetFieldData(key_);
+  Teuchos::RCP<const CompositeVector> enth = S->GetFieldData(enthalpy_key_);
+  Teuchos::RCP<const CompositeVector> flux = S->GetFieldData(flux_key_);
+  db_->WriteVector(" adv flux", flux.ptr(), true);
+  temp->ScatterMasterToGhosted("cell");
+  enth->ScatterMasterToGhosted("cell");
+
+  fused_res_->PutScalar(0.);
+  AddDiffusionAdvectionFused(*mesh_, fused_faces_,
+          *temp->ViewComponent("cell",true), *enth->ViewComponent("cell",true),
+          *S->GetFieldData(uw_conductivity_key_)->ViewComponent("face",false),
+          *flux->ViewComponent("face",false),
+          bc_markers_, bc_values_, bc_values_adv_,
+          *S->GetFieldData(energy_flux_key_, name_)->ViewComponent("face",false),
+          *fused_res_->ViewComponent("cell",true));
+
+  fused_res_->GatherGhostedToMaster("cell", Add);
+  g->ViewComponent("cell",false)->Update(1., *fused_res_->ViewComponent("cell",false), 1.);
+}
+
+
 // ---------------------------------------------------------------------
 // Add in energy source, which are accumulated by a single evaluator.
 // Note that that evaluator applies the factor of cell volume.
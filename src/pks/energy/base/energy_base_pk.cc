@@ -13,6 +13,7 @@ Author: Ethan Coon
 
 #include "OperatorDiffusionFactory.hh"
 #include "OperatorDiffusion.hh"
+#include "OperatorDiffusionFV.hh"
 #include "upwind_cell_centered.hh"
 #include "upwind_arithmetic_mean.hh"
 #include "upwind_total_flux.hh"
@@ -45,7 +46,8 @@ EnergyBase::EnergyBase(Teuchos::ParameterList& FElist,
     coupled_to_surface_via_flux_(false),
     niter_(0),
     flux_exists_(true),
-    implicit_advection_(true) {
+    implicit_advection_(true),
+    fused_residual_(false) {
 
   if (!plist_->isParameter("conserved quantity suffix"))
     plist_->set("conserved quantity suffix", "energy");
@@ -218,19 +220,35 @@ void EnergyBase::SetupEnergy_(const Teuchos::Ptr<State>& S) {
     }
   }
 
+  //  -- matrix-free residual
+  fused_residual_ = plist_->get<bool>("matrix-free residual", false);
+  if (fused_residual_ &&
+      (coef_location != "upwind: face" || matrix_->RangeMap().HasComponent("face") ||
+       !implicit_advection_ || S->IsDeformableMesh(domain_))) {
+    Errors::Message message;
+    message << name_ << ": \"matrix-free residual\" requires a cell-centered discretization, "
+            << "face conductivities, implicit advection, and a non-deforming mesh.";
+    Exceptions::amanzi_throw(message);
+  }
+  if (fused_residual_ &&
+      Teuchos::rcp_dynamic_cast<Operators::OperatorDiffusionFV>(matrix_diff_) == Teuchos::null) {
+    // Other cell-centered discretizations, e.g. nonlinear FV, have fluxes
+    // that are not two-point, and use the assembled operators.
+    if (vo_->os_OK(Teuchos::VERB_LOW)) {
+      Teuchos::OSTab tab = vo_->getOSTab();
+      *vo_->os() << "\"matrix-free residual\" requires a two-point finite volume "
+                 << "discretization, using the assembled operators." << std::endl;
+    }
+    fused_residual_ = false;
+  }
+
   //    symbolic assemble
   precon_used_ = plist_->isSublist("preconditioner");
   if (precon_used_) {
     preconditioner_->SymbolicAssembleMatrix();
 
     //    Potentially create a linear solver
-    if (plist_->isSublist("linear solver")) {
-      Teuchos::ParameterList linsolve_sublist = plist_->sublist("linear solver");
-      AmanziSolvers::LinearOperatorFactory<Operators::Operator,CompositeVector,CompositeVectorSpace> fac;
-      lin_solver_ = fac.Create(linsolve_sublist, preconditioner_);
-    } else {
-      lin_solver_ = preconditioner_;
-    }
+    lin_solver_ = CreateLinearSolver_();
   }  
 
   // -- advection of enthalpy
@@ -352,6 +370,7 @@ void EnergyBase::Initialize(const Teuchos::Ptr<State>& S) {
     S->GetField(flux_key_, name_)->Initialize(plist_->sublist(flux_key_));
   }
 
+  if (fused_residual_) InitializeFusedResidual_(S);
 };
 
 
@@ -69,10 +69,14 @@ void EnergyBase::Functional(double t_old, double t_new, Teuchos::RCP<TreeVector>
   res->PutScalar(0.0);
 
   // diffusion term, implicit
-  ApplyDiffusion_(S_next_.ptr(), res.ptr());
+  if (fused_residual_) {
+    AddDiffusionAdvectionFused_(S_next_.ptr(), res.ptr());
+  } else {
+    ApplyDiffusion_(S_next_.ptr(), res.ptr());
+  }
 #if DEBUG_FLAG
   db_->WriteVector("K",S_next_->GetFieldData(conductivity_key_).ptr(),true);
-  db_->WriteVector("res (diff)", res.ptr(), true);
+  db_->WriteVector(fused_residual_ ? "res (diff+adv)" : "res (diff)", res.ptr(), true);
 #endif
 
   // accumulation term
@@ -87,14 +91,16 @@ void EnergyBase::Functional(double t_old, double t_new, Teuchos::RCP<TreeVector>
 #endif
 
   // advection term
-  if (implicit_advection_) {
-    AddAdvection_(S_next_.ptr(), res.ptr(), true);
-  } else {
-    AddAdvection_(S_inter_.ptr(), res.ptr(), true);
-  }
+  if (!fused_residual_) {
+    if (implicit_advection_) {
+      AddAdvection_(S_next_.ptr(), res.ptr(), true);
+    } else {
+      AddAdvection_(S_inter_.ptr(), res.ptr(), true);
+    }
 #if DEBUG_FLAG
-  db_->WriteVector("res (adv)", res.ptr());
+    db_->WriteVector("res (adv)", res.ptr());
 #endif
+  }
 
   // source terms
   AddSources_(S_next_.ptr(), res.ptr());
@@ -129,8 +135,10 @@ int EnergyBase::ApplyPreconditioner(Teuchos::RCP<const TreeVector> u, Teuchos::R
   db_->WriteVector("T_res", u->Data().ptr(), true);
 #endif
 
-  // apply the preconditioner
-  int ierr = preconditioner_->ApplyInverse(*u->Data(), *Pu->Data());
+  // apply the preconditioner, or the linear solver with inexact Newton
+  int ierr = forcing_ == Teuchos::null ?
+      preconditioner_->ApplyInverse(*u->Data(), *Pu->Data()) :
+      ApplyLinearSolver_(lin_solver_, *u->Data(), *Pu->Data());
 
 #if DEBUG_FLAG
   db_->WriteVector("PC*T_res", Pu->Data().ptr(), true);
@@ -244,7 +252,7 @@ void EnergyBase::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> u
   preconditioner_diff_->ApplyBCs(true, true);
   if (precon_used_) {
     preconditioner_->AssembleMatrix();
-    preconditioner_->InitPreconditioner(plist_->sublist("preconditioner"));
+    UpdatePreconditionerInverse_();
   }
 };
 
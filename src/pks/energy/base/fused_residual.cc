@@ -0,0 +1,94 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/* -------------------------------------------------------------------------
+ATS
+
+License: see $ATS_DIR/COPYRIGHT
+Author: ATS developers
+
+The face sweep of EnergyBase's matrix-free residual.
+------------------------------------------------------------------------- */
+
+#include "dbc.hh"
+#include "Op.hh"
+#include "OperatorDefs.hh"
+
+#include "fused_residual.hh"
+
+namespace Amanzi {
+namespace Energy {
+
+void InitializeFusedFaces(const AmanziMesh::Mesh& mesh,
+                          Operators::OperatorDiffusion& diff,
+                          const CompositeVector& coef,
+                          FusedFaces& faces) {
+  Teuchos::RCP<CompositeVector> ones = Teuchos::rcp(new CompositeVector(coef));
+  ones->PutScalar(1.);
+  diff.global_operator()->Init();
+  diff.SetScalarCoefficient(ones, Teuchos::null);
+  diff.UpdateMatrices(Teuchos::null, Teuchos::null);
+  const std::vector<WhetStone::DenseMatrix>& Aface = diff.local_matrices()->matrices;
+
+  int nfaces_owned = mesh.num_entities(AmanziMesh::FACE, AmanziMesh::OWNED);
+  ASSERT(Aface.size() >= nfaces_owned);
+  faces.cells.assign(2*nfaces_owned, -1);
+  faces.trans.resize(nfaces_owned);
+
+  AmanziMesh::Entity_ID_List cells;
+  for (int f=0; f!=nfaces_owned; ++f) {
+    mesh.face_get_cells(f, AmanziMesh::USED, &cells);
+    for (int n=0; n!=cells.size(); ++n) {
+      int dir;
+      mesh.face_normal(f, false, cells[n], &dir);
+      faces.cells[2*f + (dir > 0 ? 0 : 1)] = cells[n];
+    }
+    faces.trans[f] = Aface[f](0,0);
+  }
+}
+
+
+void AddDiffusionAdvectionFused(const AmanziMesh::Mesh& mesh,
+                                const FusedFaces& faces,
+                                const Epetra_MultiVector& T_c,
+                                const Epetra_MultiVector& h_c,
+                                const Epetra_MultiVector& K_f,
+                                const Epetra_MultiVector& q_f,
+                                const std::vector<int>& bc_markers,
+                                const std::vector<double>& bc_values,
+                                const std::vector<double>& bc_values_adv,
+                                Epetra_MultiVector& eflux_f,
+                                Epetra_MultiVector& res_c) {
+  int nfaces_owned = faces.trans.size();
+  for (int f=0; f!=nfaces_owned; ++f) {
+    // c1 is the cell the normal points out of
+    int c1 = faces.cells[2*f];
+    int c2 = faces.cells[2*f+1];
+
+    // conductive flux
+    double F = 0.;
+    if (c1 >= 0 && c2 >= 0) {
+      F = faces.trans[f] * K_f[0][f] * (T_c[0][c1] - T_c[0][c2]);
+    } else if (bc_markers[f] == Operators::OPERATOR_BC_DIRICHLET) {
+      F = faces.trans[f] * K_f[0][f] * (c1 >= 0 ?
+              T_c[0][c1] - bc_values[f] : bc_values[f] - T_c[0][c2]);
+    } else if (bc_markers[f] == Operators::OPERATOR_BC_NEUMANN) {
+      // outward flux
+      F = (c1 >= 0 ? 1. : -1.) * bc_values[f] * mesh.face_area(f);
+    }
+    eflux_f[0][f] = F;
+
+    // advected enthalpy, upwinded, with the boundary value on inflow
+    double q = q_f[0][f];
+    if (q >= 0.) {
+      F += q * (c1 >= 0 ? h_c[0][c1] : bc_values_adv[f]);
+    } else {
+      F += q * (c2 >= 0 ? h_c[0][c2] : bc_values_adv[f]);
+    }
+
+    if (c1 >= 0) res_c[0][c1] += F;
+    if (c2 >= 0) res_c[0][c2] -= F;
+  }
+}
+
+} // namespace Energy
+} // namespace Amanzi
@@ -0,0 +1,62 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/* -------------------------------------------------------------------------
+ATS
+
+License: see $ATS_DIR/COPYRIGHT
+Author: ATS developers
+
+The face sweep of EnergyBase's matrix-free residual, div (q h - K grad T), for
+two-point finite volume discretizations.  It is kept apart from the PK so that
+it may be checked against the assembled operators.
+------------------------------------------------------------------------- */
+
+#ifndef PKS_ENERGY_FUSED_RESIDUAL_HH_
+#define PKS_ENERGY_FUSED_RESIDUAL_HH_
+
+#include <vector>
+
+#include "Epetra_MultiVector.h"
+
+#include "Mesh.hh"
+#include "CompositeVector.hh"
+#include "OperatorDiffusion.hh"
+
+namespace Amanzi {
+namespace Energy {
+
+// The owned faces: the cells each one's normal points out of and into (-1 on
+// the boundary), and their transmissibilities.
+struct FusedFaces {
+  std::vector<AmanziMesh::Entity_ID> cells;
+  std::vector<double> trans;
+};
+
+// Take the transmissibilities from the two-point diffusion operator diff,
+// assembled with a unit coefficient in the space of coef, so that the
+// matrix-free and assembled residuals are the same.
+void InitializeFusedFaces(const AmanziMesh::Mesh& mesh,
+                          Operators::OperatorDiffusion& diff,
+                          const CompositeVector& coef,
+                          FusedFaces& faces);
+
+// Add the conductive and advective fluxes of each owned face to its two
+// cells, in the ghosted cell residual res_c, and set the conductive flux
+// eflux_f.  T_c and h_c are ghosted, K_f and q_f owned face values.  Inflow
+// across the boundary carries the enthalpy bc_values_adv.
+void AddDiffusionAdvectionFused(const AmanziMesh::Mesh& mesh,
+                                const FusedFaces& faces,
+                                const Epetra_MultiVector& T_c,
+                                const Epetra_MultiVector& h_c,
+                                const Epetra_MultiVector& K_f,
+                                const Epetra_MultiVector& q_f,
+                                const std::vector<int>& bc_markers,
+                                const std::vector<double>& bc_values,
+                                const std::vector<double>& bc_values_adv,
+                                Epetra_MultiVector& eflux_f,
+                                Epetra_MultiVector& res_c);
+
+} // namespace Energy
+} // namespace Amanzi
+
+#endif
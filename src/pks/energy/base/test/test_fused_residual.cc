@@ -0,0 +1,174 @@
+/*
+  The matrix-free residual of EnergyBase against the assembled diffusion and
+  advection operators.
+*/
+
+#include <cmath>
+#include <vector>
+
+#include "UnitTest++.h"
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+#include "Epetra_MpiComm.h"
+
+#include "GeometricModel.hh"
+#include "MeshFactory.hh"
+#include "CompositeVector.hh"
+#include "CompositeVectorSpace.hh"
+#include "OperatorDefs.hh"
+#include "OperatorDiffusionFactory.hh"
+#include "OperatorDiffusion.hh"
+#include "OperatorAdvection.hh"
+#include "Operator.hh"
+
+#include "fused_residual.hh"
+
+using namespace Amanzi;
+
+TEST(FUSED_RESIDUAL_MATCHES_ASSEMBLED) {
+  Epetra_MpiComm comm(MPI_COMM_WORLD);
+
+  Teuchos::ParameterList region_list;
+  Teuchos::RCP<AmanziGeometry::GeometricModel> gm =
+      Teuchos::rcp(new AmanziGeometry::GeometricModel(3, region_list, &comm));
+  AmanziMesh::MeshFactory meshfactory(&comm);
+  AmanziMesh::FrameworkPreference pref;
+  pref.push_back(AmanziMesh::MSTK);
+  meshfactory.preference(pref);
+  Teuchos::RCP<AmanziMesh::Mesh> mesh = meshfactory(0.,0.,0., 1.,1.,1., 5,4,3, gm);
+
+  int nfaces_owned = mesh->num_entities(AmanziMesh::FACE, AmanziMesh::OWNED);
+  int nfaces_used = mesh->num_entities(AmanziMesh::FACE, AmanziMesh::USED);
+
+  // boundary conditions, as EnergyBase sets them: Dirichlet temperature on
+  // the left, with Dirichlet enthalpy for advection; a Neumann flux on the
+  // right, and no flux elsewhere, with Neumann advection
+  std::vector<int> bc_markers(nfaces_used, Operators::OPERATOR_BC_NONE);
+  std::vector<double> bc_values(nfaces_used, 0.);
+  std::vector<int> bc_markers_adv(nfaces_used, Operators::OPERATOR_BC_NONE);
+  std::vector<double> bc_values_adv(nfaces_used, 0.);
+  std::vector<double> mixed;
+  AmanziMesh::Entity_ID_List cells;
+  for (int f=0; f!=nfaces_used; ++f) {
+    mesh->face_get_cells(f, AmanziMesh::USED, &cells);
+    if (cells.size() != 1) continue;
+    const AmanziGeometry::Point& xf = mesh->face_centroid(f);
+    if (xf[0] < 1.e-10) {
+      bc_markers[f] = Operators::OPERATOR_BC_DIRICHLET;
+      bc_values[f] = 280. + 5. * xf[1];
+      bc_markers_adv[f] = Operators::OPERATOR_BC_DIRICHLET;
+      bc_values_adv[f] = 75. * bc_values[f];
+    } else {
+      bc_markers[f] = Operators::OPERATOR_BC_NEUMANN;
+      bc_values[f] = xf[0] > 1. - 1.e-10 ? 3. : 0.;
+      bc_markers_adv[f] = Operators::OPERATOR_BC_NEUMANN;
+    }
+  }
+  Teuchos::RCP<Operators::BCs> bc = Teuchos::rcp(new Operators::BCs(
+      Operators::OPERATOR_BC_TYPE_FACE, bc_markers, bc_values, mixed));
+  Teuchos::RCP<Operators::BCs> bc_adv = Teuchos::rcp(new Operators::BCs(
+      Operators::OPERATOR_BC_TYPE_FACE, bc_markers_adv, bc_values_adv, mixed));
+
+  // the forward operators
+  Teuchos::ParameterList diff_plist;
+  diff_plist.set("discretization primary", std::string("fv: default"));
+  diff_plist.set("nonlinear coefficient", std::string("upwind: face"));
+  Operators::OperatorDiffusionFactory opfactory;
+  Teuchos::RCP<Operators::OperatorDiffusion> diff = opfactory.Create(diff_plist, mesh, bc);
+  diff->SetTensorCoefficient(Teuchos::null);
+
+  Teuchos::ParameterList adv_plist;
+  Teuchos::RCP<Operators::OperatorAdvection> adv =
+      Teuchos::rcp(new Operators::OperatorAdvection(adv_plist, mesh));
+
+  // fields: conductivity and mass flux on faces, temperature and enthalpy
+  // on cells
+  CompositeVectorSpace face_space;
+  face_space.SetMesh(mesh)->SetGhosted()->SetComponent("face", AmanziMesh::FACE, 1);
+  Teuchos::RCP<CompositeVector> K = Teuchos::rcp(new CompositeVector(face_space));
+  CompositeVector q(face_space), eflux(face_space), eflux_fused(face_space);
+  {
+    Epetra_MultiVector& K_f = *K->ViewComponent("face", false);
+    Epetra_MultiVector& q_f = *q.ViewComponent("face", false);
+    AmanziGeometry::Point velocity(3);
+    for (int f=0; f!=nfaces_owned; ++f) {
+      const AmanziGeometry::Point& xf = mesh->face_centroid(f);
+      K_f[0][f] = 1. + xf[0] + 0.5 * xf[2];
+      velocity[0] = 1. + xf[2];
+      velocity[1] = 0.5 - xf[0];
+      velocity[2] = -0.25;
+      q_f[0][f] = mesh->face_normal(f) * velocity;
+    }
+  }
+  K->ScatterMasterToGhosted("face");
+
+  CompositeVector T(diff->global_operator()->DomainMap());
+  CompositeVectorSpace enth_space;
+  enth_space.SetMesh(mesh)->SetGhosted()
+      ->AddComponent("cell", AmanziMesh::CELL, 1)
+      ->AddComponent("boundary_face", AmanziMesh::BOUNDARY_FACE, 1);
+  CompositeVector h(enth_space);
+  {
+    T.PutScalar(0.);
+    Epetra_MultiVector& T_c = *T.ViewComponent("cell", false);
+    Epetra_MultiVector& h_c = *h.ViewComponent("cell", false);
+    int ncells_owned = T_c.MyLength();
+    for (int c=0; c!=ncells_owned; ++c) {
+      const AmanziGeometry::Point& xc = mesh->cell_centroid(c);
+      T_c[0][c] = 280. + 10. * xc[0] + std::sin(3. * xc[1]) - 2. * xc[2] * xc[2];
+      h_c[0][c] = 75. * T_c[0][c];
+    }
+  }
+  T.ScatterMasterToGhosted("cell");
+  h.ScatterMasterToGhosted("cell");
+
+  // the transmissibilities, from the operator with a unit coefficient
+  Energy::FusedFaces faces;
+  Energy::InitializeFusedFaces(*mesh, *diff, *K, faces);
+  CHECK_EQUAL(nfaces_owned, faces.trans.size());
+
+  // the assembled residual, as in EnergyBase::ApplyDiffusion_ and AddAdvection_
+  CompositeVector res(diff->global_operator()->RangeMap());
+  res.PutScalar(0.);
+  diff->global_operator()->Init();
+  diff->SetScalarCoefficient(K, Teuchos::null);
+  diff->UpdateMatrices(Teuchos::null, Teuchos::null);
+  diff->UpdateFlux(T, eflux);
+  diff->ApplyBCs(true, true);
+  diff->global_operator()->ComputeNegativeResidual(T, res);
+
+  adv->global_operator()->Init();
+  adv->Setup(q);
+  adv->UpdateMatrices(q);
+  adv->ApplyBCs(bc_adv, false);
+  adv->global_operator()->ComputeNegativeResidual(h, res, false);
+
+  // the matrix-free residual
+  CompositeVector res_fused(res);
+  res_fused.PutScalar(0.);
+  CompositeVector res_ghosted(T);
+  res_ghosted.PutScalar(0.);
+  Energy::AddDiffusionAdvectionFused(*mesh, faces,
+          *T.ViewComponent("cell", true), *h.ViewComponent("cell", true),
+          *K->ViewComponent("face", false), *q.ViewComponent("face", false),
+          bc_markers, bc_values, bc_values_adv,
+          *eflux_fused.ViewComponent("face", false),
+          *res_ghosted.ViewComponent("cell", true));
+  res_ghosted.GatherGhostedToMaster("cell", Add);
+  res_fused.ViewComponent("cell", false)->Update(1., *res_ghosted.ViewComponent("cell", false), 0.);
+
+  // compare, relative to the size of the fluxes
+  double norm, diff_norm;
+  res.ViewComponent("cell", false)->NormInf(&norm);
+  res_fused.Update(-1., res, 1.);
+  res_fused.ViewComponent("cell", false)->NormInf(&diff_norm);
+  CHECK(norm > 0.);
+  CHECK_CLOSE(0., diff_norm / norm, 1.e-12);
+
+  eflux.ViewComponent("face", false)->NormInf(&norm);
+  eflux_fused.Update(-1., eflux, 1.);
+  eflux_fused.ViewComponent("face", false)->NormInf(&diff_norm);
+  CHECK(norm > 0.);
+  CHECK_CLOSE(0., diff_norm / norm, 1.e-12);
+}
@@ -0,0 +1,88 @@
+/*
+  Testing of the batch evaluation of three-phase thermal conductivity models:
+  on a list of cells, it gives the pointwise model, and leaves other cells
+  alone.
+*/
+
+#include <vector>
+
+#include "UnitTest++.h"
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+
+#include "thermal_conductivity_threephase_peterslidard.hh"
+#include "thermal_conductivity_threephase_volume_averaged.hh"
+#include "thermal_conductivity_threephase_wetdry.hh"
+
+namespace {
+
+using namespace Amanzi;
+using namespace Amanzi::Energy;
+
+// Checks the batch method of tc, called through the base class, against its
+// pointwise method, on every other cell of a range of states.
+void
+checkBatch(ThermalConductivityThreePhase& tc)
+{
+  const int ncells = 9;
+  std::vector<double> poro(ncells), sat_liq(ncells), sat_ice(ncells), temp(ncells);
+  for (int c=0; c!=ncells; ++c) {
+    poro[c] = 0.2 + 0.05*c;
+    sat_ice[c] = 0.1*c;
+    sat_liq[c] = 1. - sat_ice[c];
+    temp[c] = 260. + 2.*c;
+  }
+
+  AmanziMesh::Entity_ID_List ids;
+  for (int c=0; c<ncells; c+=2) ids.push_back(c);
+
+  std::vector<double> result(ncells, -1.);
+  tc.ThermalConductivityBatch(ids, &poro[0], &sat_liq[0], &sat_ice[0], &temp[0], &result[0]);
+
+  for (int c=0; c!=ncells; ++c) {
+    if (c % 2 == 0) {
+      double expected = tc.ThermalConductivity(poro[c], sat_liq[c], sat_ice[c], temp[c]);
+      CHECK(expected > 0.);
+      CHECK_CLOSE(expected, result[c], 1.e-12 * expected);
+    } else {
+      CHECK_EQUAL(-1., result[c]);
+    }
+  }
+}
+
+Teuchos::ParameterList
+conductivityList()
+{
+  Teuchos::ParameterList plist;
+  plist.set<double>("thermal conductivity of soil [W/(m-K)]", 2.);
+  plist.set<double>("thermal conductivity of ice [W/(m-K)]", 2.2);
+  plist.set<double>("thermal conductivity of liquid [W/(m-K)]", 0.6);
+  plist.set<double>("thermal conductivity of gas [W/(m-K)]", 0.02);
+  plist.set<double>("unsaturated alpha unfrozen [-]", 0.7);
+  plist.set<double>("unsaturated alpha frozen [-]", 0.3);
+  return plist;
+}
+
+} // namespace
+
+
+TEST(THERMAL_CONDUCTIVITY_BATCH_PETERSLIDARD) {
+  Teuchos::ParameterList plist = conductivityList();
+  ThermalConductivityThreePhasePetersLidard tc(plist);
+  checkBatch(tc);
+}
+
+TEST(THERMAL_CONDUCTIVITY_BATCH_VOLUME_AVERAGED) {
+  Teuchos::ParameterList plist = conductivityList();
+  ThermalConductivityThreePhaseVolumeAveraged tc(plist);
+  checkBatch(tc);
+}
+
+TEST(THERMAL_CONDUCTIVITY_BATCH_WETDRY) {
+  Teuchos::ParameterList plist = conductivityList();
+  plist.set<double>("thermal conductivity, dry [W/(m-K)]", 0.3);
+  plist.set<double>("thermal conductivity, saturated (unfrozen) [W/(m-K)]", 1.5);
+  ThermalConductivityThreePhaseWetDry tc(plist);
+  checkBatch(tc);
+}
@@ -15,6 +15,7 @@ UNITS: ????
 #define PK_ENERGY_RELATIONS_TC_THREEPHASE_HH_
 
 #include "dbc.hh"
+#include "MeshDefs.hh"
 
 namespace Amanzi {
 namespace Energy {
@@ -25,6 +26,19 @@ public:
   virtual ~ThermalConductivityThreePhase() {}
 
   virtual double ThermalConductivity(double porosity, double sat_liq, double sat_ice, double temp) = 0;
+
+  // Evaluate on a list of entities, e.g. all cells of a region.  The default
+  // calls the pointwise method; models deriving from
+  // ThermalConductivityThreePhaseBatch inline it instead.
+  virtual void ThermalConductivityBatch(const AmanziMesh::Entity_ID_List& ids,
+          const double* porosity, const double* sat_liq, const double* sat_ice,
+          const double* temp, double* result) {
+    for (int i=0; i!=ids.size(); ++i) {
+      int c = ids[i];
+      result[c] = ThermalConductivity(porosity[c], sat_liq[c], sat_ice[c], temp[c]);
+    }
+  }
+
   virtual double DThermalConductivity_DPorosity(double porosity, double sat_liq, double sat_ice, double temp) {
     ASSERT(false);
     return 0.;
@@ -43,6 +57,33 @@ public:
   }
 };
 
+
+// Base class of models whose batch method calls Model::ThermalConductivity
+// non-virtually, so that the pointwise model is inlined into the loop.  Each
+// model instantiates it in its source file, where the pointwise model is
+// defined, and declares it extern in its header.
+template<class Model>
+class ThermalConductivityThreePhaseBatch : public ThermalConductivityThreePhase {
+
+public:
+  virtual void ThermalConductivityBatch(const AmanziMesh::Entity_ID_List& ids,
+          const double* porosity, const double* sat_liq, const double* sat_ice,
+          const double* temp, double* result);
+};
+
+
+template<class Model>
+void ThermalConductivityThreePhaseBatch<Model>::ThermalConductivityBatch(
+    const AmanziMesh::Entity_ID_List& ids,
+    const double* poro, const double* sat_liq, const double* sat_ice,
+    const double* temp, double* result) {
+  Model& model = static_cast<Model&>(*this);
+  for (int i=0; i!=ids.size(); ++i) {
+    int c = ids[i];
+    result[c] = model.Model::ThermalConductivity(poro[c], sat_liq[c], sat_ice[c], temp[c]);
+  }
+}
+
 } // namespace
 } // namespace
 
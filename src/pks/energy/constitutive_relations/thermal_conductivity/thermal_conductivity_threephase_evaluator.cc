@@ -99,12 +99,9 @@ void ThermalConductivityThreePhaseEvaluator::EvaluateField_(
         AmanziMesh::Entity_ID_List id_list;
         mesh->get_set_entities(region_name, AmanziMesh::CELL, AmanziMesh::OWNED, &id_list);
 
-        // loop over indices
-        for (AmanziMesh::Entity_ID_List::const_iterator id=id_list.begin();
-             id!=id_list.end(); ++id) {
-          result_v[0][*id] = lcv->second->ThermalConductivity(poro_v[0][*id],
-                  sat_v[0][*id], sat2_v[0][*id], temp_v[0][*id]);
-        }
+        // one call per region
+        lcv->second->ThermalConductivityBatch(id_list, poro_v[0],
+                sat_v[0], sat2_v[0], temp_v[0], result_v[0]);
       } else {
         std::stringstream m;
         m << "Thermal conductivity evaluator: unknown region on cells: \"" << region_name << "\"";
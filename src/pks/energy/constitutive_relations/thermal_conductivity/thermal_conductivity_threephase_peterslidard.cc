@@ -31,6 +31,8 @@ double ThermalConductivityThreePhasePetersLidard::ThermalConductivity(double por
     + (1.0 - kersten_f - kersten_u) * k_dry;
 };
 
+template class ThermalConductivityThreePhaseBatch<ThermalConductivityThreePhasePetersLidard>;
+
 void ThermalConductivityThreePhasePetersLidard::InitializeFromPlist_() {
   d_ = 0.053; // unitless empericial parameter
 
@@ -40,7 +40,8 @@ Units: ????
 namespace Amanzi {
 namespace Energy {
 
-class ThermalConductivityThreePhasePetersLidard : public ThermalConductivityThreePhase {
+class ThermalConductivityThreePhasePetersLidard :
+    public ThermalConductivityThreePhaseBatch<ThermalConductivityThreePhasePetersLidard> {
 
 public:
   ThermalConductivityThreePhasePetersLidard(Teuchos::ParameterList& plist);
@@ -67,6 +68,8 @@ private:
 
 };
 
+extern template class ThermalConductivityThreePhaseBatch<ThermalConductivityThreePhasePetersLidard>;
+
 }
 }
 
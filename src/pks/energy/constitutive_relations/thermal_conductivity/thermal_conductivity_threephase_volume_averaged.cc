@@ -28,6 +28,8 @@ double ThermalConductivityThreePhaseVolumeAveraged::ThermalConductivity(double p
       + poro*sat_ice*k_ice_ + poro*(1-sat_liq-sat_ice)*k_gas_;
 };
 
+template class ThermalConductivityThreePhaseBatch<ThermalConductivityThreePhaseVolumeAveraged>;
+
 void ThermalConductivityThreePhaseVolumeAveraged::InitializeFromPlist_() {
   k_soil_ = plist_.get<double>("thermal conductivity of soil [W/(m-K)]");
   k_ice_ = plist_.get<double>("thermal conductivity of ice [W/(m-K)]");
@@ -33,7 +33,8 @@ Units: ????
 namespace Amanzi {
 namespace Energy {
 
-class ThermalConductivityThreePhaseVolumeAveraged : public ThermalConductivityThreePhase {
+class ThermalConductivityThreePhaseVolumeAveraged :
+    public ThermalConductivityThreePhaseBatch<ThermalConductivityThreePhaseVolumeAveraged> {
 
 public:
   ThermalConductivityThreePhaseVolumeAveraged(Teuchos::ParameterList& plist);
@@ -56,6 +57,8 @@ private:
 
 };
 
+extern template class ThermalConductivityThreePhaseBatch<ThermalConductivityThreePhaseVolumeAveraged>;
+
 }
 }
 
@@ -72,6 +72,8 @@ ThermalConductivityThreePhaseWetDry::DThermalConductivity_DTemperature(double po
 }
 
 
+template class ThermalConductivityThreePhaseBatch<ThermalConductivityThreePhaseWetDry>;
+
 void ThermalConductivityThreePhaseWetDry::InitializeFromPlist_() {
   eps_ = plist_.get<double>("epsilon [-]", 1.e-10);
   alpha_u_ = plist_.get<double>("unsaturated alpha unfrozen [-]");
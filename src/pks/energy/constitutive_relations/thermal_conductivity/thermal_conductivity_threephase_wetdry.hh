@@ -39,7 +39,8 @@ Units: ????
 namespace Amanzi {
 namespace Energy {
 
-class ThermalConductivityThreePhaseWetDry : public ThermalConductivityThreePhase {
+class ThermalConductivityThreePhaseWetDry :
+    public ThermalConductivityThreePhaseBatch<ThermalConductivityThreePhaseWetDry> {
 
 public:
   ThermalConductivityThreePhaseWetDry(Teuchos::ParameterList& plist);
@@ -67,6 +68,8 @@ private:
 
 };
 
+extern template class ThermalConductivityThreePhaseBatch<ThermalConductivityThreePhaseWetDry>;
+
 } // namespace
 } // namespace
 
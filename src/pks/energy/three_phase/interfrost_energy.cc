@@ -133,7 +133,7 @@ InterfrostEnergy::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector>
   preconditioner_diff_->ApplyBCs(true, true);
   if (precon_used_) {
     preconditioner_->AssembleMatrix();
-    preconditioner_->InitPreconditioner(plist_->sublist("preconditioner"));
+    UpdatePreconditionerInverse_();
   }
 };
 
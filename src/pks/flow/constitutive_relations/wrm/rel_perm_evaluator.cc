@@ -40,7 +40,8 @@ RelPermEvaluator::RelPermEvaluator(const RelPermEvaluator& other) :
     is_surf_(other.is_surf_),
     surf_domain_(other.surf_domain_),
     perm_scale_(other.perm_scale_),
-    min_val_(other.min_val_) {}
+    min_val_(other.min_val_),
+    region_cells_(other.region_cells_) {}
 
 
 Teuchos::RCP<FieldEvaluator>
@@ -162,9 +163,12 @@ void RelPermEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
   Epetra_MultiVector& res_c = *result->ViewComponent("cell",false);
 
   int ncells = res_c.MyLength();
+  if (region_cells_.empty()) GetRegionCells(*wrms_, ncells, &region_cells_);
+  for (int i=0; i!=wrms_->second.size(); ++i) {
+    wrms_->second[i]->k_relative_batch(region_cells_[i], sat_c[0], res_c[0]);
+  }
   for (unsigned int c=0; c!=ncells; ++c) {
-    int index = (*wrms_->first)[c];
-    res_c[0][c] = std::max(wrms_->second[index]->k_relative(sat_c[0][c]), min_val_);
+    res_c[0][c] = std::max(res_c[0][c], min_val_);
   }
 
   // -- Potentially evaluate the model on boundary faces as well.
@@ -264,9 +268,11 @@ void RelPermEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>
     Epetra_MultiVector& res_c = *result->ViewComponent("cell",false);
 
     int ncells = res_c.MyLength();
+    if (region_cells_.empty()) GetRegionCells(*wrms_, ncells, &region_cells_);
+    for (int i=0; i!=wrms_->second.size(); ++i) {
+      wrms_->second[i]->d_k_relative_batch(region_cells_[i], sat_c[0], res_c[0]);
+    }
     for (unsigned int c=0; c!=ncells; ++c) {
-      int index = (*wrms_->first)[c];
-      res_c[0][c] = wrms_->second[index]->d_k_relative(sat_c[0][c]);
       ASSERT(res_c[0][c] >= 0.);
     }
 
@@ -58,6 +58,9 @@ class RelPermEvaluator : public SecondaryVariableFieldEvaluator {
   double perm_scale_;
   double min_val_;
 
+  // cells of each WRM's region, so each WRM is called once per region
+  std::vector<AmanziMesh::Entity_ID_List> region_cells_;
+
  private:
   static Utils::RegisteredFactory<FieldEvaluator,RelPermEvaluator> factory_;
 };
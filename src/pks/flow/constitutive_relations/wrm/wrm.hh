@@ -11,6 +11,7 @@
 #define AMANZI_FLOWRELATIONS_WRM_
 
 #include "Teuchos_ParameterList.hpp"
+#include "MeshDefs.hh"
 
 namespace Amanzi {
 namespace Flow {
@@ -35,6 +36,27 @@ public:
   virtual double d_capillaryPressure(double saturation) = 0;
   virtual double residualSaturation() = 0;
 
+  // Evaluate on a list of entities, e.g. all cells of a region:
+  //   result[id] = f(x[id]) for each id in ids.
+  // The defaults call the pointwise methods.  Models override these to
+  // resolve their options once per list rather than once per entry.
+  virtual void k_relative_batch(const AmanziMesh::Entity_ID_List& ids,
+          const double* s, double* kr) {
+    for (int i=0; i!=ids.size(); ++i) kr[ids[i]] = k_relative(s[ids[i]]);
+  }
+  virtual void d_k_relative_batch(const AmanziMesh::Entity_ID_List& ids,
+          const double* s, double* dkr) {
+    for (int i=0; i!=ids.size(); ++i) dkr[ids[i]] = d_k_relative(s[ids[i]]);
+  }
+  virtual void saturation_batch(const AmanziMesh::Entity_ID_List& ids,
+          const double* pc, double* s) {
+    for (int i=0; i!=ids.size(); ++i) s[ids[i]] = saturation(pc[ids[i]]);
+  }
+  virtual void d_saturation_batch(const AmanziMesh::Entity_ID_List& ids,
+          const double* pc, double* ds) {
+    for (int i=0; i!=ids.size(); ++i) ds[ids[i]] = d_saturation(pc[ids[i]]);
+  }
+
 };
 
 } //namespace
@@ -35,7 +35,8 @@ WRMEvaluator::WRMEvaluator(const WRMEvaluator& other) :
     SecondaryVariablesFieldEvaluator(other),
     calc_other_sat_(other.calc_other_sat_),
     cap_pres_key_(other.cap_pres_key_),
-    wrms_(other.wrms_) {}
+    wrms_(other.wrms_),
+    region_cells_(other.region_cells_) {}
 
 
 Teuchos::RCP<FieldEvaluator> WRMEvaluator::Clone() const {
@@ -87,8 +88,9 @@ void WRMEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
 
   // calculate cell values
   AmanziMesh::Entity_ID ncells = sat_c.MyLength();
-  for (AmanziMesh::Entity_ID c=0; c!=ncells; ++c) {
-    sat_c[0][c] = wrms_->second[(*wrms_->first)[c]]->saturation(pres_c[0][c]);
+  if (region_cells_.empty()) GetRegionCells(*wrms_, ncells, &region_cells_);
+  for (int i=0; i!=wrms_->second.size(); ++i) {
+    wrms_->second[i]->saturation_batch(region_cells_[i], pres_c[0], sat_c[0]);
   }
 
   // Potentially do face values as well.
@@ -154,8 +156,9 @@ void WRMEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
 
   // calculate cell values
   AmanziMesh::Entity_ID ncells = sat_c.MyLength();
-  for (AmanziMesh::Entity_ID c=0; c!=ncells; ++c) {
-    sat_c[0][c] = wrms_->second[(*wrms_->first)[c]]->d_saturation(pres_c[0][c]);
+  if (region_cells_.empty()) GetRegionCells(*wrms_, ncells, &region_cells_);
+  for (int i=0; i!=wrms_->second.size(); ++i) {
+    wrms_->second[i]->d_saturation_batch(region_cells_[i], pres_c[0], sat_c[0]);
   }
 
   // Potentially do face values as well.
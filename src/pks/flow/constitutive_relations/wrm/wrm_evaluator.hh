@@ -45,6 +45,9 @@ class WRMEvaluator : public SecondaryVariablesFieldEvaluator {
   bool calc_other_sat_;
   Key cap_pres_key_;
 
+  // cells of each WRM's region, so each WRM is called once per region
+  std::vector<AmanziMesh::Entity_ID_List> region_cells_;
+
  private:
   static Utils::RegisteredFactory<FieldEvaluator,WRMEvaluator> factory_;
 
@@ -57,5 +57,17 @@ createWRMPermafrostModelPartition(Teuchos::ParameterList& plist,
   return Teuchos::rcp(new WRMPermafrostModelPartition(wrms->first, pm_list));
 }
 
+
+void
+GetRegionCells(const WRMPartition& wrms, int ncells,
+               std::vector<AmanziMesh::Entity_ID_List>* region_cells) {
+  ASSERT(wrms.first->initialized());
+  region_cells->assign(wrms.second.size(), AmanziMesh::Entity_ID_List());
+  for (AmanziMesh::Entity_ID c=0; c!=ncells; ++c) {
+    int index = (*wrms.first)[c];
+    if (index >= 0) (*region_cells)[index].push_back(c);
+  }
+}
+
 } // namespace
 } // namespace
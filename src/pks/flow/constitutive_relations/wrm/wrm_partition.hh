@@ -29,6 +29,13 @@ Teuchos::RCP<WRMPermafrostModelPartition>
 createWRMPermafrostModelPartition(Teuchos::ParameterList& plist,
         Teuchos::RCP<WRMPartition>& wrms);
 
+// Cells of an initialized partition, grouped by region so that each WRM can
+// be evaluated on all of its cells at once.  region_cells[i] lists the
+// first ncells cells that use wrms->second[i].
+void
+GetRegionCells(const WRMPartition& wrms, int ncells,
+               std::vector<AmanziMesh::Entity_ID_List>* region_cells);
+
 } // namespace
 } // namespace
 
@@ -35,9 +35,9 @@ double WRMVanGenuchten::k_relative(double s) {
   if (s <= s0_) {
     double se = (s - sr_)/(1-sr_);
     if (function_ == FLOW_WRM_MUALEM) {
-      return pow(se, l_) * pow(1.0 - pow(1.0 - pow(se, 1.0/m_), m_), 2.0);
+      return k_relative_<FLOW_WRM_MUALEM>(se);
     } else {
-      return se * se * (1.0 - pow(1.0 - pow(se, 1.0/m_), m_));
+      return k_relative_<FLOW_WRM_BURDINE>(se);
     }
   } else if (s == 1.0) {
     return 1.0;
@@ -53,19 +53,11 @@ double WRMVanGenuchten::k_relative(double s) {
 double WRMVanGenuchten::d_k_relative(double s) {
   if (s <= s0_) {
     double se = (s - sr_)/(1-sr_);
-
-    double x = pow(se, 1.0 / m_);
-    if (fabs(1.0 - x) < FLOW_WRM_TOLERANCE) return 0.0;
-
-    double y = pow(1.0 - x, m_);
-    double dkdse;
-    if (function_ == FLOW_WRM_MUALEM)
-      dkdse = (1.0 - y) * (l_ * (1.0 - y) + 2 * x * y / (1.0 - x)) * pow(se, l_ - 1.0);
-    else
-      dkdse = (2 * (1.0 - y) + x / (1.0 - x)) * se;
-
-    return dkdse / (1 - sr_);
-
+    if (function_ == FLOW_WRM_MUALEM) {
+      return d_k_relative_<FLOW_WRM_MUALEM>(se);
+    } else {
+      return d_k_relative_<FLOW_WRM_BURDINE>(se);
+    }
   } else if (s == 1.0) {
     return 0.0;
   } else {
@@ -132,6 +124,154 @@ double WRMVanGenuchten::d_capillaryPressure(double s) {
 }
 
 
+/* ******************************************************************
+ * Unsmoothed relative permeability as a function of effective
+ * saturation, for Mualem or Burdine.
+ ****************************************************************** */
+template<int Function>
+double WRMVanGenuchten::k_relative_(double se) const {
+  if (Function == FLOW_WRM_MUALEM) {
+    return pow(se, l_) * pow(1.0 - pow(1.0 - pow(se, 1.0/m_), m_), 2.0);
+  } else {
+    return se * se * (1.0 - pow(1.0 - pow(se, 1.0/m_), m_));
+  }
+}
+
+
+template<int Function>
+double WRMVanGenuchten::d_k_relative_(double se) const {
+  double x = pow(se, 1.0 / m_);
+  if (fabs(1.0 - x) < FLOW_WRM_TOLERANCE) return 0.0;
+
+  double y = pow(1.0 - x, m_);
+  double dkdse;
+  if (Function == FLOW_WRM_MUALEM)
+    dkdse = (1.0 - y) * (l_ * (1.0 - y) + 2 * x * y / (1.0 - x)) * pow(se, l_ - 1.0);
+  else
+    dkdse = (2 * (1.0 - y) + x / (1.0 - x)) * se;
+
+  return dkdse / (1 - sr_);
+}
+
+
+/* ******************************************************************
+ * Loops over a list of entries.  Without smoothing, the spline
+ * branches are compiled out.
+ ****************************************************************** */
+template<int Function, bool Smoothed>
+void WRMVanGenuchten::k_relative_loop_(const AmanziMesh::Entity_ID_List& ids,
+        const double* s, double* kr) {
+  double sr = sr_;
+  double s0 = s0_;
+  for (int i=0; i!=ids.size(); ++i) {
+    double s_i = s[ids[i]];
+    if (!Smoothed || s_i <= s0) {
+      kr[ids[i]] = k_relative_<Function>((s_i - sr)/(1-sr));
+    } else if (s_i == 1.0) {
+      kr[ids[i]] = 1.0;
+    } else {
+      kr[ids[i]] = fit_kr_(s_i);
+    }
+  }
+}
+
+
+template<int Function, bool Smoothed>
+void WRMVanGenuchten::d_k_relative_loop_(const AmanziMesh::Entity_ID_List& ids,
+        const double* s, double* dkr) {
+  double sr = sr_;
+  double s0 = s0_;
+  for (int i=0; i!=ids.size(); ++i) {
+    double s_i = s[ids[i]];
+    if (!Smoothed || s_i <= s0) {
+      dkr[ids[i]] = d_k_relative_<Function>((s_i - sr)/(1-sr));
+    } else if (s_i == 1.0) {
+      dkr[ids[i]] = 0.0;
+    } else {
+      dkr[ids[i]] = fit_kr_.Derivative(s_i);
+    }
+  }
+}
+
+
+template<bool Smoothed>
+void WRMVanGenuchten::saturation_loop_(const AmanziMesh::Entity_ID_List& ids,
+        const double* pc, double* s) {
+  double pc0 = Smoothed ? pc0_ : 0.;
+  for (int i=0; i!=ids.size(); ++i) {
+    double pc_i = pc[ids[i]];
+    if (pc_i > pc0) {
+      s[ids[i]] = std::pow(1.0 + std::pow(alpha_*pc_i, n_), -m_) * (1.0 - sr_) + sr_;
+    } else if (!Smoothed || pc_i <= 0.) {
+      s[ids[i]] = 1.0;
+    } else {
+      s[ids[i]] = fit_s_(pc_i);
+    }
+  }
+}
+
+
+template<bool Smoothed>
+void WRMVanGenuchten::d_saturation_loop_(const AmanziMesh::Entity_ID_List& ids,
+        const double* pc, double* ds) {
+  double pc0 = Smoothed ? pc0_ : 0.;
+  for (int i=0; i!=ids.size(); ++i) {
+    double pc_i = pc[ids[i]];
+    if (pc_i > pc0) {
+      ds[ids[i]] = -m_*n_ * std::pow(1.0 + std::pow(alpha_*pc_i, n_), -m_-1.0)
+          * std::pow(alpha_*pc_i, n_-1) * alpha_ * (1.0 - sr_);
+    } else if (!Smoothed || pc_i <= 0.) {
+      ds[ids[i]] = 0.0;
+    } else {
+      ds[ids[i]] = fit_s_.Derivative(pc_i);
+    }
+  }
+}
+
+
+/* ******************************************************************
+ * Batch evaluation: the model options are resolved once per list.
+ ****************************************************************** */
+void WRMVanGenuchten::k_relative_batch(const AmanziMesh::Entity_ID_List& ids,
+        const double* s, double* kr) {
+  bool smoothed = s0_ < 1.;
+  if (function_ == FLOW_WRM_MUALEM) {
+    if (smoothed) k_relative_loop_<FLOW_WRM_MUALEM,true>(ids, s, kr);
+    else k_relative_loop_<FLOW_WRM_MUALEM,false>(ids, s, kr);
+  } else {
+    if (smoothed) k_relative_loop_<FLOW_WRM_BURDINE,true>(ids, s, kr);
+    else k_relative_loop_<FLOW_WRM_BURDINE,false>(ids, s, kr);
+  }
+}
+
+
+void WRMVanGenuchten::d_k_relative_batch(const AmanziMesh::Entity_ID_List& ids,
+        const double* s, double* dkr) {
+  bool smoothed = s0_ < 1.;
+  if (function_ == FLOW_WRM_MUALEM) {
+    if (smoothed) d_k_relative_loop_<FLOW_WRM_MUALEM,true>(ids, s, dkr);
+    else d_k_relative_loop_<FLOW_WRM_MUALEM,false>(ids, s, dkr);
+  } else {
+    if (smoothed) d_k_relative_loop_<FLOW_WRM_BURDINE,true>(ids, s, dkr);
+    else d_k_relative_loop_<FLOW_WRM_BURDINE,false>(ids, s, dkr);
+  }
+}
+
+
+void WRMVanGenuchten::saturation_batch(const AmanziMesh::Entity_ID_List& ids,
+        const double* pc, double* s) {
+  if (pc0_ > 0.) saturation_loop_<true>(ids, pc, s);
+  else saturation_loop_<false>(ids, pc, s);
+}
+
+
+void WRMVanGenuchten::d_saturation_batch(const AmanziMesh::Entity_ID_List& ids,
+        const double* pc, double* ds) {
+  if (pc0_ > 0.) d_saturation_loop_<true>(ids, pc, ds);
+  else d_saturation_loop_<false>(ids, pc, ds);
+}
+
+
 void WRMVanGenuchten::InitializeFromPlist_() {
   std::string fname = plist_.get<std::string>("Krel function name", "Mualem");
   if (fname == std::string("Mualem")) {
@@ -48,9 +48,36 @@ public:
   double d_capillaryPressure(double saturation);
   double residualSaturation() { return sr_; }
 
+  // Batch versions dispatch once to a loop specialized on the Krel function
+  // and on whether smoothing is used.
+  void k_relative_batch(const AmanziMesh::Entity_ID_List& ids,
+                        const double* s, double* kr);
+  void d_k_relative_batch(const AmanziMesh::Entity_ID_List& ids,
+                          const double* s, double* dkr);
+  void saturation_batch(const AmanziMesh::Entity_ID_List& ids,
+                        const double* pc, double* s);
+  void d_saturation_batch(const AmanziMesh::Entity_ID_List& ids,
+                          const double* pc, double* ds);
+
  private:
   void InitializeFromPlist_();
 
+  template<int Function> double k_relative_(double se) const;
+  template<int Function> double d_k_relative_(double se) const;
+
+  template<int Function, bool Smoothed>
+  void k_relative_loop_(const AmanziMesh::Entity_ID_List& ids,
+                        const double* s, double* kr);
+  template<int Function, bool Smoothed>
+  void d_k_relative_loop_(const AmanziMesh::Entity_ID_List& ids,
+                          const double* s, double* dkr);
+  template<bool Smoothed>
+  void saturation_loop_(const AmanziMesh::Entity_ID_List& ids,
+                        const double* pc, double* s);
+  template<bool Smoothed>
+  void d_saturation_loop_(const AmanziMesh::Entity_ID_List& ids,
+                          const double* pc, double* ds);
+
   Teuchos::ParameterList& plist_;
 
   double m_;  // van Genuchten parameters: m, n, alpha
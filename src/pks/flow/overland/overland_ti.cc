@@ -121,7 +121,7 @@ int OverlandFlow::ApplyPreconditioner(Teuchos::RCP<const TreeVector> u, Teuchos:
 #endif
 
   // apply the preconditioner
-  int ierr = lin_solver_->ApplyInverse(*u->Data(), *Pu->Data());
+  int ierr = ApplyLinearSolver_(lin_solver_, *u->Data(), *Pu->Data());
 
 #if DEBUG_FLAG
   db_->WriteVector("PC*h_res (h-coords)", Pu->Data().ptr(), true);
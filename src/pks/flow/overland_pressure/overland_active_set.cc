@@ -0,0 +1,212 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! Wet/dry active set for the overland flow preconditioner.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: ATS developers
+*/
+
+#include "dbc.hh"
+#include "errors.hh"
+#include "PreconditionerFactory.hh"
+
+#include "overland_active_set.hh"
+
+namespace Amanzi {
+namespace Flow {
+
+OverlandActiveSet::OverlandActiveSet(Teuchos::ParameterList& plist,
+        Teuchos::ParameterList& pc_plist,
+        const Teuchos::RCP<const AmanziMesh::Mesh>& mesh) :
+    mesh_(mesh),
+    nactive_global_(0),
+    structure_changed_(true)
+{
+  wet_depth_ = plist.get<double>("wet ponded depth [m]", 1.e-4);
+  dry_depth_ = plist.get<double>("dry ponded depth [m]", 1.e-5);
+  if (dry_depth_ > wet_depth_) {
+    Errors::Message msg("OverlandActiveSet: \"dry ponded depth [m]\" must not exceed \"wet ponded depth [m]\".");
+    Exceptions::amanzi_throw(msg);
+  }
+
+  AmanziPreconditioners::PreconditionerFactory fac;
+  pc_ = fac.Create(pc_plist);
+
+  const Epetra_Map& cell_map = mesh_->cell_map(false);
+  const Epetra_Map& cell_map_ghosted = mesh_->cell_map(true);
+  cell_import_ = Teuchos::rcp(new Epetra_Import(cell_map_ghosted, cell_map));
+  wet_owned_ = Teuchos::rcp(new Epetra_IntVector(cell_map));
+  wet_ = Teuchos::rcp(new Epetra_IntVector(cell_map_ghosted));
+}
+
+
+bool
+OverlandActiveSet::Update(const CompositeVector& depth) {
+  const Epetra_MultiVector& h = *depth.ViewComponent("cell",false);
+  int ncells_owned = h.MyLength();
+
+  // wet, with hysteresis
+  for (int c=0; c!=ncells_owned; ++c) {
+    if (h[0][c] > wet_depth_) (*wet_owned_)[c] = 1;
+    else if (h[0][c] < dry_depth_) (*wet_owned_)[c] = 0;
+  }
+  wet_->Import(*wet_owned_, *cell_import_, Insert);
+
+  // active if wet or next to a wet cell
+  AmanziMesh::Entity_ID_List faces, cells;
+  int nactive_old = active_cells_.size();
+  int nactive = 0;
+  int changed = 0;
+  for (int c=0; c!=ncells_owned; ++c) {
+    bool active = (*wet_)[c];
+    if (!active) {
+      mesh_->cell_get_faces(c, &faces);
+      for (int i=0; i!=faces.size() && !active; ++i) {
+        mesh_->face_get_cells(faces[i], AmanziMesh::USED, &cells);
+        for (int j=0; j!=cells.size(); ++j) active |= (bool) (*wet_)[cells[j]];
+      }
+    }
+
+    if (active) {
+      if (nactive < nactive_old) {
+        changed |= active_cells_[nactive] != c;
+        active_cells_[nactive] = c;
+      } else {
+        changed = 1;
+        active_cells_.push_back(c);
+      }
+      nactive++;
+    }
+  }
+  changed |= nactive != nactive_old;
+  changed |= active_map_ == Teuchos::null;
+  active_cells_.resize(nactive);
+
+  int changed_global = 0;
+  mesh_->get_comm()->MaxAll(&changed, &changed_global, 1);
+  if (changed_global) {
+    mesh_->get_comm()->SumAll(&nactive, &nactive_global_, 1);
+    active_map_ = Teuchos::rcp(new Epetra_Map(-1, nactive, 0, *mesh_->get_comm()));
+    structure_changed_ = true;
+  }
+  return changed_global;
+}
+
+
+void
+OverlandActiveSet::RestrictCoefficients(const Teuchos::Ptr<CompositeVector>& cond,
+        const Teuchos::Ptr<CompositeVector>& dcond) const {
+  AmanziMesh::Entity_ID_List cells;
+
+  Epetra_MultiVector& cond_f = *cond->ViewComponent("face",true);
+  int nfaces = cond_f.MyLength();
+  for (int f=0; f!=nfaces; ++f) {
+    mesh_->face_get_cells(f, AmanziMesh::USED, &cells);
+    bool wet = false;
+    for (int j=0; j!=cells.size(); ++j) wet |= (bool) (*wet_)[cells[j]];
+    if (!wet) cond_f[0][f] = 0.;
+  }
+
+  if (dcond != Teuchos::null) {
+    Epetra_MultiVector& dcond_c = *dcond->ViewComponent("cell",true);
+    int ncells = dcond_c.MyLength();
+    for (int c=0; c!=ncells; ++c) {
+      if (!(*wet_)[c]) dcond_c[0][c] = 0.;
+    }
+  }
+}
+
+
+void
+OverlandActiveSet::UpdatePreconditioner(const Epetra_CrsMatrix& A) {
+  // rows of A are the owned cells, in order
+  ASSERT(A.NumMyRows() == mesh_->num_entities(AmanziMesh::CELL, AmanziMesh::OWNED));
+
+  if (col_import_ == Teuchos::null) {
+    col_import_ = Teuchos::rcp(new Epetra_Import(A.ColMap(), A.RowMap()));
+    active_gid_row_ = Teuchos::rcp(new Epetra_IntVector(A.RowMap()));
+    active_gid_col_ = Teuchos::rcp(new Epetra_IntVector(A.ColMap()));
+    inv_diag_ = Teuchos::rcp(new Epetra_Vector(A.RowMap()));
+    indices_.resize(A.MaxNumEntries());
+    values_.resize(A.MaxNumEntries());
+  }
+
+  // the inactive rows are diagonal
+  A.ExtractDiagonalCopy(*inv_diag_);
+  inv_diag_->Reciprocal(*inv_diag_);
+
+  if (structure_changed_) {
+    active_gid_row_->PutValue(-1);
+    int nactive = active_cells_.size();
+    for (int i=0; i!=nactive; ++i) {
+      (*active_gid_row_)[active_cells_[i]] = active_map_->GID(i);
+    }
+    active_gid_col_->Import(*active_gid_row_, *col_import_, Insert);
+
+    A_active_ = Teuchos::rcp(new Epetra_CrsMatrix(Copy, *active_map_, A.MaxNumEntries()));
+    b_active_ = Teuchos::null;
+    x_active_ = Teuchos::null;
+  }
+
+  // copy the active block, coupled only to itself
+  int nactive = active_cells_.size();
+  for (int i=0; i!=nactive; ++i) {
+    int nentries;
+    double* vals;
+    int* inds;
+    A.ExtractMyRowView(active_cells_[i], nentries, vals, inds);
+
+    int n = 0;
+    for (int j=0; j!=nentries; ++j) {
+      int gid = (*active_gid_col_)[inds[j]];
+      if (gid >= 0) {
+        indices_[n] = gid;
+        values_[n] = vals[j];
+        n++;
+      }
+    }
+
+    int row = active_map_->GID(i);
+    int ierr = structure_changed_ ?
+        A_active_->InsertGlobalValues(row, n, &values_[0], &indices_[0]) :
+        A_active_->ReplaceGlobalValues(row, n, &values_[0], &indices_[0]);
+    ASSERT(!ierr);
+  }
+
+  if (structure_changed_) {
+    A_active_->FillComplete();
+    structure_changed_ = false;
+  }
+  if (nactive_global_ > 0) pc_->Update(A_active_);
+}
+
+
+int
+OverlandActiveSet::ApplyInverse(const Epetra_MultiVector& b, Epetra_MultiVector& x) const {
+  int ncells_owned = x.MyLength();
+  for (int k=0; k!=x.NumVectors(); ++k) {
+    for (int c=0; c!=ncells_owned; ++c) x[k][c] = b[k][c] * (*inv_diag_)[c];
+  }
+  if (nactive_global_ == 0) return 0;
+
+  if (b_active_ == Teuchos::null || b_active_->NumVectors() != b.NumVectors()) {
+    b_active_ = Teuchos::rcp(new Epetra_MultiVector(*active_map_, b.NumVectors()));
+    x_active_ = Teuchos::rcp(new Epetra_MultiVector(*active_map_, b.NumVectors()));
+  }
+
+  int nactive = active_cells_.size();
+  for (int k=0; k!=b.NumVectors(); ++k) {
+    for (int i=0; i!=nactive; ++i) (*b_active_)[k][i] = b[k][active_cells_[i]];
+  }
+  int ierr = pc_->ApplyInverse(*b_active_, *x_active_);
+  for (int k=0; k!=x.NumVectors(); ++k) {
+    for (int i=0; i!=nactive; ++i) x[k][active_cells_[i]] = (*x_active_)[k][i];
+  }
+  return ierr;
+}
+
+}  // namespace Flow
+}  // namespace Amanzi
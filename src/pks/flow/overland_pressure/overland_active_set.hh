@@ -0,0 +1,126 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! Wet/dry active set for the overland flow preconditioner.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: ATS developers
+*/
+
+
+/*!
+
+Most of a watershed surface is dry most of the time, and its rows of the
+overland flow preconditioner are trivial.  The active set restricts the
+preconditioner to the cells that are wet, or next to a wet cell.
+
+A cell becomes wet when its ponded depth exceeds the `"wet ponded depth`", and
+stays wet until it falls below the `"dry ponded depth`".  The preconditioner's
+conductivity is zeroed on faces with no wet neighbor, as is the derivative of
+the conductivity in cells that are not wet.  This decouples the system into
+the block of active cells, which is extracted and handed to the
+preconditioner, and the remaining cells, whose rows are only their
+accumulation and boundary terms and are inverted by their diagonal.  The
+residual is not changed, only its approximate Jacobian, so the converged
+solution is the same.
+
+This is only supported for cell-centered discretizations of a standalone
+(uncoupled) overland flow PK, and replaces both its `"preconditioner`" and
+`"linear solver`" applications.
+
+* `"wet-dry active set`" ``[list]``
+
+  * `"wet ponded depth [m]`" ``[double]`` **1.e-4** Depth above which a cell
+    becomes wet.
+
+  * `"dry ponded depth [m]`" ``[double]`` **1.e-5** Depth below which a wet
+    cell becomes dry.  Must not exceed the wet depth.
+
+*/
+
+#ifndef PK_FLOW_OVERLAND_ACTIVE_SET_HH_
+#define PK_FLOW_OVERLAND_ACTIVE_SET_HH_
+
+#include <vector>
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+#include "Epetra_Map.h"
+#include "Epetra_Import.h"
+#include "Epetra_IntVector.h"
+#include "Epetra_Vector.h"
+#include "Epetra_CrsMatrix.h"
+
+#include "Mesh.hh"
+#include "CompositeVector.hh"
+#include "Preconditioner.hh"
+
+namespace Amanzi {
+namespace Flow {
+
+class OverlandActiveSet {
+
+ public:
+  OverlandActiveSet(Teuchos::ParameterList& plist,
+                    Teuchos::ParameterList& pc_plist,
+                    const Teuchos::RCP<const AmanziMesh::Mesh>& mesh);
+
+  // Update the wet set from the ponded depth.  Returns true if the set of
+  // active cells changed.
+  bool Update(const CompositeVector& depth);
+
+  // Zero the face conductivity on faces with no wet neighbor, and the cell
+  // derivative of conductivity in cells that are not wet.
+  void RestrictCoefficients(const Teuchos::Ptr<CompositeVector>& cond,
+                            const Teuchos::Ptr<CompositeVector>& dcond) const;
+
+  // Extract the active block of the assembled A and update the
+  // preconditioner with it.
+  void UpdatePreconditioner(const Epetra_CrsMatrix& A);
+
+  // x = A^-1 b, approximately on the active block and exactly by the
+  // diagonal elsewhere.  Returns 0 on success.
+  int ApplyInverse(const Epetra_MultiVector& b, Epetra_MultiVector& x) const;
+
+  // number of active cells, global
+  int num_active() const { return nactive_global_; }
+
+ protected:
+  Teuchos::RCP<const AmanziMesh::Mesh> mesh_;
+  Teuchos::RCP<AmanziPreconditioners::Preconditioner> pc_;
+  double wet_depth_;
+  double dry_depth_;
+
+  // wet markers of owned cells, and of used cells
+  Teuchos::RCP<Epetra_Import> cell_import_;
+  Teuchos::RCP<Epetra_IntVector> wet_owned_;
+  Teuchos::RCP<Epetra_IntVector> wet_;
+
+  // owned cells of the active block, in order
+  std::vector<int> active_cells_;
+  int nactive_global_;
+
+  // global index in the active block of each row and column of A, -1 if not
+  // active
+  Teuchos::RCP<Epetra_Import> col_import_;
+  Teuchos::RCP<Epetra_IntVector> active_gid_row_;
+  Teuchos::RCP<Epetra_IntVector> active_gid_col_;
+
+  // the active block, and the inverse diagonal of the rest
+  Teuchos::RCP<Epetra_Map> active_map_;
+  Teuchos::RCP<Epetra_CrsMatrix> A_active_;
+  mutable Teuchos::RCP<Epetra_MultiVector> b_active_, x_active_;
+  Teuchos::RCP<Epetra_Vector> inv_diag_;
+  bool structure_changed_;
+
+  // row work space
+  std::vector<int> indices_;
+  std::vector<double> values_;
+};
+
+}  // namespace Flow
+}  // namespace Amanzi
+
+#endif
@@ -75,6 +75,11 @@ Boundary conditions:
 
 * `"boundary conditions`" ``[surface-flow-bc-spec]`` **defaults to Neuman, 0 normal flux**
 
+Performance:
+
+* `"wet-dry active set`" ``[list]`` **optional** If present, restricts the
+  preconditioner to wet cells and their neighbors.  See OverlandActiveSet_.
+
 
 May inherit options from PKPhysicalBDFBase_.
 
@@ -104,6 +109,7 @@ namespace Flow {
 
 class OverlandConductivityModel;
 class HeightModel;
+class OverlandActiveSet;
 
 //class OverlandPressureFlow : public PKPhysicalBDFBase {
 class OverlandPressureFlow : public PK_PhysicalBDF_Default {
@@ -241,6 +247,11 @@ protected:
 
   bool precon_used_;
 
+  // wet/dry restriction of the preconditioner, and its coefficients
+  Teuchos::RCP<OverlandActiveSet> active_set_;
+  Teuchos::RCP<CompositeVector> cond_active_;
+  Teuchos::RCP<CompositeVector> dcond_active_;
+
   // boundary condition data
   Teuchos::RCP<Functions::BoundaryFunction> bc_zero_gradient_;
   Teuchos::RCP<Functions::BoundaryFunction> bc_head_;
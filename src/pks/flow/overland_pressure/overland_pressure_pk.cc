@@ -39,6 +39,7 @@ Author: Ethan Coon (ecoon@lanl.gov)
 #include "UpwindFluxFactory.hh"
 #include "OperatorDiffusionFactory.hh"
 
+#include "overland_active_set.hh"
 #include "overland_pressure.hh"
 
 namespace Amanzi {
@@ -279,6 +280,21 @@ void OverlandPressureFlow::SetupOverlandFlow_(const Teuchos::Ptr<State>& S) {
     lin_solver_ = preconditioner_;
   }
 
+  //    Potentially restrict the preconditioner to the wet cells
+  if (plist_->isSublist("wet-dry active set")) {
+    if (coef_location != "upwind: face" ||
+        preconditioner_->RangeMap().HasComponent("face") ||
+        coupled_to_subsurface_via_head_ || coupled_to_subsurface_via_flux_ ||
+        !precon_used_) {
+      Errors::Message message;
+      message << name_ << ": \"wet-dry active set\" requires an uncoupled, cell-centered "
+              << "discretization with upwinded face conductivities and a \"preconditioner\".";
+      Exceptions::amanzi_throw(message);
+    }
+    active_set_ = Teuchos::rcp(new OverlandActiveSet(plist_->sublist("wet-dry active set"),
+            plist_->sublist("preconditioner"), mesh_));
+  }
+
   // primary variable
   S->RequireField(key_, name_)->Update(matrix_->RangeMap())->SetGhosted();
   S->RequireField(Keys::getKey(domain_,"pressure"))->Update(matrix_->RangeMap())->SetGhosted();
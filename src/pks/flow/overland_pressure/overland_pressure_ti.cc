@@ -10,6 +10,7 @@ Authors: Ethan Coon (ecoon@lanl.gov)
 #include "EpetraExt_RowMatrixOut.h"
 #include "boost/math/special_functions/fpclassify.hpp"
 
+#include "overland_active_set.hh"
 #include "overland_pressure.hh"
 #include "Op.hh"
 
@@ -169,7 +170,15 @@ int OverlandPressureFlow::ApplyPreconditioner(Teuchos::RCP<const TreeVector> u,
 #endif
 
   // apply the preconditioner
-  int ierr = lin_solver_->ApplyInverse(*u->Data(), *Pu->Data());
+  int ierr = 0;
+  if (active_set_ != Teuchos::null) {
+    // ApplyInverse() returns 0 on success, while ierr follows the linear
+    // solver, which returns > 0 on success
+    ierr = active_set_->ApplyInverse(*u->Data()->ViewComponent("cell",false),
+            *Pu->Data()->ViewComponent("cell",false)) ? 0 : 1;
+  } else {
+    ierr = ApplyLinearSolver_(lin_solver_, *u->Data(), *Pu->Data());
+  }
 
 #if DEBUG_FLAG
   db_->WriteVector("PC*h_res (h-coords)", Pu->Data().ptr(), true);
@@ -234,6 +243,27 @@ void OverlandPressureFlow::UpdatePreconditioner(double t, Teuchos::RCP<const Tre
     }
   }
 
+  // -- restrict the coefficients to the active set, decoupling the dry cells
+  if (active_set_ != Teuchos::null) {
+    S_next_->GetFieldEvaluator(Keys::getKey(domain_,"ponded_depth"))->HasFieldChanged(S_next_.ptr(), name_);
+    active_set_->Update(*S_next_->GetFieldData(Keys::getKey(domain_,"ponded_depth")));
+    if (vo_->os_OK(Teuchos::VERB_HIGH))
+      *vo_->os() << "  active cells: " << active_set_->num_active() << std::endl;
+
+    if (cond_active_ == Teuchos::null)
+      cond_active_ = Teuchos::rcp(new CompositeVector(*cond));
+    *cond_active_ = *cond;
+    if (dcond != Teuchos::null) {
+      if (dcond_active_ == Teuchos::null)
+        dcond_active_ = Teuchos::rcp(new CompositeVector(*dcond));
+      *dcond_active_ = *dcond;
+    }
+    active_set_->RestrictCoefficients(cond_active_.ptr(),
+            dcond == Teuchos::null ? Teuchos::Ptr<CompositeVector>() : dcond_active_.ptr());
+    cond = cond_active_;
+    if (dcond != Teuchos::null) dcond = dcond_active_;
+  }
+
   // 1.b: Create all local matrices.
   preconditioner_->Init();
   preconditioner_diff_->SetScalarCoefficient(cond, dcond);
@@ -379,7 +409,11 @@ void OverlandPressureFlow::UpdatePreconditioner(double t, Teuchos::RCP<const Tre
 
   if (precon_used_) {
     preconditioner_->AssembleMatrix();
-    preconditioner_->InitPreconditioner(plist_->sublist("preconditioner"));
+    if (active_set_ != Teuchos::null) {
+      active_set_->UpdatePreconditioner(*preconditioner_->A());
+    } else {
+      preconditioner_->InitPreconditioner(plist_->sublist("preconditioner"));
+    }
   }      
   
   /*
@@ -0,0 +1,175 @@
+/*
+  Testing of the overland flow wet/dry active set: as cells wet and dry, its
+  inverse of the preconditioner is that of the whole surface.
+*/
+
+#include <cmath>
+#include <string>
+
+#include "UnitTest++.h"
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+#include "Epetra_MpiComm.h"
+#include "Epetra_CrsMatrix.h"
+#include "Epetra_Vector.h"
+
+#include "MeshFactory.hh"
+#include "CompositeVector.hh"
+#include "CompositeVectorSpace.hh"
+#include "PreconditionerFactory.hh"
+
+#include "overland_active_set.hh"
+
+namespace {
+
+using namespace Amanzi;
+
+const int nx = 6;
+
+// A 6x6 surface, the preconditioner of its overland flow (unit accumulation
+// plus the face conductivities, restricted by the active set), and the same
+// preconditioner over the whole surface.
+struct SurfaceFixture {
+  SurfaceFixture() : comm(MPI_COMM_SELF) {
+    Teuchos::ParameterList region_list;
+    Teuchos::RCP<AmanziGeometry::GeometricModel> gm =
+        Teuchos::rcp(new AmanziGeometry::GeometricModel(2, region_list, &comm));
+    AmanziMesh::MeshFactory meshfactory(&comm);
+    AmanziMesh::FrameworkPreference pref;
+    pref.push_back(AmanziMesh::MSTK);
+    meshfactory.preference(pref);
+    mesh = meshfactory(0.,0., 1.,1., nx,nx, gm);
+
+    CompositeVectorSpace depth_space;
+    depth_space.SetMesh(mesh)->SetGhosted()->AddComponent("cell", AmanziMesh::CELL, 1);
+    depth = Teuchos::rcp(new CompositeVector(depth_space));
+
+    CompositeVectorSpace cond_space;
+    cond_space.SetMesh(mesh)->SetGhosted()->AddComponent("face", AmanziMesh::FACE, 1);
+    cond = Teuchos::rcp(new CompositeVector(cond_space));
+
+    // an exact factorization, so that both paths solve their systems
+    pc_list.set<std::string>("preconditioner type", "block ilu");
+    pc_list.sublist("block ilu parameters").set<int>("fact: level-of-fill", 2*nx*nx);
+    pc_list.sublist("block ilu parameters").set<int>("overlap", 0);
+
+    Teuchos::ParameterList as_list;
+    active_set = Teuchos::rcp(new Flow::OverlandActiveSet(as_list, pc_list, mesh));
+  }
+
+  // Ponded depth, wet where depth_of(i,j) says so.
+  void SetDepth(double (*depth_of)(int i, int j)) {
+    Epetra_MultiVector& h = *depth->ViewComponent("cell",false);
+    for (int c=0; c!=h.MyLength(); ++c) {
+      AmanziGeometry::Point xc = mesh->cell_centroid(c);
+      h[0][c] = depth_of((int) (xc[0] * nx), (int) (xc[1] * nx));
+    }
+  }
+
+  // The preconditioner, with conductivity k on each face before restriction.
+  Teuchos::RCP<Epetra_CrsMatrix> Assemble(double k) {
+    cond->PutScalar(k);
+    active_set->RestrictCoefficients(cond.ptr(), Teuchos::Ptr<CompositeVector>());
+    const Epetra_MultiVector& cond_f = *cond->ViewComponent("face",false);
+
+    const Epetra_Map& cell_map = mesh->cell_map(false);
+    Teuchos::RCP<Epetra_CrsMatrix> A = Teuchos::rcp(new Epetra_CrsMatrix(Copy, cell_map, 5));
+    AmanziMesh::Entity_ID_List faces, cells;
+    for (int c=0; c!=cell_map.NumMyElements(); ++c) {
+      int row = cell_map.GID(c);
+      double diag = 1.;
+      mesh->cell_get_faces(c, &faces);
+      for (int i=0; i!=faces.size(); ++i) {
+        mesh->face_get_cells(faces[i], AmanziMesh::USED, &cells);
+        if (cells.size() != 2) continue;
+        int nbr = cells[0] == c ? cells[1] : cells[0];
+        double off = -cond_f[0][faces[i]];
+        int col = cell_map.GID(nbr);
+        A->InsertGlobalValues(row, 1, &off, &col);
+        diag += cond_f[0][faces[i]];
+      }
+      A->InsertGlobalValues(row, 1, &diag, &row);
+    }
+    A->FillComplete();
+    return A;
+  }
+
+  // Checks that the active set's inverse of A is that of the whole surface.
+  void CheckInverse(const Teuchos::RCP<Epetra_CrsMatrix>& A) {
+    active_set->UpdatePreconditioner(*A);
+
+    Epetra_MultiVector b(A->RowMap(), 1);
+    for (int c=0; c!=b.MyLength(); ++c) b[0][c] = std::sin(1. + c);
+    Epetra_MultiVector x_active(b), x_full(b);
+    CHECK_EQUAL(0, active_set->ApplyInverse(b, x_active));
+
+    AmanziPreconditioners::PreconditionerFactory fac;
+    Teuchos::RCP<AmanziPreconditioners::Preconditioner> pc = fac.Create(pc_list);
+    pc->Update(A);
+    CHECK_EQUAL(0, pc->ApplyInverse(b, x_full));
+
+    // the same solution, with the same residual
+    Epetra_MultiVector r_active(b), r_full(b);
+    A->Multiply(false, x_active, r_active);
+    r_active.Update(1., b, -1.);
+    A->Multiply(false, x_full, r_full);
+    r_full.Update(1., b, -1.);
+    double r_active_norm, r_full_norm;
+    r_active.NormInf(&r_active_norm);
+    r_full.NormInf(&r_full_norm);
+    CHECK_CLOSE(r_full_norm, r_active_norm, 1.e-10);
+    CHECK(r_active_norm < 1.e-10);
+    for (int c=0; c!=b.MyLength(); ++c) CHECK_CLOSE(x_full[0][c], x_active[0][c], 1.e-10);
+  }
+
+  Epetra_MpiComm comm;
+  Teuchos::RCP<AmanziMesh::Mesh> mesh;
+  Teuchos::RCP<CompositeVector> depth, cond;
+  Teuchos::ParameterList pc_list;
+  Teuchos::RCP<Flow::OverlandActiveSet> active_set;
+};
+
+// wet in a 2x2 corner
+double cornerWet(int i, int j) { return i < 2 && j < 2 ? 1.e-2 : 0.; }
+
+// the corner drains to between the dry and wet depths, except one cell which
+// dries, and a cell in the middle wets
+double cornerDraining(int i, int j) {
+  if (i == 0 && j == 0) return 1.e-6;
+  if (i < 2 && j < 2) return 5.e-5;
+  if (i == 4 && j == 3) return 1.e-2;
+  return 0.;
+}
+
+double allDry(int i, int j) { return 0.; }
+
+} // namespace
+
+
+// Cells activate, stay active between the dry and wet depths, deactivate,
+// and the active set's preconditioner matches the whole surface's throughout.
+TEST_FIXTURE(SurfaceFixture, OVERLAND_ACTIVE_SET_WET_DRY) {
+  // the corner and its neighbors: 4 wet, and 4 next to them
+  SetDepth(cornerWet);
+  CHECK(active_set->Update(*depth));
+  CHECK_EQUAL(8, active_set->num_active());
+  CheckInverse(Assemble(10.));
+
+  // the same set, new values
+  CHECK(!active_set->Update(*depth));
+  CheckInverse(Assemble(100.));
+
+  // three corner cells stay wet by hysteresis, (0,0) dries but stays active
+  // next to them, and a new wet cell brings in its 4 neighbors
+  SetDepth(cornerDraining);
+  CHECK(active_set->Update(*depth));
+  CHECK_EQUAL(13, active_set->num_active());
+  CheckInverse(Assemble(10.));
+
+  // nothing active, and the inverse is the diagonal
+  SetDepth(allDry);
+  CHECK(active_set->Update(*depth));
+  CHECK_EQUAL(0, active_set->num_active());
+  CheckInverse(Assemble(10.));
+}
@@ -164,7 +164,7 @@ Interfrost::UpdatePreconditioner(double t,
 
   if (precon_used_) {
     preconditioner_->AssembleMatrix();
-    preconditioner_->InitPreconditioner(plist_->sublist("preconditioner"));
+    UpdatePreconditionerInverse_();
   }      
       
 }
@@ -280,13 +280,7 @@ void Richards::SetupRichardsFlow_(const Teuchos::Ptr<State>& S) {
     preconditioner_->SymbolicAssembleMatrix();
   
     //    Potentially create a linear solver
-    if (plist_->isSublist("linear solver")) {
-      Teuchos::ParameterList linsolve_sublist = plist_->sublist("linear solver");
-      AmanziSolvers::LinearOperatorFactory<Operators::Operator,CompositeVector,CompositeVectorSpace> fac;
-      lin_solver_ = fac.Create(linsolve_sublist, preconditioner_);
-    } else {
-      lin_solver_ = preconditioner_;
-    }
+    lin_solver_ = CreateLinearSolver_();
   }
 
   // -- PC control
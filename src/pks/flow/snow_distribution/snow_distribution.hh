@@ -113,6 +113,12 @@ protected:
   Teuchos::RCP<Operators::OperatorDiffusion> preconditioner_diff_;
   Teuchos::RCP<Operators::OperatorAccumulation> preconditioner_acc_;
 
+  // preconditioner coefficient, the upwinded conductivity times a scaling
+  // factor, and its value when the preconditioner was last built
+  Teuchos::RCP<CompositeVector> cond_times_factor_;
+  Teuchos::RCP<CompositeVector> cond_pc_;
+  double pc_reuse_tol_;
+
   // factory registration
   static RegisteredPKFactory<SnowDistribution> reg_;
 };
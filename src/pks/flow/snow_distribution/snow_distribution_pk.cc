@@ -127,6 +127,11 @@ void SnowDistribution::SetupSnowDistribution_(const Teuchos::Ptr<State>& S) {
   acc_pc_plist.set("entity kind", "cell");
   preconditioner_acc_ = Teuchos::rcp(new Operators::OperatorAccumulation(acc_pc_plist, preconditioner_));
 
+  // Rebuild the preconditioner (e.g. an AMG hierarchy) only when its
+  // coefficient has changed by more than this, relative to its max norm.
+  // The matrix itself is always updated.
+  pc_reuse_tol_ = plist_->get<double>("preconditioner reuse tolerance", 0.);
+
 };
 
 
@@ -162,6 +167,11 @@ void SnowDistribution::Initialize(const Teuchos::Ptr<State>& S) {
   S->GetFieldData(Keys::getKey(domain_,"upwind_snow_conductivity"),name_)->PutScalar(1.0);
   S->GetField(Keys::getKey(domain_,"upwind_snow_conductivity"),name_)->set_initialized();
 
+  // work space for the preconditioner coefficient, which the operator keeps
+  cond_times_factor_ = Teuchos::rcp(new CompositeVector(
+      *S->GetFieldData(Keys::getKey(domain_,"upwind_snow_conductivity"))));
+  preconditioner_diff_->SetScalarCoefficient(cond_times_factor_, Teuchos::null);
+
   if (upwind_method_ == Operators::UPWIND_METHOD_TOTAL_FLUX) {
     S->GetFieldData(Keys::getKey(domain_,"snow_flux_direction"), name_)->PutScalar(0.);
     S->GetField(Keys::getKey(domain_,"snow_flux_direction"), name_)->set_initialized();
@@ -132,9 +132,7 @@ void SnowDistribution::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVec
   Teuchos::RCP<const CompositeVector> cond =
     S_next_->GetFieldData(Keys::getKey(domain_,"upwind_snow_conductivity"));
 
-  Teuchos::RCP<CompositeVector> cond_times_factor = Teuchos::rcp(new CompositeVector(*cond));
-  *cond_times_factor = *cond;
-  cond_times_factor->Scale(864000);
+  cond_times_factor_->Update(864000., *cond, 0.);
 
   // ADD BACK in when upwinding of snow conductivity is added.
   // S_next_->GetFieldEvaluator("conductivity")
@@ -145,7 +143,6 @@ void SnowDistribution::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVec
   // calculating the operator is done in 3 steps:
   // 1. Create all local matrices.
   preconditioner_->Init();
-  preconditioner_diff_->SetScalarCoefficient(cond_times_factor, Teuchos::null);
   //  preconditioner_diff_->SetScalarCoefficient(cond_times_factor, dcond_times_factor);
   preconditioner_diff_->UpdateMatrices(Teuchos::null, Teuchos::null);
   // preconditioner_diff_->UpdateMatrices(*up->Data(), *flux);
@@ -167,7 +164,35 @@ void SnowDistribution::UpdatePreconditioner(double t, Teuchos::RCP<const TreeVec
 
   preconditioner_diff_->ApplyBCs(true, true);
   preconditioner_->AssembleMatrix();
-  preconditioner_->InitPreconditioner(plist_->sublist("preconditioner"));
+
+  // 3. Rebuild the preconditioner, unless the coefficient is close to the
+  //    one it was built with.
+  bool rebuild = cond_pc_ == Teuchos::null;
+  if (!rebuild) {
+    double change[2] = { 0., 0. };
+    for (const auto& comp : *cond_times_factor_) {
+      const Epetra_MultiVector& k = *cond_times_factor_->ViewComponent(comp, false);
+      const Epetra_MultiVector& k_pc = *cond_pc_->ViewComponent(comp, false);
+      for (int i=0; i!=k.MyLength(); ++i) {
+        change[0] = std::max(change[0], std::abs(k[0][i] - k_pc[0][i]));
+        change[1] = std::max(change[1], std::abs(k_pc[0][i]));
+      }
+    }
+    double change_global[2];
+    mesh_->get_comm()->MaxAll(change, change_global, 2);
+    rebuild = change_global[0] > pc_reuse_tol_ * change_global[1];
+  }
+
+  if (rebuild) {
+    preconditioner_->InitPreconditioner(plist_->sublist("preconditioner"));
+    if (pc_reuse_tol_ > 0.) {
+      if (cond_pc_ == Teuchos::null)
+        cond_pc_ = Teuchos::rcp(new CompositeVector(*cond_times_factor_));
+      *cond_pc_ = *cond_times_factor_;
+    }
+  } else if (vo_->os_OK(Teuchos::VERB_EXTREME)) {
+    *vo_->os() << "  reusing preconditioner" << std::endl;
+  }
 };
 
 double SnowDistribution::ErrorNorm(Teuchos::RCP<const TreeVector> u,
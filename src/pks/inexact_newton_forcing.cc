@@ -0,0 +1,132 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! InexactNewtonForcing: Eisenstat-Walker linear solver tolerances.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: ATS developers
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "errors.hh"
+#include "inexact_newton_forcing.hh"
+
+namespace Amanzi {
+
+InexactNewtonForcing::InexactNewtonForcing(Teuchos::ParameterList& plist,
+        Teuchos::ParameterList& linear_solver_plist,
+        const Teuchos::RCP<VerboseObject>& vo) :
+    t_old_(-1.e99),
+    t_new_(-1.e99),
+    k_(0),
+    res_norm_(0.),
+    eta_(0.),
+    num_itrs_(0),
+    num_itrs_saved_(0.),
+    vo_(vo)
+{
+  eta0_ = plist.get<double>("initial forcing term", 0.5);
+  eta_max_ = plist.get<double>("maximum forcing term", 0.9);
+  eta_min_ = plist.get<double>("minimum forcing term", 1.e-8);
+  gamma_ = plist.get<double>("forcing term gamma", 0.9);
+  alpha_ = plist.get<double>("forcing term alpha", 2.0);
+
+  if (eta_min_ <= 0. || eta_min_ > eta_max_ || eta_max_ >= 1.) {
+    Errors::Message msg("InexactNewtonForcing: forcing terms must satisfy 0 < \"minimum forcing term\" <= \"maximum forcing term\" < 1.");
+    Exceptions::amanzi_throw(msg);
+  }
+  if (gamma_ <= 0. || gamma_ > 1. || alpha_ <= 1. || alpha_ > 2.) {
+    Errors::Message msg("InexactNewtonForcing: \"forcing term gamma\" must be in (0,1] and \"forcing term alpha\" in (1,2].");
+    Exceptions::amanzi_throw(msg);
+  }
+  eta0_ = std::min(eta_max_, std::max(eta_min_, eta0_));
+
+  // the tolerance the linear solver would otherwise use, for reporting
+  std::string method = linear_solver_plist.get<std::string>("iterative method", "pcg");
+  fixed_tol_ = linear_solver_plist.sublist(method + " parameters")
+      .get<double>("error tolerance", 1.e-6);
+}
+
+
+double
+InexactNewtonForcing::Tolerance(double t_old, double t_new, double res_norm)
+{
+  if (t_old != t_old_ || t_new != t_new_) {
+    // a solve that was never finished was abandoned, e.g. by a coupler that
+    // does not tell its children of a failed step
+    Report_("abandoned");
+    Reset_();
+    t_old_ = t_old;
+    t_new_ = t_new;
+  }
+
+  double eta = eta0_;
+  if (k_ > 0 && res_norm_ > 0.) {
+    eta = gamma_ * std::pow(res_norm / res_norm_, alpha_);
+    double eta_safe = gamma_ * std::pow(eta_, alpha_);
+    if (eta_safe > 0.1) eta = std::max(eta, eta_safe);
+    eta = std::min(eta_max_, std::max(eta_min_, eta));
+  }
+
+  res_norm_ = res_norm;
+  eta_ = eta;
+  k_++;
+
+  if (vo_->os_OK(Teuchos::VERB_HIGH)) {
+    Teuchos::OSTab tab = vo_->getOSTab();
+    *vo_->os() << "inexact Newton: |r| = " << res_norm << ", linear tolerance = " << eta << std::endl;
+  }
+  return eta;
+}
+
+
+void
+InexactNewtonForcing::Record(int num_itrs)
+{
+  num_itrs_ += num_itrs;
+
+  // at a constant rate of convergence, iterations scale with log(tol)
+  if (num_itrs > 0) {
+    num_itrs_saved_ += num_itrs * (std::log(fixed_tol_) / std::log(eta_) - 1.);
+  }
+}
+
+
+void
+InexactNewtonForcing::Finish(bool committed)
+{
+  Report_(committed ? "committed" : "failed");
+  Reset_();
+}
+
+
+void
+InexactNewtonForcing::Report_(const std::string& outcome)
+{
+  if (k_ > 0 && vo_->os_OK(Teuchos::VERB_MEDIUM)) {
+    Teuchos::OSTab tab = vo_->getOSTab();
+    *vo_->os() << "inexact Newton: " << k_ << " linear solves, " << num_itrs_
+               << " iterations, ~" << static_cast<int>(std::round(num_itrs_saved_))
+               << " saved vs tolerance " << fixed_tol_
+               << " (t = " << t_old_ << " to " << t_new_ << ", " << outcome << ")" << std::endl;
+  }
+}
+
+
+void
+InexactNewtonForcing::Reset_()
+{
+  t_old_ = -1.e99;
+  t_new_ = -1.e99;
+  k_ = 0;
+  res_norm_ = 0.;
+  eta_ = 0.;
+  num_itrs_ = 0;
+  num_itrs_saved_ = 0.;
+}
+
+} // namespace Amanzi
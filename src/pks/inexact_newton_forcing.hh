@@ -0,0 +1,96 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! InexactNewtonForcing: Eisenstat-Walker linear solver tolerances.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: ATS developers
+*/
+
+/*!
+
+By default, the linear solver in a PK's preconditioner solves to the fixed
+`"error tolerance`" of its `"linear solver`" list on every nonlinear
+iteration.  Far from convergence this over-solves: the correction is only as
+good as the linearization.  With an `"inexact Newton`" list, the tolerance
+(the forcing term, :math:`\eta_k`) is instead set on each nonlinear iteration
+:math:`k` from the reduction of the residual, following Eisenstat and Walker's
+second choice:
+
+:math:`\eta_k = \gamma \left( \frac{\|r_k\|}{\|r_{k-1}\|} \right)^\alpha`
+
+safeguarded, when :math:`\gamma \eta_{k-1}^\alpha > 0.1`, by
+:math:`\eta_k \geq \gamma \eta_{k-1}^\alpha` so that the tolerance does not
+drop suddenly, and bounded by the minimum and maximum forcing terms.  The
+first iteration of each nonlinear solve uses the initial forcing term.  Here
+:math:`\|r\|` is the 2-norm of the residual that the preconditioner is applied
+to.  The nonlinear convergence criteria are unchanged.
+
+At `"verbosity level`" medium or higher, the number of linear iterations of
+each nonlinear solve is reported when its step is committed or fails, along
+with an estimate of the iterations saved relative to the fixed tolerance,
+assuming the linear solver converges at a constant rate.
+
+This requires a `"linear solver`" list in the PK, and is ignored by PKs that
+do not solve with it.
+
+* `"inexact Newton`" ``[list]``
+
+  * `"initial forcing term`" ``[double]`` **0.5**
+  * `"maximum forcing term`" ``[double]`` **0.9**
+  * `"minimum forcing term`" ``[double]`` **1.e-8**
+  * `"forcing term gamma`" ``[double]`` **0.9** :math:`\gamma`, in (0,1].
+  * `"forcing term alpha`" ``[double]`` **2.0** :math:`\alpha`, in (1,2].
+
+*/
+
+#ifndef ATS_INEXACT_NEWTON_FORCING_HH_
+#define ATS_INEXACT_NEWTON_FORCING_HH_
+
+#include "Teuchos_ParameterList.hpp"
+#include "VerboseObject.hh"
+
+namespace Amanzi {
+
+class InexactNewtonForcing {
+
+ public:
+  InexactNewtonForcing(Teuchos::ParameterList& plist,
+                       Teuchos::ParameterList& linear_solver_plist,
+                       const Teuchos::RCP<VerboseObject>& vo);
+
+  // The linear tolerance for the next solve of the nonlinear solve from
+  // t_old to t_new, given the norm of its residual.
+  double Tolerance(double t_old, double t_new, double res_norm);
+
+  // The number of iterations taken by that solve.
+  void Record(int num_itrs);
+
+  // Report the current nonlinear solve, once its step is committed or has
+  // failed, and start afresh.
+  void Finish(bool committed);
+
+ protected:
+  void Report_(const std::string& outcome);
+  void Reset_();
+
+ protected:
+  double eta0_, eta_min_, eta_max_;
+  double gamma_, alpha_;
+  double fixed_tol_;
+
+  // the current nonlinear solve
+  double t_old_, t_new_;
+  int k_;
+  double res_norm_, eta_;
+  int num_itrs_;
+  double num_itrs_saved_;
+
+  Teuchos::RCP<VerboseObject> vo_;
+};
+
+} // namespace Amanzi
+
+#endif
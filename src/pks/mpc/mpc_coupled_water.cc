@@ -34,6 +34,7 @@ MPCCoupledWater::Setup(const Teuchos::Ptr<State>& S) {
   // grab the meshes 
   surf_mesh_ = S->GetMesh(domain_surf_);
   domain_mesh_ = S->GetMesh(domain_ss_);
+  surf_faces_ = SurfaceCellToSubsurfaceFace(*surf_mesh_);
   
   // cast the PKs
   domain_flow_pk_ = sub_pks_[0];
@@ -75,6 +76,7 @@ MPCCoupledWater::Setup(const Teuchos::Ptr<State>& S) {
   Teuchos::RCP<Teuchos::ParameterList> water_list = Teuchos::sublist(plist_, "water delegate");
   water_ = Teuchos::rcp(new MPCDelegateWater(water_list, domain_ss_));
   water_->set_indices(0,1);
+  water_->set_surface_faces(surf_faces_);
 
   // grab the debuggers
   domain_db_ = domain_flow_pk_->debugger();
@@ -97,7 +99,7 @@ MPCCoupledWater::Initialize(const Teuchos::Ptr<State>& S) {
   //       		  S->GetFieldData(Keys::getKey(domain_ss_,"pressure"), sub_pks_[0]->name()).ptr());
   // ensure continuity of ICs... subsurface takes precedence.
   CopySubsurfaceToSurface(*S->GetFieldData(Keys::getKey(domain_ss_,"pressure"), sub_pks_[0]->name()),
-			  S->GetFieldData(Keys::getKey(domain_surf_,"pressure"), sub_pks_[1]->name()).ptr());
+			  S->GetFieldData(Keys::getKey(domain_surf_,"pressure"), sub_pks_[1]->name()).ptr(), surf_faces_);
 
   // Initialize my timestepper.
   PK_BDF_Default::Initialize(S);
@@ -149,11 +151,11 @@ int MPCCoupledWater::ApplyPreconditioner(Teuchos::RCP<const TreeVector> u,
   // call the precon's inverse
   if (vo_->os_OK(Teuchos::VERB_EXTREME))
     *vo_->os() << "Precon applying subsurface operator." << std::endl;
-  int ierr = lin_solver_->ApplyInverse(*u->SubVector(0)->Data(), *Pu->SubVector(0)->Data());
+  int ierr = ApplyLinearSolver_(lin_solver_, *u->SubVector(0)->Data(), *Pu->SubVector(0)->Data());
 
   // Copy subsurface face corrections to surface cell corrections
   CopySubsurfaceToSurface(*Pu->SubVector(0)->Data(),
-                          Pu->SubVector(1)->Data().ptr());
+                          Pu->SubVector(1)->Data().ptr(), surf_faces_);
 
   // // Derive surface face corrections.
   // UpdateConsistentFaceCorrectionWater_(u, Pu);
@@ -214,7 +216,7 @@ MPCCoupledWater::ModifyPredictor(double h, Teuchos::RCP<const TreeVector> u0,
     S_next_->GetFieldEvaluator(Keys::getKey(domain_surf_,"relative_permeability"))->HasFieldChanged(S_next_.ptr(),name_);
     Teuchos::RCP<const CompositeVector> h_prev = S_inter_->GetFieldData(Keys::getKey(domain_surf_,"ponded_depth"));
     MergeSubsurfaceAndSurfacePressure(*h_prev, u->SubVector(0)->Data().ptr(),
-            u->SubVector(1)->Data().ptr());
+            u->SubVector(1)->Data().ptr(), surf_faces_);
   }
   
 
@@ -226,7 +228,7 @@ MPCCoupledWater::ModifyPredictor(double h, Teuchos::RCP<const TreeVector> u0,
 
   // -- copy surf --> sub
   if (newly_modified) {
-    CopySurfaceToSubsurface(*u->SubVector(1)->Data(), u->SubVector(0)->Data().ptr());
+    CopySurfaceToSubsurface(*u->SubVector(1)->Data(), u->SubVector(0)->Data().ptr(), surf_faces_);
   }
 
   // Calculate consistent surface faces
@@ -288,7 +290,7 @@ MPCCoupledWater::ModifyCorrection(double h, Teuchos::RCP<const TreeVector> res,
 
     // Copy subsurface face corrections to surface cell corrections
     CopySubsurfaceToSurface(*du->SubVector(0)->Data(),
-                            du->SubVector(1)->Data().ptr());
+                            du->SubVector(1)->Data().ptr(), surf_faces_);
   }
 
   // if (modified) {
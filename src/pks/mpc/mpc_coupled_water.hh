@@ -94,6 +94,7 @@ class MPCCoupledWater : public StrongMPC<PK_PhysicalBDF_Default> {
   // sub meshes
   Teuchos::RCP<const AmanziMesh::Mesh> domain_mesh_;
   Teuchos::RCP<const AmanziMesh::Mesh> surf_mesh_;
+  std::vector<AmanziMesh::Entity_ID> surf_faces_;  // surface cell to subsurface face
 
   // coupled preconditioner
   Teuchos::RCP<Operators::Operator> precon_;
@@ -31,6 +31,7 @@ MPCCoupledWater::setup(const Teuchos::Ptr<State>& S) {
   // grab the meshes 
   surf_mesh_ = S->GetMesh(domain_surf);
   domain_mesh_ = S->GetMesh(domain_ss);
+  surf_faces_ = SurfaceCellToSubsurfaceFace(*surf_mesh_);
 
   // cast the PKs
   domain_flow_pk_ = sub_pks_[0];
@@ -101,6 +102,7 @@ MPCCoupledWater::setup(const Teuchos::Ptr<State>& S) {
   Teuchos::RCP<Teuchos::ParameterList> water_list = Teuchos::sublist(plist_, "water delegate");
   water_ = Teuchos::rcp(new MPCDelegateWater(water_list));
   water_->set_indices(0,1);
+  water_->set_surface_faces(surf_faces_);
 
   // grab the debuggers
   domain_db_ = domain_flow_pk_->debugger();
@@ -129,7 +131,7 @@ MPCCoupledWater::initialize(const Teuchos::Ptr<State>& S) {
   MPC<PKPhysicalBDFBase>::initialize(S);
   // ensure continuity of ICs... surface takes precedence.
   CopySurfaceToSubsurface(*S->GetFieldData("surface-pressure", sub_pks_[1]->name()),
-                          S->GetFieldData("pressure", sub_pks_[0]->name()).ptr());
+                          S->GetFieldData("pressure", sub_pks_[0]->name()).ptr(), surf_faces_);
   // Initialize my timestepper.
   PKBDFBase::initialize(S);
 
@@ -186,7 +188,7 @@ int MPCCoupledWater::ApplyPreconditioner(Teuchos::RCP<const TreeVector> u,
 
   // Copy subsurface face corrections to surface cell corrections
   CopySubsurfaceToSurface(*Pu->SubVector(0)->Data(),
-                          Pu->SubVector(1)->Data().ptr());
+                          Pu->SubVector(1)->Data().ptr(), surf_faces_);
 
   // // Derive surface face corrections.
   // UpdateConsistentFaceCorrectionWater_(u, Pu);
@@ -246,7 +248,7 @@ MPCCoupledWater::ModifyPredictor(double h, Teuchos::RCP<const TreeVector> u0,
     S_next_->GetFieldEvaluator("surface-relative_permeability")->HasFieldChanged(S_next_.ptr(),name_);
     Teuchos::RCP<const CompositeVector> h_prev = S_inter_->GetFieldData("surface-ponded_depth");
     MergeSubsurfaceAndSurfacePressure(*h_prev, u->SubVector(0)->Data().ptr(),
-            u->SubVector(1)->Data().ptr());
+            u->SubVector(1)->Data().ptr(), surf_faces_);
   }
   /*
   // Hack surface faces
@@ -257,7 +259,7 @@ MPCCoupledWater::ModifyPredictor(double h, Teuchos::RCP<const TreeVector> u0,
   
   // -- copy surf --> sub
   if (newly_modified) {
-    CopySurfaceToSubsurface(*u->SubVector(1)->Data(), u->SubVector(0)->Data().ptr());
+    CopySurfaceToSubsurface(*u->SubVector(1)->Data(), u->SubVector(0)->Data().ptr(), surf_faces_);
   }
 
   // Calculate consistent surface faces
@@ -319,7 +321,7 @@ MPCCoupledWater::ModifyCorrection(double h, Teuchos::RCP<const TreeVector> res,
 
     // Copy subsurface face corrections to surface cell corrections
     CopySubsurfaceToSurface(*du->SubVector(0)->Data(),
-                            du->SubVector(1)->Data().ptr());
+                            du->SubVector(1)->Data().ptr(), surf_faces_);
   }
 
   // if (modified) {
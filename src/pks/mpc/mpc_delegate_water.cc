@@ -1,5 +1,7 @@
 // Delegate for heuristic corrections based upon coupled surface/subsurface water.
 
+#include "errors.hh"
+
 #include "mpc_delegate_water.hh"
 
 namespace Amanzi {
@@ -51,6 +53,18 @@ MPCDelegateWater::MPCDelegateWater(const Teuchos::RCP<Teuchos::ParameterList>& p
   vo_ = Teuchos::rcp(new VerboseObject(plist->name(), *plist_));
 }
 
+
+void
+MPCDelegateWater::CheckSurfaceFaces_(int ncells_surf) const {
+  if (surf_faces_.size() != ncells_surf) {
+    Errors::Message msg;
+    msg << "MPCDelegateWater: the surface cell to subsurface face map has "
+        << (int) surf_faces_.size() << " entries but the surface has " << ncells_surf
+        << " cells; the MPC must call set_surface_faces() in its setup.";
+    Exceptions::amanzi_throw(msg);
+  }
+}
+
 // Approach 1: global face limiter on the correction size
 int
 MPCDelegateWater::ModifyCorrection_WaterFaceLimiter(double h, Teuchos::RCP<const TreeVector> res,
@@ -95,9 +109,9 @@ MPCDelegateWater::ModifyCorrection_WaterSpurtDamp(double h, Teuchos::RCP<const T
   // Approach 2
   double damp = 1.;
   if (damp_the_spurt_) {
+    CheckSurfaceFaces_(ncells_surf);
     for (int cs=0; cs!=ncells_surf; ++cs) {
-      AmanziMesh::Entity_ID f =
-          surf_mesh->entity_get_parent(AmanziMesh::CELL, cs);
+      AmanziMesh::Entity_ID f = surf_faces_[cs];
       double p_old = domain_p_f[0][f];
       double p_new = p_old - domain_Pu_f[0][f];
       if ((p_new > patm + cap_size_) && (p_old < patm)) {
@@ -137,8 +151,9 @@ MPCDelegateWater::ModifyCorrection_WaterSpurtCap(double h, Teuchos::RCP<const Tr
   // Approach 3
   int n_modified = 0;
   if (cap_the_spurt_) {
+    CheckSurfaceFaces_(ncells_surf);
     for (int cs=0; cs!=ncells_surf; ++cs) {
-      AmanziMesh::Entity_ID f = surf_mesh->entity_get_parent(AmanziMesh::CELL, cs);
+      AmanziMesh::Entity_ID f = surf_faces_[cs];
 
       double p_old = domain_p_f[0][f];
       double p_new = p_old - domain_Pu_f[0][f] / damp;
@@ -254,15 +269,13 @@ MPCDelegateWater::ModifyPredictor_Heuristic(double h, const Teuchos::RCP<TreeVec
     Epetra_MultiVector& surf_u_c =
         *u->SubVector(i_surf_)->Data()->ViewComponent("cell",false);
 
-    Teuchos::RCP<const AmanziMesh::Mesh> surf_mesh =
-        u->SubVector(i_surf_)->Data()->Mesh();
-
     const Epetra_MultiVector& surf_u_prev_c =
         *S_->GetFieldData("surface_pressure")->ViewComponent("cell",false);
     const double& patm = *S_next_->GetScalarData("atmospheric_pressure");
     int ncells = surf_u_c.MyLength();
+    CheckSurfaceFaces_(ncells);
     for (int c=0; c!=ncells; ++c) {
-      int f = surf_mesh->entity_get_parent(AmanziMesh::CELL, c);
+      int f = surf_faces_[c];
 
       double dp = surf_u_c[0][c] - surf_u_prev_c[0][c];
       double pnew = surf_u_c[0][c] - patm;
@@ -318,10 +331,10 @@ MPCDelegateWater::ModifyPredictor_WaterSpurtDamp(double h,
         *S_->GetFieldData(key_ss)->ViewComponent("face",false);
 
     int rank = surf_mesh->get_comm()->MyPID();
+    CheckSurfaceFaces_(ncells_surf);
     double damp = 1.;
     for (unsigned int cs=0; cs!=ncells_surf; ++cs) {
-      AmanziMesh::Entity_ID f =
-          surf_mesh->entity_get_parent(AmanziMesh::CELL, cs);
+      AmanziMesh::Entity_ID f = surf_faces_[cs];
       double p_old = domain_pold_f[0][f];
       double p_new = domain_pnew_f[0][f];
       if ((p_new > patm + cap_size_) && (p_old < patm)) {
@@ -357,8 +370,7 @@ MPCDelegateWater::ModifyPredictor_WaterSpurtDamp(double h,
 
       // undamp and cap the surface
       for (unsigned int cs=0; cs!=ncells_surf; ++cs) {
-        AmanziMesh::Entity_ID f =
-            surf_mesh->entity_get_parent(AmanziMesh::CELL, cs);
+        AmanziMesh::Entity_ID f = surf_faces_[cs];
         double p_old = domain_pold_f[0][f];
         double p_new = (domain_pnew_f[0][f] - p_old) / damp + p_old;
         if ((p_new > patm + cap_size_) && (p_old < patm)) {
@@ -410,16 +422,13 @@ MPCDelegateWater::ModifyPredictor_TempFromSource(double h, const Teuchos::RCP<Tr
     const Epetra_MultiVector& dhsource = *S_->GetFieldData("surface_mass_source")
         ->ViewComponent("cell",false);
 
-    Teuchos::RCP<const AmanziMesh::Mesh> surf_mesh =
-        u->SubVector(i_surf_)->Data()->Mesh();
-
+    CheckSurfaceFaces_(surf_Tnew_c.MyLength());
     for (unsigned int c=0; c!=surf_Tnew_c.MyLength(); ++c) {
       if (surf_Tnew_c[0][c] < 271.15) {
         // frozen, modify predictor to ensure surface is ready to accept ice
         if (surf_pnew_c[0][c] < 101325.) {
           surf_pnew_c[0][c] = 101325.1;
-          AmanziMesh::Entity_ID f =
-              surf_mesh->entity_get_parent(AmanziMesh::CELL, c);
+          AmanziMesh::Entity_ID f = surf_faces_[c];
           domain_pnew_f[0][f] = surf_pnew_c[0][c];
         }
       }
@@ -104,6 +104,11 @@ class MPCDelegateWater {
     i_Tsurf_ = i_Tsurf;
   }
 
+  // surface cell to subsurface face map, from SurfaceCellToSubsurfaceFace()
+  void set_surface_faces(const std::vector<AmanziMesh::Entity_ID>& faces) {
+    surf_faces_ = faces;
+  }
+
 
   bool
   ModifyPredictor_Heuristic(double h, const Teuchos::RCP<TreeVector>& u);
@@ -137,6 +142,9 @@ class MPCDelegateWater {
                                     Teuchos::RCP<const TreeVector> u, Teuchos::RCP<TreeVector> du, double damping);
 
  protected:
+  // throws unless set_surface_faces() was given a map of this many surface cells
+  void CheckSurfaceFaces_(int ncells_surf) const;
+
   Teuchos::RCP<Teuchos::ParameterList> plist_;
   Teuchos::RCP<VerboseObject> vo_;
   Teuchos::RCP<Debugger> db_;
@@ -168,6 +176,9 @@ class MPCDelegateWater {
   int i_Tsurf_;
   int i_Tdomain_;
 
+  // surface cell to subsurface face
+  std::vector<AmanziMesh::Entity_ID> surf_faces_;
+
   Key domain_ss_;
 
 };
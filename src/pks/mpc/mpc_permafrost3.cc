@@ -53,6 +53,7 @@ MPCPermafrost3::setup(const Teuchos::Ptr<State>& S) {
   // grab the meshes
   surf_mesh_ = S->GetMesh("surface");
   domain_mesh_ = S->GetMesh();
+  surf_faces_ = SurfaceCellToSubsurfaceFace(*surf_mesh_);
 
   // cast the PKs
   domain_flow_pk_ = sub_pks_[0];
@@ -171,6 +172,7 @@ MPCPermafrost3::setup(const Teuchos::Ptr<State>& S) {
   Teuchos::RCP<Teuchos::ParameterList> water_list = Teuchos::sublist(plist_, "water delegate");
   water_ = Teuchos::rcp(new MPCDelegateWater(water_list));
   water_->set_indices(0,2,1,3);
+  water_->set_surface_faces(surf_faces_);
 
   // set up our own predictors
   consistent_cells_ =
@@ -194,9 +196,9 @@ MPCPermafrost3::initialize(const Teuchos::Ptr<State>& S) {
 
   // ensure continuity of ICs... surface takes precedence.
   CopySurfaceToSubsurface(*S->GetFieldData("surface_pressure", sub_pks_[2]->name()),
-                          S->GetFieldData("pressure", sub_pks_[0]->name()).ptr());
+                          S->GetFieldData("pressure", sub_pks_[0]->name()).ptr(), surf_faces_);
   CopySurfaceToSubsurface(*S->GetFieldData("surface_temperature", sub_pks_[3]->name()),
-                          S->GetFieldData("temperature", sub_pks_[1]->name()).ptr());
+                          S->GetFieldData("temperature", sub_pks_[1]->name()).ptr(), surf_faces_);
 
   // initialize delegates
   surf_ewc_->initialize(S);
@@ -370,9 +372,9 @@ int MPCPermafrost3::ApplyPreconditioner(Teuchos::RCP<const TreeVector> r,
   
   // Copy subsurface face corrections to surface cell corrections
   CopySubsurfaceToSurface(*Pr->SubVector(0)->Data(),
-                          Pr->SubVector(2)->Data().ptr());
+                          Pr->SubVector(2)->Data().ptr(), surf_faces_);
   CopySubsurfaceToSurface(*Pr->SubVector(1)->Data(),
-                          Pr->SubVector(3)->Data().ptr());
+                          Pr->SubVector(3)->Data().ptr(), surf_faces_);
 
   // Derive surface face corrections.
   pc_surf_energy_->UpdateConsistentFaceCorrection(*r->SubVector(3)->Data(),
@@ -522,8 +524,8 @@ MPCPermafrost3::ModifyPredictor(double h, Teuchos::RCP<const TreeVector> u0,
   if (modified) {
     S_next_->GetFieldEvaluator("surface_relative_permeability")->HasFieldChanged(S_next_.ptr(),name_);
     Teuchos::RCP<const CompositeVector> h_prev = S_inter_->GetFieldData("ponded_depth");
-    MergeSubsurfaceAndSurfacePressure(*h_prev, u->SubVector(0)->Data().ptr(), u->SubVector(2)->Data().ptr());
-    CopySubsurfaceToSurface(*u->SubVector(1)->Data(), u->SubVector(3)->Data().ptr());
+    MergeSubsurfaceAndSurfacePressure(*h_prev, u->SubVector(0)->Data().ptr(), u->SubVector(2)->Data().ptr(), surf_faces_);
+    CopySubsurfaceToSurface(*u->SubVector(1)->Data(), u->SubVector(3)->Data().ptr(), surf_faces_);
   }
 
   // Hack surface faces
@@ -535,8 +537,8 @@ MPCPermafrost3::ModifyPredictor(double h, Teuchos::RCP<const TreeVector> u0,
 
   // -- copy surf --> sub
   //  if (newly_modified) {
-  CopySurfaceToSubsurface(*u->SubVector(2)->Data(), u->SubVector(0)->Data().ptr());
-  CopySurfaceToSubsurface(*u->SubVector(3)->Data(), u->SubVector(1)->Data().ptr());
+  CopySurfaceToSubsurface(*u->SubVector(2)->Data(), u->SubVector(0)->Data().ptr(), surf_faces_);
+  CopySurfaceToSubsurface(*u->SubVector(3)->Data(), u->SubVector(1)->Data().ptr(), surf_faces_);
   //  }
 
   // Calculate consistent surface faces
@@ -632,7 +634,7 @@ MPCPermafrost3::ModifyCorrection(double h, Teuchos::RCP<const TreeVector> r,
   if (modified) {
     // Copy subsurface face corrections to surface cell corrections
     CopySubsurfaceToSurface(*du->SubVector(0)->Data(),
-                            du->SubVector(2)->Data().ptr());
+                            du->SubVector(2)->Data().ptr(), surf_faces_);
 
     // Derive surface face corrections.
     UpdateConsistentFaceCorrectionWater_(r.ptr(), u.ptr(), du.ptr());
@@ -82,6 +82,7 @@ class MPCPermafrost3 : public StrongMPC<PKPhysicalBDFBase> {
   // sub meshes
   Teuchos::RCP<const AmanziMesh::Mesh> domain_mesh_;
   Teuchos::RCP<const AmanziMesh::Mesh> surf_mesh_;
+  std::vector<AmanziMesh::Entity_ID> surf_faces_;  // surface cell to subsurface face
 
   // coupled preconditioner
   Teuchos::RCP<TreeMatrix> lin_solver_;
@@ -58,6 +58,7 @@ MPCPermafrost4::Setup(const Teuchos::Ptr<State>& S) {
   // grab the meshes
   surf_mesh_ = S->GetMesh(domain_surf_);
   domain_mesh_ = S->GetMesh(domain_subsurf_);
+  surf_faces_ = SurfaceCellToSubsurfaceFace(*surf_mesh_);
   
   // alias the PKs for easier reference
   domain_flow_pk_ = sub_pks_[0];
@@ -144,6 +145,7 @@ MPCPermafrost4::Setup(const Teuchos::Ptr<State>& S) {
   water_ = Teuchos::rcp(new MPCDelegateWater(water_list, domain_subsurf_));
 
   water_->set_indices(0,2,1,3);
+  water_->set_surface_faces(surf_faces_);
 
   // grab the debuggers
   domain_db_ = domain_flow_pk_->debugger();
@@ -167,9 +169,9 @@ MPCPermafrost4::Initialize(const Teuchos::Ptr<State>& S) {
 
   // ensure continuity of ICs... surface takes precedence.
   CopySurfaceToSubsurface(*S->GetFieldData(Keys::getKey(domain_surf_,"pressure"), surf_flow_pk_->name()),
-                          S->GetFieldData(Keys::getKey(domain_subsurf_,"pressure"), domain_flow_pk_->name()).ptr());
+                          S->GetFieldData(Keys::getKey(domain_subsurf_,"pressure"), domain_flow_pk_->name()).ptr(), surf_faces_);
   CopySurfaceToSubsurface(*S->GetFieldData(Keys::getKey(domain_surf_,"temperature"), surf_energy_pk_->name()),
-                          S->GetFieldData(Keys::getKey(domain_subsurf_,"temperature"), domain_energy_pk_->name()).ptr());
+                          S->GetFieldData(Keys::getKey(domain_subsurf_,"temperature"), domain_energy_pk_->name()).ptr(), surf_faces_);
 }
 
 
@@ -277,9 +279,9 @@ int MPCPermafrost4::ApplyPreconditioner(Teuchos::RCP<const TreeVector> r,
 
   // Copy subsurface face corrections to surface cell corrections
   CopySubsurfaceToSurface(*Pr->SubVector(0)->Data(),
-                          Pr->SubVector(2)->Data().ptr());
+                          Pr->SubVector(2)->Data().ptr(), surf_faces_);
   CopySubsurfaceToSurface(*Pr->SubVector(1)->Data(),
-                          Pr->SubVector(3)->Data().ptr());
+                          Pr->SubVector(3)->Data().ptr(), surf_faces_);
 
   // dump to screen
   if (vo_->os_OK(Teuchos::VERB_HIGH)) {
@@ -436,8 +438,8 @@ MPCPermafrost4::ModifyPredictor(double h, Teuchos::RCP<const TreeVector> u0,
     S_next_->GetFieldEvaluator(Keys::getKey(domain_surf_,"relative_permeability"))->HasFieldChanged(S_next_.ptr(),name_);
     Teuchos::RCP<const CompositeVector> h_prev = S_inter_->GetFieldData(Keys::getKey(domain_surf_,"ponded_depth"));
 
-    MergeSubsurfaceAndSurfacePressure(*h_prev, u->SubVector(0)->Data().ptr(), u->SubVector(2)->Data().ptr());
-    CopySubsurfaceToSurface(*u->SubVector(1)->Data(), u->SubVector(3)->Data().ptr());
+    MergeSubsurfaceAndSurfacePressure(*h_prev, u->SubVector(0)->Data().ptr(), u->SubVector(2)->Data().ptr(), surf_faces_);
+    CopySubsurfaceToSurface(*u->SubVector(1)->Data(), u->SubVector(3)->Data().ptr(), surf_faces_);
   }
 
   // Hack surface faces
@@ -469,8 +471,8 @@ MPCPermafrost4::ModifyPredictor(double h, Teuchos::RCP<const TreeVector> u0,
 
   // -- copy surf --> sub
   //  if (newly_modified) {
-  CopySurfaceToSubsurface(*u->SubVector(2)->Data(), u->SubVector(0)->Data().ptr());
-  CopySurfaceToSubsurface(*u->SubVector(3)->Data(), u->SubVector(1)->Data().ptr());
+  CopySurfaceToSubsurface(*u->SubVector(2)->Data(), u->SubVector(0)->Data().ptr(), surf_faces_);
+  CopySurfaceToSubsurface(*u->SubVector(3)->Data(), u->SubVector(1)->Data().ptr(), surf_faces_);
   //  }
 
   // Calculate consistent surface faces
@@ -512,9 +514,9 @@ MPCPermafrost4::ModifyCorrection(double h, Teuchos::RCP<const TreeVector> r,
       StrongMPC<PK_PhysicalBDF_Default>::ModifyCorrection(h,r,u,du);
   if (pk_modified) {
     CopySurfaceToSubsurface(*du->SubVector(2)->Data(),
-                            du->SubVector(0)->Data().ptr());
+                            du->SubVector(0)->Data().ptr(), surf_faces_);
     CopySurfaceToSubsurface(*du->SubVector(3)->Data(),
-                            du->SubVector(1)->Data().ptr());
+                            du->SubVector(1)->Data().ptr(), surf_faces_);
   }
     
   // modify correction using water approaches
@@ -536,7 +538,7 @@ MPCPermafrost4::ModifyCorrection(double h, Teuchos::RCP<const TreeVector> r,
   if (modified) {
     // Copy subsurface face corrections to surface cell corrections
     CopySubsurfaceToSurface(*du->SubVector(0)->Data(),
-                            du->SubVector(2)->Data().ptr());
+                            du->SubVector(2)->Data().ptr(), surf_faces_);
   }
 
   // dump modified correction to screen
@@ -59,6 +59,7 @@ class MPCPermafrost4 : public MPCSubsurface {
   Key domain_subsurf_;
   Teuchos::RCP<const AmanziMesh::Mesh> domain_mesh_;
   Teuchos::RCP<const AmanziMesh::Mesh> surf_mesh_;
+  std::vector<AmanziMesh::Entity_ID> surf_faces_;  // surface cell to subsurface face
 
   // off-diagonal terms
   Teuchos::RCP<Operators::OperatorAccumulation> dE_dp_surf_;
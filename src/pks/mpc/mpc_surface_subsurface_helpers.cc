@@ -1,45 +1,64 @@
+#include "dbc.hh"
 #include "mpc_surface_subsurface_helpers.hh"
 
 namespace Amanzi {
 
+std::vector<AmanziMesh::Entity_ID>
+SurfaceCellToSubsurfaceFace(const AmanziMesh::Mesh& surf_mesh) {
+  int ncells = surf_mesh.num_entities(AmanziMesh::CELL, AmanziMesh::OWNED);
+  std::vector<AmanziMesh::Entity_ID> faces(ncells);
+  for (int sc=0; sc!=ncells; ++sc) {
+    faces[sc] = surf_mesh.entity_get_parent(AmanziMesh::CELL, sc);
+  }
+  return faces;
+}
+
+
 void
 CopySurfaceToSubsurface(const CompositeVector& surf,
-                        const Teuchos::Ptr<CompositeVector>& sub) {
+                        const Teuchos::Ptr<CompositeVector>& sub,
+                        const std::vector<AmanziMesh::Entity_ID>& faces) {
   const Epetra_MultiVector& surf_c = *surf.ViewComponent("cell",false);
   Epetra_MultiVector& sub_f = *sub->ViewComponent("face",false);
+  ASSERT(faces.size() == surf_c.MyLength());
 
-  for (unsigned int sc=0; sc!=surf_c.MyLength(); ++sc) {
-    AmanziMesh::Entity_ID f =
-        surf.Mesh()->entity_get_parent(AmanziMesh::CELL, sc);
-    sub_f[0][f] = surf_c[0][sc];
+  const double* surf_v = surf_c[0];
+  double* sub_v = sub_f[0];
+  int ncells = surf_c.MyLength();
+  for (int sc=0; sc!=ncells; ++sc) {
+    sub_v[faces[sc]] = surf_v[sc];
   }
 }
 
 void
 CopySubsurfaceToSurface(const CompositeVector& sub,
-                        const Teuchos::Ptr<CompositeVector>& surf) {
+                        const Teuchos::Ptr<CompositeVector>& surf,
+                        const std::vector<AmanziMesh::Entity_ID>& faces) {
   const Epetra_MultiVector& sub_f = *sub.ViewComponent("face",false);
   Epetra_MultiVector& surf_c = *surf->ViewComponent("cell",false);
+  ASSERT(faces.size() == surf_c.MyLength());
 
-  for (unsigned int sc=0; sc!=surf_c.MyLength(); ++sc) {
-    AmanziMesh::Entity_ID f =
-        surf->Mesh()->entity_get_parent(AmanziMesh::CELL, sc);
-    surf_c[0][sc] = sub_f[0][f];
+  const double* sub_v = sub_f[0];
+  double* surf_v = surf_c[0];
+  int ncells = surf_c.MyLength();
+  for (int sc=0; sc!=ncells; ++sc) {
+    surf_v[sc] = sub_v[faces[sc]];
   }
 }
 
 void
 MergeSubsurfaceAndSurfacePressure(const CompositeVector& h_prev,
 				  const Teuchos::Ptr<CompositeVector>& sub_p,
-				  const Teuchos::Ptr<CompositeVector>& surf_p) {
+				  const Teuchos::Ptr<CompositeVector>& surf_p,
+                                  const std::vector<AmanziMesh::Entity_ID>& faces) {
   Epetra_MultiVector& sub_p_f = *sub_p->ViewComponent("face",false);
   Epetra_MultiVector& surf_p_c = *surf_p->ViewComponent("cell",false);
   const Epetra_MultiVector& h_c = *h_prev.ViewComponent("cell",false);
+  ASSERT(faces.size() == surf_p_c.MyLength());
   double p_atm = 101325.;
 
   for (unsigned int sc=0; sc!=surf_p_c.MyLength(); ++sc) {
-    AmanziMesh::Entity_ID f =
-        surf_p->Mesh()->entity_get_parent(AmanziMesh::CELL, sc);
+    AmanziMesh::Entity_ID f = faces[sc];
     if (h_c[0][sc] > 0. && surf_p_c[0][sc] > p_atm) {
       sub_p_f[0][f] = surf_p_c[0][sc];
     } else {
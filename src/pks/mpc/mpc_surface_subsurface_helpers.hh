@@ -1,26 +1,36 @@
 #ifndef PKS_MPC_SURFACE_SUBSURFACE_HELPERS_HH_
 #define PKS_MPC_SURFACE_SUBSURFACE_HELPERS_HH_
 
+#include <vector>
+
 #include "CompositeVector.hh"
 
 namespace Amanzi {
 
+// Index map from owned surface cells to the subsurface face each surface
+// cell is extruded from.  This depends only on topology, so MPCs build it
+// once, in Setup, and pass it to the helpers below.
+std::vector<AmanziMesh::Entity_ID>
+SurfaceCellToSubsurfaceFace(const AmanziMesh::Mesh& surf_mesh);
+
 void
 CopySurfaceToSubsurface(const CompositeVector& surf,
-                        const Teuchos::Ptr<CompositeVector>& sub);
+                        const Teuchos::Ptr<CompositeVector>& sub,
+                        const std::vector<AmanziMesh::Entity_ID>& faces);
 
 void
 CopySubsurfaceToSurface(const CompositeVector& sub,
-                        const Teuchos::Ptr<CompositeVector>& surf);
+                        const Teuchos::Ptr<CompositeVector>& surf,
+                        const std::vector<AmanziMesh::Entity_ID>& faces);
 
 void
 MergeSubsurfaceAndSurfacePressure(const CompositeVector& kr_surf,
 				  const Teuchos::Ptr<CompositeVector>& sub_p,
-				  const Teuchos::Ptr<CompositeVector>& surf_p);
+				  const Teuchos::Ptr<CompositeVector>& surf_p,
+                                  const std::vector<AmanziMesh::Entity_ID>& faces);
 
 
 } // namespace
 
 
 #endif
-
@@ -33,6 +33,7 @@ OperatorSplitMPC::OperatorSplitMPC(Teuchos::ParameterList& FElist,
   std::string domain = plist_->get<std::string>("domain name");
   primary_variable_ = Keys::readKey(*plist_, domain, "primary variable");
   primary_variable_star_ = Keys::getKey(domain+"_star", Keys::getVarName(primary_variable_));
+  surf_faces_ = SurfaceCellToSubsurfaceFace(*S->GetMesh(domain));
   init_(S);
 };
 
@@ -81,13 +82,15 @@ bool OperatorSplitMPC::AdvanceStep(double t_old, double t_new, bool reinit) {
   // BEGIN THE NON-GENERIC PART TO BE REMOVED
   // also copy and mark the subsurface system
   CopySurfaceToSubsurface(*S_inter_->GetFieldData(primary_variable_),
-                          S_inter_->GetFieldData("pressure",S_inter_->GetField("pressure")->owner()).ptr());
+                          S_inter_->GetFieldData("pressure",S_inter_->GetField("pressure")->owner()).ptr(),
+                          surf_faces_);
   auto eval = S_inter_->GetFieldEvaluator("pressure");
   auto eval_pvfe = Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>(eval);
   eval_pvfe->SetFieldAsChanged(S_inter_.ptr());
 
   CopySurfaceToSubsurface(*S_next_->GetFieldData(primary_variable_),
-                          S_next_->GetFieldData("pressure",S_next_->GetField("pressure")->owner()).ptr());
+                          S_next_->GetFieldData("pressure",S_next_->GetField("pressure")->owner()).ptr(),
+                          surf_faces_);
   auto eval2 = S_next_->GetFieldEvaluator("pressure");
   auto eval_pvfe2 = Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>(eval2);
   eval_pvfe2->SetFieldAsChanged(S_next_.ptr());
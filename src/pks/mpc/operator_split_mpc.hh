@@ -56,6 +56,7 @@ class OperatorSplitMPC : public MPC<PK> {
  protected:
   Key primary_variable_;
   Key primary_variable_star_;
+  std::vector<AmanziMesh::Entity_ID> surf_faces_;  // surface cell to subsurface face
   
  private:
   // factory registration
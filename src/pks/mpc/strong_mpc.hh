@@ -53,6 +53,11 @@ public:
   void set_states(const Teuchos::RCP<const State>& S,
                   const Teuchos::RCP<State>& S_inter,
                   const Teuchos::RCP<State>& S_next);
+
+  // checkpointed time derivative of each sub-PK's solution
+  virtual void SetupSolutionDot(const Teuchos::Ptr<State>& S);
+  virtual bool State_to_SolutionDot(const Teuchos::Ptr<State>& S,
+          TreeVector& soln_dot);
   
   // StrongMPC is a BDFFnBase
   // -- computes the non-linear functional g = g(t,u,udot)
@@ -175,6 +180,27 @@ void StrongMPC<PK_t>::set_states(const Teuchos::RCP<const State>& S,
   MPC<PK_t>::set_states(S,S_inter,S_next);
 } 
 
+// -----------------------------------------------------------------------------
+// Checkpointed time derivative of the solution, for restart.
+// -----------------------------------------------------------------------------
+template<class PK_t>
+void StrongMPC<PK_t>::SetupSolutionDot(const Teuchos::Ptr<State>& S) {
+  for (unsigned int i=0; i!=sub_pks_.size(); ++i) {
+    sub_pks_[i]->SetupSolutionDot(S);
+  }
+}
+
+template<class PK_t>
+bool StrongMPC<PK_t>::State_to_SolutionDot(const Teuchos::Ptr<State>& S,
+        TreeVector& soln_dot) {
+  bool initialized = true;
+  for (unsigned int i=0; i!=sub_pks_.size(); ++i) {
+    initialized &= sub_pks_[i]->State_to_SolutionDot(S, *soln_dot.SubVector(i));
+  }
+  return initialized;
+}
+
+
 // -----------------------------------------------------------------------------
 // Compute the non-linear functional g = g(t,u,udot).
 // -----------------------------------------------------------------------------
@@ -12,6 +12,7 @@ sub-PKs, calling their advance() methods and returning failure if any fail.
 See additional documentation in the base class src/pks/mpc/MPC.hh
 ------------------------------------------------------------------------- */
 
+#include "pk_bdf_default.hh"
 #include "weak_mpc.hh"
 
 namespace Amanzi {
@@ -64,4 +65,18 @@ bool WeakMPC::AdvanceStep(double t_old, double t_new, bool reinit) {
   return fail;
 };
 
+// -----------------------------------------------------------------------------
+// Checkpointed time integrator history of each sub-PK, for restart.
+// -----------------------------------------------------------------------------
+void WeakMPC::SetupIntegratorHistory(const Teuchos::Ptr<State>& S) {
+  for (MPC<PK>::SubPKList::iterator pk = sub_pks_.begin();
+       pk != sub_pks_.end(); ++pk) {
+    Teuchos::RCP<PK_BDF_Default> pk_bdf = Teuchos::rcp_dynamic_cast<PK_BDF_Default>(*pk);
+    if (pk_bdf != Teuchos::null) pk_bdf->SetupIntegratorHistory(S);
+
+    Teuchos::RCP<WeakMPC> pk_weak = Teuchos::rcp_dynamic_cast<WeakMPC>(*pk);
+    if (pk_weak != Teuchos::null) pk_weak->SetupIntegratorHistory(S);
+  }
+};
+
 } // namespace
@@ -41,6 +41,10 @@ public:
 
   virtual void set_dt(double dt);
 
+  // -- Require the fields checkpointing the time integrator history of each
+  //    sub-PK, each of which integrates in time on its own.
+  void SetupIntegratorHistory(const Teuchos::Ptr<State>& S);
+
 private:
   // factory registration
   static RegisteredPKFactory<WeakMPC> reg_;
@@ -120,6 +120,21 @@ WeakMPCSemiCoupled::Setup(const Teuchos::Ptr<State>& S) {
   //  sync_time_ = plist_->get<double>("sync time"); //provide default value later!!
   ASSERT(!(coupling_key_.empty()));
 
+  // the surface to subsurface maps, which depend only on topology
+  Teuchos::RCP<const AmanziMesh::Mesh> surf_mesh = S->GetMesh("surface");
+  int ncells_surf = surf_mesh->num_entities(AmanziMesh::CELL, AmanziMesh::OWNED);
+  column_surf_faces_.resize(ncells_surf);
+  for (int c=0; c!=ncells_surf; ++c) {
+    std::stringstream name;
+    name << "surface_column_" << surf_mesh->cell_map(false).GID(c);
+    if (S->HasMesh(name.str())) {
+      column_surf_faces_[c] = SurfaceCellToSubsurfaceFace(*S->GetMesh(name.str()));
+    }
+  }
+  if (coupling_key_ == "surface subsurface system: 3D") {
+    surf_faces_ = SurfaceCellToSubsurfaceFace(*surf_mesh);
+  }
+
 };
 
 //-------------------------------------------------------------------------------------
@@ -243,11 +258,13 @@ WeakMPCSemiCoupled::CoupledSurfSubsurfColumns(double t_old, double t_new, bool r
     
     CopySurfaceToSubsurface(*S_inter_->GetFieldData(Keys::getKey(name.str(),"pressure")),
 			    S_inter_->GetFieldData(Keys::getKey(name_ss.str(),"pressure"), 
-						   S_inter_->GetField(Keys::getKey(name_ss.str(),"pressure"))->owner()).ptr());
+						   S_inter_->GetField(Keys::getKey(name_ss.str(),"pressure"))->owner()).ptr(),
+			    column_surf_faces_[c]);
     
     CopySurfaceToSubsurface(*S_inter_->GetFieldData(Keys::getKey(name.str(),"temperature")),
 			    S_inter_->GetFieldData(Keys::getKey(name_ss.str(),"temperature"), 
-						   S_inter_->GetField(Keys::getKey(name_ss.str(),"temperature"))->owner()).ptr());
+						   S_inter_->GetField(Keys::getKey(name_ss.str(),"temperature"))->owner()).ptr(),
+			    column_surf_faces_[c]);
   } 
   // NOTE: later do it in the setup --aj
   
@@ -541,10 +558,12 @@ WeakMPCSemiCoupled::CoupledSurfSubsurf3D(double t_old, double t_new, bool reinit
   
   
   CopySurfaceToSubsurface(*S_inter_->GetFieldData("surface-pressure"),
-			  S_inter_->GetFieldData("pressure", S_inter_->GetField("pressure")->owner()).ptr());
+			  S_inter_->GetFieldData("pressure", S_inter_->GetField("pressure")->owner()).ptr(),
+			  surf_faces_);
 
   CopySurfaceToSubsurface(*S_inter_->GetFieldData("surface-temperature"),
-			 S_inter_->GetFieldData("temperature", S_inter_->GetField("temperature")->owner()).ptr());
+			 S_inter_->GetFieldData("temperature", S_inter_->GetField("temperature")->owner()).ptr(),
+			  surf_faces_);
   
   // NOTE: later do it in the setup --aj
   
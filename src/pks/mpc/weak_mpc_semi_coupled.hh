@@ -39,6 +39,11 @@ private :
   static unsigned flag_star, flag_star_surf;
   Key coupling_key_ ;
   bool subcycle_key_ ;
+
+  // surface cell to subsurface face, of each column, by surface cell
+  std::vector<std::vector<AmanziMesh::Entity_ID> > column_surf_faces_;
+  // surface cell to subsurface face, for the 3D coupling
+  std::vector<AmanziMesh::Entity_ID> surf_faces_;
   
 
   bool sg_model_;
@@ -194,6 +194,18 @@ WeakMPCSemiCoupledDeform::Setup(const Teuchos::Ptr<State>& S) {
   
   ASSERT(!(coupling_key_.empty()));
 
+  // the surface to subsurface maps, which depend only on topology
+  Teuchos::RCP<const AmanziMesh::Mesh> surf_mesh = S->GetMesh("surface");
+  int ncells_surf = surf_mesh->num_entities(AmanziMesh::CELL, AmanziMesh::OWNED);
+  column_surf_faces_.resize(ncells_surf);
+  for (int c=0; c!=ncells_surf; ++c) {
+    std::stringstream name;
+    name << "surface_column_" << surf_mesh->cell_map(false).GID(c);
+    if (S->HasMesh(name.str())) {
+      column_surf_faces_[c] = SurfaceCellToSubsurfaceFace(*S->GetMesh(name.str()));
+    }
+  }
+
 };
 
 
@@ -334,11 +346,13 @@ WeakMPCSemiCoupledDeform::CoupledSurfSubsurfColumns(double t_old, double t_new,
     
     CopySurfaceToSubsurface(*S_inter_->GetFieldData(Keys::getKey(name.str(),"pressure")),
 			     S_inter_->GetFieldData(Keys::getKey(name_ss.str(),"pressure"), 
-			     S_inter_->GetField(Keys::getKey(name_ss.str(),"pressure"))->owner()).ptr());
+			     S_inter_->GetField(Keys::getKey(name_ss.str(),"pressure"))->owner()).ptr(),
+			    column_surf_faces_[c]);
     
     CopySurfaceToSubsurface(*S_inter_->GetFieldData(Keys::getKey(name.str(),"temperature")),
 			     S_inter_->GetFieldData(Keys::getKey(name_ss.str(),"temperature"), 
-			     S_inter_->GetField(Keys::getKey(name_ss.str(),"temperature"))->owner()).ptr());
+			     S_inter_->GetField(Keys::getKey(name_ss.str(),"temperature"))->owner()).ptr(),
+			    column_surf_faces_[c]);
   } 
 
   // successful surface_star system updates columns -- changes previous solution.
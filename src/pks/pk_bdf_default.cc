@@ -11,6 +11,7 @@ BDF.
 ------------------------------------------------------------------------- */
 
 #include "Teuchos_TimeMonitor.hpp"
+#include "errors.hh"
 #include "BDF1_TI.hh"
 #include "pk_bdf_default.hh"
 #include "State.hh"
@@ -36,10 +37,36 @@ void PK_BDF_Default::Setup(const Teuchos::Ptr<State>& S) {
     if (bdf_plist.isSublist("continuation parameters")) {
       S->RequireScalar("continuation_parameter", name_);
     }
+
+    // -- check if the history is checkpointed
+    checkpoint_history_ = bdf_plist.get<bool>("checkpoint integrator history", false);
+  }
+
+  // adaptive linear solver tolerances
+  if (plist_->isSublist("inexact Newton")) {
+    if (!plist_->isSublist("linear solver")) {
+      Errors::Message msg;
+      msg << "PK \"" << name_ << "\": \"inexact Newton\" requires a \"linear solver\" list.";
+      Exceptions::amanzi_throw(msg);
+    }
+    forcing_ = Teuchos::rcp(new InexactNewtonForcing(plist_->sublist("inexact Newton"),
+            plist_->sublist("linear solver"), vo_));
   }
 };
 
 
+// -----------------------------------------------------------------------------
+// Fields checkpointing the time integrator's history.
+// -----------------------------------------------------------------------------
+void PK_BDF_Default::SetupIntegratorHistory(const Teuchos::Ptr<State>& S) {
+  if (!checkpoint_history_) return;
+
+  dt_key_ = name_ + "_dt";
+  S->RequireScalar(dt_key_, name_);
+  SetupSolutionDot(S);
+}
+
+
 // -----------------------------------------------------------------------------
 // Initialization of timestepper.
 // -----------------------------------------------------------------------------
@@ -61,6 +88,35 @@ void PK_BDF_Default::Initialize(const Teuchos::Ptr<State>& S) {
     Teuchos::RCP<TreeVector> solution_dot = Teuchos::rcp(new TreeVector(*solution_));
     solution_dot->PutScalar(0.0);
 
+    // -- restore the history from a checkpoint
+    if (checkpoint_history_) {
+      if (!S->HasField(dt_key_)) {
+        Errors::Message msg;
+        msg << "PK \"" << name_ << "\": \"checkpoint integrator history\" is only supported for the top-level PK, or a sub-PK of a top-level WeakMPC.";
+        Exceptions::amanzi_throw(msg);
+      }
+
+      Teuchos::RCP<Field> dt_field = S->GetField(dt_key_, name_);
+      bool restored_dt = dt_field->initialized();
+      if (restored_dt) {
+        dt_ = *S->GetScalarData(dt_key_, name_);
+      } else {
+        *S->GetScalarData(dt_key_, name_) = dt_;
+        dt_field->set_initialized();
+      }
+
+      // solution_dot now points to State, which holds zero unless restarted
+      bool restored_dot = State_to_SolutionDot(S, *solution_dot);
+      if (restored_dt != restored_dot && vo_->os_OK(Teuchos::VERB_LOW)) {
+        Teuchos::OSTab tab = vo_->getOSTab();
+        *vo_->os() << "WARNING: restarting with only part of the time integrator history;"
+                   << " the " << (restored_dt ? "predictor is constant" : "timestep size is the initial one")
+                   << " on the first step." << std::endl;
+      }
+      solution_old_ = Teuchos::rcp(new TreeVector(*solution_));
+      solution_dot_ = Teuchos::rcp(new TreeVector(*solution_));
+    }
+
     // -- set initial state
     time_stepper_->SetInitialState(S->time(), solution_, solution_dot);
   }
@@ -80,8 +136,23 @@ double PK_BDF_Default::get_dt() { return dt_; }
 void PK_BDF_Default::CommitStep(double t_old, double t_new, const Teuchos::RCP<State>& S) {
 
   double dt = t_new -t_old;
-  if (dt > 0. && time_stepper_ != Teuchos::null)
+  if (dt > 0. && time_stepper_ != Teuchos::null) {
     time_stepper_->CommitSolution(dt, solution_, true);
+
+    if (checkpoint_history_) {
+      // the divided difference of the last step, which seeds the predictor
+      // on restart
+      State_to_SolutionDot(S.ptr(), *solution_dot_);
+      *solution_dot_ = *solution_;
+      solution_dot_->Update(-1., *solution_old_, 1.);
+      solution_dot_->Scale(1./dt);
+      *solution_old_ = *solution_;
+
+      *S->GetScalarData(dt_key_, name_) = dt_;
+    }
+  }
+
+  if (forcing_ != Teuchos::null) forcing_->Finish(true);
 }
 
 void PK_BDF_Default::set_states(const Teuchos::RCP<const State>& S,
@@ -148,6 +219,7 @@ bool PK_BDF_Default::AdvanceStep(double t_old, double t_new, bool reinit) {
     dt_ = dt_solver;
   }
 
+  if (fail && forcing_ != Teuchos::null) forcing_->Finish(false);
   return fail;
 };
 
@@ -37,9 +37,30 @@ couples the flow and energy PKs, not to the flow or energy PK itself.
   Note that this is only provided in the top-most ``PKBDFBase`` in the tree --
   this is often a StrongMPC_ or a class deriving from StrongMPC_.
 
+  The time integrator list also takes:
+
+  * `"checkpoint integrator history`" ``[bool]`` **false** If true, the
+    recommended timestep size and the time derivative of the solution are
+    kept in State and so written to checkpoint files.  A run restarted from
+    such a checkpoint starts with the timestep size the uninterrupted run
+    would have taken, and with the same linear predictor, rather than from
+    the `"initial time step`" with a constant predictor.  This is only
+    supported when this PK is the top-level PK of the simulation, or a
+    sub-PK of a top-level WeakMPC, each of whose sub-PKs integrates in time
+    on its own.
+
+    A checkpoint written without this option has neither the timestep size
+    nor the time derivative, so restart from it with the option off, and
+    turn the option on from the next restart.  If only one of the two is
+    read, a warning is written and the other takes its default.
+
 * `"preconditioner`" ``[preconditioner-spec]`` is a Preconditioner_.
 
   This spec describes how to form the (approximate) inverse of the preconditioner.
+
+* `"inexact Newton`" ``[list]`` **optional** Sets the tolerance of the
+  PK's `"linear solver`" on each nonlinear iteration from the reduction of
+  the residual, see InexactNewtonForcing_.
   
 NOTE: ``PKBDFBase  (v)-->`` PKDefaultBase_
 
@@ -51,10 +72,13 @@ NOTE: ``PKBDFBase  (v)-->`` PKDefaultBase_
 
 #include "Teuchos_TimeMonitor.hpp"
 
+#include "Key.hh"
 #include "BDFFnBase.hh"
 #include "BDF1_TI.hh"
 #include "PK_BDF.hh"
 
+#include "inexact_newton_forcing.hh"
+
 
 
 namespace Amanzi {
@@ -69,7 +93,8 @@ class PK_BDF_Default : public PK_BDF {
                  const Teuchos::RCP<State>& S,
                  const Teuchos::RCP<TreeVector>& solution) :
     PK_BDF(pk_tree, glist, S, solution),
-    PK(pk_tree, glist, S, solution) {}
+    PK(pk_tree, glist, S, solution),
+    checkpoint_history_(false) {}
   
   // Virtual destructor
   virtual ~PK_BDF_Default() {}
@@ -104,6 +129,21 @@ class PK_BDF_Default : public PK_BDF {
   // update the continuation parameter
   virtual void UpdateContinuationParameter(double lambda);
 
+  // -- Require the fields that checkpoint the time integrator's history.
+  //    These take the structure of the solution, so this is called once all
+  //    PKs are set up, and before the State is.
+  void SetupIntegratorHistory(const Teuchos::Ptr<State>& S);
+
+  // -- Require a field, owned by this PK, for the time derivative of each
+  //    part of the solution.
+  virtual void SetupSolutionDot(const Teuchos::Ptr<State>& S) {}
+
+  // -- Point soln_dot at those fields.  Returns true if they were all
+  //    already initialized, i.e. read from a checkpoint; otherwise they are
+  //    zeroed and marked initialized.
+  virtual bool State_to_SolutionDot(const Teuchos::Ptr<State>& S,
+          TreeVector& soln_dot) { return false; }
+
   // -- Check the admissibility of a solution.
   virtual bool IsAdmissible(Teuchos::RCP<const TreeVector> up) { return true; }
 
@@ -136,6 +176,15 @@ class PK_BDF_Default : public PK_BDF {
   double dt_;
   Teuchos::RCP<BDF1_TI<TreeVector, TreeVectorSpace> > time_stepper_;
 
+  // checkpointed history of the time integrator
+  bool checkpoint_history_;
+  Key dt_key_;
+  Teuchos::RCP<TreeVector> solution_old_;
+  Teuchos::RCP<TreeVector> solution_dot_;
+
+  // adaptive linear solver tolerances
+  Teuchos::RCP<InexactNewtonForcing> forcing_;
+
   // timing
   Teuchos::RCP<Teuchos::Time> step_walltime_;
 
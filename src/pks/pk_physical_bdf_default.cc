@@ -12,6 +12,8 @@ PKPhysicalBase and BDF methods of PK_BDF_Default.
 
 #include "boost/math/special_functions/fpclassify.hpp"
 
+#include "LinearOperator.hh"
+#include "LinearOperatorFactory.hh"
 #include "pk_physical_bdf_default.hh"
 
 namespace Amanzi {
@@ -66,6 +68,31 @@ void PK_PhysicalBDF_Default::Initialize(const Teuchos::Ptr<State>& S) {
 }
 
 
+// -----------------------------------------------------------------------------
+// Time derivative of the primary variable, checkpointed for restart.  It takes
+// the structure of the primary variable, which is complete only once this PK
+// is set up.
+// -----------------------------------------------------------------------------
+void PK_PhysicalBDF_Default::SetupSolutionDot(const Teuchos::Ptr<State>& S) {
+  Key dot_key = key_ + "_time_derivative";
+  S->RequireField(dot_key, name_)->Update(*S->RequireField(key_));
+  S->GetField(dot_key, name_)->set_io_vis(false);
+}
+
+
+bool PK_PhysicalBDF_Default::State_to_SolutionDot(const Teuchos::Ptr<State>& S,
+        TreeVector& soln_dot) {
+  Teuchos::RCP<Field> field = S->GetField(key_ + "_time_derivative", name_);
+  bool initialized = field->initialized();
+  if (!initialized) {
+    field->GetFieldData()->PutScalar(0.);
+    field->set_initialized();
+  }
+  soln_dot.SetData(field->GetFieldData());
+  return initialized;
+}
+
+
 // -----------------------------------------------------------------------------
 // Default enorm that uses an abs and rel tolerance to monitor convergence.
 // -----------------------------------------------------------------------------
@@ -188,6 +215,84 @@ PK_PhysicalBDF_Default::ApplyBoundaryConditions_(const Teuchos::Ptr<CompositeVec
 };
 
 
+// -----------------------------------------------------------------------------
+// Apply the linear solver, with its tolerance set from the reduction of the
+// residual when using inexact Newton.  With the "single precision ilu"
+// preconditioner, lin_solver is preconditioner_ and the solve goes through the
+// single precision solver.
+// -----------------------------------------------------------------------------
+int
+PK_PhysicalBDF_Default::ApplyLinearSolver_(const Teuchos::RCP<Operators::Operator>& lin_solver,
+        const CompositeVector& res, CompositeVector& Pres) {
+  if (sp_lin_solver_ != Teuchos::null && lin_solver == preconditioner_) {
+    if (forcing_ != Teuchos::null) {
+      double res_norm;
+      res.Norm2(&res_norm);
+      sp_lin_solver_->set_tolerance(forcing_->Tolerance(S_inter_->time(), S_next_->time(), res_norm));
+    }
+    int ierr = sp_lin_solver_->ApplyInverse(res, Pres);
+    if (forcing_ != Teuchos::null) forcing_->Record(sp_lin_solver_->num_itrs());
+    return ierr;
+  }
+
+  typedef AmanziSolvers::LinearOperator<Operators::Operator,CompositeVector,CompositeVectorSpace> LinearOperator_t;
+  Teuchos::RCP<LinearOperator_t> solver = forcing_ == Teuchos::null ? Teuchos::null
+      : Teuchos::rcp_dynamic_cast<LinearOperator_t>(lin_solver);
+  if (solver == Teuchos::null) return lin_solver->ApplyInverse(res, Pres);
+
+  double res_norm;
+  res.Norm2(&res_norm);
+  solver->set_tolerance(forcing_->Tolerance(S_inter_->time(), S_next_->time(), res_norm));
+  int ierr = solver->ApplyInverse(res, Pres);
+  forcing_->Record(solver->num_itrs());
+  return ierr;
+}
+
+
+// -----------------------------------------------------------------------------
+// Create the linear solver of preconditioner_.  The "single precision ilu"
+// preconditioner is not known to Amanzi's preconditioner factory, so its
+// solver is created here over a SinglePrecisionOperator.
+// -----------------------------------------------------------------------------
+Teuchos::RCP<Operators::Operator>
+PK_PhysicalBDF_Default::CreateLinearSolver_() {
+  std::string pc_type = plist_->sublist("preconditioner")
+      .get<std::string>("preconditioner type", "");
+  if (pc_type == "single precision ilu") {
+    if (!plist_->isSublist("linear solver")) {
+      Errors::Message msg;
+      msg << name_ << ": the \"single precision ilu\" preconditioner requires a \"linear solver\" list.";
+      Exceptions::amanzi_throw(msg);
+    }
+    Teuchos::ParameterList linsolve_sublist = plist_->sublist("linear solver");
+    sp_preconditioner_ = Teuchos::rcp(new Operators::SinglePrecisionOperator(preconditioner_));
+    AmanziSolvers::LinearOperatorFactory<Operators::SinglePrecisionOperator,
+                                         CompositeVector,CompositeVectorSpace> fac;
+    sp_lin_solver_ = fac.Create(linsolve_sublist, sp_preconditioner_);
+    return preconditioner_;
+  }
+
+  if (plist_->isSublist("linear solver")) {
+    Teuchos::ParameterList linsolve_sublist = plist_->sublist("linear solver");
+    AmanziSolvers::LinearOperatorFactory<Operators::Operator,CompositeVector,CompositeVectorSpace> fac;
+    return fac.Create(linsolve_sublist, preconditioner_);
+  }
+  return preconditioner_;
+}
+
+
+// -----------------------------------------------------------------------------
+// Update the inverse of the assembled preconditioner_.
+// -----------------------------------------------------------------------------
+void PK_PhysicalBDF_Default::UpdatePreconditionerInverse_() {
+  if (sp_preconditioner_ != Teuchos::null) {
+    sp_preconditioner_->Update();
+  } else {
+    preconditioner_->InitPreconditioner(plist_->sublist("preconditioner"));
+  }
+}
+
+
 double PK_PhysicalBDF_Default::BoundaryValue(const Teuchos::RCP<const Amanzi::CompositeVector>& solution, int face_id){
   double value=0.;
 
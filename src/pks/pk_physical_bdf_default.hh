@@ -32,6 +32,14 @@ By default, the error norm used by solvers is given by:
 The defaults here are typically good, or else good defaults are set in the
 code, so these need not be supplied.
 
+PKs that build their linear solver through this base class (Richards and
+energy) also accept the `"preconditioner type`" `"single precision ilu`" in
+their `"preconditioner`" list.  This is an ILU(0) of the assembled
+preconditioner, stored and applied in single precision, and requires a
+`"linear solver`" list: the Krylov method still applies the double precision
+operator, so it converges to the same tolerance.  Only cell-centered
+discretizations are supported.
+
 
 NOTE: ``PKPhysicalBDFBase -->`` PKBDFBase_
       ``PKPhysicalBDFBase -->`` PKPhysicalBase_
@@ -48,6 +56,8 @@ NOTE: ``PKPhysicalBDFBase -->`` PKBDFBase_
 #include "pk_physical_default.hh"
 
 #include "Operator.hh"
+#include "LinearOperator.hh"
+#include "SinglePrecisionOperator.hh"
 
 namespace Amanzi {
 
@@ -78,6 +88,11 @@ class PK_PhysicalBDF_Default : public PK_BDF_Default,
   // methods, so we need a unique overrider.
   virtual void Initialize(const Teuchos::Ptr<State>& S);
 
+  // Checkpointed time derivative of the primary variable.
+  virtual void SetupSolutionDot(const Teuchos::Ptr<State>& S);
+  virtual bool State_to_SolutionDot(const Teuchos::Ptr<State>& S,
+          TreeVector& soln_dot);
+
   // Default preconditioner is Picard
   virtual int ApplyPreconditioner(Teuchos::RCP<const TreeVector> u, Teuchos::RCP<TreeVector> Pu) {
     *Pu = *u;
@@ -107,6 +122,18 @@ class PK_PhysicalBDF_Default : public PK_BDF_Default,
   virtual double BoundaryValue(const Teuchos::RCP<const Amanzi::CompositeVector>& solution, int face_id);
   virtual int BoundaryDirection(int face_id);
   virtual void ApplyBoundaryConditions_(const Teuchos::Ptr<CompositeVector>& u);
+
+  // Apply the linear solver, with its tolerance set by the inexact Newton
+  // forcing term, if any.
+  int ApplyLinearSolver_(const Teuchos::RCP<Operators::Operator>& lin_solver,
+                         const CompositeVector& res, CompositeVector& Pres);
+
+  // Create the linear solver of preconditioner_ from the "linear solver"
+  // list, or return preconditioner_ if there is none.
+  Teuchos::RCP<Operators::Operator> CreateLinearSolver_();
+
+  // Update the inverse of the assembled preconditioner_.
+  void UpdatePreconditionerInverse_();
   
   // PC operator access
   Teuchos::RCP<Operators::Operator> preconditioner() { return preconditioner_; }
@@ -120,6 +147,12 @@ class PK_PhysicalBDF_Default : public PK_BDF_Default,
   // PC
   Teuchos::RCP<Operators::Operator> preconditioner_;
 
+  // "single precision ilu" preconditioner, and the solver that uses it
+  typedef AmanziSolvers::LinearOperator<Operators::SinglePrecisionOperator,
+                                        CompositeVector,CompositeVectorSpace> SinglePrecisionSolver;
+  Teuchos::RCP<Operators::SinglePrecisionOperator> sp_preconditioner_;
+  Teuchos::RCP<SinglePrecisionSolver> sp_lin_solver_;
+
   // BCs
   std::vector<int> bc_markers_;
   std::vector<double> bc_values_;
@@ -45,31 +45,60 @@ SurfaceBalanceImplicit::SurfaceBalanceImplicit(Teuchos::ParameterList& pk_tree,
   } else if (boost::ends_with(domain_, "_surface")) {
     domain_ss_ = plist_->get<std::string>("subsurface domain name", domain_.substr(0,domain_.size()-8));
   } else {
-    plist_->get<std::string>("subsurface domain name");
+    domain_ss_ = plist_->get<std::string>("subsurface domain name");
   }
 
+  // keys
+  air_temp_key_ = Keys::getKey(domain_,"air_temperature");
+  albedo_key_ = Keys::getKey(domain_,"albedo");
+  esource_key_ = Keys::getKey(domain_,"conducted_energy_source");
+  evap_flux_key_ = Keys::getKey(domain_,"evaporative_flux");
+  lw_in_key_ = Keys::getKey(domain_,"incoming_longwave_radiation");
+  sw_in_key_ = Keys::getKey(domain_,"incoming_shortwave_radiation");
+  wsource_key_ = Keys::getKey(domain_,"mass_source");
+  wtemp_key_ = Keys::getKey(domain_,"mass_source_temperature");
+  ponded_depth_key_ = Keys::getKey(domain_,"ponded_depth");
+  poro_key_ = Keys::getKey(domain_,"porosity");
+  precip_rain_key_ = Keys::getKey(domain_,"precipitation_rain");
+  precip_snow_key_ = Keys::getKey(domain_,"precipitation_snow");
+  pres_key_ = Keys::getKey(domain_,"pressure");
+  qE_lh_key_ = Keys::getKey(domain_,"qE_latent_heat");
+  qE_lw_out_key_ = Keys::getKey(domain_,"qE_lw_out");
+  qE_sh_key_ = Keys::getKey(domain_,"qE_sensible_heat");
+  rel_hum_key_ = Keys::getKey(domain_,"relative_humidity");
+  snow_age_key_ = Keys::getKey(domain_,"snow_age");
+  snow_dens_key_ = Keys::getKey(domain_,"snow_density");
+  snow_temp_key_ = Keys::getKey(domain_,"snow_temperature");
+  swe_key_ = Keys::getKey(domain_,"stored_SWE");
+  temp_key_ = Keys::getKey(domain_,"temperature");
+  unfrozen_frac_key_ = Keys::getKey(domain_,"unfrozen_fraction");
+  wind_speed_key_ = Keys::getKey(domain_,"wind_speed");
+  w_v_source_key_ = Keys::getKey(domain_ss_,"mass_source");
+  sat_liq_key_ = Keys::getKey(domain_ss_,"saturation_liquid");
+  desource_dT_key_ = Keys::getDerivKey(esource_key_, temp_key_);
+
   Teuchos::ParameterList& esource_sublist =
-      FElist.sublist(Keys::getKey(domain_,"conducted_energy_source"));
-  esource_sublist.set("evaluator name", Keys::getKey(domain_,"conducted_energy_source"));
+      FElist.sublist(esource_key_);
+  esource_sublist.set("evaluator name", esource_key_);
   esource_sublist.set("field evaluator type", "primary variable");
 
   // -- surface mass source
   Teuchos::ParameterList& wsource_sublist =
-    FElist.sublist(Keys::getKey(domain_,"mass_source"));
-  wsource_sublist.set("evaluator name", Keys::getKey(domain_,"mass_source"));
+    FElist.sublist(wsource_key_);
+  wsource_sublist.set("evaluator name", wsource_key_);
   wsource_sublist.set("field evaluator type", "primary variable");
 
   // -- subsurface mass source for VaporFlux at cell center
   Teuchos::ParameterList& w_v_source_sublist =
 
-    FElist.sublist(Keys::getKey(domain_ss_,"mass_source"));
-  w_v_source_sublist.set("evaluator name", Keys::getKey(domain_ss_,"mass_source"));
+    FElist.sublist(w_v_source_key_);
+  w_v_source_sublist.set("evaluator name", w_v_source_key_);
   w_v_source_sublist.set("field evaluator type", "primary variable");
 
   // -- surface energy temperature
   Teuchos::ParameterList& wtemp_sublist =
-    FElist.sublist(Keys::getKey(domain_,"mass_source_temperature"));
-  wtemp_sublist.set("evaluator name", Keys::getKey(domain_,"mass_source_temperature"));
+    FElist.sublist(wtemp_key_);
+  wtemp_sublist.set("evaluator name", wtemp_key_);
   wtemp_sublist.set("field evaluator type", "primary variable");
 
   // Derivatives for PC
@@ -96,6 +125,14 @@ SurfaceBalanceImplicit::SurfaceBalanceImplicit(Teuchos::ParameterList& pk_tree,
   // modify predictor by calling advance -- this is cheap and sets up BCs
   // correctly for subsurface's call to ModifyPredictorConsistentFaces()
   modify_predictor_advance_ = plist_->get<bool>("modify predictor by advancing", false);
+
+  // error norm on the change in snow depth
+  snow_atol_ = plist_->get<double>("snow depth absolute error tolerance", 1.0);
+  snow_rtol_ = plist_->get<double>("snow depth relative error tolerance", 0.0);
+  if (snow_atol_ <= 0. || snow_rtol_ < 0.) {
+    Errors::Message message("Invalid parameters: snow depth absolute error tolerance must be positive, relative error tolerance non-negative.");
+    Exceptions::amanzi_throw(message);
+  }
 }
 
 // main methods
@@ -112,10 +149,10 @@ SurfaceBalanceImplicit::Setup(const Teuchos::Ptr<State>& S) {
 
   // requirements: other primary variables
   Teuchos::RCP<FieldEvaluator> fm;
-  S->RequireField(Keys::getKey(domain_,"conducted_energy_source"), name_)->SetMesh(mesh_)
+  S->RequireField(esource_key_, name_)->SetMesh(mesh_)
       ->SetComponent("cell", AmanziMesh::CELL, 1);
-  S->RequireFieldEvaluator(Keys::getKey(domain_,"conducted_energy_source"));
-  fm = S->GetFieldEvaluator(Keys::getKey(domain_,"conducted_energy_source"));
+  S->RequireFieldEvaluator(esource_key_);
+  fm = S->GetFieldEvaluator(esource_key_);
 
   pvfe_esource_ = Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>(fm);
   if (pvfe_esource_ == Teuchos::null) {
@@ -124,10 +161,10 @@ SurfaceBalanceImplicit::Setup(const Teuchos::Ptr<State>& S) {
   }
 
 
-  S->RequireField(Keys::getKey(domain_,"mass_source"), name_)->SetMesh(mesh_)
+  S->RequireField(wsource_key_, name_)->SetMesh(mesh_)
       ->SetComponent("cell", AmanziMesh::CELL, 1);
-  S->RequireFieldEvaluator(Keys::getKey(domain_,"mass_source"));
-  fm = S->GetFieldEvaluator(Keys::getKey(domain_,"mass_source"));
+  S->RequireFieldEvaluator(wsource_key_);
+  fm = S->GetFieldEvaluator(wsource_key_);
 
   pvfe_wsource_ = Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>(fm);
   if (pvfe_wsource_ == Teuchos::null) {
@@ -136,10 +173,10 @@ SurfaceBalanceImplicit::Setup(const Teuchos::Ptr<State>& S) {
   }
 
 
-  S->RequireField(Keys::getKey(domain_ss_,"mass_source"), name_)->SetMesh(subsurf_mesh_)
+  S->RequireField(w_v_source_key_, name_)->SetMesh(subsurf_mesh_)
     ->SetComponent("cell", AmanziMesh::CELL, 1);
-  S->RequireFieldEvaluator(Keys::getKey(domain_ss_,"mass_source"));
-  fm = S->GetFieldEvaluator(Keys::getKey(domain_ss_,"mass_source"));
+  S->RequireFieldEvaluator(w_v_source_key_);
+  fm = S->GetFieldEvaluator(w_v_source_key_);
 
   pvfe_w_v_source_ = Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>(fm);
   if (pvfe_w_v_source_ == Teuchos::null) {
@@ -148,10 +185,10 @@ SurfaceBalanceImplicit::Setup(const Teuchos::Ptr<State>& S) {
   }
 
 
-  S->RequireField(Keys::getKey(domain_,"mass_source_temperature"), name_)->SetMesh(mesh_)
+  S->RequireField(wtemp_key_, name_)->SetMesh(mesh_)
       ->SetComponent("cell", AmanziMesh::CELL, 1);
-  S->RequireFieldEvaluator(Keys::getKey(domain_,"mass_source_temperature"));
-  fm = S->GetFieldEvaluator(Keys::getKey(domain_,"mass_source_temperature"));
+  S->RequireFieldEvaluator(wtemp_key_);
+  fm = S->GetFieldEvaluator(wtemp_key_);
 
   pvfe_wtemp_ = Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>(fm);
   if (pvfe_wtemp_ == Teuchos::null) {
@@ -162,94 +199,93 @@ SurfaceBalanceImplicit::Setup(const Teuchos::Ptr<State>& S) {
   // requirements: source derivatives
   if (eval_derivatives_) {
 
-    Key key_cond_temp = Keys::getDerivKey(Keys::getKey(domain_,"conducted_energy_source"), Keys::getKey(domain_,"temperature"));
-    S->RequireField(key_cond_temp, name_)->SetMesh(mesh_)
+    S->RequireField(desource_dT_key_, name_)->SetMesh(mesh_)
        ->SetComponent("cell", AmanziMesh::CELL, 1);
   }
 
   // requirements: diagnostic variables
-  S->RequireField(Keys::getKey(domain_,"albedo"),name_)->SetMesh(mesh_)
+  S->RequireField(albedo_key_,name_)->SetMesh(mesh_)
     ->SetComponent("cell", AmanziMesh::CELL, 1);
-  S->GetField(Keys::getKey(domain_,"albedo"),name_)->set_io_checkpoint(false);
-  S->RequireField(Keys::getKey(domain_,"evaporative_flux"),name_)->SetMesh(mesh_)
+  S->GetField(albedo_key_,name_)->set_io_checkpoint(false);
+  S->RequireField(evap_flux_key_,name_)->SetMesh(mesh_)
     ->SetComponent("cell", AmanziMesh::CELL, 1);
-  S->GetField(Keys::getKey(domain_,"evaporative_flux"),name_)->set_io_checkpoint(false);
-  S->RequireField(Keys::getKey(domain_,"qE_latent_heat"),name_)->SetMesh(mesh_)
+  S->GetField(evap_flux_key_,name_)->set_io_checkpoint(false);
+  S->RequireField(qE_lh_key_,name_)->SetMesh(mesh_)
     ->SetComponent("cell", AmanziMesh::CELL, 1);
-  S->GetField(Keys::getKey(domain_,"qE_latent_heat"),name_)->set_io_checkpoint(false);
-  S->RequireField(Keys::getKey(domain_,"qE_sensible_heat"),name_)->SetMesh(mesh_)
+  S->GetField(qE_lh_key_,name_)->set_io_checkpoint(false);
+  S->RequireField(qE_sh_key_,name_)->SetMesh(mesh_)
     ->SetComponent("cell", AmanziMesh::CELL, 1);
-  S->GetField(Keys::getKey(domain_,"qE_sensible_heat"),name_)->set_io_checkpoint(false);
-  S->RequireField(Keys::getKey(domain_,"qE_lw_out"),name_)->SetMesh(mesh_)
+  S->GetField(qE_sh_key_,name_)->set_io_checkpoint(false);
+  S->RequireField(qE_lw_out_key_,name_)->SetMesh(mesh_)
     ->SetComponent("cell", AmanziMesh::CELL, 1);
-  S->GetField(Keys::getKey(domain_,"qE_lw_out"),name_)->set_io_checkpoint(false);
+  S->GetField(qE_lw_out_key_,name_)->set_io_checkpoint(false);
   
   // requirements: independent variables (data from MET)
-  S->RequireFieldEvaluator(Keys::getKey(domain_,"incoming_shortwave_radiation"));
-  S->RequireField(Keys::getKey(domain_,"incoming_shortwave_radiation"))->SetMesh(mesh_)
+  S->RequireFieldEvaluator(sw_in_key_);
+  S->RequireField(sw_in_key_)->SetMesh(mesh_)
       ->AddComponent("cell", AmanziMesh::CELL, 1);
 
   if (longwave_input_) {
-    S->RequireFieldEvaluator(Keys::getKey(domain_,"incoming_longwave_radiation"));
-    S->RequireField(Keys::getKey(domain_,"incoming_longwave_radiation"))->SetMesh(mesh_)
+    S->RequireFieldEvaluator(lw_in_key_);
+    S->RequireField(lw_in_key_)->SetMesh(mesh_)
         ->AddComponent("cell", AmanziMesh::CELL, 1);
   }
 
-  S->RequireFieldEvaluator(Keys::getKey(domain_,"air_temperature"));
-  S->RequireField(Keys::getKey(domain_,"air_temperature"))->SetMesh(mesh_)
+  S->RequireFieldEvaluator(air_temp_key_);
+  S->RequireField(air_temp_key_)->SetMesh(mesh_)
       ->AddComponent("cell", AmanziMesh::CELL, 1);
 
-  S->RequireFieldEvaluator(Keys::getKey(domain_,"relative_humidity"));
-  S->RequireField(Keys::getKey(domain_,"relative_humidity"))->SetMesh(mesh_)
+  S->RequireFieldEvaluator(rel_hum_key_);
+  S->RequireField(rel_hum_key_)->SetMesh(mesh_)
       ->AddComponent("cell", AmanziMesh::CELL, 1);
 
-  S->RequireFieldEvaluator(Keys::getKey(domain_,"wind_speed"));
-  S->RequireField(Keys::getKey(domain_,"wind_speed"))->SetMesh(mesh_)
+  S->RequireFieldEvaluator(wind_speed_key_);
+  S->RequireField(wind_speed_key_)->SetMesh(mesh_)
       ->AddComponent("cell", AmanziMesh::CELL, 1);
 
-  S->RequireFieldEvaluator(Keys::getKey(domain_,"precipitation_rain"));
-  S->RequireField(Keys::getKey(domain_,"precipitation_rain"))->SetMesh(mesh_)
+  S->RequireFieldEvaluator(precip_rain_key_);
+  S->RequireField(precip_rain_key_)->SetMesh(mesh_)
       ->AddComponent("cell", AmanziMesh::CELL, 1);
 
-  S->RequireFieldEvaluator(Keys::getKey(domain_,"precipitation_snow"));
-  S->RequireField(Keys::getKey(domain_,"precipitation_snow"))->SetMesh(mesh_)
+  S->RequireFieldEvaluator(precip_snow_key_);
+  S->RequireField(precip_snow_key_)->SetMesh(mesh_)
       ->AddComponent("cell", AmanziMesh::CELL, 1);
 
   // requirements: stored secondary variables
-  S->RequireField(Keys::getKey(domain_,"snow_density"), name_)->SetMesh(mesh_)
+  S->RequireField(snow_dens_key_, name_)->SetMesh(mesh_)
       ->AddComponent("cell", AmanziMesh::CELL, 1);
 
-  S->RequireField(Keys::getKey(domain_,"snow_age"), name_)->SetMesh(mesh_)
+  S->RequireField(snow_age_key_, name_)->SetMesh(mesh_)
       ->AddComponent("cell", AmanziMesh::CELL, 1);
 
-  S->RequireField(Keys::getKey(domain_,"snow_temperature"), name_)->SetMesh(mesh_)
+  S->RequireField(snow_temp_key_, name_)->SetMesh(mesh_)
       ->AddComponent("cell", AmanziMesh::CELL, 1);
 
-  S->RequireField(Keys::getKey(domain_,"stored_SWE"), name_)->SetMesh(mesh_)
+  S->RequireField(swe_key_, name_)->SetMesh(mesh_)
       ->AddComponent("cell", AmanziMesh::CELL, 1);
 
-  S->RequireFieldEvaluator(Keys::getKey(domain_,"temperature"));
-  S->RequireField(Keys::getKey(domain_,"temperature"))->SetMesh(mesh_)
+  S->RequireFieldEvaluator(temp_key_);
+  S->RequireField(temp_key_)->SetMesh(mesh_)
       ->AddComponent("cell", AmanziMesh::CELL, 1);
 
-  S->RequireFieldEvaluator(Keys::getKey(domain_,"pressure"));
-  S->RequireField(Keys::getKey(domain_,"pressure"))->SetMesh(mesh_)
+  S->RequireFieldEvaluator(pres_key_);
+  S->RequireField(pres_key_)->SetMesh(mesh_)
       ->AddComponent("cell", AmanziMesh::CELL, 1);
 
-  S->RequireFieldEvaluator(Keys::getKey(domain_,"ponded_depth"));
-  S->RequireField(Keys::getKey(domain_,"ponded_depth"))->SetMesh(mesh_)
+  S->RequireFieldEvaluator(ponded_depth_key_);
+  S->RequireField(ponded_depth_key_)->SetMesh(mesh_)
       ->AddComponent("cell", AmanziMesh::CELL, 1);
 
  //   S->RequireFieldEvaluator("saturation_liquid");
-  S->RequireField(Keys::getKey(domain_ss_,"saturation_liquid"))->SetMesh(subsurf_mesh_)
+  S->RequireField(sat_liq_key_)->SetMesh(subsurf_mesh_)
        ->AddComponent("cell", AmanziMesh::CELL, 1);
 
-  S->RequireFieldEvaluator(Keys::getKey(domain_,"unfrozen_fraction"));
-  S->RequireField(Keys::getKey(domain_,"unfrozen_fraction"))->SetMesh(mesh_)
+  S->RequireFieldEvaluator(unfrozen_frac_key_);
+  S->RequireField(unfrozen_frac_key_)->SetMesh(mesh_)
       ->AddComponent("cell", AmanziMesh::CELL, 1);
 
-  S->RequireFieldEvaluator(Keys::getKey(domain_,"porosity"));
-  S->RequireField(Keys::getKey(domain_,"porosity"))->SetMesh(mesh_)
+  S->RequireFieldEvaluator(poro_key_);
+  S->RequireField(poro_key_)->SetMesh(mesh_)
       ->AddComponent("cell", AmanziMesh::CELL, 1);
 
 }
@@ -265,62 +301,61 @@ SurfaceBalanceImplicit::Initialize(const Teuchos::Ptr<State>& S) {
   ASSERT(plist_->isSublist("initial condition"));
   Teuchos::ParameterList& ic_list = plist_->sublist("initial condition");
 
-  if (!S->GetField(Keys::getKey(domain_,"snow_density"))->initialized()) {
+  if (!S->GetField(snow_dens_key_)->initialized()) {
     if (ic_list.isParameter("restart file")) {
       // initialize density, age from restart file
-      S->GetField(Keys::getKey(domain_,"snow_density"), name_)->Initialize(ic_list);
-      S->GetField(Keys::getKey(domain_,"snow_density"), name_)->set_initialized();
-      S->GetField(Keys::getKey(domain_,"snow_age"), name_)->Initialize(ic_list);
-      S->GetField(Keys::getKey(domain_,"snow_age"), name_)->set_initialized();
+      S->GetField(snow_dens_key_, name_)->Initialize(ic_list);
+      S->GetField(snow_dens_key_, name_)->set_initialized();
+      S->GetField(snow_age_key_, name_)->Initialize(ic_list);
+      S->GetField(snow_age_key_, name_)->set_initialized();
     } else {
       // initialize density to fresh powder, age to 0
-      S->GetFieldData(Keys::getKey(domain_,"snow_density"),name_)->PutScalar(seb.params.density_freshsnow);
-      S->GetField(Keys::getKey(domain_,"snow_density"), name_)->set_initialized();
-      S->GetFieldData(Keys::getKey(domain_,"snow_age"),name_)->PutScalar(0.);
-      S->GetField(Keys::getKey(domain_,"snow_age"), name_)->set_initialized();
+      S->GetFieldData(snow_dens_key_,name_)->PutScalar(seb.params.density_freshsnow);
+      S->GetField(snow_dens_key_, name_)->set_initialized();
+      S->GetFieldData(snow_age_key_,name_)->PutScalar(0.);
+      S->GetField(snow_age_key_, name_)->set_initialized();
 
     }
   }
 
   // initialize swe consistently with snow height and density
 
-  Epetra_MultiVector& swe = *S->GetFieldData(Keys::getKey(domain_,"stored_SWE"),name_)->ViewComponent("cell",false);
+  Epetra_MultiVector& swe = *S->GetFieldData(swe_key_,name_)->ViewComponent("cell",false);
   const Epetra_MultiVector& snow_ht = *S->GetFieldData(key_)->ViewComponent("cell",false);
-  const Epetra_MultiVector& snow_dens = *S->GetFieldData(Keys::getKey(domain_,"snow_density"))->ViewComponent("cell",false);
+  const Epetra_MultiVector& snow_dens = *S->GetFieldData(snow_dens_key_)->ViewComponent("cell",false);
   for (int c=0; c!=swe.MyLength(); ++c) {
     swe[0][c] = snow_ht[0][c] * snow_dens[0][c] / seb.in.vp_ground.density_w;
   }
-  S->GetField(Keys::getKey(domain_,"stored_SWE"), name_)->set_initialized();
+  S->GetField(swe_key_, name_)->set_initialized();
 
   // initialize snow temp
-  S->GetFieldData(Keys::getKey(domain_,"snow_temperature"),name_)->PutScalar(0.);
-  S->GetField(Keys::getKey(domain_,"snow_temperature"), name_)->set_initialized();
+  S->GetFieldData(snow_temp_key_,name_)->PutScalar(0.);
+  S->GetField(snow_temp_key_, name_)->set_initialized();
 
   // initialize sources, temps
-  S->GetFieldData(Keys::getKey(domain_,"conducted_energy_source"),name_)->PutScalar(0.);
-  S->GetField(Keys::getKey(domain_,"conducted_energy_source"),name_)->set_initialized();
+  S->GetFieldData(esource_key_,name_)->PutScalar(0.);
+  S->GetField(esource_key_,name_)->set_initialized();
 
   if (eval_derivatives_) {
-    Key key_cond_temp = Keys::getDerivKey(Keys::getKey(domain_,"conducted_energy_source"), Keys::getKey(domain_,"temperature"));
-    S->GetFieldData(key_cond_temp,name_)->PutScalar(0.);
-    S->GetField(key_cond_temp,name_)->set_initialized();
+    S->GetFieldData(desource_dT_key_,name_)->PutScalar(0.);
+    S->GetField(desource_dT_key_,name_)->set_initialized();
   }
 
-  S->GetFieldData(Keys::getKey(domain_,"mass_source"),name_)->PutScalar(0.);
-  S->GetField(Keys::getKey(domain_,"mass_source"),name_)->set_initialized();
+  S->GetFieldData(wsource_key_,name_)->PutScalar(0.);
+  S->GetField(wsource_key_,name_)->set_initialized();
 
-  S->GetFieldData(Keys::getKey(domain_ss_,"mass_source"),name_)->PutScalar(0.);
-  S->GetField(Keys::getKey(domain_ss_,"mass_source"),name_)->set_initialized();
+  S->GetFieldData(w_v_source_key_,name_)->PutScalar(0.);
+  S->GetField(w_v_source_key_,name_)->set_initialized();
 
-  S->GetFieldData(Keys::getKey(domain_,"mass_source_temperature"),name_)->PutScalar(273.15);
-  S->GetField(Keys::getKey(domain_,"mass_source_temperature"),name_)->set_initialized();
+  S->GetFieldData(wtemp_key_,name_)->PutScalar(273.15);
+  S->GetField(wtemp_key_,name_)->set_initialized();
 
   // initialize diagnostics
-  S->GetField(Keys::getKey(domain_,"albedo"),name_)->set_initialized();
-  S->GetField(Keys::getKey(domain_,"evaporative_flux"),name_)->set_initialized();
-  S->GetField(Keys::getKey(domain_,"qE_latent_heat"),name_)->set_initialized();
-  S->GetField(Keys::getKey(domain_,"qE_sensible_heat"),name_)->set_initialized();
-  S->GetField(Keys::getKey(domain_,"qE_lw_out"),name_)->set_initialized();
+  S->GetField(albedo_key_,name_)->set_initialized();
+  S->GetField(evap_flux_key_,name_)->set_initialized();
+  S->GetField(qE_lh_key_,name_)->set_initialized();
+  S->GetField(qE_sh_key_,name_)->set_initialized();
+  S->GetField(qE_lw_out_key_,name_)->set_initialized();
 
 }
 
@@ -355,120 +390,119 @@ SurfaceBalanceImplicit::Functional(double t_old, double t_new, Teuchos::RCP<Tree
   // pull old snow data
   const Epetra_MultiVector& snow_depth_old = *u_old->Data()->ViewComponent("cell",false);
 
-  const Epetra_MultiVector& snow_age_old = *S_inter_->GetFieldData(Keys::getKey(domain_,"snow_age"))
+  const Epetra_MultiVector& snow_age_old = *S_inter_->GetFieldData(snow_age_key_)
       ->ViewComponent("cell",false);
-  const Epetra_MultiVector& snow_dens_old = *S_inter_->GetFieldData(Keys::getKey(domain_,"snow_density"))
+  const Epetra_MultiVector& snow_dens_old = *S_inter_->GetFieldData(snow_dens_key_)
       ->ViewComponent("cell",false);
-  const Epetra_MultiVector& stored_SWE_old = *S_inter_->GetFieldData(Keys::getKey(domain_,"stored_SWE"))
+  const Epetra_MultiVector& stored_SWE_old = *S_inter_->GetFieldData(swe_key_)
       ->ViewComponent("cell",false);
 
   // pull current snow data
   const Epetra_MultiVector& snow_depth_new = *u_new->Data()->ViewComponent("cell",false);
 
-  Epetra_MultiVector& snow_temp_new = *S_next_->GetFieldData(Keys::getKey(domain_,"snow_temperature"), name_)
+  Epetra_MultiVector& snow_temp_new = *S_next_->GetFieldData(snow_temp_key_, name_)
       ->ViewComponent("cell",false);
-  Epetra_MultiVector& snow_age_new = *S_next_->GetFieldData(Keys::getKey(domain_,"snow_age"), name_)
+  Epetra_MultiVector& snow_age_new = *S_next_->GetFieldData(snow_age_key_, name_)
       ->ViewComponent("cell",false);
-  Epetra_MultiVector& snow_dens_new = *S_next_->GetFieldData(Keys::getKey(domain_,"snow_density"), name_)
+  Epetra_MultiVector& snow_dens_new = *S_next_->GetFieldData(snow_dens_key_, name_)
       ->ViewComponent("cell",false);
-  Epetra_MultiVector& stored_SWE_new = *S_next_->GetFieldData(Keys::getKey(domain_,"stored_SWE"), name_)
+  Epetra_MultiVector& stored_SWE_new = *S_next_->GetFieldData(swe_key_, name_)
       ->ViewComponent("cell",false);
 
   // pull diagnostics
-  Epetra_MultiVector& albedo = *S_next_->GetFieldData(Keys::getKey(domain_,"albedo"),name_)
+  Epetra_MultiVector& albedo = *S_next_->GetFieldData(albedo_key_,name_)
       ->ViewComponent("cell",false);
-  Epetra_MultiVector& evaporative_flux = *S_next_->GetFieldData(Keys::getKey(domain_,"evaporative_flux"),name_)
+  Epetra_MultiVector& evaporative_flux = *S_next_->GetFieldData(evap_flux_key_,name_)
       ->ViewComponent("cell",false);
-  Epetra_MultiVector& qE_latent_heat = *S_next_->GetFieldData(Keys::getKey(domain_,"qE_latent_heat"),name_)
+  Epetra_MultiVector& qE_latent_heat = *S_next_->GetFieldData(qE_lh_key_,name_)
       ->ViewComponent("cell",false);
-  Epetra_MultiVector& qE_sensible_heat = *S_next_->GetFieldData(Keys::getKey(domain_,"qE_sensible_heat"),name_)
+  Epetra_MultiVector& qE_sensible_heat = *S_next_->GetFieldData(qE_sh_key_,name_)
       ->ViewComponent("cell",false);
-  Epetra_MultiVector& qE_lw_out = *S_next_->GetFieldData(Keys::getKey(domain_,"qE_lw_out"),name_)
+  Epetra_MultiVector& qE_lw_out = *S_next_->GetFieldData(qE_lw_out_key_,name_)
       ->ViewComponent("cell",false);
 
   // pull ATS data
-  S_next_->GetFieldEvaluator(Keys::getKey(domain_,"temperature"))->HasFieldChanged(S_next_.ptr(), name_);
+  S_next_->GetFieldEvaluator(temp_key_)->HasFieldChanged(S_next_.ptr(), name_);
   const Epetra_MultiVector& surf_temp =
-    *S_next_->GetFieldData(Keys::getKey(domain_,"temperature"))->ViewComponent("cell", false);
+    *S_next_->GetFieldData(temp_key_)->ViewComponent("cell", false);
 
-  S_next_->GetFieldEvaluator(Keys::getKey(domain_,"pressure"))->HasFieldChanged(S_next_.ptr(), name_);
+  S_next_->GetFieldEvaluator(pres_key_)->HasFieldChanged(S_next_.ptr(), name_);
   const Epetra_MultiVector& surf_pres =
-    *S_next_->GetFieldData(Keys::getKey(domain_,"pressure"))->ViewComponent("cell", false);
+    *S_next_->GetFieldData(pres_key_)->ViewComponent("cell", false);
 
-  S_next_->GetFieldEvaluator(Keys::getKey(domain_,"ponded_depth"))->HasFieldChanged(S_next_.ptr(), name_);
+  S_next_->GetFieldEvaluator(ponded_depth_key_)->HasFieldChanged(S_next_.ptr(), name_);
   const Epetra_MultiVector& ponded_depth =
-    *S_next_->GetFieldData(Keys::getKey(domain_,"ponded_depth"))->ViewComponent("cell", false);
+    *S_next_->GetFieldData(ponded_depth_key_)->ViewComponent("cell", false);
 
  //  S_next_->GetFieldEvaluator("saturation_liquid")->HasFieldChanged(S_next_.ptr(), name_);
    const Epetra_MultiVector& saturation_liquid =
-     *S_next_->GetFieldData(Keys::getKey(domain_ss_,"saturation_liquid"))->ViewComponent("cell", false);
+     *S_next_->GetFieldData(sat_liq_key_)->ViewComponent("cell", false);
 
-   S_next_->GetFieldEvaluator(Keys::getKey(domain_,"unfrozen_fraction"))->HasFieldChanged(S_next_.ptr(), name_);
+   S_next_->GetFieldEvaluator(unfrozen_frac_key_)->HasFieldChanged(S_next_.ptr(), name_);
   const Epetra_MultiVector& unfrozen_fraction =
-    *S_next_->GetFieldData(Keys::getKey(domain_,"unfrozen_fraction"))->ViewComponent("cell", false);
+    *S_next_->GetFieldData(unfrozen_frac_key_)->ViewComponent("cell", false);
 
-  S_next_->GetFieldEvaluator(Keys::getKey(domain_,"porosity"))->HasFieldChanged(S_next_.ptr(), name_);
+  S_next_->GetFieldEvaluator(poro_key_)->HasFieldChanged(S_next_.ptr(), name_);
   const Epetra_MultiVector& surf_porosity =
-    *S_next_->GetFieldData(Keys::getKey(domain_,"porosity"))->ViewComponent("cell", false);
+    *S_next_->GetFieldData(poro_key_)->ViewComponent("cell", false);
 
 
   // pull Met data
-  S_next_->GetFieldEvaluator(Keys::getKey(domain_,"air_temperature"))->HasFieldChanged(S_next_.ptr(), name_);
+  S_next_->GetFieldEvaluator(air_temp_key_)->HasFieldChanged(S_next_.ptr(), name_);
   const Epetra_MultiVector& air_temp =
-    *S_next_->GetFieldData(Keys::getKey(domain_,"air_temperature"))->ViewComponent("cell", false);
+    *S_next_->GetFieldData(air_temp_key_)->ViewComponent("cell", false);
 
-  S_next_->GetFieldEvaluator(Keys::getKey(domain_,"incoming_shortwave_radiation"))->HasFieldChanged(S_next_.ptr(), name_);
+  S_next_->GetFieldEvaluator(sw_in_key_)->HasFieldChanged(S_next_.ptr(), name_);
   const Epetra_MultiVector& incoming_shortwave =
-    *S_next_->GetFieldData(Keys::getKey(domain_,"incoming_shortwave_radiation"))->ViewComponent("cell", false);
+    *S_next_->GetFieldData(sw_in_key_)->ViewComponent("cell", false);
 
  Teuchos::RCP<const Epetra_MultiVector> incoming_longwave = Teuchos::null;
   if (longwave_input_) {
-    S_next_->GetFieldEvaluator(Keys::getKey(domain_,"incoming_longwave_radiation"))->HasFieldChanged(S_next_.ptr(), name_);
+    S_next_->GetFieldEvaluator(lw_in_key_)->HasFieldChanged(S_next_.ptr(), name_);
        incoming_longwave =
-         S_next_->GetFieldData(Keys::getKey(domain_,"incoming_longwave_radiation"))->ViewComponent("cell", false);
+         S_next_->GetFieldData(lw_in_key_)->ViewComponent("cell", false);
   }
 
-  S_next_->GetFieldEvaluator(Keys::getKey(domain_,"relative_humidity"))->HasFieldChanged(S_next_.ptr(), name_);
+  S_next_->GetFieldEvaluator(rel_hum_key_)->HasFieldChanged(S_next_.ptr(), name_);
   const Epetra_MultiVector& relative_humidity =
-    *S_next_->GetFieldData(Keys::getKey(domain_,"relative_humidity"))->ViewComponent("cell", false);
+    *S_next_->GetFieldData(rel_hum_key_)->ViewComponent("cell", false);
 
-  S_next_->GetFieldEvaluator(Keys::getKey(domain_,"wind_speed"))->HasFieldChanged(S_next_.ptr(), name_);
+  S_next_->GetFieldEvaluator(wind_speed_key_)->HasFieldChanged(S_next_.ptr(), name_);
   const Epetra_MultiVector& wind_speed =
-    *S_next_->GetFieldData(Keys::getKey(domain_,"wind_speed"))->ViewComponent("cell", false);
+    *S_next_->GetFieldData(wind_speed_key_)->ViewComponent("cell", false);
 
-  S_next_->GetFieldEvaluator(Keys::getKey(domain_,"precipitation_rain"))->HasFieldChanged(S_next_.ptr(), name_);
+  S_next_->GetFieldEvaluator(precip_rain_key_)->HasFieldChanged(S_next_.ptr(), name_);
   const Epetra_MultiVector& precip_rain =
-    *S_next_->GetFieldData(Keys::getKey(domain_,"precipitation_rain"))->ViewComponent("cell", false);
+    *S_next_->GetFieldData(precip_rain_key_)->ViewComponent("cell", false);
 
   // snow precip need not be updated each iteration
   if (implicit_snow_) {
-    S_next_->GetFieldEvaluator(Keys::getKey(domain_,"precipitation_snow"))->HasFieldChanged(S_next_.ptr(), name_);
+    S_next_->GetFieldEvaluator(precip_snow_key_)->HasFieldChanged(S_next_.ptr(), name_);
   } else {
-    S_inter_->GetFieldEvaluator(Keys::getKey(domain_,"precipitation_snow"))->HasFieldChanged(S_inter_.ptr(), name_);
+    S_inter_->GetFieldEvaluator(precip_snow_key_)->HasFieldChanged(S_inter_.ptr(), name_);
   }
   const Epetra_MultiVector& precip_snow = implicit_snow_ ?
-    *S_next_->GetFieldData(Keys::getKey(domain_,"precipitation_snow"))->ViewComponent("cell", false) :
-    *S_inter_->GetFieldData(Keys::getKey(domain_,"precipitation_snow"))->ViewComponent("cell", false);
+    *S_next_->GetFieldData(precip_snow_key_)->ViewComponent("cell", false) :
+    *S_inter_->GetFieldData(precip_snow_key_)->ViewComponent("cell", false);
 
   // pull additional primary variable data
   Epetra_MultiVector& surf_energy_flux =
-    *S_next_->GetFieldData(Keys::getKey(domain_,"conducted_energy_source"), name_)->ViewComponent("cell", false);
+    *S_next_->GetFieldData(esource_key_, name_)->ViewComponent("cell", false);
   Teuchos::RCP<Epetra_MultiVector> dsurf_energy_flux_dT;
   if (eval_derivatives_) {
-    Key key_cond_temp = Keys::getDerivKey(Keys::getKey(domain_,"conducted_energy_source"), Keys::getKey(domain_,"temperature"));
-    dsurf_energy_flux_dT = S_next_->GetFieldData(key_cond_temp, name_)
+    dsurf_energy_flux_dT = S_next_->GetFieldData(desource_dT_key_, name_)
       ->ViewComponent("cell", false);
   }
 
   Epetra_MultiVector& surf_water_flux =
-    *S_next_->GetFieldData(Keys::getKey(domain_,"mass_source"), name_)->ViewComponent("cell", false);
+    *S_next_->GetFieldData(wsource_key_, name_)->ViewComponent("cell", false);
 
   Epetra_MultiVector& vapor_flux =
-    *S_next_->GetFieldData(Keys::getKey(domain_ss_,"mass_source"), name_)->ViewComponent("cell", false);
+    *S_next_->GetFieldData(w_v_source_key_, name_)->ViewComponent("cell", false);
   vapor_flux.PutScalar(0.);
 
   Epetra_MultiVector& surf_water_flux_temp =
-    *S_next_->GetFieldData(Keys::getKey(domain_,"mass_source_temperature"), name_)->ViewComponent("cell", false);
+    *S_next_->GetFieldData(wtemp_key_, name_)->ViewComponent("cell", false);
 
   unsigned int ncells = mesh_->num_entities(AmanziMesh::CELL, AmanziMesh::OWNED);
   for (unsigned int c=0; c!=ncells; ++c) { // START CELL LOOP  ##########################
@@ -761,25 +795,25 @@ SurfaceBalanceImplicit::Functional(double t_old, double t_new, Teuchos::RCP<Tree
     std::vector< Teuchos::Ptr<const CompositeVector> > vecs;
 
     vnames.push_back("air_temp"); 
-    vecs.push_back(S_next_->GetFieldData(Keys::getKey(domain_,"air_temperature")).ptr());
+    vecs.push_back(S_next_->GetFieldData(air_temp_key_).ptr());
     
     vnames.push_back("rel_hum"); 
-    vecs.push_back(S_next_->GetFieldData(Keys::getKey(domain_,"relative_humidity")).ptr());
+    vecs.push_back(S_next_->GetFieldData(rel_hum_key_).ptr());
     
     vnames.push_back("Qsw_in"); 
-    vecs.push_back(S_next_->GetFieldData(Keys::getKey(domain_,"incoming_shortwave_radiation")).ptr());
+    vecs.push_back(S_next_->GetFieldData(sw_in_key_).ptr());
     
     vnames.push_back("precip_rain"); 
-    vecs.push_back(S_next_->GetFieldData(Keys::getKey(domain_,"precipitation_rain")).ptr());
+    vecs.push_back(S_next_->GetFieldData(precip_rain_key_).ptr());
     
     vnames.push_back("precip_snow"); 
-    vecs.push_back(S_next_->GetFieldData(Keys::getKey(domain_,"precipitation_snow")).ptr());
+    vecs.push_back(S_next_->GetFieldData(precip_snow_key_).ptr());
     
     vnames.push_back("T_ground"); 
-    vecs.push_back(S_next_->GetFieldData(Keys::getKey(domain_,"temperature")).ptr());
+    vecs.push_back(S_next_->GetFieldData(temp_key_).ptr());
     
     vnames.push_back("p_ground"); 
-    vecs.push_back(S_next_->GetFieldData(Keys::getKey(domain_,"pressure")).ptr());
+    vecs.push_back(S_next_->GetFieldData(pres_key_).ptr());
     
 
     db_->WriteVectors(vnames, vecs, true);
@@ -792,7 +826,7 @@ SurfaceBalanceImplicit::Functional(double t_old, double t_new, Teuchos::RCP<Tree
     vecs.push_back(S_next_->GetFieldData(Keys::getKey(domain_,"snow_depth")).ptr());
     
     vnames.push_back("snow_temp"); 
-    vecs.push_back(S_next_->GetFieldData(Keys::getKey(domain_,"snow_temperature")).ptr());
+    vecs.push_back(S_next_->GetFieldData(snow_temp_key_).ptr());
     
     db_->WriteVectors(vnames, vecs, true);
     db_->WriteDivider();
@@ -801,16 +835,16 @@ SurfaceBalanceImplicit::Functional(double t_old, double t_new, Teuchos::RCP<Tree
     vecs.clear();
 
     vnames.push_back("energy_source"); 
-    vecs.push_back(S_next_->GetFieldData(Keys::getKey(domain_,"conducted_energy_source")).ptr());
+    vecs.push_back(S_next_->GetFieldData(esource_key_).ptr());
     
     vnames.push_back("water_source"); 
-    vecs.push_back(S_next_->GetFieldData(Keys::getKey(domain_,"mass_source")).ptr());
+    vecs.push_back(S_next_->GetFieldData(wsource_key_).ptr());
     
     vnames.push_back("evap flux"); 
-    vecs.push_back(S_next_->GetFieldData(Keys::getKey(domain_,"evaporative_flux")).ptr());
+    vecs.push_back(S_next_->GetFieldData(evap_flux_key_).ptr());
     
     vnames.push_back("T_water_source"); 
-    vecs.push_back(S_next_->GetFieldData(Keys::getKey(domain_,"mass_source_temperature")).ptr());
+    vecs.push_back(S_next_->GetFieldData(wtemp_key_).ptr());
     
     db_->WriteVectors(vnames, vecs, true);
     db_->WriteDivider();
@@ -834,29 +868,51 @@ SurfaceBalanceImplicit::Functional(double t_old, double t_new, Teuchos::RCP<Tree
 
 
 // applies preconditioner to u and returns the result in Pu
+//
+// The residual is r_c = h_c - H_c, where the model's snow depth H_c is
+// computed from the old snow pack and the current ground and met data, and
+// does not depend on the new snow depth.  The Jacobian of this PK's block is
+// therefore the identity, cell by cell, and the identity is the exact Newton
+// preconditioner.  Coupling to the ground temperature enters through the
+// conducted energy source derivative, which is assembled by the energy PK.
 int SurfaceBalanceImplicit::ApplyPreconditioner(Teuchos::RCP<const TreeVector> u,
         Teuchos::RCP<TreeVector> Pu) {
   *Pu = *u;
-  
   return 0;
 }
 
 
-// updates the preconditioner
+// updates the preconditioner -- nothing to do, see ApplyPreconditioner()
 void
 SurfaceBalanceImplicit::UpdatePreconditioner(double t,
         Teuchos::RCP<const TreeVector> up, double h) {}
 
 
-// error monitor, inf norm is good, this is relative to 1m snow pack
+// error monitor: inf norm of the correction in snow depth, relative to
+// atol [m] + rtol * snow depth
 double
 SurfaceBalanceImplicit::ErrorNorm(Teuchos::RCP<const TreeVector> u,
         Teuchos::RCP<const TreeVector> du) {
   Teuchos::OSTab tab = vo_->getOSTab();
+
+  const Epetra_MultiVector& u_c = *u->Data()->ViewComponent("cell",false);
+  const Epetra_MultiVector& du_c = *du->Data()->ViewComponent("cell",false);
+
+  double enorm_loc = 0.;
+  int c_loc = -1;
+  unsigned int ncells = du_c.MyLength();
+  for (unsigned int c=0; c!=ncells; ++c) {
+    double enorm_c = std::abs(du_c[0][c]) / (snow_atol_ + snow_rtol_*std::abs(u_c[0][c]));
+    if (enorm_c > enorm_loc) {
+      enorm_loc = enorm_c;
+      c_loc = c;
+    }
+  }
+
   double err;
-  du->NormInf(&err);
+  mesh_->get_comm()->MaxAll(&enorm_loc, &err, 1);
   if (vo_->os_OK(Teuchos::VERB_MEDIUM)) {
-    *vo_->os() << "ENorm (cells) = " << err << std::endl;
+    *vo_->os() << "ENorm (cells) = " << err << " (local max at " << c_loc << ")" << std::endl;
   }
   return err;
 }
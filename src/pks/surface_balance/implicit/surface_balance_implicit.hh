@@ -12,6 +12,11 @@
    entering through the surface skin.  Snow surface energy balance
    is calculated at equilibrium with ground/surface water and Air.
 
+   The error norm is the max over cells of the correction in snow depth,
+   relative to "snow depth absolute error tolerance" [m] (default 1) plus
+   "snow depth relative error tolerance" [-] (default 0) times the snow
+   depth.  The defaults make this the max correction, in m.
+
    ------------------------------------------------------------------------- */
 
 #ifndef PK_SURFACE_BALANCE_IMPLICIT_HH_
@@ -81,11 +86,41 @@ public:
   double wind_speed_ref_ht_;
   double snow_ground_trans_;
   double min_snow_trans_;
+  double snow_atol_, snow_rtol_;
 
   Teuchos::RCP<const AmanziMesh::Mesh> subsurf_mesh_;
 
   Key domain_ss_;
 
+  // keys, built once to avoid string work in Functional()
+  Key air_temp_key_;
+  Key albedo_key_;
+  Key esource_key_;
+  Key evap_flux_key_;
+  Key lw_in_key_;
+  Key sw_in_key_;
+  Key wsource_key_;
+  Key wtemp_key_;
+  Key ponded_depth_key_;
+  Key poro_key_;
+  Key precip_rain_key_;
+  Key precip_snow_key_;
+  Key pres_key_;
+  Key qE_lh_key_;
+  Key qE_lw_out_key_;
+  Key qE_sh_key_;
+  Key rel_hum_key_;
+  Key snow_age_key_;
+  Key snow_dens_key_;
+  Key snow_temp_key_;
+  Key swe_key_;
+  Key temp_key_;
+  Key unfrozen_frac_key_;
+  Key wind_speed_key_;
+  Key w_v_source_key_;
+  Key sat_liq_key_;
+  Key desource_dT_key_;
+
  private:
   // factory registration
   static RegisteredPKFactory<SurfaceBalanceImplicit> reg_;
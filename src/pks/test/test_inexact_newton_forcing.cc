@@ -0,0 +1,88 @@
+#include "UnitTest++.h"
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+
+#include "errors.hh"
+#include "inexact_newton_forcing.hh"
+
+using namespace Amanzi;
+
+struct forcing_fixture {
+  forcing_fixture() {
+    plist.set("initial forcing term", 0.5);
+    plist.set("maximum forcing term", 0.9);
+    plist.set("minimum forcing term", 1.e-3);
+    plist.set("forcing term gamma", 0.9);
+    plist.set("forcing term alpha", 2.0);
+
+    solver_plist.set("iterative method", "gmres");
+    solver_plist.sublist("gmres parameters").set("error tolerance", 1.e-10);
+
+    Teuchos::ParameterList vo_plist;
+    vo = Teuchos::rcp(new VerboseObject("forcing", vo_plist));
+  }
+
+  Teuchos::ParameterList plist;
+  Teuchos::ParameterList solver_plist;
+  Teuchos::RCP<VerboseObject> vo;
+};
+
+
+// The sequence of tolerances of one nonlinear solve.
+TEST_FIXTURE(forcing_fixture, INEXACT_NEWTON_SEQUENCE) {
+  InexactNewtonForcing forcing(plist, solver_plist, vo);
+
+  // initial forcing term on the first iteration
+  CHECK_CLOSE(0.5, forcing.Tolerance(0., 1., 1.), 1.e-14);
+
+  // gamma (r_k / r_k-1)^alpha = 0.9 * 0.1^2 = 0.009, safeguarded by
+  // gamma eta_k-1^alpha = 0.9 * 0.5^2 = 0.225 > 0.1
+  CHECK_CLOSE(0.225, forcing.Tolerance(0., 1., 0.1), 1.e-14);
+
+  // 0.9 * 0.01^2 = 9.e-5, not safeguarded as 0.9 * 0.225^2 < 0.1, and
+  // clamped to the minimum
+  CHECK_CLOSE(1.e-3, forcing.Tolerance(0., 1., 1.e-3), 1.e-14);
+
+  // 0.9 * 0.5^2 = 0.225, neither safeguarded nor clamped
+  CHECK_CLOSE(0.225, forcing.Tolerance(0., 1., 5.e-4), 1.e-14);
+
+  // 0.9 * 2^2 = 3.6, clamped to the maximum
+  CHECK_CLOSE(0.9, forcing.Tolerance(0., 1., 1.e-3), 1.e-14);
+
+  // 0.9 * 0.5^2 = 0.225, safeguarded by 0.9 * 0.9^2 = 0.729
+  CHECK_CLOSE(0.729, forcing.Tolerance(0., 1., 5.e-4), 1.e-14);
+}
+
+
+// Each new nonlinear solve, or a finished one, starts from the initial term.
+TEST_FIXTURE(forcing_fixture, INEXACT_NEWTON_RESTART) {
+  InexactNewtonForcing forcing(plist, solver_plist, vo);
+
+  CHECK_CLOSE(0.5, forcing.Tolerance(0., 1., 1.), 1.e-14);
+  CHECK_CLOSE(0.225, forcing.Tolerance(0., 1., 0.1), 1.e-14);
+
+  // a new step
+  CHECK_CLOSE(0.5, forcing.Tolerance(1., 2., 0.1), 1.e-14);
+  forcing.Record(10);
+  forcing.Finish(false);
+
+  // the failed step, retried over the same interval
+  CHECK_CLOSE(0.5, forcing.Tolerance(1., 2., 0.1), 1.e-14);
+  CHECK_CLOSE(0.225, forcing.Tolerance(1., 2., 0.01), 1.e-14);
+}
+
+
+// The initial term is clamped to the bounds, and bad bounds are refused.
+TEST_FIXTURE(forcing_fixture, INEXACT_NEWTON_BOUNDS) {
+  plist.set("initial forcing term", 0.99);
+  InexactNewtonForcing forcing(plist, solver_plist, vo);
+  CHECK_CLOSE(0.9, forcing.Tolerance(0., 1., 1.), 1.e-14);
+
+  plist.set("minimum forcing term", 0.95);
+  CHECK_THROW(Teuchos::rcp(new InexactNewtonForcing(plist, solver_plist, vo)), Errors::Message);
+
+  plist.set("minimum forcing term", 1.e-3);
+  plist.set("forcing term alpha", 1.0);
+  CHECK_THROW(Teuchos::rcp(new InexactNewtonForcing(plist, solver_plist, vo)), Errors::Message);
+}
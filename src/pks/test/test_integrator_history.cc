@@ -0,0 +1,237 @@
+/*
+  Testing of the checkpointed time integrator history: a run restarted from a
+  checkpoint takes the step, from the predictor, of the uninterrupted run.
+*/
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include "UnitTest++.h"
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+#include "Epetra_MpiComm.h"
+
+#include "MeshFactory.hh"
+#include "State.hh"
+#include "checkpoint.hh"
+
+#include "pk_physical_bdf_default.hh"
+
+using namespace Amanzi;
+
+namespace {
+
+// du/dt = -u on one cell.  The preconditioner is the exact inverse.
+class DecayPK : public PK_PhysicalBDF_Default {
+ public:
+  DecayPK(Teuchos::ParameterList& pk_tree,
+          const Teuchos::RCP<Teuchos::ParameterList>& glist,
+          const Teuchos::RCP<State>& S,
+          const Teuchos::RCP<TreeVector>& solution) :
+      PK_PhysicalBDF_Default(pk_tree, glist, S, solution),
+      PK(pk_tree, glist, S, solution),
+      h_(1.),
+      record_guess_(false),
+      guess_(0.) {}
+
+  virtual void Setup(const Teuchos::Ptr<State>& S) {
+    PK_PhysicalBDF_Default::Setup(S);
+    S->RequireField(key_, name_)->SetMesh(mesh_)->SetGhosted()
+        ->SetComponent("cell", AmanziMesh::CELL, 1);
+  }
+
+  virtual void CalculateDiagnostics(const Teuchos::RCP<State>& S) {}
+
+  virtual void Functional(double t_old, double t_new, Teuchos::RCP<TreeVector> u_old,
+                          Teuchos::RCP<TreeVector> u_new, Teuchos::RCP<TreeVector> g) {
+    if (record_guess_) {
+      guess_ = (*u_new->Data()->ViewComponent("cell",false))[0][0];
+      record_guess_ = false;
+    }
+    double h = t_new - t_old;
+    *g = *u_new;
+    g->Update(-1./h, *u_old, 1./h + 1.);
+  }
+
+  virtual void UpdatePreconditioner(double t, Teuchos::RCP<const TreeVector> up, double h) {
+    h_ = h;
+  }
+
+  virtual int ApplyPreconditioner(Teuchos::RCP<const TreeVector> u, Teuchos::RCP<TreeVector> Pu) {
+    *Pu = *u;
+    Pu->Scale(h_ / (1. + h_));
+    return 0;
+  }
+
+  virtual double ErrorNorm(Teuchos::RCP<const TreeVector> u,
+                           Teuchos::RCP<const TreeVector> du) {
+    double norm;
+    du->NormInf(&norm);
+    return norm / 1.e-10;
+  }
+
+  // The first iterate of the next nonlinear solve, which is the predictor.
+  void RecordGuess() { record_guess_ = true; }
+  double guess() const { return guess_; }
+
+ protected:
+  double h_;
+  bool record_guess_;
+  double guess_;
+};
+
+
+Teuchos::RCP<Teuchos::ParameterList>
+decayList(bool checkpoint_history)
+{
+  Teuchos::RCP<Teuchos::ParameterList> plist = Teuchos::rcp(new Teuchos::ParameterList("main"));
+  Teuchos::ParameterList& pk_list = plist->sublist("PKs").sublist("decay");
+  pk_list.set<std::string>("PK type", "decay");
+  pk_list.set<std::string>("primary variable key", "u");
+  pk_list.set<std::string>("conserved quantity key", "u");
+  pk_list.set<std::string>("cell volume key", "u");
+  pk_list.set<double>("initial time step", 1.);
+
+  Teuchos::ParameterList& ti_list = pk_list.sublist("time integrator");
+  ti_list.set<bool>("checkpoint integrator history", checkpoint_history);
+  ti_list.set<bool>("extrapolate initial guess", true);
+  ti_list.set<std::string>("solver type", "nka");
+  Teuchos::ParameterList& nka_list = ti_list.sublist("nka parameters");
+  nka_list.set<double>("nonlinear tolerance", 1.);
+  nka_list.set<double>("diverged tolerance", 1.e10);
+  nka_list.set<int>("limit iterations", 20);
+  nka_list.set<int>("max divergent iterations", 3);
+  ti_list.set<std::string>("timestep controller type", "standard");
+  Teuchos::ParameterList& ts_list = ti_list.sublist("timestep controller standard parameters");
+  ts_list.set<int>("max iterations", 12);
+  ts_list.set<int>("min iterations", 6);
+  ts_list.set<double>("time step reduction factor", 0.5);
+  ts_list.set<double>("time step increase factor", 1.25);
+  ts_list.set<double>("max time step", 100.);
+  ts_list.set<double>("min time step", 1.e-4);
+
+  plist->sublist("PK tree").sublist("decay").set<std::string>("PK type", "decay");
+  return plist;
+}
+
+
+// A PK and its State, set up as the Coordinator does.  If restart_file is not
+// empty, State is read from it, else u starts at 1.
+struct DecayRun {
+  DecayRun(bool checkpoint_history, const std::string& restart_file) :
+      plist(decayList(checkpoint_history)),
+      comm(MPI_COMM_SELF) {
+    Teuchos::ParameterList region_list;
+    Teuchos::RCP<AmanziGeometry::GeometricModel> gm =
+        Teuchos::rcp(new AmanziGeometry::GeometricModel(3, region_list, &comm));
+    AmanziMesh::MeshFactory meshfactory(&comm);
+    AmanziMesh::FrameworkPreference pref;
+    pref.push_back(AmanziMesh::MSTK);
+    meshfactory.preference(pref);
+    Teuchos::RCP<AmanziMesh::Mesh> mesh = meshfactory(0.,0.,0., 1.,1.,1., 1,1,1, gm);
+
+    Teuchos::ParameterList state_list;
+    S = Teuchos::rcp(new State(state_list));
+    S->RegisterDomainMesh(mesh);
+
+    soln = Teuchos::rcp(new TreeVector());
+    pk = Teuchos::rcp(new DecayPK(plist->sublist("PK tree").sublist("decay"), plist, S, soln));
+    pk->Setup(S.ptr());
+    pk->SetupIntegratorHistory(S.ptr());
+    S->Setup();
+
+    if (restart_file.empty()) {
+      S->GetFieldData("u", "decay")->PutScalar(1.);
+      S->GetField("u", "decay")->set_initialized();
+    } else {
+      ReadCheckpoint(&comm, S.ptr(), restart_file);
+    }
+    S->InitializeFields();
+    pk->Initialize(S.ptr());
+    S->InitializeEvaluators();
+    S->CheckAllFieldsInitialized();
+
+    S_next = Teuchos::rcp(new State(*S));
+    *S_next = *S;
+  }
+
+  // Take the step the PK recommends, returning the predictor it started from.
+  double Step() {
+    double t_old = S->time();
+    double t_new = t_old + pk->get_dt();
+    S_next->set_time(t_new);
+    pk->set_states(S, S, S_next);
+    pk->RecordGuess();
+    bool fail = pk->AdvanceStep(t_old, t_new, false);
+    CHECK(!fail);
+    pk->CommitStep(t_old, t_new, S_next);
+    S_next->advance_cycle();
+    *S = *S_next;
+    return pk->guess();
+  }
+
+  double u() const { return (*S->GetFieldData("u")->ViewComponent("cell",false))[0][0]; }
+
+  Teuchos::RCP<Teuchos::ParameterList> plist;
+  Epetra_MpiComm comm;
+  Teuchos::RCP<State> S, S_next;
+  Teuchos::RCP<TreeVector> soln;
+  Teuchos::RCP<DecayPK> pk;
+};
+
+
+// Write a checkpoint of the run, returning its filename.
+std::string
+writeCheckpoint(DecayRun& run, const std::string& base)
+{
+  Teuchos::ParameterList chkp_list;
+  chkp_list.set<std::string>("file name base", base);
+  chkp_list.set<int>("file name digits", 5);
+  Checkpoint chkp(chkp_list, &run.comm);
+  WriteCheckpoint(Teuchos::ptr(&chkp), run.S.ptr(), run.pk->get_dt());
+
+  std::stringstream filename;
+  filename << base << std::setfill('0') << std::setw(5) << run.S->cycle() << ".h5";
+  return filename.str();
+}
+
+} // namespace
+
+
+TEST(INTEGRATOR_HISTORY_RESTART) {
+  DecayRun run(true, "");
+  run.Step();
+  run.Step();
+  std::string filename = writeCheckpoint(run, "integrator_history_");
+  double dt = run.pk->get_dt();
+  double u_last = run.u();
+  double guess = run.Step();
+  double u = run.u();
+
+  // the timestep grew, and the predictor is not the last solution
+  CHECK(dt > 1.);
+  CHECK(std::abs(guess - u_last) > 1.e-6);
+
+  DecayRun restart(true, filename);
+  CHECK_CLOSE(dt, restart.pk->get_dt(), 1.e-12);
+  CHECK_CLOSE(guess, restart.Step(), 1.e-12);
+  CHECK_CLOSE(u, restart.u(), 1.e-12);
+}
+
+
+// Without the history, a restart starts over from the initial timestep and a
+// constant predictor.
+TEST(INTEGRATOR_HISTORY_NOT_CHECKPOINTED) {
+  DecayRun run(false, "");
+  run.Step();
+  run.Step();
+  std::string filename = writeCheckpoint(run, "no_integrator_history_");
+  double u = run.u();
+
+  DecayRun restart(false, filename);
+  CHECK_CLOSE(1., restart.pk->get_dt(), 1.e-12);
+  CHECK_CLOSE(u, restart.Step(), 1.e-12);
+}
@@ -14,6 +14,8 @@
 #ifndef AMANZI_MECHANICAL_DISPERSION_MODEL_HH_
 #define AMANZI_MECHANICAL_DISPERSION_MODEL_HH_
 
+#include <vector>
+
 // Amanzi
 #include "Point.hh"
 #include "Tensor.hh"
@@ -29,6 +31,29 @@ class MDM {
   virtual WhetStone::Tensor mech_dispersion(
       const AmanziGeometry::Point& u, int axi_symmetry, double s, double phi) const = 0;
 
+  // Batched version: computes the dispersion tensors of the given cells
+  // into packed storage, one contiguous array per tensor entry.  Component
+  // i of the velocity of cell c is u[i * stride + c], and entry (i, j) of
+  // its tensor is D[(i * dim_ + j) * stride + c].  All dim_ x dim_ entries
+  // are written, also for models of rank 1.
+  virtual void mech_dispersion(
+      const std::vector<int>& cells, int stride, const double* u, const int* axi_symmetry,
+      const double* s, const double* phi, double* D) const {
+    AmanziGeometry::Point uc(dim_);
+    for (int c : cells) {
+      for (int i = 0; i < dim_; i++) uc[i] = u[i * stride + c];
+      WhetStone::Tensor Dc = mech_dispersion(uc, axi_symmetry[c], s[c], phi[c]);
+      for (int i = 0; i < dim_; i++) {
+        for (int j = 0; j < dim_; j++) {
+          D[(i * dim_ + j) * stride + c] = (Dc.rank() == 1) ? (i == j ? Dc(0, 0) : 0.0) : Dc(i, j);
+        }
+      }
+    }
+  }
+
+  // Rank of the tensors returned by mech_dispersion().
+  virtual int tensor_rank() const { return 2; }
+
   // The model is valid if at least one parameter is not zero.
   virtual bool is_valid() const = 0;
 
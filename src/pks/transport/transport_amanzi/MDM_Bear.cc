@@ -60,6 +60,40 @@ WhetStone::Tensor MDM_Bear::mech_dispersion(
   return D;
 }
 
+
+/* ******************************************************************
+* Batched version of the above on packed storage.
+****************************************************************** */
+void MDM_Bear::mech_dispersion(
+    const std::vector<int>& cells, int stride, const double* u, const int* axi_symmetry,
+    const double* s, const double* phi, double* D) const
+{
+  double v[3];
+  for (int c : cells) {
+    double vnorm = 0.0;
+    for (int i = 0; i < dim_; i++) {
+      v[i] = u[i * stride + c] / phi[c];
+      vnorm += v[i] * v[i];
+    }
+    vnorm = std::sqrt(vnorm);
+
+    if (vnorm != 0.0) {
+      double a1 = alphaT_ * vnorm;
+      double anisotropy = (alphaL_ - alphaT_) / vnorm;
+      double scale = phi[c] * s[c];
+      for (int i = 0; i < dim_; i++) {
+        for (int j = i; j < dim_; j++) {
+          double Dij = anisotropy * v[i] * v[j];
+          if (i == j) Dij = a1 + Dij;
+          D[(i * dim_ + j) * stride + c] = D[(j * dim_ + i) * stride + c] = Dij * scale;
+        }
+      }
+    } else {
+      for (int k = 0; k < dim_ * dim_; k++) D[k * stride + c] = 0.0;
+    }
+  }
+}
+
 }  // namespace Transport
 }  // namespace Amanzi
 
@@ -38,6 +38,11 @@ class MDM_Bear : public MDM {
   WhetStone::Tensor mech_dispersion(
       const AmanziGeometry::Point& u, int axi_symmetry, double s, double phi) const;
 
+  // -- batched dispersion tensors in packed storage.
+  void mech_dispersion(
+      const std::vector<int>& cells, int stride, const double* u, const int* axi_symmetry,
+      const double* s, const double* phi, double* D) const;
+
   // -- the model is valid if at least one parameter is not zero.
   bool is_valid() const { return (alphaL_ + alphaT_ != 0.0); }
 
@@ -70,6 +70,51 @@ WhetStone::Tensor MDM_BurnettFrind::mech_dispersion(
   return D;
 }
 
+
+/* ******************************************************************
+* Batched version of the above on packed storage.
+****************************************************************** */
+void MDM_BurnettFrind::mech_dispersion(
+    const std::vector<int>& cells, int stride, const double* u, const int* axi_symmetry,
+    const double* s, const double* phi, double* D) const
+{
+  double v[3], Dc[3][3];
+  for (int c : cells) {
+    double vnorm = 0.0;
+    for (int i = 0; i < dim_; i++) {
+      v[i] = u[i * stride + c] / phi[c];
+      vnorm += v[i] * v[i];
+    }
+    vnorm = std::sqrt(vnorm);
+
+    if (vnorm != 0.0) {
+      double a1 = alphaTV_ * vnorm;
+      double a2 = (alphaL_ - alphaTV_) / vnorm;
+      double a3 = (alphaTH_ - alphaTV_) / vnorm;
+      for (int i = 0; i < dim_; i++) {
+        for (int j = i; j < dim_; j++) {
+          Dc[i][j] = a2 * v[i] * v[j];
+          if (i == j) Dc[i][j] = a1 + Dc[i][j];
+          Dc[j][i] = Dc[i][j];
+        }
+      }
+      Dc[0][0] += a3 * v[1] * v[1];
+      Dc[1][1] += a3 * v[0] * v[0];
+      Dc[0][1] -= a3 * v[0] * v[1];
+      Dc[1][0] -= a3 * v[0] * v[1];
+
+      double scale = phi[c] * s[c];
+      for (int i = 0; i < dim_; i++) {
+        for (int j = 0; j < dim_; j++) {
+          D[(i * dim_ + j) * stride + c] = Dc[i][j] * scale;
+        }
+      }
+    } else {
+      for (int k = 0; k < dim_ * dim_; k++) D[k * stride + c] = 0.0;
+    }
+  }
+}
+
 }  // namespace Transport
 }  // namespace Amanzi
 
@@ -41,6 +41,26 @@ WhetStone::Tensor MDM_Isotropic::mech_dispersion(
   return D;
 }
 
+
+/* ******************************************************************
+* Batched version of the above on packed storage.
+****************************************************************** */
+void MDM_Isotropic::mech_dispersion(
+    const std::vector<int>& cells, int stride, const double* u, const int* axi_symmetry,
+    const double* s, const double* phi, double* D) const
+{
+  for (int i = 0; i < dim_; i++) {
+    for (int j = 0; j < dim_; j++) {
+      double* Dij = D + (i * dim_ + j) * stride;
+      if (i == j) {
+        for (int c : cells) Dij[c] = alpha_ * s[c] * phi[c];
+      } else {
+        for (int c : cells) Dij[c] = 0.0;
+      }
+    }
+  }
+}
+
 }  // namespace Transport
 }  // namespace Amanzi
 
@@ -77,6 +77,53 @@ WhetStone::Tensor MDM_LichtnerKelkarRobinson::mech_dispersion(
   return D;
 }
 
+
+/* ******************************************************************
+* Batched version of the above on packed storage.
+****************************************************************** */
+void MDM_LichtnerKelkarRobinson::mech_dispersion(
+    const std::vector<int>& cells, int stride, const double* u, const int* axi_symmetry,
+    const double* s, const double* phi, double* D) const
+{
+  double v[3], omega[3];
+  for (int c : cells) {
+    int k = axi_symmetry[c];
+    ASSERT(k >= 0 && k < 3);
+
+    double vnorm = 0.0;
+    for (int i = 0; i < dim_; i++) {
+      v[i] = u[i * stride + c] / phi[c];
+      vnorm += v[i] * v[i];
+    }
+    vnorm = std::sqrt(vnorm);
+
+    if (vnorm != 0.0) {
+      double theta = v[k] / vnorm;  // cosine of angle theta
+      double theta2 = theta * theta;
+
+      // define direction orthogonal to symmetry axis
+      for (int i = 0; i < dim_; i++) omega[i] = v[i] * (-theta / vnorm);
+      omega[k] += 1.0;
+
+      double alphaL = alphaLH_ + theta2 * (alphaLV_ - alphaLH_);
+      double a1 = alphaTH_ * vnorm;
+      double a2 = (alphaL - alphaTH_) / vnorm;
+      double a3 = (alphaTV_ - alphaTH_) * vnorm;
+      double scale = phi[c] * s[c];
+
+      for (int i = 0; i < dim_; i++) {
+        for (int j = i; j < dim_; j++) {
+          double Dij = a2 * v[i] * v[j] + a3 * omega[i] * omega[j];
+          if (i == j) Dij = a1 + Dij;
+          D[(i * dim_ + j) * stride + c] = D[(j * dim_ + i) * stride + c] = Dij * scale;
+        }
+      }
+    } else {
+      for (int n = 0; n < dim_ * dim_; n++) D[n * stride + c] = 0.0;
+    }
+  }
+}
+
 }  // namespace Transport
 }  // namespace Amanzi
 
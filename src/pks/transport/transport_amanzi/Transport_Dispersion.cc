@@ -9,6 +9,8 @@
   Author: Konstantin Lipnikov (lipnikov@lanl.gov)
 */
 
+#include <algorithm>
+
 #include "Teuchos_RCP.hpp"
 #include "Epetra_FECrsGraph.h"
 #include "Epetra_FECrsMatrix.h"
@@ -29,35 +31,93 @@ namespace Transport{
 /* *******************************************************************
 * Calculate dispersive tensor from given Darcy fluxes. The flux is
 * assumed to be scaled by face area.
+*
+* The mechanical dispersion is kept in packed storage, one array per
+* tensor entry, and computed by one batched call per model. It depends
+* on the flux, porosity and saturation only, so it is recomputed only
+* when one of them has changed since the last call.
 ******************************************************************* */
 void Transport_PK_ATS::CalculateDispersionTensor_(
     const Epetra_MultiVector& darcy_flux, 
     const Epetra_MultiVector& porosity, const Epetra_MultiVector& saturation,
     const Epetra_MultiVector& mol_density )
 {
-  D_.resize(ncells_owned);
-  for (int c = 0; c < ncells_owned; c++) D_[c].Init(dim, 1);
+  int nmodels = mdm_->second.size();
+  if (mdm_cells_.size() == 0) {
+    mdm_cells_.resize(nmodels);
+    for (int c = 0; c < ncells_owned; ++c) mdm_cells_[(*mdm_->first)[c]].push_back(c);
+  }
 
-  AmanziGeometry::Point velocity(dim);
-  AmanziMesh::Entity_ID_List faces;
-  WhetStone::MFD3D_Diffusion mfd3d(mesh_);
+  bool changed = D_packed_.size() == 0;
+  changed |= UpdateDispersionInput_(darcy_flux, dispersion_flux_);
+  changed |= UpdateDispersionInput_(porosity, dispersion_phi_);
+  changed |= UpdateDispersionInput_(saturation, dispersion_ws_);
 
-  for (int c = 0; c < ncells_owned; ++c) {
-    mesh_->cell_get_faces(c, &faces);
-    int nfaces = faces.size();
+  if (changed) {
+    velocity_packed_.resize(dim * ncells_owned);
+    D_packed_.resize(dim * dim * ncells_owned);
+
+    AmanziGeometry::Point velocity(dim);
+    AmanziMesh::Entity_ID_List faces;
+    WhetStone::MFD3D_Diffusion mfd3d(mesh_);
+    std::vector<double> flux;
+
+    for (int c = 0; c < ncells_owned; ++c) {
+      mesh_->cell_get_faces(c, &faces);
+      int nfaces = faces.size();
 
-    std::vector<double> flux(nfaces);
-    for (int n = 0; n < nfaces; n++) flux[n] = darcy_flux[0][faces[n]];
-    mfd3d.RecoverGradient_MassMatrix(c, flux, velocity);
+      flux.resize(nfaces);
+      for (int n = 0; n < nfaces; n++) flux[n] = darcy_flux[0][faces[n]];
+      mfd3d.RecoverGradient_MassMatrix(c, flux, velocity);
+
+      for (int i = 0; i < dim; i++) velocity_packed_[i * ncells_owned + c] = velocity[i];
+    }
+
+    for (int m = 0; m < nmodels; m++) {
+      mdm_->second[m]->mech_dispersion(mdm_cells_[m], ncells_owned,
+              velocity_packed_.data(), axi_symmetry_.data(),
+              saturation[0], porosity[0], D_packed_.data());
+    }
+  }
 
-    D_[c] = mdm_->second[(*mdm_->first)[c]]->mech_dispersion(
-        velocity, axi_symmetry_[c], saturation[0][c], porosity[0][c]);
-    // double mol_den = mol_density[0][c];
-    // D_[c] *= mol_den;
+  // unpack, reusing the tensors of the previous call
+  D_.resize(ncells_owned);
+  for (int m = 0; m < nmodels; m++) {
+    int rank = mdm_->second[m]->tensor_rank();
+    for (int c : mdm_cells_[m]) {
+      WhetStone::Tensor& Dc = D_[c];
+      if (Dc.rank() != rank || Dc.dimension() != dim) Dc.Init(dim, rank);
+
+      if (rank == 1) {
+        Dc(0, 0) = D_packed_[c];
+      } else {
+        for (int i = 0; i < dim; i++) {
+          for (int j = 0; j < dim; j++) {
+            Dc(i, j) = D_packed_[(i * dim + j) * ncells_owned + c];
+          }
+        }
+      }
+      // double mol_den = mol_density[0][c];
+      // D_[c] *= mol_den;
+    }
   }
 }
 
 
+/* *******************************************************************
+* Copy the first vector of v into copy. Returns true if they differed.
+******************************************************************* */
+bool Transport_PK_ATS::UpdateDispersionInput_(
+    const Epetra_MultiVector& v, std::vector<double>& copy)
+{
+  int n = v.MyLength();
+  if (copy.size() == (size_t) n && std::equal(v[0], v[0] + n, copy.begin())) return false;
+
+  copy.assign(v[0], v[0] + n);
+  return true;
+}
+
+
 /* *******************************************************************
 * Calculate diffusion tensor and add it to the dispersion tensor.
 ******************************************************************* */
@@ -166,6 +166,7 @@ typedef double AnalyticFunction(const AmanziGeometry::Point&, const double);
   void CalculateDispersionTensor_(
       const Epetra_MultiVector& darcy_flux, const Epetra_MultiVector& porosity, 
       const Epetra_MultiVector& saturation, const Epetra_MultiVector& mol_density);
+  bool UpdateDispersionInput_(const Epetra_MultiVector& v, std::vector<double>& copy);
 
   void CalculateDiffusionTensor_(
       double md, int phase, const Epetra_MultiVector& porosity, 
@@ -280,6 +281,9 @@ typedef double AnalyticFunction(const AmanziGeometry::Point&, const double);
   // mechanical dispersion and molecual diffusion
   Teuchos::RCP<MDMPartition> mdm_;
   std::vector<WhetStone::Tensor> D_;
+  std::vector<std::vector<int> > mdm_cells_;  // owned cells of each model
+  std::vector<double> velocity_packed_, D_packed_;  // one array per component
+  std::vector<double> dispersion_flux_, dispersion_phi_, dispersion_ws_;  // inputs of D_packed_
 
   bool flag_dispersion_;
   std::vector<int> axi_symmetry_;  // axi-symmetry direction of permeability tensor
@@ -44,6 +44,9 @@ Effectively stolen from Amanzi, with few modifications.
 #include "ats_clm_driver.hh"
 #include "InputParserIS.hh"
 
+#define _ats_source
+#include "ats_defines.h"
+
 #include "global_verbosity.hh"
 #include "VerboseObject_objs.hh"
 
@@ -100,7 +103,9 @@ int32_t ATSCLMDriver::Initialize(const MPI_Comm& mpi_comm,
   char * xmlfile = getenv("ATS_XML_INPUT");
   ASSERT(xmlfile != NULL);
 
-  std::cout << "Initing ATS with " << num_cols << " columns" << std::endl;
+  if (out.get() && includesVerbLevel(verbLevel,Teuchos::VERB_LOW,true)) {
+    *out << "Initializing ATS with " << num_cols << " columns" << std::endl;
+  }
 
   // ======  SET UP THE INPUT SPEC =======
   // read the main parameter list
@@ -317,7 +322,6 @@ int32_t ATSCLMDriver::Initialize(const MPI_Comm& mpi_comm,
   // Create the state.
   Teuchos::ParameterList state_plist = params_copy.sublist("state");
   S_ = Teuchos::rcp(new State(state_plist));
-  state_plist.print(std::cout);
   S_->RegisterDomainMesh(mesh_);
   if (surface3D_mesh != Teuchos::null) S_->RegisterMesh("surface_3d", surface3D_mesh);
   if (surface_mesh != Teuchos::null) S_->RegisterMesh("surface", surface_mesh);
@@ -402,6 +406,19 @@ int32_t ATSCLMDriver::Initialize(const MPI_Comm& mpi_comm,
   // set up the coordinator, allocating space
   coordinator_->setup();
   coord_setup_ = true;
+
+  // ======= SET UP THE EXCHANGE BUFFERS =========
+  // One contiguous block per mesh, each field a column of length ncells.
+  sub_buffer_.assign(3 * ncells_sub_, 0.);
+  sub_host_ = Teuchos::rcp(new Epetra_MultiVector(View, *sub_clm_map_,
+          &sub_buffer_[0], ncells_sub_, 3));
+  surf_buffer_.assign(2 * ncells_surf_, 0.);
+  surf_host_ = Teuchos::rcp(new Epetra_MultiVector(View, *surf_clm_map_,
+          &surf_buffer_[0], ncells_surf_, 2));
+
+  // until ATS is initialized, data goes to S_
+  RegisterFields_(S_);
+  return 0;
 }
 
 int32_t ATSCLMDriver::Finalize() {
@@ -410,147 +427,134 @@ int32_t ATSCLMDriver::Finalize() {
 }
 
 
-int32_t ATSCLMDriver::SetData_(std::string key, double* data, int length) {
-  Teuchos::RCP<State> S = S_next_ == Teuchos::null ? S_ : S_next_;
+// Resolve the exchanged fields of S, creating views of their owned cell
+// data in the importers' target (ATS) ordering.
+void ATSCLMDriver::RegisterFields_(const Teuchos::RCP<State>& S) {
+  const char* sub_keys[3] = { "temperature", "saturation_liquid", "saturation_ice" };
+  const char* surf_keys[2] = { "surface_total_energy_source", "surface_mass_source" };
 
-  // from the name, grab data from state and determine the type of the data
-  Teuchos::RCP<CompositeVector> dat =
-      S->GetFieldData(key, S->GetField(key)->owner());
+  double* sub_ptrs[3];
+  for (int i=0; i!=3; ++i) {
+    Epetra_MultiVector& dat = *S->GetFieldData(sub_keys[i],
+            S->GetField(sub_keys[i])->owner())->ViewComponent("cell",false);
+    sub_ptrs[i] = dat[0];
+  }
+  sub_ats_ = Teuchos::rcp(new Epetra_MultiVector(View, sub_importer_->TargetMap(),
+          sub_ptrs, 3));
+
+  double* surf_ptrs[2];
+  surf_pvfes_.resize(2);
+  for (int i=0; i!=2; ++i) {
+    Epetra_MultiVector& dat = *S->GetFieldData(surf_keys[i], "clm")
+        ->ViewComponent("cell",false);
+    surf_ptrs[i] = dat[0];
+
+    surf_pvfes_[i] = Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>(
+        S->GetFieldEvaluator(surf_keys[i]));
+    ASSERT(surf_pvfes_[i] != Teuchos::null);
+  }
+  surf_ats_ = Teuchos::rcp(new Epetra_MultiVector(View, surf_importer_->TargetMap(),
+          surf_ptrs, 2));
+}
 
-  // Create an Epetra_Vector from the data and the appropriate map
-  Epetra_Vector dat_clm(View, *sub_clm_map_, data);
 
-  // Call the importer to map to state's vector
-  Epetra_MultiVector& dat_v = *dat->ViewComponent("cell",false);
-  int ierr = dat_v.Import(dat_clm, *sub_importer_, Insert);
+int32_t ATSCLMDriver::ImportTemperature_(const Epetra_MultiVector& host) {
+  Epetra_MultiVector temp(View, *sub_ats_, FIELD_TEMPERATURE, 1);
+  int ierr = temp.Import(host, *sub_importer_, Insert);
   ASSERT(!ierr);
-
-  std::cout << "SetData (ATS):" << std::endl;
-  std::cout << "data[0] = " << dat_v[0][0] << std::endl;
-  std::cout << "data[1] = " << dat_v[0][1] << std::endl;
-
   return ierr;
 }
 
 
-int32_t ATSCLMDriver::GetData_(std::string key, double* data, int length) {
-  Teuchos::RCP<State> S = S_next_ == Teuchos::null ? S_ : S_next_;
-
-  // from the name, grab data from state and determine the type of the data
-  Teuchos::RCP<CompositeVector> dat =
-      S->GetFieldData(key, S->GetField(key)->owner());
-
-  // Create an Epetra_Vector from the data and the appropriate map
-  Epetra_Vector dat_clm(View, *sub_clm_map_, data);
-
-  // Call the importer to map to state's vector
-  Epetra_MultiVector& dat_v = *dat->ViewComponent("cell",false);
-  int ierr = dat_v.Export(dat_clm, *sub_importer_, Insert);
+int32_t ATSCLMDriver::ImportSurface_(const Epetra_MultiVector& host) {
+  int ierr = surf_ats_->Import(host, *surf_importer_, Insert);
   ASSERT(!ierr);
-  return ierr;
-}
 
-int32_t ATSCLMDriver::SetSurfaceData_(std::string key, double* data, int length) {
   Teuchos::RCP<State> S = S_next_ == Teuchos::null ? S_ : S_next_;
-  if (S_next_ == Teuchos::null)
-    std::cout << "writing to S_old" << std::endl;
-  else
-    std::cout << "writing to S_next" << std::endl;
-
-  // from the name, grab data from state and determine the type of the data
-  Teuchos::RCP<CompositeVector> dat =
-      S->GetFieldData(key, S->GetField(key)->owner());
+  for (int i=0; i!=surf_pvfes_.size(); ++i)
+    surf_pvfes_[i]->SetFieldAsChanged(S.ptr());
+  return ierr;
+}
 
-  // Create an Epetra_Vector from the data and the appropriate map
-  Epetra_Vector dat_clm(View, *surf_clm_map_, data);
 
-  // Call the importer to map to state's vector
-  Epetra_MultiVector& dat_v = *dat->ViewComponent("cell",false);
-  int ierr = dat_v.Import(dat_clm, *surf_importer_, Insert);
+// The reverse of the subsurface import: ATS ordering -> CLM ordering.
+int32_t ATSCLMDriver::ExportSubsurface_(Epetra_MultiVector& host) {
+  int ierr = host.Export(*sub_ats_, *sub_importer_, Insert);
   ASSERT(!ierr);
-
-  std::cout << "Surf data in = " << std::endl;
-  dat_clm.Print(std::cout);
-  std::cout << "Surf data out = " << std::endl;
-  dat_v.Print(std::cout);
-
-  //  std::cout << "Surf Data In (" << key << ")[0] = " << data[0] << std::endl;
-  //  std::cout << "Surf Data Out (" << key << ")[0] = " << dat_v[0][0] << std::endl;
   return ierr;
 }
 
-int32_t ATSCLMDriver::GetSurfaceData_(std::string key, double* data, int length) {
-  Teuchos::RCP<State> S = S_next_ == Teuchos::null ? S_ : S_next_;
 
-  // from the name, grab data from state and determine the type of the data
-  Teuchos::RCP<CompositeVector> dat =
-      S->GetFieldData(key, S->GetField(key)->owner());
+int32_t ATSCLMDriver::GetFieldView(int field, double** data, int* length) {
+  if (field >= FIELD_TEMPERATURE && field <= FIELD_SATURATION_ICE) {
+    *data = (*sub_host_)[field - FIELD_TEMPERATURE];
+    *length = ncells_sub_;
+  } else if (field >= FIELD_SURFACE_ENERGY_SOURCE && field <= FIELD_SURFACE_MASS_SOURCE) {
+    *data = (*surf_host_)[field - FIELD_SURFACE_ENERGY_SOURCE];
+    *length = ncells_surf_;
+  } else {
+    *data = NULL;
+    *length = 0;
+    return ATS_FIELD_ERROR;
+  }
+  return 0;
+}
 
-  // Create an Epetra_Vector from the data and the appropriate map
-  Epetra_Vector dat_clm(View, *surf_clm_map_, data);
 
-  // Call the importer to map to state's vector
-  Epetra_MultiVector& dat_v = *dat->ViewComponent("cell",false);
-  int ierr = dat_v.Export(dat_clm, *surf_importer_, Insert);
-  ASSERT(!ierr);
+int32_t ATSCLMDriver::Exchange(int direction) {
+  int ierr(0);
+  switch (direction) {
+    case EXCHANGE_INIT: {
+      // saturations are computed from temperature and pressure by ATS
+      Epetra_MultiVector host_temp(View, *sub_host_, FIELD_TEMPERATURE, 1);
+      ierr |= ImportTemperature_(host_temp);
+      InitializeCoordinator_();
+      break;
+    }
+    case EXCHANGE_IN:
+      ierr |= ImportSurface_(*surf_host_);
+      break;
+    case EXCHANGE_OUT:
+      ierr |= ExportSubsurface_(*sub_host_);
+      break;
+    default:
+      ierr = ATS_FIELD_ERROR;
+  }
   return ierr;
 }
 
-int32_t ATSCLMDriver::SetInitCLMData(double* T, double* sl, double* si) {
-  int ierr(0);
-  std::cout << "SetInitCLMData (ATS):" << std::endl;
-  std::cout << "T_ats[0] = " << T[0] << std::endl;
-  std::cout << "T_ats[374] = " << T[374] << std::endl;
-  std::cout << "sl_ats[0] = " << sl[0] << std::endl;
-  std::cout << "sl_ats[374] = " << sl[374] << std::endl;
-  std::cout << "si_ats[0] = " << si[0] << std::endl;
-  std::cout << "si_ats[374] = " << si[374] << std::endl;
-
-  ierr |= SetData_("temperature", T, ncells_sub_);
-
-  // ierr |= SetData_("saturation_liquid", sl, ncells_sub_);
-  // S_->GetField("saturation_liquid", S_->GetField("saturation_liquid")->owner())->set_initialized();
-  // ierr |= SetData_("saturation_ice", si, ncells_sub_);
-  // S_->GetField("saturation_ice", S_->GetField("saturation_ice")->owner())->set_initialized();
 
+void ATSCLMDriver::InitializeCoordinator_() {
   coordinator_->initialize();
   coord_init_ = true;
   S_next_ = coordinator_->get_next_state();
 
-  return ierr;
+  // from here on data goes to S_next_
+  RegisterFields_(S_next_);
 }
 
-int32_t ATSCLMDriver::SetCLMData(double* e_flux, double* w_flux) {
-  int ierr(0);
-
-  std::cout << "SetCLMData (ATS) (on " << ncells_surf_ << " cells):" << std::endl;
-  std::cout << "Qe_ats[0] = " << e_flux[0] << std::endl;
-  std::cout << "Qe_ats[24] = " << e_flux[24] << std::endl;
-  std::cout << "Qw_ats[0] = " << w_flux[0] << std::endl;
-  std::cout << "Qw_ats[24] = " << w_flux[24] << std::endl;
 
-  ierr |= SetSurfaceData_("surface_total_energy_source", e_flux, ncells_surf_);
-  ierr |= SetSurfaceData_("surface_mass_source", w_flux, ncells_surf_);
+// The original, pointer-per-call interface.  The caller's arrays are
+// wrapped, not copied, and go through the same batched transfers.
+int32_t ATSCLMDriver::SetInitCLMData(double* T, double* sl, double* si) {
+  // saturations are computed from temperature and pressure by ATS
+  Epetra_MultiVector host(View, *sub_clm_map_, T, ncells_sub_, 1);
+  int ierr = ImportTemperature_(host);
+  InitializeCoordinator_();
   return ierr;
 }
 
+int32_t ATSCLMDriver::SetCLMData(double* e_flux, double* w_flux) {
+  double* ptrs[2] = { e_flux, w_flux };
+  Epetra_MultiVector host(View, *surf_clm_map_, ptrs, 2);
+  return ImportSurface_(host);
+}
 
-int32_t ATSCLMDriver::GetCLMData(double* T, double* sl, double* si) {
-  int ierr(0);
-
-  ierr |= GetData_("temperature", T, ncells_sub_);
-  ierr |= GetData_("saturation_liquid", sl, ncells_sub_);
-  ierr |= GetData_("saturation_ice", si, ncells_sub_);
-
-  std::cout << "GetCLMData (ATS):" << std::endl;
-  std::cout << "T_ats[0] = " << T[0] << std::endl;
-  std::cout << "T_ats[374] = " << T[374] << std::endl;
-  std::cout << "sl_ats[0] = " << sl[0] << std::endl;
-  std::cout << "sl_ats[374] = " << sl[374] << std::endl;
-  std::cout << "si_ats[0] = " << si[0] << std::endl;
-  std::cout << "si_ats[374] = " << si[374] << std::endl;
 
-  return ierr;
+int32_t ATSCLMDriver::GetCLMData(double* T, double* sl, double* si) {
+  double* ptrs[3] = { T, sl, si };
+  Epetra_MultiVector host(View, *sub_clm_map_, ptrs, 3);
+  return ExportSubsurface_(host);
 }
 
 
@@ -32,6 +32,15 @@ Put
 - saturation_gas   (1 - s_i - s_l)
 
 
+Exchange
+
+The exchanged fields are a fixed list, resolved once.  The driver owns one
+contiguous, CLM-ordered buffer per field (GetFieldView()), which the host
+model reads and writes in place.  Exchange() then moves every field of a
+direction with a single Import/Export per mesh, through views of the
+state's own vectors, so nothing is looked up or copied field by field.
+
+
 ------------------------------------------------------------------------- */
 
 #ifndef ATS_CLM_DRIVER_HH
@@ -44,6 +53,9 @@ Put
 
 #include "Teuchos_ParameterList.hpp"
 #include "Teuchos_VerboseObject.hpp"
+#include "Epetra_MultiVector.h"
+#include "Epetra_Import.h"
+#include "primary_variable_field_evaluator.hh"
 #include "Simulator.hh"
 
 namespace Amanzi {
@@ -64,6 +76,29 @@ struct ATSCLMDriver
   int32_t SetCLMData(double* e_flux, double* w_flux);
   int32_t GetCLMData(double* T, double* sl, double* si);
 
+  // Exchanged fields and directions.  These values match ATS_FIELD_* and
+  // ATS_EXCHANGE_* in ats_defines.
+  enum ExchangeField {
+    FIELD_TEMPERATURE = 0,
+    FIELD_SATURATION_LIQUID,
+    FIELD_SATURATION_ICE,
+    FIELD_SURFACE_ENERGY_SOURCE,
+    FIELD_SURFACE_MASS_SOURCE,
+    NUM_FIELDS
+  };
+  enum ExchangeDirection {
+    EXCHANGE_INIT = 0,  // host -> ATS temperature, then initialize ATS
+    EXCHANGE_IN,        // host -> ATS surface sources
+    EXCHANGE_OUT        // ATS -> host temperature and saturations
+  };
+
+  // Pointer to and length of the host buffer of a field.  Valid from
+  // Initialize() until Finalize().
+  int32_t GetFieldView(int field, double** data, int* length);
+
+  // Move all fields of a direction between the host buffers and ATS.
+  int32_t Exchange(int direction);
+
  protected:
   // size of data
   int ncells_surf_;
@@ -86,16 +121,30 @@ struct ATSCLMDriver
   Teuchos::RCP<Epetra_Import> surf_importer_;
   Teuchos::RCP<Epetra_Import> sub_importer_;
 
+  // Host buffers, field-major in CLM ordering, and multivector views of
+  // them on the CLM maps.
+  std::vector<double> sub_buffer_;
+  std::vector<double> surf_buffer_;
+  Teuchos::RCP<Epetra_MultiVector> sub_host_;
+  Teuchos::RCP<Epetra_MultiVector> surf_host_;
+
+  // Views of the state's cell vectors on the importers' target maps, and the
+  // evaluators of the imported surface sources.
+  Teuchos::RCP<Epetra_MultiVector> sub_ats_;
+  Teuchos::RCP<Epetra_MultiVector> surf_ats_;
+  std::vector<Teuchos::RCP<PrimaryVariableFieldEvaluator> > surf_pvfes_;
+
   Teuchos::EVerbosityLevel verbosity_;
 
   // list of region names
   std::vector<std::string> clm_type_region_names;
 
  private:
-  int32_t SetData_(std::string key, double* data, int length);
-  int32_t GetData_(std::string key, double* data, int length);
-  int32_t SetSurfaceData_(std::string key, double* data, int length);
-  int32_t GetSurfaceData_(std::string key, double* data, int length);
+  void RegisterFields_(const Teuchos::RCP<State>& S);
+  void InitializeCoordinator_();
+  int32_t ImportTemperature_(const Epetra_MultiVector& host);
+  int32_t ImportSurface_(const Epetra_MultiVector& host);
+  int32_t ExportSubsurface_(Epetra_MultiVector& host);
 
 };
 
@@ -11,5 +11,14 @@
 
 static const int32_t ATS_SUCCESS = 0;
 static const int32_t ATS_MPI_ERROR = -1;
+static const int32_t ATS_FIELD_ERROR = -2;
+static const int32_t ATS_FIELD_TEMPERATURE = 0;
+static const int32_t ATS_FIELD_SATURATION_LIQUID = 1;
+static const int32_t ATS_FIELD_SATURATION_ICE = 2;
+static const int32_t ATS_FIELD_SURFACE_ENERGY_SOURCE = 3;
+static const int32_t ATS_FIELD_SURFACE_MASS_SOURCE = 4;
+static const int32_t ATS_EXCHANGE_INIT = 0;
+static const int32_t ATS_EXCHANGE_IN = 1;
+static const int32_t ATS_EXCHANGE_OUT = 2;
 
 #endif // ats_defines_h
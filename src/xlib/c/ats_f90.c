@@ -33,6 +33,15 @@ int32_t ats_get_clm_data_f90(double * T, double * Sl, double * Si) {
 	return ats_get_clm_data(T, Sl, Si);
 } // ats_get_clm_data_f90
 
+int32_t ats_get_field_view_f90(int32_t * field, double ** data,
+	int32_t * length) {
+	return ats_get_field_view(*field, data, length);
+} // ats_get_field_view_f90
+
+int32_t ats_exchange_f90(int32_t * direction) {
+	return ats_exchange(*direction);
+} // ats_exchange_f90
+
 int32_t ats_advance_f90(double * dt, int32_t * force_viz) {
 	return ats_advance(*dt, *force_viz);
 } // ats_advance_f90
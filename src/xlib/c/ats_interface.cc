@@ -37,6 +37,14 @@ int32_t ats_get_clm_data(double * T, double * Sl, double * Si) {
 	return _state.clm_driver().GetCLMData(T, Sl, Si);
 } // ats_get_clm_data
 
+int32_t ats_get_field_view(int32_t field, double ** data, int32_t * length) {
+	return _state.clm_driver().GetFieldView(field, data, length);
+} // ats_get_field_view
+
+int32_t ats_exchange(int32_t direction) {
+	return _state.clm_driver().Exchange(direction);
+} // ats_exchange
+
 int32_t ats_advance(double dt, int32_t force_viz) {
 	return _state.clm_driver().Advance(dt, force_viz == 1 ? true : false);
 } // ats_advance
@@ -33,6 +33,14 @@ int32_t ats_set_init_clm_data(double * T, double * Sl, double * Si);
 int32_t ats_set_clm_data(double * e_flux, double * w_flux);
 int32_t ats_get_clm_data(double * T, double * Sl, double * Si);
 
+/*
+ * Zero-copy exchange: the host reads and writes the buffer of each
+ * ATS_FIELD_* in place, then calls ats_exchange with an ATS_EXCHANGE_*
+ * direction to move all of that direction's fields at once.
+ */
+int32_t ats_get_field_view(int32_t field, double ** data, int32_t * length);
+int32_t ats_exchange(int32_t direction);
+
 int32_t ats_advance(double dt, int32_t force_viz);
 
 #if defined(__cplusplus)
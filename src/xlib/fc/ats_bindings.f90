@@ -82,6 +82,34 @@ interface
       integer(int32_t) :: ierr
    end function ats_get_clm_data_f90
 
+   !---------------------------------------------------------------------------!
+   ! ats_get_field_view_f90
+   !---------------------------------------------------------------------------!
+
+   function ats_get_field_view_f90(field, data, length) &
+      result(ierr) bind(C, name="ats_get_field_view_f90")
+      use, intrinsic :: ISO_C_BINDING
+      use :: ats_data
+      implicit none
+      integer(int32_t) :: field
+      type(c_ptr) :: data
+      integer(int32_t) :: length
+      integer(int32_t) :: ierr
+   end function ats_get_field_view_f90
+
+   !---------------------------------------------------------------------------!
+   ! ats_exchange_f90
+   !---------------------------------------------------------------------------!
+
+   function ats_exchange_f90(direction) &
+      result(ierr) bind(C, name="ats_exchange_f90")
+      use, intrinsic :: ISO_C_BINDING
+      use :: ats_data
+      implicit none
+      integer(int32_t) :: direction
+      integer(int32_t) :: ierr
+   end function ats_exchange_f90
+
    !---------------------------------------------------------------------------!
    ! ats_advance_f90
    !---------------------------------------------------------------------------!
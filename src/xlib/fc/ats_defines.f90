@@ -9,5 +9,14 @@ module ats_defines
 
       integer(int32_t), bind(C, name='ATS_SUCCESS') :: ATS_SUCCESS
       integer(int32_t), bind(C, name='ATS_MPI_ERROR') :: ATS_MPI_ERROR
+      integer(int32_t), bind(C, name='ATS_FIELD_ERROR') :: ATS_FIELD_ERROR
+      integer(int32_t), bind(C, name='ATS_FIELD_TEMPERATURE') :: ATS_FIELD_TEMPERATURE
+      integer(int32_t), bind(C, name='ATS_FIELD_SATURATION_LIQUID') :: ATS_FIELD_SATURATION_LIQUID
+      integer(int32_t), bind(C, name='ATS_FIELD_SATURATION_ICE') :: ATS_FIELD_SATURATION_ICE
+      integer(int32_t), bind(C, name='ATS_FIELD_SURFACE_ENERGY_SOURCE') :: ATS_FIELD_SURFACE_ENERGY_SOURCE
+      integer(int32_t), bind(C, name='ATS_FIELD_SURFACE_MASS_SOURCE') :: ATS_FIELD_SURFACE_MASS_SOURCE
+      integer(int32_t), bind(C, name='ATS_EXCHANGE_INIT') :: ATS_EXCHANGE_INIT
+      integer(int32_t), bind(C, name='ATS_EXCHANGE_IN') :: ATS_EXCHANGE_IN
+      integer(int32_t), bind(C, name='ATS_EXCHANGE_OUT') :: ATS_EXCHANGE_OUT
 
 end module ats_defines
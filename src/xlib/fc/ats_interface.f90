@@ -85,6 +85,43 @@ module ats_interface
       ierr = ats_get_clm_data_f90(T, Sl, Si)
    end subroutine ats_get_clm_data
 
+   !---------------------------------------------------------------------------!
+   ! ats_get_field_view
+   !
+   ! Associates data with the ATS-owned buffer of field, which the host reads
+   ! and writes in place.
+   !---------------------------------------------------------------------------!
+
+   subroutine ats_get_field_view(field, data, ierr)
+      use :: ats_data
+      implicit none
+      integer(int32_t) :: field
+      real(c_double), pointer :: data(:)
+      integer(int32_t) :: ierr
+      type(c_ptr) :: cdata
+      integer(int32_t) :: length
+
+      ierr = ats_get_field_view_f90(field, cdata, length)
+      if (ierr == 0) then
+         call c_f_pointer(cdata, data, [length])
+      else
+         nullify(data)
+      end if
+   end subroutine ats_get_field_view
+
+   !---------------------------------------------------------------------------!
+   ! ats_exchange
+   !---------------------------------------------------------------------------!
+
+   subroutine ats_exchange(direction, ierr)
+      use :: ats_data
+      implicit none
+      integer(int32_t) :: direction
+      integer(int32_t) :: ierr
+
+      ierr = ats_exchange_f90(direction)
+   end subroutine ats_exchange
+
    !---------------------------------------------------------------------------!
    ! ats_advance
    !---------------------------------------------------------------------------!
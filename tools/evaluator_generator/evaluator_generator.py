@@ -1,4 +1,5 @@
-import sys,os
+import sys,os,re
+import sympy
 from sympy.printing import ccode
 
 _template_directory = os.path.dirname(os.path.abspath(__file__))
@@ -20,7 +21,7 @@ def render(tname, d):
     
 class EvalGen(object):
     def __init__(self, name, namespace, descriptor, my_key=None, expression=None,
-                 doc=None, **kwargs):
+                 doc=None, kernel=None, **kwargs):
         self.d = {}
         self.setName(name, **kwargs)
         self.setNamespace(namespace, **kwargs)
@@ -36,6 +37,11 @@ class EvalGen(object):
         self.par_names = []
         self.par_defaults = []
         self.expression = expression
+        if kernel is None:
+            kernel = expression is not None
+        if kernel and expression is None:
+            raise ValueError("A kernel can only be generated from an expression.")
+        self.kernel = kernel
         if doc is not None:
             self.d['docDict'] = doc
         else:
@@ -98,11 +104,17 @@ class EvalGen(object):
     def renderMyMethodDeclarationArgs(self):
         return ", ".join(["double %s"%var for var in self.vars])
 
+    def renderKernelArgs(self):
+        return ", ".join(["%s_v[0]"%var for var in self.vars])
+
     def renderEvaluateModel(self):
         d = dict()
         d['keyEpetraVectorList'] = self.renderKeyEpetraVector()
         d['myKeyMethod'] = self.d['myKeyMethod']
         d['myMethodArgs'] = self.renderMyMethodArgs()
+        d['kernelArgs'] = self.renderKernelArgs()
+        if self.kernel:
+            return render('evaluator_evaluateModelKernel.cc', d)
         return render('evaluator_evaluateModel.cc', d)
 
     def renderEvaluateDerivs(self):
@@ -114,18 +126,24 @@ class EvalGen(object):
             d['myKeyMethod'] = self.d['myKeyMethod']
             d['wrtMethod'] = ''.join([word[0].upper()+word[1:] for word in arg.split("_")])
             d['myMethodArgs'] = self.renderMyMethodArgs()
+            d['kernelArgs'] = self.renderKernelArgs()
             return d
+
+        if self.kernel:
+            tname = 'evaluator_evaluateDerivsKernel.cc'
+        else:
+            tname = 'evaluator_evaluateDerivs.cc'
         
         if len(self.args) > 0:
             d = getDict(self.args[0], self.vars[0])
             d['if_elseif'] = render('evaluator_ifWRT.cc', d)
-            wrt_list.append(render('evaluator_evaluateDerivs.cc', d))
+            wrt_list.append(render(tname, d))
 
         if len(self.args) > 1:
             for arg,var in zip(self.args[1:],self.vars[1:]):
                 d = getDict(arg,var)
                 d['if_elseif'] = render('evaluator_elseifWRT.cc', d)
-                wrt_list.append(render('evaluator_evaluateDerivs.cc', d))
+                wrt_list.append(render(tname, d))
 
         wrt_list.append('\n'.join(["  } else {",
                                    "    ASSERT(0);",
@@ -142,6 +160,15 @@ class EvalGen(object):
                                  dict(myMethod="D%sD%s"%(self.d['myKeyMethod'],''.join([word[0].upper()+word[1:] for word in arg.split("_")])),
                                       myMethodDeclarationArgs=self.d['myMethodDeclarationArgs'])) for arg in self.args])
 
+    def renderMethodDefinitionArgs(self, expr):
+        # arguments the expression does not use are left unnamed, so that
+        # derivatives which do not depend on every variable compile cleanly
+        if expr is None:
+            return self.d['myMethodDeclarationArgs']
+        used = set([str(s) for s in expr.free_symbols])
+        return ", ".join(["double %s"%var if var in used else "double /* %s */"%var
+                          for var in self.vars])
+
     def renderModelMethodImplementation(self):
         if self.expression is not None:
             implementation = ccode(self.expression)
@@ -149,7 +176,7 @@ class EvalGen(object):
             implementation = "ASSERT(False)"
         return render('model_methodImplementation.cc', dict(evalClassName=self.d['evalClassName'],
                                                             myMethod=self.d['myKeyMethod'],
-                                                            myMethodDeclarationArgs=self.d['myMethodDeclarationArgs'],
+                                                            myMethodDeclarationArgs=self.renderMethodDefinitionArgs(self.expression),
                                                             myMethodImplementation=implementation))
 
     def renderModelDerivImplementations(self):
@@ -158,13 +185,15 @@ class EvalGen(object):
         for arg,var in zip(self.args,self.vars):
             if self.expression is not None:
                 print "differentiation of", self.expression, "with respect to", var
-                implementation = ccode(self.expression.diff(var))
+                deriv = self.expression.diff(var)
+                implementation = ccode(deriv)
             else:
+                deriv = None
                 implementation = "ASSERT(False)"
             impls.append(render('model_methodImplementation.cc',
                                 dict(evalClassName=self.d['evalClassName'],
                                      myMethod="D%sD%s"%(self.d['myKeyMethod'],''.join([word[0].upper()+word[1:] for word in arg.split("_")])),
-                                     myMethodDeclarationArgs=self.d['myMethodDeclarationArgs'],
+                                     myMethodDeclarationArgs=self.renderMethodDefinitionArgs(deriv),
                                      myMethodImplementation=implementation)))
         return '\n\n'.join(impls)
     
@@ -181,6 +210,98 @@ class EvalGen(object):
 
         return '\n'.join(p_inits)
 
+    def derivMethod(self, arg):
+        return "D%sD%s"%(self.d['myKeyMethod'],''.join([word[0].upper()+word[1:] for word in arg.split("_")]))
+
+    def literalParams(self):
+        return all(p[0] in ["double", "int", "bool"] for p in self.pars)
+
+    def renderKernelDefaultConstructor(self):
+        # a literal type, so that kernels with constant parameters may be constexpr
+        if self.literalParams():
+            inits = ["%s(0)"%p[1] for p in self.pars]
+            if len(inits) > 0:
+                return "constexpr %sKernel() : %s {}"%(self.d['evalClassName'], ", ".join(inits))
+            return "constexpr %sKernel() {}"%self.d['evalClassName']
+        return "%sKernel() {}"%self.d['evalClassName']
+
+    def kernelQualifier(self, implementation):
+        # cmath functions are not constexpr, so only pure arithmetic may be
+        if self.literalParams() and re.search(r"[A-Za-z_]\w*\s*\(", implementation) is None:
+            return "constexpr"
+        return "inline"
+
+    def renderKernelPointwise(self):
+        methods = [(self.d['myKeyMethod'], self.expression)] + \
+                  [(self.derivMethod(arg), self.expression.diff(var)) for arg,var in zip(self.args,self.vars)]
+        pointwise = []
+        for method,expr in methods:
+            implementation = ccode(expr)
+            pointwise.append(render('kernel_pointwise.hh',
+                                    dict(kernelQualifier=self.kernelQualifier(implementation),
+                                         myMethod=method,
+                                         myMethodDeclarationArgs=self.renderMethodDefinitionArgs(expr),
+                                         myMethodImplementation=implementation)))
+        return '\n\n'.join(pointwise)
+
+    def renderKernelLoops(self):
+        methods = [self.d['myKeyMethod'],] + [self.derivMethod(arg) for arg in self.args]
+        return '\n\n'.join([render('kernel_loop.hh',
+                                   dict(myMethod=method,
+                                        kernelLoopDeclarationArgs=self.d['kernelLoopDeclarationArgs'],
+                                        kernelLoopArgs=", ".join(["%s_v[kernel_i]"%var for var in self.vars])))
+                             for method in methods])
+
+    def renderKernelFusedBody(self):
+        # common subexpressions are shared by the value and all derivatives
+        exprs = [self.expression,] + [self.expression.diff(var) for var in self.vars]
+        replacements, reduced = sympy.cse(exprs, symbols=sympy.numbered_symbols("cse"))
+
+        used = set([str(s) for e in exprs for s in e.free_symbols])
+        lines = ["      const double %s = %s_v[kernel_i];"%(var,var) for var in self.vars if var in used]
+        lines.extend(["      const double %s = %s;"%(sym, ccode(expr)) for sym,expr in replacements])
+        lines.append("      result[kernel_i] = %s;"%ccode(reduced[0]))
+        lines.extend(["      result_d%s[kernel_i] = %s;"%(var, ccode(expr)) for var,expr in zip(self.vars, reduced[1:])])
+        return '\n'.join(lines)
+
+    def renderBenchmarkParams(self):
+        lines = []
+        for p, pdefault in zip(self.pars, self.par_defaults):
+            if p[0] in ["double", "int"]:
+                if pdefault is None: pdefault = 1
+                lines.append("  kernel.%s = %s;"%(p[1], str(pdefault)))
+        return '\n'.join(lines)
+
+    def genKernelArgs(self):
+        self.d['kernelInclude'] = '\n#include "%s_kernel.hh"'%self.d['evalName']
+        self.d['kernelDeclaration'] = '\n  %sKernel kernel_;'%self.d['evalClassName']
+        self.d['kernelConstruct'] = '\n  kernel_ = %sKernel(sublist);'%self.d['evalClassName']
+        self.d['kernelCopy'] = ',\n    kernel_(other.kernel_)'
+
+        self.d['kernelLoopDeclarationArgs'] = ", ".join(["const double* ATS_RESTRICT %s_v"%var for var in self.vars])
+        self.d['kernelFusedDeclarationArgs'] = ", ".join(["double* ATS_RESTRICT result_d%s"%var for var in self.vars])
+        used = set([str(sym) for sym in self.expression.free_symbols])
+        self.d['kernelFusedInputDeclarationArgs'] = ", ".join(
+            ["const double* ATS_RESTRICT %s_v"%var if var in used else "const double* ATS_RESTRICT /* %s_v */"%var
+             for var in self.vars])
+        self.d['kernelDefaultConstructor'] = self.renderKernelDefaultConstructor()
+        self.d['kernelInitializeParamsList'] = '\n'.join(['  '+line for line in self.d['modelInitializeParamsList'].split('\n')])
+        self.d['kernelPointwiseList'] = self.renderKernelPointwise()
+        self.d['kernelLoopList'] = self.renderKernelLoops()
+        self.d['kernelFusedBody'] = self.renderKernelFusedBody()
+
+        # microbenchmark
+        self.d['benchParamList'] = self.renderBenchmarkParams()
+        self.d['benchInputList'] = '\n'.join(["  std::vector<double> %s(bench_n);\n  for (int bench_i=0; bench_i!=bench_n; ++bench_i) %s[bench_i] = 1. + (double) bench_i / bench_n;"%(var,var) for var in self.vars])
+        self.d['benchOutputList'] = '\n'.join(["  std::vector<double> result_d%s(bench_n);"%var for var in self.vars])
+        self.d['benchArgs'] = ", ".join(["%s.data()"%var for var in self.vars])
+        self.d['benchFusedArgs'] = ", ".join(["result_d%s.data()"%var for var in self.vars])
+        self.d['benchChecksum'] = ''.join([" + result_d%s[bench_i]"%var for var in self.vars])
+        self.d['benchDerivList'] = '\n'.join([render('benchmark_deriv.cc',
+                                                    dict(var=var, myMethod=self.derivMethod(arg),
+                                                         benchArgs=self.d['benchArgs']))
+                                             for arg,var in zip(self.args,self.vars)])
+
     def genArgs(self):
         # dependencies
         self.d['keyDeclarationList'] = self.renderKeyDeclaration()
@@ -201,6 +322,12 @@ class EvalGen(object):
         self.d['modelDerivImplementationList'] = self.renderModelDerivImplementations()
         self.d['modelInitializeParamsList'] = self.renderModelParamInitializations()
 
+        if self.kernel:
+            self.genKernelArgs()
+        else:
+            for key in ['kernelInclude', 'kernelDeclaration', 'kernelConstruct', 'kernelCopy']:
+                self.d[key] = ''
+
 def generate_evaluator(name, namespace, descriptor, my_key, dependencies, parameters, **kwargs):
     """Generates an evaluator whose class is [name]Evaluator and model is [name]Model.
 
@@ -231,12 +358,21 @@ def generate_evaluator(name, namespace, descriptor, my_key, dependencies, parame
 
       directory: directory where output files are created
 
+      expression: sympy expression of the model, in terms of the dependencies' variable
+                  names and the parameters' names (with trailing underscore)
+
+      kernel: if True, also generate a header-only kernel which the evaluator uses in
+              vectorizable loops, and a microbenchmark of that kernel.  Requires an
+              expression, and defaults to True if one is provided.
+
     Outputs:
       writes files: [name]_evaluator.hh
                     [name]_evaluator.cc
                     [name]_evaluator_reg.hh
                     [name]_model.hh
                     [name]_model.cc
+                    [name]_kernel.hh      (if kernel)
+                    [name]_benchmark.cc   (if kernel)
     """
     eg = EvalGen(name, namespace, descriptor, my_key, **kwargs)
     for dep in dependencies:
@@ -256,6 +392,8 @@ def generate_evaluator(name, namespace, descriptor, my_key, dependencies, parame
         directory = "."
 
     files = ["evaluator.hh", "evaluator.cc", "evaluator_reg.hh", "model.hh", "model.cc"]
+    if eg.kernel:
+        files.extend(["kernel.hh", "benchmark.cc"])
     for outfile in files:
         with open(os.path.join(directory, "%s_%s"%(name,outfile)), 'w') as fid:
             fid.write(render(outfile, eg.d))
@@ -0,0 +1,63 @@
+/*
+  Microbenchmark of the {evalNameString} kernel.
+
+  Generated via evaluator_generator.  Compile with optimization against the
+  Teuchos headers and libraries, e.g.
+
+    c++ -O3 -march=native -std=c++11 -I$TRILINOS_DIR/include \
+        {evalName}_benchmark.cc -L$TRILINOS_DIR/lib -lteuchosparameterlist -lteuchoscore
+
+  and run as:  ./{evalName}_benchmark [number of entries] [number of repeats]
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "{evalName}_kernel.hh"
+
+using namespace Amanzi::{namespace}::Relations;
+
+// seconds per entry of f(), averaged over nrep calls
+template<typename F>
+double TimeLoop(F f, int n, int nrep)
+{{
+  f();
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int r=0; r!=nrep; ++r) f();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / ((double) n * nrep);
+}}
+
+
+int main(int argc, char* argv[])
+{{
+  int bench_n = argc > 1 ? std::atoi(argv[1]) : 100000;
+  int bench_nrep = argc > 2 ? std::atoi(argv[2]) : 100;
+
+  {evalClassName}Kernel kernel;
+{benchParamList}
+
+{benchInputList}
+  std::vector<double> result(bench_n);
+{benchOutputList}
+
+  double t_value = TimeLoop([&]() {{
+      kernel.{myKeyMethod}(bench_n, {benchArgs}, result.data()); }}, bench_n, bench_nrep);
+  std::printf("{myKeyMethod}: %g ns/entry\n", 1.e9 * t_value);
+
+  double t_separate = t_value;
+{benchDerivList}
+
+  double t_fused = TimeLoop([&]() {{
+      kernel.{myKeyMethod}AndDerivatives(bench_n, {benchArgs}, result.data(), {benchFusedArgs}); }}, bench_n, bench_nrep);
+  std::printf("value + derivatives, separate loops: %g ns/entry\n", 1.e9 * t_separate);
+  std::printf("value + derivatives, fused loop: %g ns/entry\n", 1.e9 * t_fused);
+
+  // use the results so the loops are not optimized away
+  double sum = 0.;
+  for (int bench_i=0; bench_i!=bench_n; ++bench_i) sum += result[bench_i]{benchChecksum};
+  std::printf("checksum: %g\n", sum);
+  return 0;
+}}
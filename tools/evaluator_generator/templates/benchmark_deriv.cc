@@ -0,0 +1,4 @@
+  double t_{var} = TimeLoop([&]() {{
+      kernel.{myMethod}(bench_n, {benchArgs}, result_d{var}.data()); }}, bench_n, bench_nrep);
+  std::printf("{myMethod}: %g ns/entry\n", 1.e9 * t_{var});
+  t_separate += t_{var};
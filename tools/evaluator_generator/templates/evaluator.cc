@@ -16,7 +16,7 @@ namespace Relations {{
     SecondaryVariableFieldEvaluator(plist)
 {{
   Teuchos::ParameterList& sublist = plist_.sublist("{evalName} parameters");
-  model_ = Teuchos::rcp(new {evalClassName}Model(sublist));
+  model_ = Teuchos::rcp(new {evalClassName}Model(sublist));{kernelConstruct}
   InitializeFromPlist_();
 }}
 
@@ -25,7 +25,7 @@ namespace Relations {{
 {evalClassName}Evaluator::{evalClassName}Evaluator(const {evalClassName}Evaluator& other) :
     SecondaryVariableFieldEvaluator(other),
 {keyCopyConstructorList}    
-    model_(other.model_) {{}}
+    model_(other.model_){kernelCopy} {{}}
 
 
 // Virtual copy constructor
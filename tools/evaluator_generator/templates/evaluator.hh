@@ -11,7 +11,7 @@
 #define AMANZI_{namespaceCaps}_{evalNameCaps}_EVALUATOR_HH_
 
 #include "factory.hh"
-#include "secondary_variable_field_evaluator.hh"
+#include "secondary_variable_field_evaluator.hh"{kernelInclude}
 
 namespace Amanzi {{
 namespace {namespace} {{
@@ -41,7 +41,7 @@ class {evalClassName}Evaluator : public SecondaryVariableFieldEvaluator {{
 
 {keyDeclarationList}
 
-  Teuchos::RCP<{evalClassName}Model> model_;
+  Teuchos::RCP<{evalClassName}Model> model_;{kernelDeclaration}
 
  private:
   static Utils::RegisteredFactory<FieldEvaluator,{evalClassName}Evaluator> reg_;
@@ -0,0 +1,59 @@
+/*
+  The {evalNameString} kernel is a header-only version of the
+  {evalNameString} model, written to be inlined into vectorizable loops.
+
+  Generated via evaluator_generator with:
+{docDict}
+    
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#ifndef AMANZI_{namespaceCaps}_{evalNameCaps}_KERNEL_HH_
+#define AMANZI_{namespaceCaps}_{evalNameCaps}_KERNEL_HH_
+
+#include <cmath>
+#include "Teuchos_ParameterList.hpp"
+
+#ifndef ATS_RESTRICT
+#if defined(__GNUC__) || defined(__clang__) || defined(__INTEL_COMPILER)
+#define ATS_RESTRICT __restrict__
+#else
+#define ATS_RESTRICT
+#endif
+#endif
+
+namespace Amanzi {{
+namespace {namespace} {{
+namespace Relations {{
+
+struct {evalClassName}Kernel {{
+
+  {kernelDefaultConstructor}
+
+  explicit
+  {evalClassName}Kernel(Teuchos::ParameterList& plist) {{
+{kernelInitializeParamsList}
+  }}
+
+  // pointwise evaluation
+{kernelPointwiseList}
+
+  // loops over kernel_n entries, the arrays must not alias
+{kernelLoopList}
+
+  // value and all derivatives in one pass, sharing common subexpressions
+  void {myKeyMethod}AndDerivatives(int kernel_n, {kernelFusedInputDeclarationArgs},
+          double* ATS_RESTRICT result, {kernelFusedDeclarationArgs}) const {{
+    for (int kernel_i=0; kernel_i!=kernel_n; ++kernel_i) {{
+{kernelFusedBody}
+    }}
+  }}
+
+{paramDeclarationList}
+}};
+
+}} //namespace
+}} //namespace
+}} //namespace
+
+#endif
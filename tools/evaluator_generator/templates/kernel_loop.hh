@@ -0,0 +1,6 @@
+  void {myMethod}(int kernel_n, {kernelLoopDeclarationArgs},
+          double* ATS_RESTRICT result) const {{
+    for (int kernel_i=0; kernel_i!=kernel_n; ++kernel_i) {{
+      result[kernel_i] = {myMethod}({kernelLoopArgs});
+    }}
+  }}
@@ -0,0 +1,3 @@
+  {kernelQualifier} double {myMethod}({myMethodDeclarationArgs}) const {{
+    return {myMethodImplementation};
+  }}
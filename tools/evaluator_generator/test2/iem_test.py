@@ -8,7 +8,7 @@ params = [("cv", "double", "heat capacity"),
 
 import sympy
 cv, T0 = sympy.var("cv_,T0_")
-p, T = sympy.var("pres,temp")
+pres, temp = sympy.var("pres,temp")
 expression = cv * (temp-T0)
 
 
@@ -0,0 +1,75 @@
+/*
+  Microbenchmark of the ideal gas equation of state kernel.
+
+  Generated via evaluator_generator.  Compile with optimization against the
+  Teuchos headers and libraries, e.g.
+
+    c++ -O3 -march=native -std=c++11 -I$TRILINOS_DIR/include \
+        eos_ideal_gas_benchmark.cc -L$TRILINOS_DIR/lib -lteuchosparameterlist -lteuchoscore
+
+  and run as:  ./eos_ideal_gas_benchmark [number of entries] [number of repeats]
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "eos_ideal_gas_kernel.hh"
+
+using namespace Amanzi::General::Relations;
+
+// seconds per entry of f(), averaged over nrep calls
+template<typename F>
+double TimeLoop(F f, int n, int nrep)
+{
+  f();
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int r=0; r!=nrep; ++r) f();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / ((double) n * nrep);
+}
+
+
+int main(int argc, char* argv[])
+{
+  int bench_n = argc > 1 ? std::atoi(argv[1]) : 100000;
+  int bench_nrep = argc > 2 ? std::atoi(argv[2]) : 100;
+
+  EosIdealGasKernel kernel;
+  kernel.cv_ = 1;
+  kernel.T0_ = 1;
+
+  std::vector<double> temp(bench_n);
+  for (int bench_i=0; bench_i!=bench_n; ++bench_i) temp[bench_i] = 1. + (double) bench_i / bench_n;
+  std::vector<double> pres(bench_n);
+  for (int bench_i=0; bench_i!=bench_n; ++bench_i) pres[bench_i] = 1. + (double) bench_i / bench_n;
+  std::vector<double> result(bench_n);
+  std::vector<double> result_dtemp(bench_n);
+  std::vector<double> result_dpres(bench_n);
+
+  double t_value = TimeLoop([&]() {
+      kernel.Density(bench_n, temp.data(), pres.data(), result.data()); }, bench_n, bench_nrep);
+  std::printf("Density: %g ns/entry\n", 1.e9 * t_value);
+
+  double t_separate = t_value;
+  double t_temp = TimeLoop([&]() {
+      kernel.DDensityDTemperature(bench_n, temp.data(), pres.data(), result_dtemp.data()); }, bench_n, bench_nrep);
+  std::printf("DDensityDTemperature: %g ns/entry\n", 1.e9 * t_temp);
+  t_separate += t_temp;
+  double t_pres = TimeLoop([&]() {
+      kernel.DDensityDPressure(bench_n, temp.data(), pres.data(), result_dpres.data()); }, bench_n, bench_nrep);
+  std::printf("DDensityDPressure: %g ns/entry\n", 1.e9 * t_pres);
+  t_separate += t_pres;
+
+  double t_fused = TimeLoop([&]() {
+      kernel.DensityAndDerivatives(bench_n, temp.data(), pres.data(), result.data(), result_dtemp.data(), result_dpres.data()); }, bench_n, bench_nrep);
+  std::printf("value + derivatives, separate loops: %g ns/entry\n", 1.e9 * t_separate);
+  std::printf("value + derivatives, fused loop: %g ns/entry\n", 1.e9 * t_fused);
+
+  // use the results so the loops are not optimized away
+  double sum = 0.;
+  for (int bench_i=0; bench_i!=bench_n; ++bench_i) sum += result[bench_i] + result_dtemp[bench_i] + result_dpres[bench_i];
+  std::printf("checksum: %g\n", sum);
+  return 0;
+}
@@ -17,6 +17,7 @@ EosIdealGasEvaluator::EosIdealGasEvaluator(Teuchos::ParameterList& plist) :
 {
   Teuchos::ParameterList& sublist = plist_.sublist("eos_ideal_gas parameters");
   model_ = Teuchos::rcp(new EosIdealGasModel(sublist));
+  kernel_ = EosIdealGasKernel(sublist);
   InitializeFromPlist_();
 }
 
@@ -26,7 +27,8 @@ EosIdealGasEvaluator::EosIdealGasEvaluator(const EosIdealGasEvaluator& other) :
     SecondaryVariableFieldEvaluator(other),
     temp_key_(other.temp_key_),
     pres_key_(other.pres_key_),    
-    model_(other.model_) {}
+    model_(other.model_),
+    kernel_(other.kernel_) {}
 
 
 // Virtual copy constructor
@@ -72,9 +74,7 @@ Teuchos::RCP<const CompositeVector> pres = S->GetFieldData(pres_key_);
     Epetra_MultiVector& result_v = *result->ViewComponent(*comp,false);
 
     int ncomp = result->size(*comp, false);
-    for (int i=0; i!=ncomp; ++i) {
-      result_v[0][i] = model_->Density(temp_v[0][i], pres_v[0][i]);
-    }
+    kernel_.Density(ncomp, temp_v[0], pres_v[0], result_v[0]);
   }
 }
 
@@ -94,9 +94,7 @@ Teuchos::RCP<const CompositeVector> pres = S->GetFieldData(pres_key_);
       Epetra_MultiVector& result_v = *result->ViewComponent(*comp,false);
 
       int ncomp = result->size(*comp, false);
-      for (int i=0; i!=ncomp; ++i) {
-        result_v[0][i] = model_->DDensityDTemperature(temp_v[0][i], pres_v[0][i]);
-      }
+      kernel_.DDensityDTemperature(ncomp, temp_v[0], pres_v[0], result_v[0]);
     }
 
   } else if (wrt_key == pres_key_) {
@@ -107,9 +105,7 @@ Teuchos::RCP<const CompositeVector> pres = S->GetFieldData(pres_key_);
       Epetra_MultiVector& result_v = *result->ViewComponent(*comp,false);
 
       int ncomp = result->size(*comp, false);
-      for (int i=0; i!=ncomp; ++i) {
-        result_v[0][i] = model_->DDensityDPressure(temp_v[0][i], pres_v[0][i]);
-      }
+      kernel_.DDensityDPressure(ncomp, temp_v[0], pres_v[0], result_v[0]);
     }
 
   } else {
@@ -12,6 +12,7 @@
 
 #include "factory.hh"
 #include "secondary_variable_field_evaluator.hh"
+#include "eos_ideal_gas_kernel.hh"
 
 namespace Amanzi {
 namespace General {
@@ -43,6 +44,7 @@ class EosIdealGasEvaluator : public SecondaryVariableFieldEvaluator {
   Key pres_key_;
 
   Teuchos::RCP<EosIdealGasModel> model_;
+  EosIdealGasKernel kernel_;
 
  private:
   static Utils::RegisteredFactory<FieldEvaluator,EosIdealGasEvaluator> reg_;
@@ -0,0 +1,93 @@
+/*
+  The ideal gas equation of state kernel is a header-only version of the
+  ideal gas equation of state model, written to be inlined into vectorizable loops.
+
+  Generated via evaluator_generator with:
+
+    
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#ifndef AMANZI_GENERAL_EOS_IDEAL_GAS_KERNEL_HH_
+#define AMANZI_GENERAL_EOS_IDEAL_GAS_KERNEL_HH_
+
+#include <cmath>
+#include "Teuchos_ParameterList.hpp"
+
+#ifndef ATS_RESTRICT
+#if defined(__GNUC__) || defined(__clang__) || defined(__INTEL_COMPILER)
+#define ATS_RESTRICT __restrict__
+#else
+#define ATS_RESTRICT
+#endif
+#endif
+
+namespace Amanzi {
+namespace General {
+namespace Relations {
+
+struct EosIdealGasKernel {
+
+  constexpr EosIdealGasKernel() : cv_(0), T0_(0) {}
+
+  explicit
+  EosIdealGasKernel(Teuchos::ParameterList& plist) {
+    cv_ = plist.get<double>("heat capacity");
+    T0_ = plist.get<double>("reference temperature [K]");
+  }
+
+  // pointwise evaluation
+  constexpr double Density(double temp, double /* pres */) const {
+    return cv_*(-T0_ + temp);
+  }
+
+  constexpr double DDensityDTemperature(double /* temp */, double /* pres */) const {
+    return cv_;
+  }
+
+  constexpr double DDensityDPressure(double /* temp */, double /* pres */) const {
+    return 0;
+  }
+
+  // loops over kernel_n entries, the arrays must not alias
+  void Density(int kernel_n, const double* ATS_RESTRICT temp_v, const double* ATS_RESTRICT pres_v,
+          double* ATS_RESTRICT result) const {
+    for (int kernel_i=0; kernel_i!=kernel_n; ++kernel_i) {
+      result[kernel_i] = Density(temp_v[kernel_i], pres_v[kernel_i]);
+    }
+  }
+
+  void DDensityDTemperature(int kernel_n, const double* ATS_RESTRICT temp_v, const double* ATS_RESTRICT pres_v,
+          double* ATS_RESTRICT result) const {
+    for (int kernel_i=0; kernel_i!=kernel_n; ++kernel_i) {
+      result[kernel_i] = DDensityDTemperature(temp_v[kernel_i], pres_v[kernel_i]);
+    }
+  }
+
+  void DDensityDPressure(int kernel_n, const double* ATS_RESTRICT temp_v, const double* ATS_RESTRICT pres_v,
+          double* ATS_RESTRICT result) const {
+    for (int kernel_i=0; kernel_i!=kernel_n; ++kernel_i) {
+      result[kernel_i] = DDensityDPressure(temp_v[kernel_i], pres_v[kernel_i]);
+    }
+  }
+
+  // value and all derivatives in one pass, sharing common subexpressions
+  void DensityAndDerivatives(int kernel_n, const double* ATS_RESTRICT temp_v, const double* ATS_RESTRICT /* pres_v */,
+          double* ATS_RESTRICT result, double* ATS_RESTRICT result_dtemp, double* ATS_RESTRICT result_dpres) const {
+    for (int kernel_i=0; kernel_i!=kernel_n; ++kernel_i) {
+      const double temp = temp_v[kernel_i];
+      result[kernel_i] = cv_*(-T0_ + temp);
+      result_dtemp[kernel_i] = cv_;
+      result_dpres[kernel_i] = 0;
+    }
+  }
+
+  double cv_;
+  double T0_;
+};
+
+} //namespace
+} //namespace
+} //namespace
+
+#endif
@@ -0,0 +1,86 @@
+#include "extrudeMesh3D.hh"
+#include "readMesh2D.hh"
+#include <cfloat>
+#include <cstdlib>
+
+//
+// extrude_variable, but streamed to disk a layer at a time.
+//
+// Usage: extrude_variable_streaming [nthreads [nparts]]
+//
+// With nparts > 1, writes nparts pre-partitioned files instead of one.
+//
+
+using namespace Amanzi::AmanziGeometry;
+
+// The soil layers of extrude_variable, recomputed from the soil depths on each
+// pass over the layers.
+struct VariableSoilLayers : public LayerGenerator {
+  std::vector<double> ref_soil_mlay_dz = {2.0e-2, 6.0e-2, 1.2e-1, 2.5e-1, 5.5e-1, 0.5e1};
+  std::vector<double> ref_bedrock_mlay_dz = {0.5e1, 1.5e1};
+  double eps_dz = 1.0e-3;
+
+  std::vector<int> soil_type;
+  std::vector<int> bedrock_type;
+  std::vector<double> depths;
+  std::vector<double> rem_soil;
+
+  int size() const {
+    return ref_soil_mlay_dz.size() + ref_bedrock_mlay_dz.size();
+  }
+
+  void layer(int ilay, std::vector<double>& dzs, std::vector<int>& block_ids) {
+    int nsoil_lay = ref_soil_mlay_dz.size();
+    int nsnodes = depths.size();
+    if (ilay == 0) rem_soil = depths;
+
+    if (ilay >= nsoil_lay) {
+      dzs.assign(nsnodes, ref_bedrock_mlay_dz[ilay - nsoil_lay]);
+      block_ids = bedrock_type;
+      return;
+    }
+
+    dzs.assign(nsnodes, 0.0);
+    for (int inode = 0; inode < nsnodes; inode++) {
+      if (rem_soil[inode] < eps_dz) {
+        dzs[inode] = 0.0;
+        continue;
+      }
+      if (rem_soil[inode] > 2*ref_soil_mlay_dz[ilay])
+        dzs[inode] = ref_soil_mlay_dz[ilay];
+      else if (rem_soil[inode] > ref_soil_mlay_dz[ilay] + eps_dz)
+        dzs[inode] = 0.5*rem_soil[inode];
+      else if (rem_soil[inode] < ref_soil_mlay_dz[ilay] - eps_dz)
+        dzs[inode] = rem_soil[inode];
+      else
+        dzs[inode] = ref_soil_mlay_dz[ilay];
+
+      rem_soil[inode] -= dzs[inode];
+    }
+    block_ids = soil_type;
+  }
+};
+
+
+int main(int argc, char** argv) {
+  std::string mesh_in = "Mesh.txt";
+  std::string mesh_out = "Mesh3D_VariableSoilStreaming.exo";
+
+  int nthreads = argc > 1 ? std::atoi(argv[1]) : 0;
+  int nparts = argc > 2 ? std::atoi(argv[2]) : 1;
+
+  std::cout << "Extruding: " << mesh_in << " and writing to: " << mesh_out << std::endl;
+
+  VariableSoilLayers layers;
+  auto m = readMesh2D_text(mesh_in, layers.soil_type, layers.bedrock_type, layers.depths);
+
+  std::cout << "NNodes on the surf = " << m.coords.size() << std::endl;
+  std::cout << "Ncells on the surf = " << m.cell2node.size() << std::endl;
+
+  if (nparts > 1) {
+    extrudeMesh3D_exodus_par(m, layers, mesh_out, nparts, nthreads);
+  } else {
+    extrudeMesh3D_exodus(m, layers, mesh_out, nthreads);
+  }
+  return 0;
+}
@@ -70,8 +70,8 @@ Mesh2D::Mesh2D(std::vector<Point>& coords_,
     x += p[0];
     y += p[1];
   }
-  datum[0] = x / coords.size();
-  datum[1] = y / coords.size();
+  datum[0] = x / static_cast<int64_t>(coords.size());
+  datum[1] = y / static_cast<int64_t>(coords.size());
   for (auto& p : coords) {
     p[0] -= datum[0];
     p[1] -= datum[1];
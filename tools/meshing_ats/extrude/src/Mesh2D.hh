@@ -21,7 +21,7 @@ struct Mesh2D {
                        int face_in_cell,
                        int cell);
 
-  int64_t hash(int i, int j) {
+  int64_t hash(int i, int j) const {
     return ((int64_t) (nnodes+1))*((int64_t) i) + (int64_t) j;
   }
   
@@ -0,0 +1,939 @@
+#include <cstdio>
+#include <set>
+#include <map>
+#include <thread>
+#include <numeric>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include "exodusII.h"
+#include "netcdf.h"
+
+#include "dbc.hh"
+
+#include "partitionMesh2D.hh"
+#include "extrudeMesh3D.hh"
+
+
+namespace Amanzi {
+namespace AmanziGeometry {
+
+namespace {
+
+// Calls f(t, begin, end) on nthreads threads, for contiguous chunks t of
+// [0,n).  The chunks depend only on n and nthreads.
+template<typename F>
+void
+forChunks(int n, int nthreads, const F& f) {
+  auto bound = [n,nthreads](int t) { return (int) (((int64_t) n)*t / nthreads); };
+  std::vector<std::thread> threads;
+  for (int t=1; t<nthreads; ++t) {
+    threads.emplace_back([&f,&bound,t]() { f(t, bound(t), bound(t+1)); });
+  }
+  f(0, bound(0), bound(1));
+  for (auto& th : threads) th.join();
+}
+
+
+// Entities created by one layer, in a chunk of surface cells.
+struct LayerCounts {
+  int64_t nodes, faces, face_entries, cells, cell_entries, sides;
+  // block id --> cells, face entries of those cells
+  std::map<int, std::pair<int64_t,int64_t> > blocks;
+
+  LayerCounts() : nodes(0), faces(0), face_entries(0), cells(0), cell_entries(0), sides(0) {}
+
+  void add(const LayerCounts& other) {
+    nodes += other.nodes;
+    faces += other.faces;
+    face_entries += other.face_entries;
+    cells += other.cells;
+    cell_entries += other.cell_entries;
+    sides += other.sides;
+    for (auto& b : other.blocks) {
+      blocks[b.first].first += b.second.first;
+      blocks[b.first].second += b.second.second;
+    }
+  }
+};
+
+
+//
+// Builds one layer at a time, with the same topology and numbering as
+// Mesh3D::extrude().  Which entities a layer creates depends only on which of
+// its nodes move, so a layer is first counted, by chunk of surface nodes and
+// cells, and then filled at the resulting offsets.  Each side face is
+// created by the lowest numbered cell that contains it, which is the cell
+// that created it in the 2D mesh, so chunks never need to agree on faces.
+//
+class LayerExtruder {
+ public:
+  LayerExtruder(const Mesh2D& m, int nthreads, bool squash_zero_edges) :
+      m_(m),
+      nthreads_(nthreads),
+      squash_(squash_zero_edges),
+      moves_(m.nnodes, 0),
+      exists_(m.ncells, 0),
+      up_nodes_(m.nnodes),
+      dn_nodes_(m.nnodes),
+      up_faces_(m.ncells),
+      dn_faces_(m.ncells, -1),
+      side_faces_(m.nfaces, -1),
+      z_(m.nnodes),
+      node_chunks_(nthreads),
+      cell_chunks_(nthreads)
+  {
+    std::iota(up_nodes_.begin(), up_nodes_.end(), 0);
+    std::iota(up_faces_.begin(), up_faces_.end(), 0);
+    for (int n=0; n!=m.nnodes; ++n) z_[n] = m.coords[n][2];
+  }
+
+  // Flags the moving nodes and existing cells of a layer, and counts what the
+  // layer creates.
+  const LayerCounts& count(const std::vector<double>& dz,
+                           const std::vector<int>& block_ids) {
+    ASSERT(dz.size() == m_.nnodes);
+    ASSERT(block_ids.size() == m_.ncells);
+
+    forChunks(m_.nnodes, nthreads_, [&](int t, int nb, int ne) {
+        int64_t count = 0;
+        for (int n=nb; n!=ne; ++n) {
+          moves_[n] = !squash_ || dz[n] > 0.;
+          count += moves_[n];
+        }
+        node_chunks_[t] = count;
+      });
+
+    forChunks(m_.ncells, nthreads_, [&](int t, int cb, int ce) {
+        LayerCounts& counts = cell_chunks_[t];
+        counts = LayerCounts();
+        for (int c=cb; c!=ce; ++c) {
+          const auto& nodes = m_.cell2node[c];
+          exists_[c] = std::any_of(nodes.begin(), nodes.end(),
+                                   [this](int n) { return moves_[n]; });
+          if (!exists_[c]) continue;
+
+          counts.cells++;
+          counts.faces++;
+          counts.face_entries += nodes.size();
+          int64_t cell_entries = 2;
+          for (auto sf : m_.cell2face[c]) {
+            int nmoving = moves_[m_.face2node[sf][0]] + moves_[m_.face2node[sf][1]];
+            if (nmoving == 0) continue;
+            cell_entries++;
+            if (m_.face_cell_when_created[sf] == c) {
+              counts.faces++;
+              counts.face_entries += 2 + nmoving;
+              if (m_.side_face_counts[sf] == 1) counts.sides++;
+            }
+          }
+          counts.cell_entries += cell_entries;
+          auto& block = counts.blocks[block_ids[c]];
+          block.first++;
+          block.second += cell_entries;
+        }
+      });
+
+    totals_ = LayerCounts();
+    for (auto count : node_chunks_) totals_.nodes += count;
+    for (auto& counts : cell_chunks_) totals_.add(counts);
+    return totals_;
+  }
+
+  bool exists(int c) const { return exists_[c]; }
+
+  // Fills the layer last counted.  Its first node and face are numbered
+  // node_start and face_start, and columns whose last cell is in this layer
+  // get an outward (reversed) bottom face.
+  void build(const std::vector<double>& dz,
+             int64_t node_start, int64_t face_start, int layer,
+             const std::vector<int>& bottom_layer,
+             const std::vector<int>& block_ids,
+             const std::map<int,int>& block_index) {
+    x.resize(totals_.nodes);
+    y.resize(totals_.nodes);
+    z.resize(totals_.nodes);
+    face_counts.resize(totals_.faces);
+    face_nodes.resize(totals_.face_entries);
+    cell_cols.resize(totals_.cells);
+    cell_blocks.resize(totals_.cells);
+    cell_counts.resize(totals_.cells);
+    cell_faces.resize(totals_.cell_entries);
+    sides.resize(totals_.sides);
+
+    // chunk offsets
+    std::vector<int64_t> node_pos(nthreads_, 0);
+    std::vector<LayerCounts> cell_pos(nthreads_);
+    for (int t=1; t<nthreads_; ++t) {
+      node_pos[t] = node_pos[t-1] + node_chunks_[t-1];
+      cell_pos[t] = cell_pos[t-1];
+      cell_pos[t].add(cell_chunks_[t-1]);
+    }
+
+    // new nodes
+    forChunks(m_.nnodes, nthreads_, [&](int t, int nb, int ne) {
+        int64_t i = node_pos[t];
+        for (int n=nb; n!=ne; ++n) {
+          if (moves_[n]) {
+            z_[n] -= dz[n];
+            x[i] = m_.coords[n][0];
+            y[i] = m_.coords[n][1];
+            z[i] = z_[n];
+            dn_nodes_[n] = node_start + i;
+            i++;
+          } else {
+            dn_nodes_[n] = up_nodes_[n];
+          }
+        }
+      });
+
+    // new faces: each cell's bottom face, then the side faces it owns
+    forChunks(m_.ncells, nthreads_, [&](int t, int cb, int ce) {
+        int64_t f = cell_pos[t].faces;
+        int64_t e = cell_pos[t].face_entries;
+        for (int c=cb; c!=ce; ++c) {
+          if (!exists_[c]) continue;
+
+          const auto& nodes = m_.cell2node[c];
+          face_counts[f] = nodes.size();
+          if (bottom_layer[c] == layer) {
+            for (auto n=nodes.rbegin(); n!=nodes.rend(); ++n) face_nodes[e++] = dn_nodes_[*n];
+          } else {
+            for (auto n : nodes) face_nodes[e++] = dn_nodes_[n];
+          }
+          dn_faces_[c] = face_start + f;
+          f++;
+
+          for (auto sf : m_.cell2face[c]) {
+            if (m_.face_cell_when_created[sf] != c) continue;
+            int n0 = m_.face2node[sf][0];
+            int n1 = m_.face2node[sf][1];
+            if (!moves_[n0] && !moves_[n1]) continue;
+
+            face_counts[f] = 2 + moves_[n0] + moves_[n1];
+            face_nodes[e++] = up_nodes_[n1];
+            face_nodes[e++] = up_nodes_[n0];
+            if (moves_[n0]) face_nodes[e++] = dn_nodes_[n0];
+            if (moves_[n1]) face_nodes[e++] = dn_nodes_[n1];
+            side_faces_[sf] = face_start + f;
+            f++;
+          }
+        }
+      });
+
+    // cells: top, bottom, then side faces in 2D order
+    forChunks(m_.ncells, nthreads_, [&](int t, int cb, int ce) {
+        int64_t i = cell_pos[t].cells;
+        int64_t e = cell_pos[t].cell_entries;
+        int64_t s = cell_pos[t].sides;
+        for (int c=cb; c!=ce; ++c) {
+          if (!exists_[c]) continue;
+
+          int64_t e_begin = e;
+          cell_faces[e++] = up_faces_[c];
+          cell_faces[e++] = dn_faces_[c];
+          for (auto sf : m_.cell2face[c]) {
+            if (!moves_[m_.face2node[sf][0]] && !moves_[m_.face2node[sf][1]]) continue;
+            if (m_.side_face_counts[sf] == 1) {
+              sides[s++] = std::make_pair(i, (int) (e - e_begin));
+            }
+            cell_faces[e++] = side_faces_[sf];
+          }
+          cell_cols[i] = c;
+          cell_blocks[i] = block_index.at(block_ids[c]);
+          cell_counts[i] = e - e_begin;
+          up_faces_[c] = dn_faces_[c];
+          i++;
+        }
+      });
+
+    std::swap(up_nodes_, dn_nodes_);
+  }
+
+  // the layer built: new node coordinates, new faces (CSR, 0-based nodes), and
+  // cells (CSR, 0-based faces) in 2D order with their columns, block indices,
+  // and boundary side faces as (cell, face in cell)
+  std::vector<float> x, y, z;
+  std::vector<int> face_counts, face_nodes;
+  std::vector<int> cell_cols, cell_blocks, cell_counts, cell_faces;
+  std::vector<std::pair<int,int> > sides;
+
+ private:
+  const Mesh2D& m_;
+  int nthreads_;
+  bool squash_;
+
+  std::vector<char> moves_, exists_;
+  std::vector<int> up_nodes_, dn_nodes_;
+  std::vector<int> up_faces_;
+  std::vector<int> dn_faces_;
+  std::vector<int> side_faces_;
+  std::vector<double> z_;
+
+  std::vector<int64_t> node_chunks_;
+  std::vector<LayerCounts> cell_chunks_;
+  LayerCounts totals_;
+};
+
+
+// One part of a decomposed surface mesh, and what its file needs to know
+// about the whole: ids, and the Nemesis global sizes and maps.
+struct PartIds {
+  int part, nparts;
+
+  // the node and cell of the whole surface mesh of each 2D node and cell
+  std::vector<int> node_gids;
+  std::vector<int> cell_gids;
+
+  // the other parts holding each 2D node, and the part across each 2D face,
+  // or -1 if none
+  std::vector<std::vector<int> > node_parts;
+  std::vector<int> face_parts;
+
+  // sizes of the extrusion of the whole surface mesh
+  int64_t nnodes_global, ncells_global;
+  std::vector<int> blocks_id_global, blocks_ncells_global;
+  std::vector<int> side_sets_id_global, side_sets_size_global;
+
+  // 1-based ids, in the extrusion of the whole surface mesh, of the nodes and
+  // cells created by the layer last generated, by 2D node and cell, or 0
+  // where none is created.  Filled by SubsetLayers.
+  std::vector<int> layer_node_ids, layer_cell_ids;
+};
+
+
+// Layers of the columns of a part of the surface.  Also numbers the nodes and
+// cells of each layer as the extrusion of the whole surface does: nodes after
+// those of the layers above, in 2D order, and cells block by block, in layer
+// order within a block, and in 2D order within a layer.
+struct SubsetLayers : public LayerGenerator {
+  SubsetLayers(LayerGenerator& layers_, const Mesh2D& m_, bool squash_zero_edges,
+               const std::map<int,int64_t>& block_start_, PartIds& ids_) :
+      layers(layers_), m(m_), squash(squash_zero_edges),
+      block_start(block_start_), ids(ids_),
+      dz(m_.nnodes), block_ids(m_.ncells),
+      moves(m_.nnodes), node_ids(m_.nnodes), cell_ids(m_.ncells) {}
+
+  int size() const { return layers.size(); }
+
+  void layer(int i, std::vector<double>& sub_dz, std::vector<int>& sub_block_ids) {
+    layers.layer(i, dz, block_ids);
+    if (i == 0) {
+      next_node = m.nnodes;
+      next_cell = block_start;
+    }
+
+    for (int n=0; n!=m.nnodes; ++n) {
+      moves[n] = !squash || dz[n] > 0.;
+      node_ids[n] = moves[n] ? ++next_node : 0;
+    }
+    for (int c=0; c!=m.ncells; ++c) {
+      const auto& nodes = m.cell2node[c];
+      bool exists = std::any_of(nodes.begin(), nodes.end(),
+                                [this](int n) { return moves[n]; });
+      cell_ids[c] = exists ? ++next_cell[block_ids[c]] : 0;
+    }
+
+    sub_dz.resize(ids.node_gids.size());
+    ids.layer_node_ids.resize(ids.node_gids.size());
+    for (int n=0; n!=sub_dz.size(); ++n) {
+      sub_dz[n] = dz[ids.node_gids[n]];
+      ids.layer_node_ids[n] = node_ids[ids.node_gids[n]];
+    }
+    sub_block_ids.resize(ids.cell_gids.size());
+    ids.layer_cell_ids.resize(ids.cell_gids.size());
+    for (int c=0; c!=sub_block_ids.size(); ++c) {
+      sub_block_ids[c] = block_ids[ids.cell_gids[c]];
+      ids.layer_cell_ids[c] = cell_ids[ids.cell_gids[c]];
+    }
+  }
+
+  LayerGenerator& layers;
+  const Mesh2D& m;
+  bool squash;
+  const std::map<int,int64_t>& block_start;
+  PartIds& ids;
+
+  std::vector<double> dz;
+  std::vector<int> block_ids;
+  std::vector<char> moves;
+  std::vector<int> node_ids, cell_ids;
+  int64_t next_node;
+  std::map<int,int64_t> next_cell;
+};
+
+
+// Writes a hyperslab of a 1D integer variable defined by ex_put_block().
+void
+putIntSlab(int fid, const std::string& varname, int64_t start,
+           const std::vector<int>& data) {
+  if (data.empty()) return;
+  int varid;
+  int ierr = nc_inq_varid(fid, varname.c_str(), &varid);
+  ASSERT(!ierr);
+  size_t nc_start = start;
+  size_t nc_count = data.size();
+  ierr = nc_put_vara_int(fid, varid, &nc_start, &nc_count, &data[0]);
+  ASSERT(!ierr);
+}
+
+
+
+// Extrude m and write it to filename, as the part ids of a decomposed mesh if
+// given.
+void
+extrudeExodus(const Mesh2D& m,
+              LayerGenerator& layers,
+              const std::string& filename,
+              int nthreads,
+              bool squash_zero_edges,
+              const PartIds* ids) {
+  if (nthreads <= 0) nthreads = std::max(1, (int) std::thread::hardware_concurrency());
+  int nlayers = layers.size();
+  std::vector<double> dz;
+  std::vector<int> block_ids;
+
+  // -- counting pass: sizes of everything, and the top and bottom layer of
+  //    each column
+  LayerExtruder counter(m, nthreads, squash_zero_edges);
+  std::vector<int> top_layer(m.ncells, -1), bottom_layer(m.ncells, -1);
+  std::vector<int> cells_in_col(m.ncells, 0);
+  std::vector<int64_t> node_start(nlayers), face_start(nlayers), face_entry_start(nlayers);
+  std::map<int, std::vector<std::pair<int64_t,int64_t> > > block_layers;
+
+  int64_t nnodes = m.nnodes;
+  int64_t nfaces = m.ncells;
+  int64_t nface_entries = 0;
+  for (auto& nodes : m.cell2node) nface_entries += nodes.size();
+  int64_t nsides = 0;
+
+  // -- Nemesis: nodes of 2D nodes held by other parts are on the border, as
+  //    are the elements of columns with such nodes, counted by neighbor part
+  auto moves = [&dz,squash_zero_edges](int n) { return !squash_zero_edges || dz[n] > 0.; };
+  std::vector<char> col_border(m.ncells, 0);
+  int64_t nborder_nodes = 0, nborder_elems = 0;
+  std::map<int,int> node_cmap_counts, elem_cmap_counts;
+  auto countBorderNode = [&](int n) {
+    if (ids->node_parts[n].empty()) return;
+    nborder_nodes++;
+    for (int q : ids->node_parts[n]) node_cmap_counts[q]++;
+  };
+  if (ids) {
+    for (int c=0; c!=m.ncells; ++c) {
+      for (auto n : m.cell2node[c]) col_border[c] |= !ids->node_parts[n].empty();
+    }
+    for (int n=0; n!=m.nnodes; ++n) countBorderNode(n);
+  }
+
+  for (int lay=0; lay!=nlayers; ++lay) {
+    layers.layer(lay, dz, block_ids);
+    const LayerCounts& counts = counter.count(dz, block_ids);
+
+    if (ids) {
+      for (int n=0; n!=m.nnodes; ++n) {
+        if (moves(n)) countBorderNode(n);
+      }
+      for (int c=0; c!=m.ncells; ++c) {
+        if (!counter.exists(c)) continue;
+        nborder_elems += col_border[c];
+        for (auto sf : m.cell2face[c]) {
+          if (ids->face_parts[sf] >= 0 &&
+              (moves(m.face2node[sf][0]) || moves(m.face2node[sf][1])))
+            elem_cmap_counts[ids->face_parts[sf]]++;
+        }
+      }
+    }
+
+    for (int c=0; c!=m.ncells; ++c) {
+      if (counter.exists(c)) {
+        if (top_layer[c] < 0) top_layer[c] = lay;
+        bottom_layer[c] = lay;
+        cells_in_col[c]++;
+      }
+    }
+
+    node_start[lay] = nnodes;
+    face_start[lay] = nfaces;
+    face_entry_start[lay] = nface_entries;
+    nnodes += counts.nodes;
+    nfaces += counts.faces;
+    nface_entries += counts.face_entries;
+    nsides += counts.sides;
+    for (auto& b : counts.blocks) {
+      auto& per_layer = block_layers[b.first];
+      per_layer.resize(nlayers, std::make_pair(0,0));
+      per_layer[lay] = b.second;
+    }
+  }
+  for (int c=0; c!=m.ncells; ++c) ASSERT(top_layer[c] >= 0);
+
+  // -- every part has every block and side set of the whole mesh, if empty
+  if (ids) {
+    for (int bid : ids->blocks_id_global) {
+      block_layers[bid].resize(nlayers, std::make_pair(0,0));
+    }
+  }
+
+  // -- Exodus numbers elements block by block, in order of block id, and in
+  //    layer order within a block
+  int nblocks = block_layers.size();
+  std::map<int,int> block_index;
+  std::vector<int> blocks_id;
+  std::vector<int64_t> blocks_ncells, blocks_nentries;
+  std::vector<std::vector<int64_t> > block_cell_start(nblocks), block_entry_start(nblocks);
+  int64_t ncells = 0;
+  for (auto& b : block_layers) {
+    int lcvb = blocks_id.size();
+    block_index[b.first] = lcvb;
+    blocks_id.push_back(b.first);
+
+    int64_t block_ncells = 0, block_nentries = 0;
+    for (int lay=0; lay!=nlayers; ++lay) {
+      block_cell_start[lcvb].push_back(ncells + block_ncells);
+      block_entry_start[lcvb].push_back(block_nentries);
+      block_ncells += b.second[lay].first;
+      block_nentries += b.second[lay].second;
+    }
+    blocks_ncells.push_back(block_ncells);
+    blocks_nentries.push_back(block_nentries);
+    ncells += block_ncells;
+  }
+
+  // -- side sets: bottom, surface, sides, and the 2D cell sets on the surface
+  std::set<int> set_ids;
+  for (auto& part : m.cell_sets) set_ids.insert(part.begin(), part.end());
+  if (ids) set_ids.insert(ids->side_sets_id_global.begin()+3, ids->side_sets_id_global.end());
+  std::vector<int> side_sets_id = { 1, 2, 3 };
+  std::vector<int64_t> side_sets_size = { m.ncells, m.ncells, nsides };
+  for (int sid : set_ids) {
+    int64_t count = 0;
+    for (auto& part : m.cell_sets) count += std::count(part.begin(), part.end(), sid);
+    side_sets_id.push_back(sid);
+    side_sets_size.push_back(count);
+  }
+
+  // -- create and size the file
+  int CPU_word_size = sizeof(float);
+  int IO_Word_size = 8;
+  int fid = ex_create(filename.c_str(), EX_NOCLOBBER, &CPU_word_size, &IO_Word_size);
+  if (fid < 0) {
+    std::cerr << "Cowardly not clobbering: \"" << filename << "\" already exists." << std::endl;
+    return;
+  }
+
+  ex_init_params params;
+  sprintf(params.title, "my_mesh");
+  params.num_dim = 3;
+  params.num_nodes = nnodes;
+  params.num_edge = 0;
+  params.num_edge_blk = 0;
+  params.num_face = nfaces;
+  params.num_face_blk = 1;
+  params.num_elem = ncells;
+  params.num_elem_blk = nblocks;
+  params.num_node_maps = 0;
+  params.num_edge_maps = 0;
+  params.num_face_maps = 0;
+  params.num_elem_maps = 0;
+  params.num_side_sets = side_sets_id.size();
+  params.num_elem_sets = 0;
+  params.num_node_sets = 0;
+  params.num_face_sets = 0;
+  params.num_edge_sets = 0;
+
+  int ierr = ex_put_init_ext(fid, &params);
+  ASSERT(!ierr);
+
+  char* coord_names[3];
+  char a[10]="xcoord";
+  char b[10]="ycoord";
+  char c[10]="zcoord";
+  coord_names[0]=a;
+  coord_names[1]=b;
+  coord_names[2]=c;
+  ierr |= ex_put_coord_names(fid, coord_names);
+  ASSERT(!ierr);
+
+  // -- Nemesis: the whole mesh, and the sizes of this part's maps
+  if (ids) {
+    char ftype[2] = "p";
+    ierr |= ex_put_init_info(fid, ids->nparts, 1, ftype);
+    ierr |= ex_put_init_global(fid, ids->nnodes_global, ids->ncells_global,
+                               ids->blocks_id_global.size(), 0,
+                               ids->side_sets_id_global.size());
+    ierr |= ex_put_loadbal_param(fid, nnodes - nborder_nodes, nborder_nodes, 0,
+                                 ncells - nborder_elems, nborder_elems,
+                                 node_cmap_counts.size(), elem_cmap_counts.size(),
+                                 ids->part);
+    ASSERT(!ierr);
+
+    std::vector<int> node_cmap_ids, node_cmap_sizes, elem_cmap_ids, elem_cmap_sizes;
+    for (auto& q : node_cmap_counts) {
+      node_cmap_ids.push_back(q.first);
+      node_cmap_sizes.push_back(q.second);
+    }
+    for (auto& q : elem_cmap_counts) {
+      elem_cmap_ids.push_back(q.first);
+      elem_cmap_sizes.push_back(q.second);
+    }
+    ierr |= ex_put_cmap_params(fid, node_cmap_ids.data(), node_cmap_sizes.data(),
+                               elem_cmap_ids.data(), elem_cmap_sizes.data(), ids->part);
+    ASSERT(!ierr);
+
+    std::vector<int> blocks_id_global(ids->blocks_id_global);
+    std::vector<int> blocks_ncells_global(ids->blocks_ncells_global);
+    ierr |= ex_put_eb_info_global(fid, blocks_id_global.data(), blocks_ncells_global.data());
+    std::vector<int> side_sets_id_global(ids->side_sets_id_global);
+    std::vector<int> side_sets_size_global(ids->side_sets_size_global);
+    std::vector<int> side_sets_df_global(side_sets_id_global.size(), 0);
+    ierr |= ex_put_ss_param_global(fid, side_sets_id_global.data(),
+                                   side_sets_size_global.data(), side_sets_df_global.data());
+    ASSERT(!ierr);
+  }
+
+  // Everything is defined before any data is written, so that netCDF never
+  // has to move data to grow the header.
+  ierr |= ex_put_block(fid, EX_FACE_BLOCK, 1, "NSIDED", nfaces, nface_entries, 0,0,0);
+  ASSERT(!ierr);
+  for (int lcvb=0; lcvb!=nblocks; ++lcvb) {
+    ierr |= ex_put_block(fid, EX_ELEM_BLOCK, blocks_id[lcvb], "NFACED",
+                         blocks_ncells[lcvb], 0, 0, blocks_nentries[lcvb], 0);
+    ASSERT(!ierr);
+  }
+  for (int lcvs=0; lcvs!=side_sets_id.size(); ++lcvs) {
+    ierr |= ex_put_set_param(fid, EX_SIDE_SET, side_sets_id[lcvs], side_sets_size[lcvs], 0);
+    ASSERT(!ierr);
+  }
+
+  // The polyhedral connectivity has no partial-write call in the Exodus API,
+  // so its slabs go to the netCDF variables defined by ex_put_block() for the
+  // face block and the element block in position lcvb.
+  std::string fbconn = "fbconn1";
+  std::string fbepecnt = "fbepecnt1";
+  auto facconn = [](int lcvb) { return "facconn" + std::to_string(lcvb+1); };
+  auto ebepecnt = [](int lcvb) { return "ebepecnt" + std::to_string(lcvb+1); };
+
+  // -- the surface: level 0 nodes and the top faces
+  {
+    std::vector<float> x(m.nnodes), y(m.nnodes), z(m.nnodes);
+    for (int n=0; n!=m.nnodes; ++n) {
+      x[n] = m.coords[n][0];
+      y[n] = m.coords[n][1];
+      z[n] = m.coords[n][2];
+    }
+    ierr |= ex_put_n_coord(fid, 1, m.nnodes, &x[0], &y[0], &z[0]);
+    ASSERT(!ierr);
+
+    std::vector<int> counts, nodes;
+    for (auto& c_nodes : m.cell2node) {
+      counts.push_back(c_nodes.size());
+      for (auto n : c_nodes) nodes.push_back(n+1);
+    }
+    putIntSlab(fid, fbepecnt, 0, counts);
+    putIntSlab(fid, fbconn, 0, nodes);
+  }
+
+  // -- extrude and write layer by layer
+  LayerExtruder ext(m, nthreads, squash_zero_edges);
+  std::vector<int> top_elem(m.ncells, -1), bottom_elem(m.ncells, -1);
+  std::vector<int> sides_elem, sides_face;
+  sides_elem.reserve(nsides);
+  sides_face.reserve(nsides);
+  std::vector<int> node_map, elem_map;
+  std::vector<int> node_mapi, node_mapb, elem_mapi, elem_mapb;
+  std::map<int, std::vector<int> > node_cmaps, elem_cmaps_elem, elem_cmaps_side;
+  auto mapNode = [&](int n, int local_id) {
+    if (ids->node_parts[n].empty()) {
+      node_mapi.push_back(local_id);
+    } else {
+      node_mapb.push_back(local_id);
+      for (int q : ids->node_parts[n]) node_cmaps[q].push_back(local_id);
+    }
+  };
+  if (ids) {
+    node_map.resize(nnodes);
+    elem_map.resize(ncells);
+    for (int n=0; n!=m.nnodes; ++n) {
+      node_map[n] = ids->node_gids[n] + 1;
+      mapNode(n, n+1);
+    }
+  }
+
+  std::vector<std::vector<int> > blocks_counts(nblocks), blocks_faces(nblocks);
+  std::vector<int> elems;
+  for (int lay=0; lay!=nlayers; ++lay) {
+    layers.layer(lay, dz, block_ids);
+    ext.count(dz, block_ids);
+    ext.build(dz, node_start[lay], face_start[lay], lay, bottom_layer, block_ids, block_index);
+
+    // nodes
+    if (!ext.x.empty()) {
+      ierr |= ex_put_n_coord(fid, node_start[lay]+1, ext.x.size(),
+                             &ext.x[0], &ext.y[0], &ext.z[0]);
+      ASSERT(!ierr);
+    }
+    if (ids) {
+      int64_t i = node_start[lay];
+      for (int n=0; n!=m.nnodes; ++n) {
+        if (moves(n)) {
+          node_map[i] = ids->layer_node_ids[n];
+          mapNode(n, i+1);
+          i++;
+        }
+      }
+    }
+
+    // faces
+    for (auto& e : ext.face_nodes) e++;
+    putIntSlab(fid, fbepecnt, face_start[lay], ext.face_counts);
+    putIntSlab(fid, fbconn, face_entry_start[lay], ext.face_nodes);
+
+    // cells, gathered by block
+    for (int lcvb=0; lcvb!=nblocks; ++lcvb) {
+      blocks_counts[lcvb].clear();
+      blocks_faces[lcvb].clear();
+    }
+    elems.resize(ext.cell_cols.size());
+    int64_t e = 0;
+    for (int i=0; i!=ext.cell_cols.size(); ++i) {
+      int lcvb = ext.cell_blocks[i];
+      int col = ext.cell_cols[i];
+      elems[i] = block_cell_start[lcvb][lay] + blocks_counts[lcvb].size();
+      if (top_layer[col] == lay) top_elem[col] = elems[i];
+      if (bottom_layer[col] == lay) bottom_elem[col] = elems[i];
+      if (ids) {
+        elem_map[elems[i]] = ids->layer_cell_ids[col];
+        (col_border[col] ? elem_mapb : elem_mapi).push_back(elems[i] + 1);
+
+        // sides are numbered as the faces of the cell: top, bottom, then
+        // side faces in 2D order
+        int side = 3;
+        for (auto sf : m.cell2face[col]) {
+          if (!moves(m.face2node[sf][0]) && !moves(m.face2node[sf][1])) continue;
+          int q = ids->face_parts[sf];
+          if (q >= 0) {
+            elem_cmaps_elem[q].push_back(elems[i] + 1);
+            elem_cmaps_side[q].push_back(side);
+          }
+          side++;
+        }
+      }
+
+      blocks_counts[lcvb].push_back(ext.cell_counts[i]);
+      for (int j=0; j!=ext.cell_counts[i]; ++j) blocks_faces[lcvb].push_back(ext.cell_faces[e++] + 1);
+    }
+    for (int lcvb=0; lcvb!=nblocks; ++lcvb) {
+      int64_t block_start = block_cell_start[lcvb][0];
+      putIntSlab(fid, ebepecnt(lcvb), block_cell_start[lcvb][lay] - block_start, blocks_counts[lcvb]);
+      putIntSlab(fid, facconn(lcvb), block_entry_start[lcvb][lay], blocks_faces[lcvb]);
+    }
+
+    for (auto& side : ext.sides) {
+      sides_elem.push_back(elems[side.first]);
+      sides_face.push_back(side.second);
+    }
+
+    std::cout << "POST-Extruding: layer " << lay << " wrote " << ext.cell_cols.size()
+              << " cells and " << ext.face_counts.size() << " faces." << std::endl;
+  }
+
+  // -- side sets, as 1-based elements and faces
+  std::vector<std::vector<int> > side_sets_elems, side_sets_faces;
+  side_sets_elems.push_back(bottom_elem);
+  side_sets_faces.emplace_back(m.ncells, 2);
+  side_sets_elems.push_back(top_elem);
+  side_sets_faces.emplace_back(m.ncells, 1);
+  side_sets_elems.emplace_back(std::move(sides_elem));
+  side_sets_faces.emplace_back(std::move(sides_face));
+  for (auto& f : side_sets_faces.back()) f++;
+  for (int sid : set_ids) {
+    std::vector<int> set_elems;
+    for (auto& part : m.cell_sets) {
+      for (int col=0; col!=part.size(); ++col) {
+        if (part[col] == sid) set_elems.push_back(top_elem[col]);
+      }
+    }
+    side_sets_faces.emplace_back(set_elems.size(), 1);
+    side_sets_elems.emplace_back(std::move(set_elems));
+  }
+
+  for (int lcvs=0; lcvs!=side_sets_id.size(); ++lcvs) {
+    for (auto& elem : side_sets_elems[lcvs]) elem++;
+    if (side_sets_elems[lcvs].empty()) continue;
+    ierr |= ex_put_set(fid, EX_SIDE_SET, side_sets_id[lcvs],
+                       &side_sets_elems[lcvs][0], &side_sets_faces[lcvs][0]);
+    ASSERT(!ierr);
+  }
+
+  if (ids) {
+    ierr |= ex_put_id_map(fid, EX_NODE_MAP, &node_map[0]);
+    ASSERT(!ierr);
+    ierr |= ex_put_id_map(fid, EX_ELEM_MAP, &elem_map[0]);
+    ASSERT(!ierr);
+
+    // -- Nemesis: no ghost (external) nodes, since parts are whole columns
+    std::vector<int> node_mape;
+    ierr |= ex_put_processor_node_maps(fid, node_mapi.data(), node_mapb.data(),
+                                       node_mape.data(), ids->part);
+    ierr |= ex_put_processor_elem_maps(fid, elem_mapi.data(), elem_mapb.data(), ids->part);
+    ASSERT(!ierr);
+    for (auto& cmap : node_cmaps) {
+      std::vector<int> procs(cmap.second.size(), cmap.first);
+      ierr |= ex_put_node_cmap(fid, cmap.first, cmap.second.data(), procs.data(), ids->part);
+      ASSERT(!ierr);
+    }
+    for (auto& cmap : elem_cmaps_elem) {
+      std::vector<int> procs(cmap.second.size(), cmap.first);
+      ierr |= ex_put_elem_cmap(fid, cmap.first, cmap.second.data(),
+                               elem_cmaps_side[cmap.first].data(), procs.data(), ids->part);
+      ASSERT(!ierr);
+    }
+  }
+
+  ierr |= ex_close(fid);
+  ASSERT(!ierr);
+
+  // debugging/nice output
+  std::cout << "Wrote 3D Mesh:" << std::endl
+            << "  ncells = " << ncells << std::endl
+            << "  nfaces = " << nfaces << std::endl
+            << "  nnodes = " << nnodes << std::endl
+            << std::endl
+            << "  side sets = " << std::endl;
+  for (int i=0; i!=side_sets_id.size(); ++i)
+    std::cout << "    " << side_sets_id[i] << " ("
+              << side_sets_size[i] << " faces)" << std::endl;
+  std::cout << std::endl
+            << "  block ids = " << std::endl;
+  for (int i=0; i!=blocks_id.size(); ++i)
+    std::cout << "    " << blocks_id[i] << " ("
+              << blocks_ncells[i] << " cells)" << std::endl;
+  std::cout << std::endl;
+
+  if (!ids) {
+    std::ofstream fid_counts;
+    fid_counts.open("col_counts.txt");
+    for (auto count : cells_in_col) fid_counts << count << std::endl;
+    fid_counts.close();
+  }
+}
+
+} // namespace
+
+
+void
+extrudeMesh3D_exodus(const Mesh2D& m,
+                     LayerGenerator& layers,
+                     const std::string& filename,
+                     int nthreads,
+                     bool squash_zero_edges) {
+  extrudeExodus(m, layers, filename, nthreads, squash_zero_edges, NULL);
+}
+
+
+void
+extrudeMesh3D_exodus_par(const Mesh2D& m,
+                         LayerGenerator& layers,
+                         const std::string& filename,
+                         int nparts,
+                         int nthreads,
+                         bool squash_zero_edges) {
+  std::string basename = filename;
+  if (basename.size() > 4 && basename.substr(basename.size()-4) == ".exo")
+    basename = basename.substr(0, basename.size()-4);
+  int width = std::to_string(nparts).size();
+
+  if (nthreads <= 0) nthreads = std::max(1, (int) std::thread::hardware_concurrency());
+
+  // -- the extrusion of the whole mesh: its sizes, and the first element of
+  //    each block
+  PartIds global;
+  std::map<int,int64_t> block_start;
+  {
+    LayerExtruder counter(m, nthreads, squash_zero_edges);
+    std::vector<double> dz;
+    std::vector<int> block_ids;
+    int64_t nnodes = m.nnodes, nsides = 0;
+    std::map<int,int64_t> block_ncells;
+    for (int lay=0; lay!=layers.size(); ++lay) {
+      layers.layer(lay, dz, block_ids);
+      const LayerCounts& counts = counter.count(dz, block_ids);
+      nnodes += counts.nodes;
+      nsides += counts.sides;
+      for (auto& b : counts.blocks) block_ncells[b.first] += b.second.first;
+    }
+
+    global.nnodes_global = nnodes;
+    global.ncells_global = 0;
+    for (auto& b : block_ncells) {
+      block_start[b.first] = global.ncells_global;
+      global.ncells_global += b.second;
+      global.blocks_id_global.push_back(b.first);
+      global.blocks_ncells_global.push_back(b.second);
+    }
+
+    std::set<int> set_ids;
+    for (auto& part : m.cell_sets) set_ids.insert(part.begin(), part.end());
+    global.side_sets_id_global = { 1, 2, 3 };
+    global.side_sets_size_global = { m.ncells, m.ncells, (int) nsides };
+    for (int sid : set_ids) {
+      int count = 0;
+      for (auto& part : m.cell_sets) count += std::count(part.begin(), part.end(), sid);
+      global.side_sets_id_global.push_back(sid);
+      global.side_sets_size_global.push_back(count);
+    }
+  }
+
+  // -- the parts holding each node and face
+  std::vector<int> partition = partitionColumns(m, nparts);
+  std::vector<std::vector<int> > node_parts(m.nnodes), face_parts(m.nfaces);
+  for (int c=0; c!=m.ncells; ++c) {
+    int p = partition[c];
+    for (auto n : m.cell2node[c]) {
+      if (std::find(node_parts[n].begin(), node_parts[n].end(), p) == node_parts[n].end())
+        node_parts[n].push_back(p);
+    }
+    for (auto f : m.cell2face[c]) face_parts[f].push_back(p);
+  }
+
+  for (int rank=0; rank!=nparts; ++rank) {
+    PartIds ids(global);
+    ids.part = rank;
+    ids.nparts = nparts;
+    for (int c=0; c!=m.ncells; ++c) {
+      if (partition[c] == rank) ids.cell_gids.push_back(c);
+    }
+    Mesh2D sub = extractColumns(m, ids.cell_gids, ids.node_gids);
+
+    for (auto n : ids.node_gids) {
+      std::vector<int> others;
+      for (int p : node_parts[n]) {
+        if (p != rank) others.push_back(p);
+      }
+      std::sort(others.begin(), others.end());
+      ids.node_parts.emplace_back(std::move(others));
+    }
+    ids.face_parts.assign(sub.nfaces, -1);
+    for (int f=0; f!=sub.nfaces; ++f) {
+      int n0 = ids.node_gids[sub.face2node[f][0]];
+      int n1 = ids.node_gids[sub.face2node[f][1]];
+      auto match = m.faces_sorted.find(n0 > n1 ? m.hash(n1, n0) : m.hash(n0, n1));
+      ASSERT(match != m.faces_sorted.end());
+      for (int p : face_parts[match->second]) {
+        if (p != rank) ids.face_parts[f] = p;
+      }
+    }
+
+    std::stringstream name;
+    name << basename << ".par." << nparts << "." << std::setw(width) << std::setfill('0') << rank;
+    std::cout << "Extruding part " << rank << " (" << ids.cell_gids.size()
+              << " columns) to: " << name.str() << std::endl;
+
+    SubsetLayers sub_layers(layers, m, squash_zero_edges, block_start, ids);
+    extrudeExodus(sub, sub_layers, name.str(), nthreads, squash_zero_edges, &ids);
+  }
+}
+
+
+}
+}
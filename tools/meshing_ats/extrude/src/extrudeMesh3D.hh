@@ -0,0 +1,58 @@
+#ifndef EXTRUDE_MESH_3D_HH_
+#define EXTRUDE_MESH_3D_HH_
+
+#include <string>
+#include <vector>
+
+#include "Mesh2D.hh"
+
+//
+// Streaming extrusion.
+//
+// Mesh3D holds the entire 3D mesh, as nested vectors, until it is written.
+// These instead extrude and write one layer at a time.  A first, counting pass
+// over the layers sizes the Exodus file.  Then each layer is built in flat
+// (CSR) arrays, multithreaded over the surface cells, and written directly to
+// its place in the file.  Memory scales with one layer plus the surface mesh.
+//
+// The mesh written is identical to that of Mesh3D::extrude(), Mesh3D::finish()
+// and writeMesh3D_exodus().
+//
+
+namespace Amanzi {
+namespace AmanziGeometry {
+
+// Provides the layers, top down.  layer() is called for i = 0, 1, ..., size()-1
+// in order, once for each pass over the layers, and fills the thickness of
+// layer i at each 2D node and the block id of each 2D cell.
+struct LayerGenerator {
+  virtual ~LayerGenerator() {}
+  virtual int size() const = 0;
+  virtual void layer(int i, std::vector<double>& dz, std::vector<int>& block_ids) = 0;
+};
+
+
+// Extrude m and write it to filename.  nthreads=0 uses one thread per core.
+void extrudeMesh3D_exodus(const Mesh2D& m,
+                          LayerGenerator& layers,
+                          const std::string& filename,
+                          int nthreads=0,
+                          bool squash_zero_edges=true);
+
+// Extrude m into nparts pre-partitioned files, each holding whole columns, in
+// the Exodus decomposed naming filename.par.<nparts>.<rank> (a trailing .exo
+// is dropped), so that the simulator need not partition the mesh on startup.
+// The node and element id maps of each file are the numbering of the serial
+// mesh of extrudeMesh3D_exodus(), and each file carries the Nemesis global
+// sizes, load balance maps, and node and element communication maps.
+void extrudeMesh3D_exodus_par(const Mesh2D& m,
+                              LayerGenerator& layers,
+                              const std::string& filename,
+                              int nparts,
+                              int nthreads=0,
+                              bool squash_zero_edges=true);
+
+}
+}
+
+#endif
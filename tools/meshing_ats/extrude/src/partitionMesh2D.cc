@@ -0,0 +1,122 @@
+#include <numeric>
+
+#include "dbc.hh"
+#include "partitionMesh2D.hh"
+
+namespace Amanzi {
+namespace AmanziGeometry {
+
+namespace {
+
+void
+bisect(const std::vector<Point>& centroids,
+       std::vector<int>::iterator begin,
+       std::vector<int>::iterator end,
+       int first_part, int nparts,
+       std::vector<int>& partition) {
+  if (nparts == 1) {
+    for (auto c=begin; c!=end; ++c) partition[*c] = first_part;
+    return;
+  }
+
+  // cut across the longer extent, in proportion to the parts on each side
+  double lo[2] = { 1.e80, 1.e80 }, hi[2] = { -1.e80, -1.e80 };
+  for (auto c=begin; c!=end; ++c) {
+    for (int d=0; d!=2; ++d) {
+      lo[d] = std::min(lo[d], centroids[*c][d]);
+      hi[d] = std::max(hi[d], centroids[*c][d]);
+    }
+  }
+  int dim = (hi[0] - lo[0]) >= (hi[1] - lo[1]) ? 0 : 1;
+
+  int nparts_lo = nparts / 2;
+  auto mid = begin + ((int64_t) (end - begin)) * nparts_lo / nparts;
+  std::nth_element(begin, mid, end, [&](int a, int b) {
+      return centroids[a][dim] < centroids[b][dim]; });
+
+  bisect(centroids, begin, mid, first_part, nparts_lo, partition);
+  bisect(centroids, mid, end, first_part + nparts_lo, nparts - nparts_lo, partition);
+}
+
+} // namespace
+
+
+std::vector<int>
+partitionColumns(const Mesh2D& m, int nparts) {
+  ASSERT(nparts > 0);
+  std::vector<Point> centroids(m.ncells, Point(2));
+  for (int c=0; c!=m.ncells; ++c) {
+    for (auto n : m.cell2node[c]) {
+      centroids[c][0] += m.coords[n][0];
+      centroids[c][1] += m.coords[n][1];
+    }
+    centroids[c] /= m.cell2node[c].size();
+  }
+
+  std::vector<int> cells(m.ncells);
+  std::iota(cells.begin(), cells.end(), 0);
+  std::vector<int> partition(m.ncells, -1);
+  bisect(centroids, cells.begin(), cells.end(), 0, nparts, partition);
+  return partition;
+}
+
+
+Mesh2D
+extractColumns(const Mesh2D& m,
+               const std::vector<int>& cells,
+               std::vector<int>& nodes) {
+  std::vector<int> node_lid(m.nnodes, -1);
+  nodes.clear();
+
+  std::vector<std::vector<int> > cell2node;
+  for (auto c : cells) {
+    std::vector<int> c_nodes;
+    for (auto n : m.cell2node[c]) {
+      if (node_lid[n] < 0) {
+        node_lid[n] = nodes.size();
+        nodes.push_back(n);
+      }
+      c_nodes.push_back(node_lid[n]);
+    }
+    cell2node.emplace_back(std::move(c_nodes));
+  }
+
+  std::vector<Point> coords;
+  for (auto n : nodes) coords.push_back(m.coords[n]);
+
+  std::vector<std::vector<int> > cell_sets;
+  for (auto& part : m.cell_sets) {
+    std::vector<int> sub_part;
+    for (auto c : cells) sub_part.push_back(part[c]);
+    cell_sets.emplace_back(std::move(sub_part));
+  }
+
+  Mesh2D sub(coords, cell2node, cell_sets);
+
+  // undo the re-normalization of the already normalized coordinates
+  for (auto& p : sub.coords) {
+    p[0] += sub.datum[0];
+    p[1] += sub.datum[1];
+  }
+  sub.datum = m.datum;
+
+  // faces interior to m are interior to the piece too
+  std::vector<int> boundary_c, boundary_f;
+  for (int f=0; f!=sub.nfaces; ++f) {
+    int n0 = nodes[sub.face2node[f][0]];
+    int n1 = nodes[sub.face2node[f][1]];
+    auto h = n0 > n1 ? m.hash(n1, n0) : m.hash(n0, n1);
+    auto match = m.faces_sorted.find(h);
+    ASSERT(match != m.faces_sorted.end());
+    sub.side_face_counts[f] = m.side_face_counts[match->second];
+    if (sub.side_face_counts[f] == 1) {
+      boundary_c.push_back(sub.face_cell_when_created[f]);
+      boundary_f.push_back(sub.face_in_cell_when_created[f]);
+    }
+  }
+  sub.boundary_faces = std::make_pair(boundary_c, boundary_f);
+  return sub;
+}
+
+}
+}
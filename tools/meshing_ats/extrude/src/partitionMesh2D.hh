@@ -0,0 +1,27 @@
+#ifndef PARTITION_MESH_2D_HH_
+#define PARTITION_MESH_2D_HH_
+
+#include <vector>
+
+#include "Mesh2D.hh"
+
+namespace Amanzi {
+namespace AmanziGeometry {
+
+// Splits the cells of m into nparts compact parts of nearly equal size by
+// recursive coordinate bisection of the cell centroids.  Returns the part of
+// each cell.
+std::vector<int> partitionColumns(const Mesh2D& m, int nparts);
+
+// The piece of m made of the given cells.  On return, nodes holds the node of
+// m of each node of the piece.  Faces on the boundary of the piece but not of
+// m are not boundary faces of the piece, and the piece keeps the datum (and
+// so the coordinates) of m.
+Mesh2D extractColumns(const Mesh2D& m,
+                      const std::vector<int>& cells,
+                      std::vector<int>& nodes);
+
+}
+}
+
+#endif
@@ -9,6 +9,7 @@ _filenames = {"extrude_one_layer":"Mesh3D_OneLayer",
               "extrude_uniform":"Mesh3D_2mSoil",
               "extrude_homogeneous_uniform":"Mesh3D_Homogeneous2mSoil",
               "extrude_variable":"Mesh3D_VariableSoil",
+              "extrude_variable_streaming":"Mesh3D_VariableSoilStreaming",
               "extrude_homogeneous_variable":"Mesh3D_HomogeneousVariableSoil"}
 
 
@@ -39,6 +40,30 @@ def runExe(dirname, exes=None):
 
 
 
+# the streaming extrusion, written again into this many pre-partitioned files
+_par_exe = "extrude_variable_streaming"
+_par_nparts = 2
+
+def parFilenames(dirname, nparts=_par_nparts):
+    return [os.path.join(dirname, "%s.par.%d.%d"%(_filenames[_par_exe], nparts, rank))
+            for rank in range(nparts)]
+
+def numSurfaceCells(dirname):
+    with open(os.path.join(dirname, "Mesh.txt"), 'r') as fid:
+        return len([line for line in fid if line.strip()]) - 1
+
+def runExePar(dirname, nparts=_par_nparts):
+    cwd = os.getcwd()
+    try:
+        os.chdir(dirname)
+        executable = os.path.join("..", "..", _par_exe)
+        print "Running: %s 0 %d in %s"%(executable, nparts, os.getcwd())
+        with open(_filenames[_par_exe]+".par.log", 'w') as stdout:
+            subprocess.call([executable, "0", str(nparts)], stdout=stdout)
+    finally:
+        os.chdir(cwd)
+
+
 def loadConfig(dirname):
     cp = config_parser()
     cp.read(os.path.join(dirname, "test.cfg"))
@@ -84,6 +109,138 @@ def generateMeshClass(dirname, meshname, config):
     MyMesh.__module__ = ""
     return MyMesh
 
+# The pre-partitioned files, together, must be the serial mesh: the same
+# cells, in the same blocks, and the same nodes, numbered as in the serial
+# mesh.  Each file also carries the Nemesis global sizes, load balance maps
+# and communication maps.
+class ParMesh(unittest.TestCase):
+    def setUp(self):
+        self.serial = openMesh(os.path.join(self.dirname, _filenames[_par_exe]+".exo"))
+        self.parts = [openMesh(f) for f in parFilenames(self.dirname)]
+
+    def tearDown(self):
+        self.serial.close()
+        for part in self.parts:
+            part.close()
+
+    def test_elem_counts(self):
+        self.assertEqual(sum(len(p.dimensions["num_elem"]) for p in self.parts),
+                         len(self.serial.dimensions["num_elem"]))
+
+    def test_global_counts(self):
+        for p in self.parts:
+            self.assertEqual(len(p.dimensions["num_nodes_global"]),
+                             len(self.serial.dimensions["num_nodes"]))
+            self.assertEqual(len(p.dimensions["num_elems_global"]),
+                             len(self.serial.dimensions["num_elem"]))
+
+    def test_elem_ids(self):
+        ids = [int(i) for p in self.parts for i in p.variables["elem_num_map"][:]]
+        self.assertEqual(sorted(ids), range(1, len(self.serial.dimensions["num_elem"])+1))
+
+        # cells of a block take that block's ids in the serial mesh
+        ranges = dict()
+        start = 0
+        for bid, n in blockCounts(self.serial):
+            ranges[bid] = (start, start+n)
+            start += n
+        for p in self.parts:
+            elem_ids = p.variables["elem_num_map"][:]
+            start = 0
+            for bid, n in blockCounts(p):
+                for i in elem_ids[start:start+n]:
+                    self.assertTrue(ranges[bid][0] < i <= ranges[bid][1])
+                start += n
+
+    def test_block_counts(self):
+        serial = dict(blockCounts(self.serial))
+        summed = dict()
+        for p in self.parts:
+            for bid, n in blockCounts(p):
+                summed[bid] = summed.get(bid, 0) + n
+        self.assertEqual(summed, serial)
+
+    def test_nodes(self):
+        serial = coords(self.serial)
+
+        # every node is at its serial position, and every serial node is in a part
+        found = set()
+        for p in self.parts:
+            for i, x in zip(p.variables["node_num_map"][:], coords(p)):
+                for a, b in zip(x, serial[int(i)-1]):
+                    self.assertAlmostEqual(a, b, 5)
+                found.add(int(i))
+        self.assertEqual(len(found), len(serial))
+
+    def test_border_nodes(self):
+        # a node is on the border exactly when another part has it
+        ids = [set(int(i) for i in p.variables["node_num_map"][:]) for p in self.parts]
+        for rank, p in enumerate(self.parts):
+            others = set()
+            for other in ids[:rank] + ids[rank+1:]:
+                others |= ids[rank] & other
+            border = set(globalIds(p, "node", "node_mapb"))
+            self.assertEqual(border, others)
+            self.assertEqual(len(border) + len(localVariable(p, "node_mapi")),
+                             len(ids[rank]))
+
+    def test_node_cmaps(self):
+        # part r sends to part s the nodes s sends to r
+        cmaps = [commMaps(p, "node", "n_comm") for p in self.parts]
+        for rank, cmap in enumerate(cmaps):
+            for other, nodes in cmap.items():
+                self.assertEqual(sorted(nodes), sorted(cmaps[other][rank]))
+
+    def test_elem_cmaps(self):
+        # each face between two parts is in both parts' maps
+        cmaps = [commMaps(p, "elem", "e_comm") for p in self.parts]
+        for rank, cmap in enumerate(cmaps):
+            for other, elems in cmap.items():
+                self.assertEqual(len(elems), len(cmaps[other][rank]))
+
+# (block id, number of cells) for each block, in order; empty blocks may have
+# no cells dimension.
+def blockCounts(fid):
+    counts = []
+    for lcvb, bid in enumerate(fid.variables["eb_prop1"][:]):
+        dname = "num_el_in_blk%d"%(lcvb+1)
+        n = len(fid.dimensions[dname]) if dname in fid.dimensions else 0
+        counts.append((int(bid), n))
+    return counts
+
+def coords(fid):
+    return [tuple(float(xi) for xi in x) for x in
+            zip(*[fid.variables[v][:] for v in ["coordx", "coordy", "coordz"]])]
+
+# an integer variable, empty if the file has none of it
+def localVariable(fid, vname):
+    if vname in fid.variables:
+        return [int(i) for i in fid.variables[vname][:]]
+    return []
+
+# the global ids of the local (1-based) indices in a variable
+def globalIds(fid, entity, vname):
+    num_map = fid.variables[entity+"_num_map"][:]
+    return [int(num_map[i-1]) for i in localVariable(fid, vname)]
+
+# neighbor rank to the global ids in the communication map with it
+def commMaps(fid, entity, prefix):
+    cmaps = dict()
+    procs = localVariable(fid, prefix+"_proc")
+    ids = globalIds(fid, entity, prefix+("_nids" if entity == "node" else "_eids"))
+    for proc, i in zip(procs, ids):
+        cmaps.setdefault(proc, []).append(i)
+    return cmaps
+
+def generateParSuite(dirname):
+    class MyParMesh(ParMesh):
+        pass
+    setattr(MyParMesh, "dirname", dirname)
+    MyParMesh.__name__ = dirname+"_"+_filenames[_par_exe]+"_par"
+    MyParMesh.__module__ = ""
+    return unittest.TestLoader().loadTestsFromTestCase(MyParMesh)
+
+
 def generateSuites(dirname):
     suites = []
     config = loadConfig(dirname)
@@ -93,6 +250,9 @@ def generateSuites(dirname):
     for meshname in meshes:
         suite = unittest.TestLoader().loadTestsFromTestCase(generateMeshClass(dirname, meshname, config))
         suites.append(suite)
+
+    if numSurfaceCells(dirname) >= _par_nparts:
+        suites.append(generateParSuite(dirname))
     return suites
     
 
@@ -101,6 +261,8 @@ if __name__ == "__main__":
     suites = []
     for d in findDirectories():
         runExe(d)
+        if numSurfaceCells(d) >= _par_nparts:
+            runExePar(d)
         suites.append(unittest.TestSuite(generateSuites(d)))
     suite = unittest.TestSuite(suites)
     runner = unittest.TextTestRunner(verbosity=2)